@@ -0,0 +1,90 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : registry and reporting helpers of mini-benchmark
+ *
+ * @file Benchmark.h
+ * @date 2018-12-03
+ */
+#pragma once
+#include <libdevcore/Common.h>
+#include <libdevcore/CommonIO.h>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace dev
+{
+namespace bench
+{
+using BenchmarkFunc = std::function<void()>;
+
+struct BenchmarkEntry
+{
+    std::string description;
+    BenchmarkFunc run;
+};
+
+/// all benchmarks linked into mini-benchmark, by name
+inline std::map<std::string, BenchmarkEntry>& benchmarks()
+{
+    static std::map<std::string, BenchmarkEntry> s_benchmarks;
+    return s_benchmarks;
+}
+
+/// registers a benchmark at static initialization, see BENCHMARK_REGISTER
+struct BenchmarkRegistrar
+{
+    BenchmarkRegistrar(
+        std::string const& _name, std::string const& _description, BenchmarkFunc const& _run)
+    {
+        benchmarks()[_name] = BenchmarkEntry{_description, _run};
+    }
+};
+
+/// run _op _count times and @returns the operations per second
+inline double opsPerSecond(size_t _count, std::function<void()> const& _op)
+{
+    Timer timer;
+    _op();
+    double elapsed = timer.elapsed();
+    return elapsed > 0 ? _count / elapsed : 0;
+}
+
+/// print one result line: <case> <ops/s> [<speedup vs baseline>]
+inline void report(std::string const& _case, double _opsPerSecond, double _baseline = 0)
+{
+    std::cout << std::left << std::setw(48) << _case << std::right << std::setw(16)
+              << std::fixed << std::setprecision(0) << _opsPerSecond << " ops/s";
+    if (_baseline > 0)
+        std::cout << std::setw(10) << std::setprecision(2) << _opsPerSecond / _baseline << "x";
+    std::cout << std::endl;
+}
+
+/// print one measurement line: <case> <value> <unit>
+inline void reportValue(std::string const& _case, double _value, std::string const& _unit)
+{
+    std::cout << std::left << std::setw(48) << _case << std::right << std::setw(16)
+              << std::fixed << std::setprecision(2) << _value << " " << _unit << std::endl;
+}
+}  // namespace bench
+}  // namespace dev
+
+#define BENCHMARK_REGISTER(NAME, DESCRIPTION, FUNC) \
+    static ::dev::bench::BenchmarkRegistrar s_benchmark_##NAME(#NAME, DESCRIPTION, FUNC)
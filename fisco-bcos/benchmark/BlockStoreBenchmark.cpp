@@ -0,0 +1,184 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : blocks kept as hex rows in the leveldb of the state against the BlockStore segments:
+ * block writes, reads by hash and by range, and the state reads of either db
+ *
+ * @file BlockStoreBenchmark.cpp
+ * @date 2018-12-21
+ */
+#include "Benchmark.h"
+#include <leveldb/db.h>
+#include <libblockchain/BlockStore.h>
+#include <libdevcore/CommonData.h>
+#include <libdevcore/SHA3.h>
+#include <boost/filesystem.hpp>
+#include <random>
+
+using namespace dev;
+using namespace dev::bench;
+using namespace dev::blockchain;
+
+namespace
+{
+std::shared_ptr<leveldb::DB> openLevelDB(std::string const& _path)
+{
+    boost::filesystem::remove_all(_path);
+    leveldb::Options options;
+    options.create_if_missing = true;
+    leveldb::DB* db = nullptr;
+    leveldb::DB::Open(options, _path, &db);
+    return std::shared_ptr<leveldb::DB>(db);
+}
+
+/// _count state rows of about the size of a contract storage entry
+void writeState(leveldb::DB& _db, size_t _count)
+{
+    for (size_t i = 0; i < _count; i++)
+    {
+        std::string value = toString(sha3(toString(_count + i)));
+        _db.Put(leveldb::WriteOptions(), "c_state_" + toString(sha3(toString(i))),
+            "{\"key\":\"" + toString(i) + "\",\"value\":\"" + value + "\"}");
+    }
+}
+}  // namespace
+
+static void blockStoreBenchmark()
+{
+    size_t const blockCount = 2000;
+    size_t const blockSize = 32 * 1024;
+    size_t const stateCount = 200000;
+    std::string const blocksDB = "mini-benchmark-blocks-leveldb";
+    std::string const stateDB = "mini-benchmark-state-leveldb";
+    std::string const storePath = "mini-benchmark-blockstore";
+
+    std::mt19937_64 random(7);
+    std::vector<bytes> blocks(blockCount, bytes(blockSize));
+    h256s hashes(blockCount);
+    for (size_t i = 0; i < blockCount; i++)
+    {
+        for (auto& b : blocks[i])
+            b = (byte)random();
+        hashes[i] = sha3(blocks[i]);
+    }
+
+    /// before: the blocks are hex rows of _sys_hash_2_block_ next to the state
+    auto mixed = openLevelDB(blocksDB);
+    writeState(*mixed, stateCount);
+    double ldbWrite = opsPerSecond(blockCount, [&]() {
+        for (size_t i = 0; i < blockCount; i++)
+        {
+            mixed->Put(leveldb::WriteOptions(), "_sys_number_2_hash__" + toString(i + 1),
+                "{\"value\":\"" + hashes[i].hex() + "\"}");
+            mixed->Put(leveldb::WriteOptions(), "_sys_hash_2_block__" + hashes[i].hex(),
+                "{\"value\":\"" + toHexPrefixed(blocks[i]) + "\"}");
+        }
+    });
+    /// after: the blocks are appended to the segments, the state db keeps number -> hash only
+    auto state = openLevelDB(stateDB);
+    writeState(*state, stateCount);
+    boost::filesystem::remove_all(storePath);
+    auto store = std::make_shared<BlockStore>(storePath);
+    double storeWrite = opsPerSecond(blockCount, [&]() {
+        for (size_t i = 0; i < blockCount; i++)
+        {
+            state->Put(leveldb::WriteOptions(), "_sys_number_2_hash__" + toString(i + 1),
+                "{\"value\":\"" + hashes[i].hex() + "\"}");
+            store->put(i + 1, hashes[i], ref(blocks[i]));
+        }
+    });
+    report("block write, leveldb hex rows", ldbWrite);
+    report("block write, BlockStore", storeWrite, ldbWrite);
+
+    std::vector<size_t> order(blockCount);
+    for (size_t i = 0; i < blockCount; i++)
+        order[i] = random() % blockCount;
+    size_t bytesRead = 0;
+    double ldbRead = opsPerSecond(blockCount, [&]() {
+        for (size_t i : order)
+        {
+            std::string value;
+            mixed->Get(leveldb::ReadOptions(), "_sys_hash_2_block__" + hashes[i].hex(), &value);
+            /// {"value":"0x...."}
+            bytesRead += fromHex(value.substr(10, value.size() - 12)).size();
+        }
+    });
+    double storeRead = opsPerSecond(blockCount, [&]() {
+        for (size_t i : order)
+            bytesRead += store->get(hashes[i])->size();
+    });
+    report("block read by hash, leveldb hex rows", ldbRead);
+    report("block read by hash, BlockStore", storeRead, ldbRead);
+
+    /// sync reads blocks by ranges of number
+    size_t const range = 64;
+    size_t const rangeBlocks = (blockCount - 1) / range * range;
+    double ldbRange = opsPerSecond(rangeBlocks, [&]() {
+        for (size_t from = 1; from + range <= blockCount; from += range)
+        {
+            for (size_t number = from; number < from + range; number++)
+            {
+                std::string hash;
+                std::string key = "_sys_number_2_hash__" + toString(number);
+                mixed->Get(leveldb::ReadOptions(), key, &hash);
+                std::string value;
+                mixed->Get(leveldb::ReadOptions(),
+                    "_sys_hash_2_block__" + hash.substr(10, hash.size() - 12), &value);
+                bytesRead += fromHex(value.substr(10, value.size() - 12)).size();
+            }
+        }
+    });
+    double storeRange = opsPerSecond(rangeBlocks, [&]() {
+        for (size_t from = 1; from + range <= blockCount; from += range)
+        {
+            for (auto const& block : store->getRange(from, from + range - 1))
+                bytesRead += block->size();
+        }
+    });
+    report("block range read, leveldb hex rows", ldbRange);
+    report("block range read, BlockStore", storeRange, ldbRange);
+
+    /// state reads no longer share the db, its caches and its compactions with the blocks
+    size_t const stateReads = 200000;
+    std::vector<std::string> keys(stateReads);
+    for (auto& key : keys)
+        key = "c_state_" + toString(sha3(toString(random() % stateCount)));
+    double mixedState = opsPerSecond(stateReads, [&]() {
+        std::string value;
+        for (auto const& key : keys)
+            bytesRead += mixed->Get(leveldb::ReadOptions(), key, &value).ok() ? value.size() : 0;
+    });
+    double onlyState = opsPerSecond(stateReads, [&]() {
+        std::string value;
+        for (auto const& key : keys)
+            bytesRead += state->Get(leveldb::ReadOptions(), key, &value).ok() ? value.size() : 0;
+    });
+    report("state read, blocks in the state leveldb", mixedState);
+    report("state read, blocks in BlockStore", onlyState, mixedState);
+    reportValue("bytes read", bytesRead / (1024.0 * 1024.0), "MB");
+
+    mixed.reset();
+    state.reset();
+    store.reset();
+    boost::filesystem::remove_all(blocksDB);
+    boost::filesystem::remove_all(stateDB);
+    boost::filesystem::remove_all(storePath);
+}
+
+BENCHMARK_REGISTER(blockstore,
+    "blocks as hex rows of the state leveldb vs BlockStore segments: writes, reads, state reads",
+    blockStoreBenchmark);
@@ -0,0 +1,115 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : a large block decoded whole by Block against read through BlockView by consumers
+ * wanting the header, the transaction hashes, the senders or one transaction only
+ *
+ * @file BlockViewBenchmark.cpp
+ * @date 2018-12-25
+ */
+#include "Benchmark.h"
+#include <libdevcrypto/Common.h>
+#include <libethcore/Block.h>
+#include <libethcore/BlockView.h>
+
+using namespace dev;
+using namespace dev::bench;
+using namespace dev::eth;
+
+namespace
+{
+/// a block of _count signed transactions with _dataSize bytes of call data each
+std::shared_ptr<bytes const> makeBlock(size_t _count, size_t _dataSize)
+{
+    KeyPair keyPair = KeyPair::create();
+    Transactions txs(_count);
+    for (size_t i = 0; i < _count; i++)
+    {
+        bytes data(_dataSize, byte(i));
+        txs[i] = Transaction(u256(0), u256(0), u256(30000000), Address(i + 1), data, u256(i));
+        txs[i].setBlockLimit(u256(1000));
+        SignatureStruct sig = sign(keyPair.secret(), txs[i].sha3(WithoutSignature));
+        txs[i].updateSignature(sig);
+    }
+    BlockHeader header;
+    header.setNumber(1);
+    header.setGasLimit(u256(3000000000));
+    header.setTimestamp(1545696000000);
+    header.setSealer(u256(0));
+    Block block;
+    block.setBlockHeader(header);
+    block.setTransactions(txs);
+    auto encoded = std::make_shared<bytes>();
+    block.encode(*encoded);
+    return encoded;
+}
+}  // namespace
+
+static void blockViewBenchmark()
+{
+    size_t const count = 5000;
+    size_t const rounds = 20;
+    auto data = makeBlock(count, 256);
+    reportValue("block size", data->size() / (1024.0 * 1024.0), "MB");
+
+    size_t checksum = 0;
+    /// the senders are recovered once, every later decode finds them in SenderCache
+    checksum += Block(*data).transactions().size();
+    double fullDecode = opsPerSecond(rounds, [&]() {
+        for (size_t r = 0; r < rounds; r++)
+            checksum += Block(*data).transactions().size();
+    });
+    report("Block decode", fullDecode);
+
+    double headerOnly = opsPerSecond(rounds, [&]() {
+        for (size_t r = 0; r < rounds; r++)
+            checksum += BlockView(data).number();
+    });
+    report("BlockView header only", headerOnly, fullDecode);
+
+    double hashesOnly = opsPerSecond(rounds, [&]() {
+        for (size_t r = 0; r < rounds; r++)
+            checksum += BlockView(data).transactionHashes().size();
+    });
+    report("BlockView transaction hashes", hashesOnly, fullDecode);
+
+    double sendersOnly = opsPerSecond(rounds, [&]() {
+        for (size_t r = 0; r < rounds; r++)
+        {
+            for (auto const& tx : BlockView(data).transactions())
+                checksum += tx.sender()[0];
+        }
+    });
+    report("BlockView senders", sendersOnly, fullDecode);
+
+    /// the transaction by hash query: one transaction out of the block
+    double oneDecode = opsPerSecond(rounds, [&]() {
+        for (size_t r = 0; r < rounds; r++)
+            checksum += Block(*data).transactions()[count / 2].data().size();
+    });
+    double oneView = opsPerSecond(rounds, [&]() {
+        for (size_t r = 0; r < rounds; r++)
+            checksum += BlockView(data).transaction(count / 2).toTransaction().data().size();
+    });
+    report("one transaction, Block decode", oneDecode);
+    report("one transaction, BlockView", oneView, oneDecode);
+    reportValue("checksum", checksum, "");
+}
+
+BENCHMARK_REGISTER(blockview,
+    "decoding a 5000 transaction block whole vs BlockView header, hashes, senders, one tx",
+    blockViewBenchmark);
@@ -0,0 +1,302 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : messages per second and p99 round trip of two ChannelSessions echoing AMOP sized
+ * messages over loopback TCP, and of SDK connections sending AMOP requests that the
+ * ChannelRPCServer routes to the nodes following their topic
+ *
+ * @file ChannelBenchmark.cpp
+ * @date 2018-12-16
+ */
+#include "Benchmark.h"
+#include "FakeModule.h"
+#include <libchannelserver/ChannelMessage.h>
+#include <libchannelserver/ChannelRPCServer.h>
+#include <libchannelserver/ChannelSession.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
+using namespace dev;
+using namespace dev::bench;
+using namespace dev::channel;
+
+namespace
+{
+ChannelSession::Ptr createSession(std::shared_ptr<boost::asio::io_service> _ioService,
+    boost::asio::ssl::context& _context, ThreadPool::Ptr _threadPool)
+{
+    auto session = std::make_shared<ChannelSession>();
+    session->setThreadPool(_threadPool);
+    session->setIOService(_ioService);
+    session->setMessageFactory(std::make_shared<ChannelMessageFactory>());
+    session->setEnableSSL(false);
+    session->setSSLSocket(
+        std::make_shared<boost::asio::ssl::stream<boost::asio::ip::tcp::socket> >(
+            *_ioService, _context));
+    return session;
+}
+
+/// seq of the _index-th request, unique 32 characters
+std::string seqOf(size_t _index)
+{
+    std::string seq = toString(_index);
+    return std::string(32 - seq.size(), '0') + seq;
+}
+
+/// send requests _first to _first + _count of _size bytes, prefixed by _topic if any, with at
+/// most _window unanswered, and fill _latencies with the round trip of each in microseconds
+void sendWindowed(ChannelSession::Ptr _client, std::string const& _topic, size_t _first,
+    size_t _count, size_t _size, size_t _window, std::vector<double>& _latencies)
+{
+    std::mutex mutex;
+    std::condition_variable answered;
+    size_t inFlight = 0;
+    size_t done = 0;
+    bytes payload;
+    if (!_topic.empty())
+    {
+        payload.push_back(byte(_topic.size() + 1));
+        payload.insert(payload.end(), _topic.begin(), _topic.end());
+    }
+    payload.resize(payload.size() + _size, 0x2a);
+
+    for (size_t i = _first; i < _first + _count; i++)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            answered.wait(lock, [&]() { return inFlight < _window; });
+            inFlight++;
+        }
+        auto request = std::make_shared<ChannelMessage>();
+        request->setType(0x30);
+        request->setSeq(seqOf(i));
+        request->setData(payload.data(), payload.size());
+        auto start = std::chrono::steady_clock::now();
+        _client->asyncSendMessage(
+            request, [&, i, start](ChannelException, dev::channel::Message::Ptr) {
+                auto elapsed = std::chrono::steady_clock::now() - start;
+                _latencies[i] = std::chrono::duration<double, std::micro>(elapsed).count();
+                std::lock_guard<std::mutex> lock(mutex);
+                inFlight--;
+                done++;
+                answered.notify_all();
+            });
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    answered.wait(lock, [&]() { return done == _count; });
+}
+
+/// send _count messages of _size bytes with at most _window unanswered, @returns messages per
+/// second and fills _latencies with the round trip of each in microseconds
+double echo(ChannelSession::Ptr _client, size_t _count, size_t _size, size_t _window,
+    std::vector<double>& _latencies)
+{
+    _latencies.assign(_count, 0);
+    return opsPerSecond(
+        _count, [&]() { sendWindowed(_client, "", 0, _count, _size, _window, _latencies); });
+}
+
+/// the nodes following the AMOP topic: they answer every request from a thread pool, as their
+/// SDK would through the network, but for m_dead that never answers
+class TopicService : public NullService
+{
+public:
+    TopicService(NodeIDs const& _nodeIDs, NodeID const& _dead)
+      : m_nodeIDs(_nodeIDs), m_dead(_dead), m_threadPool("TopicNodes", 4)
+    {}
+    void setServer(std::weak_ptr<ChannelRPCServer> _server) { m_server = _server; }
+
+    NodeIDs getPeersByTopic(std::string const&) override { return m_nodeIDs; }
+    void asyncSendMessageByNodeID(NodeID const& _nodeID, dev::p2p::Message::Ptr _message,
+        std::function<void(dev::p2p::P2PException, dev::p2p::Message::Ptr)>,
+        dev::p2p::Options const&) override
+    {
+        if (_nodeID == m_dead)
+            return;
+        auto buffer = _message->buffer();
+        m_threadPool.enqueue([this, _nodeID, buffer]() {
+            ChannelMessage request;
+            request.decode(buffer->data(), buffer->size());
+            if (request.type() != 0x30)
+                return;
+            request.setType(0x31);
+            request.setResult(0);
+            auto response = std::make_shared<bytes>();
+            request.encode(*response);
+            if (auto server = m_server.lock())
+                server->onNodeRequest(_nodeID, response);
+        });
+    }
+
+private:
+    NodeIDs m_nodeIDs;
+    NodeID m_dead;
+    ThreadPool m_threadPool;
+    std::weak_ptr<ChannelRPCServer> m_server;
+};
+
+/// _connections SDK connections of a ChannelRPCServer sending _count AMOP requests in all, a
+/// window of _window each, @returns messages per second and fills _latencies
+double amop(std::shared_ptr<boost::asio::io_service> _ioService,
+    boost::asio::ssl::context& _context, ThreadPool::Ptr _threadPool,
+    std::shared_ptr<TopicService> _service, uint32_t _timeout, size_t _connections,
+    size_t _count, size_t _window, std::vector<double>& _latencies)
+{
+    auto channelServer = std::make_shared<ChannelServer>();
+    channelServer->setIOService(_ioService);
+    channelServer->setMessageFactory(std::make_shared<ChannelMessageFactory>());
+    auto server = std::make_shared<ChannelRPCServer>();
+    server->setService(_service);
+    server->setChannelServer(channelServer);
+    server->setMessageTimeout(_timeout);
+    _service->setServer(server);
+
+    boost::asio::ip::tcp::acceptor acceptor(*_ioService,
+        boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), 0));
+    std::vector<ChannelSession::Ptr> clients;
+    for (size_t i = 0; i < _connections; i++)
+    {
+        auto session = createSession(_ioService, _context, _threadPool);
+        auto client = createSession(_ioService, _context, _threadPool);
+        client->sslSocket()->next_layer().connect(acceptor.local_endpoint());
+        acceptor.accept(session->sslSocket()->next_layer());
+        client->sslSocket()->next_layer().set_option(boost::asio::ip::tcp::no_delay(true));
+        session->sslSocket()->next_layer().set_option(boost::asio::ip::tcp::no_delay(true));
+        server->onConnect(ChannelException(), session);
+        client->run();
+        clients.push_back(client);
+    }
+
+    _latencies.assign(_count, 0);
+    size_t const perConnection = _count / _connections;
+    double rate = opsPerSecond(perConnection * _connections, [&]() {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < _connections; i++)
+        {
+            threads.push_back(std::thread([&, i]() {
+                sendWindowed(clients[i], "amop", i * perConnection, perConnection, 256, _window,
+                    _latencies);
+            }));
+        }
+        for (auto& thread : threads)
+            thread.join();
+    });
+    _latencies.resize(perConnection * _connections);
+
+    for (auto& client : clients)
+        client->disconnectByQuit();
+    return rate;
+}
+}  // namespace
+
+static void channelBenchmark()
+{
+    auto ioService = std::make_shared<boost::asio::io_service>();
+    boost::asio::ssl::context context(boost::asio::ssl::context::sslv23);
+    auto threadPool = std::make_shared<ThreadPool>("ChannelBench", 4);
+
+    boost::asio::ip::tcp::acceptor acceptor(*ioService,
+        boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string("127.0.0.1"), 0));
+    auto server = createSession(ioService, context, threadPool);
+    auto client = createSession(ioService, context, threadPool);
+    client->sslSocket()->next_layer().connect(acceptor.local_endpoint());
+    acceptor.accept(server->sslSocket()->next_layer());
+    client->sslSocket()->next_layer().set_option(boost::asio::ip::tcp::no_delay(true));
+    server->sslSocket()->next_layer().set_option(boost::asio::ip::tcp::no_delay(true));
+
+    /// the server answers every request with its own payload
+    server->setMessageHandler([](ChannelSession::Ptr _session, ChannelException _e,
+                                  dev::channel::Message::Ptr _message) {
+        if (_e.errorCode() != 0 || !_message)
+            return;
+        auto response = std::make_shared<ChannelMessage>();
+        response->setType(_message->type());
+        response->setSeq(_message->seq());
+        response->setData(_message->data(), _message->dataSize());
+        _session->asyncSendMessage(response, ChannelSession::CallbackType(), 0);
+    });
+    server->run();
+    client->run();
+    std::thread ioThread([ioService]() { ioService->run(); });
+
+    size_t const count = 20000;
+    for (size_t size : {128, 4096})
+    {
+        for (size_t window : {1, 100})
+        {
+            std::vector<double> latencies;
+            double rate = echo(client, count, size, window, latencies);
+            std::sort(latencies.begin(), latencies.end());
+            std::string name = "echo " + toString(size) + " bytes, window " + toString(window);
+            report(name, rate);
+            reportValue(name + " p99", latencies[count * 99 / 100], "us");
+        }
+    }
+
+    client->disconnectByQuit();
+    server->disconnectByQuit();
+    ioService->stop();
+    ioThread.join();
+}
+
+BENCHMARK_REGISTER(channel,
+    "ChannelSession echo over loopback TCP: messages/s and p99 round trip, 128B/4KB, window 1/100",
+    channelBenchmark);
+
+static void amopBenchmark()
+{
+    auto ioService = std::make_shared<boost::asio::io_service>();
+    boost::asio::io_service::work work(*ioService);
+    boost::asio::ssl::context context(boost::asio::ssl::context::sslv23);
+    auto threadPool = std::make_shared<ThreadPool>("AMOPBench", 8);
+    std::vector<std::thread> ioThreads;
+    for (size_t i = 0; i < 2; i++)
+        ioThreads.push_back(std::thread([ioService]() { ioService->run(); }));
+
+    NodeIDs nodeIDs{NodeID::random(), NodeID::random()};
+    size_t const count = 20000;
+    for (size_t connections : {1, 4, 16})
+    {
+        auto service = std::make_shared<TopicService>(nodeIDs, NodeID());
+        std::vector<double> latencies;
+        double rate = amop(ioService, context, threadPool, service,
+            ChannelRPCServer::c_defaultMessageTimeout, connections, count, 32, latencies);
+        std::sort(latencies.begin(), latencies.end());
+        std::string name = "AMOP " + toString(connections) + " SDK connections";
+        report(name, rate);
+        reportValue(name + " p99", latencies[latencies.size() * 99 / 100], "us");
+    }
+
+    /// a node that never answers costs its requests a timeout, the others are not held up
+    auto service = std::make_shared<TopicService>(nodeIDs, nodeIDs[0]);
+    std::vector<double> latencies;
+    double rate = amop(ioService, context, threadPool, service, 50, 4, 2000, 32, latencies);
+    std::sort(latencies.begin(), latencies.end());
+    report("AMOP 4 SDK connections, 1 of 2 nodes dead, 50ms timeout", rate);
+    reportValue("AMOP dead node p50", latencies[latencies.size() / 2], "us");
+    reportValue("AMOP dead node p99", latencies[latencies.size() * 99 / 100], "us");
+
+    ioService->stop();
+    for (auto& thread : ioThreads)
+        thread.join();
+}
+
+BENCHMARK_REGISTER(amop,
+    "AMOP requests routed by ChannelRPCServer: messages/s and p99 by SDK connections, dead node",
+    amopBenchmark);
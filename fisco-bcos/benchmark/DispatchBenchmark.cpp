@@ -0,0 +1,143 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : consensus messages in a flood of transaction gossip, handed to the session thread
+ * pool in arrival order against the prioritized queues of MessageDispatcher
+ *
+ * @file DispatchBenchmark.cpp
+ * @date 2018-12-24
+ */
+#include "Benchmark.h"
+#include <libethcore/Protocol.h>
+#include <libp2p/MessageDispatcher.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+
+using namespace dev;
+using namespace dev::bench;
+using namespace dev::p2p;
+
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+/// what a handler of about the cost of a decoded transaction does
+void work()
+{
+    auto end = Clock::now() + std::chrono::microseconds(20);
+    while (Clock::now() < end)
+    {
+    }
+}
+
+struct Latency
+{
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> max{0};
+    std::atomic<uint64_t> count{0};
+
+    void add(Clock::time_point _queued)
+    {
+        uint64_t us =
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - _queued).count();
+        total += us;
+        ++count;
+        uint64_t seen = max;
+        while (us > seen && !max.compare_exchange_weak(seen, us))
+        {
+        }
+    }
+};
+
+/// _gossip transaction handlers with a consensus handler every _every of them, through _push
+void flood(size_t _gossip, size_t _every, Latency& _latency,
+    std::function<void(PROTOCOL_ID, std::function<void()> const&)> const& _push)
+{
+    PROTOCOL_ID txPool = dev::eth::getGroupProtoclID(1, dev::eth::ProtocolID::TxPool);
+    PROTOCOL_ID pbft = dev::eth::getGroupProtoclID(1, dev::eth::ProtocolID::PBFT);
+    auto done = std::make_shared<std::promise<void>>();
+    auto left = std::make_shared<std::atomic<size_t>>(_gossip + _gossip / _every);
+    auto finish = [done, left]() {
+        if (--*left == 0)
+            done->set_value();
+    };
+    for (size_t i = 1; i <= _gossip; i++)
+    {
+        _push(txPool, [finish]() {
+            work();
+            finish();
+        });
+        if (i % _every == 0)
+        {
+            auto queued = Clock::now();
+            _push(pbft, [&_latency, queued, finish]() {
+                _latency.add(queued);
+                work();
+                finish();
+            });
+        }
+    }
+    done->get_future().wait();
+}
+}  // namespace
+
+static void dispatchBenchmark()
+{
+    size_t const gossip = 100000;
+    size_t const every = 500;
+    size_t const threads = 4;
+
+    /// before: every handler posted to the pool, one FIFO for all protocols
+    Latency fifo;
+    {
+        auto threadPool = std::make_shared<ThreadPool>("BenchmarkFIFO", threads);
+        double ops = opsPerSecond(gossip, [&]() {
+            flood(gossip, every, fifo, [&](PROTOCOL_ID, std::function<void()> const& _handler) {
+                threadPool->enqueue(_handler);
+            });
+        });
+        report("handlers, one FIFO", ops);
+    }
+    /// after: queues by protocol, consensus first
+    Latency prioritized;
+    {
+        auto threadPool = std::make_shared<ThreadPool>("BenchmarkQueues", threads);
+        auto dispatcher = std::make_shared<MessageDispatcher>(threadPool, gossip * 2);
+        double ops = opsPerSecond(gossip, [&]() {
+            flood(gossip, every, prioritized,
+                [&](PROTOCOL_ID _protocolID, std::function<void()> const& _handler) {
+                    dispatcher->push(_protocolID, _handler);
+                });
+        });
+        report("handlers, MessageDispatcher", ops);
+        auto status = dispatcher->status();
+        for (auto const& queue : status)
+            reportValue("max depth of protocol " + toString(queue.protocolID), queue.maxDepth,
+                "handlers");
+    }
+
+    reportValue("consensus wait, one FIFO", fifo.total / 1000.0 / fifo.count, "ms avg");
+    reportValue("consensus wait, one FIFO", fifo.max / 1000.0, "ms max");
+    reportValue("consensus wait, MessageDispatcher", prioritized.total / 1000.0 / prioritized.count,
+        "ms avg");
+    reportValue("consensus wait, MessageDispatcher", prioritized.max / 1000.0, "ms max");
+}
+
+BENCHMARK_REGISTER(dispatch,
+    "consensus handler latency under transaction gossip, one FIFO vs prioritized queues",
+    dispatchBenchmark);
@@ -0,0 +1,124 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : p2p service and blockchain stubs for the txpool benchmarks
+ *
+ * @file FakeModule.h
+ * @date 2018-12-17
+ */
+#pragma once
+#include <libblockchain/BlockChainInterface.h>
+#include <libdevcrypto/Common.h>
+#include <libethcore/Protocol.h>
+#include <libp2p/P2PInterface.h>
+#include <libtxpool/TxPool.h>
+
+namespace dev
+{
+namespace bench
+{
+/// the txpool only registers its handler, nothing is sent
+class NullService : public dev::p2p::P2PInterface
+{
+public:
+    Message::Ptr sendMessageByNodeID(NodeID const&, Message::Ptr) override { return nullptr; }
+    void asyncSendMessageByNodeID(
+        NodeID const&, Message::Ptr, CallbackFunc, dev::p2p::Options const&) override
+    {}
+    Message::Ptr sendMessageByTopic(std::string const&, Message::Ptr) override { return nullptr; }
+    void asyncSendMessageByTopic(
+        std::string const&, Message::Ptr, CallbackFunc, dev::p2p::Options const&) override
+    {}
+    ResponseFuture::Ptr requestByNodeID(
+        NodeID const&, Message::Ptr, dev::p2p::Options const&) override
+    {
+        return std::make_shared<ResponseFuture>();
+    }
+    ResponseFuture::Ptr requestByTopic(
+        std::string const&, Message::Ptr, dev::p2p::Options const&) override
+    {
+        return std::make_shared<ResponseFuture>();
+    }
+    void asyncMulticastMessageByTopic(std::string const&, Message::Ptr) override {}
+    NodeIDs getPeersByTopic(std::string const&) override { return NodeIDs(); }
+    void asyncMulticastMessageByNodeIDList(NodeIDs const&, Message::Ptr) override {}
+    void asyncBroadcastMessage(Message::Ptr, dev::p2p::Options const&) override {}
+    void registerHandlerByProtoclID(PROTOCOL_ID, CallbackFuncWithSession) override {}
+    void registerHandlerByTopic(std::string const&, CallbackFuncWithSession) override {}
+    void setTopicsByNode(NodeID const&, std::shared_ptr<std::vector<std::string>>) override {}
+    std::shared_ptr<std::vector<std::string>> getTopicsByNode(NodeID const&) override
+    {
+        return nullptr;
+    }
+    SessionInfos sessionInfos() const override { return SessionInfos(); }
+    SessionInfos sessionInfosByProtocolID(PROTOCOL_ID) const override { return SessionInfos(); }
+    bool isConnected(NodeID const&) const override { return false; }
+    void setGroupID2NodeList(std::map<GROUP_ID, h512s> const&) override {}
+    void setTopics(std::shared_ptr<std::vector<std::string>>) override {}
+    std::shared_ptr<std::vector<std::string>> topics() const override { return nullptr; }
+    void setMessageFactory(MessageFactory::Ptr) override {}
+    std::shared_ptr<dev::p2p::Host> host() const override { return nullptr; }
+};
+
+/// a chain at block 0 without transactions, enough for the nonce and block limit checks
+class EmptyBlockChain : public dev::blockchain::BlockChainInterface
+{
+public:
+    int64_t number() override { return 0; }
+    h256 numberHash(int64_t) override { return h256(); }
+    Transaction getTxByHash(h256 const&) override { return Transaction(); }
+    LocalisedTransaction getLocalisedTxByHash(h256 const&) override
+    {
+        return LocalisedTransaction();
+    }
+    TransactionReceipt getTransactionReceiptByHash(h256 const&) override
+    {
+        return TransactionReceipt();
+    }
+    std::shared_ptr<Block> getBlockByHash(h256 const&) override { return nullptr; }
+    std::shared_ptr<Block> getBlockByNumber(int64_t) override { return nullptr; }
+    dev::blockchain::CommitResult commitBlock(
+        Block&, std::shared_ptr<dev::blockverifier::ExecutiveContext>) override
+    {
+        return dev::blockchain::CommitResult::OK;
+    }
+    void setGroupMark(std::string const&) override {}
+};
+
+inline std::shared_ptr<dev::txpool::TxPool> createTxPool(size_t _limit)
+{
+    return std::make_shared<dev::txpool::TxPool>(std::make_shared<NullService>(),
+        std::make_shared<EmptyBlockChain>(),
+        getGroupProtoclID(1, dev::eth::ProtocolID::TxPool), _limit);
+}
+
+/// _count transactions of _keyPair with distinct nonces, valid at block 0
+inline dev::eth::Transactions signedTransactions(size_t _count, KeyPair const& _keyPair)
+{
+    dev::eth::Transactions txs;
+    for (size_t i = 0; i < _count; i++)
+    {
+        dev::eth::Transaction tx(
+            u256(0), u256(1), u256(30000000), Address(0x1000), bytes(68, 0x2a), u256(i));
+        tx.setBlockLimit(u256(500));
+        tx.updateSignature(SignatureStruct(sign(_keyPair.secret(), tx.sha3(WithoutSignature))));
+        txs.push_back(tx);
+    }
+    return txs;
+}
+}  // namespace bench
+}  // namespace dev
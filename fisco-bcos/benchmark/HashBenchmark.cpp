@@ -0,0 +1,95 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : inserts and lookups per second of h256 sets: std::unordered_set with the former
+ * byte-wise hash, std::unordered_set with the word-wise hash and FlatHashSet
+ *
+ * @file HashBenchmark.cpp
+ * @date 2018-12-19
+ */
+#include "Benchmark.h"
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/FlatHash.h>
+#include <boost/functional/hash.hpp>
+#include <unordered_set>
+
+using namespace dev;
+using namespace dev::bench;
+
+namespace
+{
+/// FixedHash::hash before it loaded whole words
+struct ByteRangeHash
+{
+    size_t operator()(h256 const& _value) const
+    {
+        return boost::hash_range(_value.data(), _value.data() + h256::size);
+    }
+};
+
+/// report inserting _keys into an empty Set, then finding each of them and as many absent keys
+template <class Set>
+void measure(std::string const& _name, h256s const& _keys, h256s const& _absent,
+    double& _insert, double& _lookup, double _insertBaseline = 0, double _lookupBaseline = 0)
+{
+    Set set;
+    _insert = opsPerSecond(_keys.size(), [&]() {
+        for (auto const& key : _keys)
+            set.insert(key);
+    });
+    size_t found = 0;
+    _lookup = opsPerSecond(_keys.size() * 2, [&]() {
+        for (auto const& key : _keys)
+            found += set.count(key);
+        for (auto const& key : _absent)
+            found += set.count(key);
+    });
+    if (found != _keys.size())
+        std::cout << _name << ": found " << found << " of " << _keys.size() << std::endl;
+    std::string suffix = " " + toString(_keys.size()) + " keys";
+    report(_name + " insert" + suffix, _insert, _insertBaseline);
+    report(_name + " lookup" + suffix, _lookup, _lookupBaseline);
+}
+}  // namespace
+
+static void hashBenchmark()
+{
+    for (size_t count : {100000, 1000000})
+    {
+        h256s keys(count);
+        h256s absent(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            keys[i] = h256::random();
+            absent[i] = h256::random();
+        }
+        double byteInsert = 0;
+        double byteLookup = 0;
+        double insert = 0;
+        double lookup = 0;
+        measure<std::unordered_set<h256, ByteRangeHash>>(
+            "unordered_set byte hash", keys, absent, byteInsert, byteLookup);
+        measure<std::unordered_set<h256>>(
+            "unordered_set word hash", keys, absent, insert, lookup, byteInsert, byteLookup);
+        measure<FlatHashSet<h256>>(
+            "FlatHashSet word hash", keys, absent, insert, lookup, byteInsert, byteLookup);
+    }
+}
+
+BENCHMARK_REGISTER(hash,
+    "h256 set insert/lookup at 100k/1M keys: byte-wise hash, word-wise hash, FlatHashSet",
+    hashBenchmark);
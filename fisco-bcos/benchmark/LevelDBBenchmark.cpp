@@ -0,0 +1,134 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : read-heavy load on the state leveldb opened as the nodes did, an 8MB block cache
+ * and no bloom filter, against the LevelDBConfig defaults
+ *
+ * @file LevelDBBenchmark.cpp
+ * @date 2018-12-22
+ */
+#include "Benchmark.h"
+#include <libdevcore/CommonData.h>
+#include <libdevcore/SHA3.h>
+#include <libstorage/LevelDBStorage.h>
+#include <boost/filesystem.hpp>
+#include <random>
+
+using namespace dev;
+using namespace dev::bench;
+using namespace dev::storage;
+
+namespace
+{
+std::string const c_table = "c_benchmark";
+
+/// _rows entries of about the size of a contract storage entry, _perBlock to a block
+std::shared_ptr<LevelDBStorage> fill(
+    std::string const& _path, LevelDBConfig const& _config, size_t _rows, size_t _perBlock)
+{
+    boost::filesystem::remove_all(_path);
+    auto storage = std::make_shared<LevelDBStorage>();
+    storage->open(_path, _config);
+    for (size_t from = 0; from < _rows; from += _perBlock)
+    {
+        auto tableData = std::make_shared<TableData>();
+        tableData->tableName = c_table;
+        for (size_t i = from; i < from + _perBlock && i < _rows; i++)
+        {
+            auto entries = std::make_shared<Entries>();
+            auto entry = std::make_shared<Entry>();
+            entry->setField("value", toString(sha3(toString(_rows + i))));
+            entries->addEntry(entry);
+            tableData->data.insert(std::make_pair(toString(sha3(toString(i))), entries));
+        }
+        int64_t number = from / _perBlock + 1;
+        storage->commit(h256(number), number, std::vector<TableData::Ptr>{tableData}, h256(number));
+    }
+    return storage;
+}
+
+/// select each of _keys at block _number, the number of entries found
+size_t selectAll(LevelDBStorage& _storage, int64_t _number, std::vector<std::string> const& _keys)
+{
+    size_t found = 0;
+    for (auto const& key : _keys)
+        found += _storage.select(h256(_number), _number, c_table, key)->size();
+    return found;
+}
+}  // namespace
+
+static void levelDBBenchmark()
+{
+    size_t const rows = 500000;
+    size_t const perBlock = 5000;
+    size_t const reads = 200000;
+    int64_t const number = rows / perBlock;
+    std::string const beforePath = "mini-benchmark-leveldb-before";
+    std::string const afterPath = "mini-benchmark-leveldb-after";
+
+    /// before: leveldb::Options with max_open_files 100 and nothing else set
+    LevelDBConfig before;
+    before.cacheSize = 0;
+    before.bloomFilterBits = 0;
+    before.writeBufferSize = 4;
+    before.maxOpenFiles = 100;
+    LevelDBConfig after;
+
+    auto beforeDB = fill(beforePath, before, rows, perBlock);
+    auto afterDB = fill(afterPath, after, rows, perBlock);
+
+    std::mt19937_64 random(11);
+    std::vector<std::string> hits(reads);
+    for (auto& key : hits)
+        key = toString(sha3(toString(random() % rows)));
+    std::vector<std::string> misses(reads);
+    for (auto& key : misses)
+        key = toString(sha3(toString(rows * 2 + random() % rows)));
+
+    size_t found = 0;
+    /// a first pass warms the caches as a running node has them
+    selectAll(*beforeDB, number, hits);
+    selectAll(*afterDB, number, hits);
+    double beforeHits =
+        opsPerSecond(reads, [&]() { found += selectAll(*beforeDB, number, hits); });
+    double afterHits = opsPerSecond(reads, [&]() { found += selectAll(*afterDB, number, hits); });
+    report("select hit, 8MB cache no bloom", beforeHits);
+    report("select hit, LevelDBConfig defaults", afterHits, beforeHits);
+
+    double beforeMisses =
+        opsPerSecond(reads, [&]() { found += selectAll(*beforeDB, number, misses); });
+    double afterMisses =
+        opsPerSecond(reads, [&]() { found += selectAll(*afterDB, number, misses); });
+    report("select miss, 8MB cache no bloom", beforeMisses);
+    report("select miss, LevelDBConfig defaults", afterMisses, beforeMisses);
+    reportValue("entries found", found, "entries");
+
+    Json::Value status = afterDB->status();
+    reportValue("approximate size", status["approximateSize"].asUInt64() / (1024.0 * 1024.0), "MB");
+    reportValue(
+        "block cache usage", status["blockCacheUsage"].asUInt64() / (1024.0 * 1024.0), "MB");
+    std::cout << status["leveldb.stats"].asString() << std::endl;
+
+    beforeDB.reset();
+    afterDB.reset();
+    boost::filesystem::remove_all(beforePath);
+    boost::filesystem::remove_all(afterPath);
+}
+
+BENCHMARK_REGISTER(leveldb,
+    "random selects on the state leveldb, former options vs the LevelDBConfig defaults",
+    levelDBBenchmark);
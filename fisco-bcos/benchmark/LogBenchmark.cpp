@@ -0,0 +1,137 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : cost of the hot path logs through LOG against ASYNC_LOG/ASYNC_LOG_RATED, and
+ * transactions per second of RPC threads logging as sendRawTransaction does
+ *
+ * @file LogBenchmark.cpp
+ * @date 2018-12-20
+ */
+#include "Benchmark.h"
+#include "FakeModule.h"
+#include <libdevcore/easylog.h>
+#include <thread>
+
+using namespace dev;
+using namespace dev::bench;
+using namespace dev::eth;
+
+namespace
+{
+/// _threads threads running _op _count times in all
+double threadedOpsPerSecond(
+    size_t _threads, size_t _count, std::function<void(size_t)> const& _op)
+{
+    return opsPerSecond(_count, [&]() {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < _threads; t++)
+        {
+            threads.push_back(std::thread([&, t]() {
+                for (size_t i = t; i < _count; i += _threads)
+                    _op(i);
+            }));
+        }
+        for (auto& thread : threads)
+            thread.join();
+        AsyncLogger::instance().flush();
+    });
+}
+}  // namespace
+
+static void logBenchmark()
+{
+    /// log to a file only, as a node does, and keep the terminal for the results
+    el::Configurations fileOnly;
+    fileOnly.setToDefault();
+    fileOnly.setGlobally(el::ConfigurationType::ToStandardOutput, "false");
+    fileOnly.setGlobally(el::ConfigurationType::Filename, "mini-benchmark-log.log");
+    el::Loggers::reconfigureLogger(el::base::consts::kDefaultLoggerId, fileOnly);
+    AsyncLogger::loadEnabledLevels();
+
+    size_t const count = 100000;
+    size_t const threads = 8;
+    NodeID nodeID = NodeID::random();
+    bytes param(256, 0xab);
+    double sync = threadedOpsPerSecond(threads, count, [&](size_t) {
+        LOG(INFO) << "Call Service::asyncSendMessageByNodeID to NodeID=" << nodeID.abridged();
+    });
+    uint64_t dropped = AsyncLogger::instance().dropped();
+    double async = threadedOpsPerSecond(threads, count, [&](size_t) {
+        ASYNC_LOG(INFO) << "Call Service::asyncSendMessageByNodeID to NodeID="
+                        << nodeID.abridged();
+    });
+    double rated = threadedOpsPerSecond(threads, count, [&](size_t) {
+        ASYNC_LOG_RATED(INFO) << "Call Service::asyncSendMessageByNodeID to NodeID="
+                              << nodeID.abridged();
+    });
+    report("LOG(INFO) 8 threads", sync);
+    report("ASYNC_LOG(INFO) 8 threads", async, sync);
+    report("ASYNC_LOG_RATED(INFO) 8 threads", rated, sync);
+    /// lines of threads outrunning the writer are dropped rather than waited for
+    reportValue("ASYNC_LOG(INFO) dropped", AsyncLogger::instance().dropped() - dropped, "lines");
+
+    /// a filtered TRACE line with a hex argument, as ExecutiveContext::call logs
+    el::Configurations noTrace = fileOnly;
+    noTrace.set(el::Level::Trace, el::ConfigurationType::Enabled, "false");
+    el::Loggers::reconfigureLogger(el::base::consts::kDefaultLoggerId, noTrace);
+    AsyncLogger::loadEnabledLevels();
+    double filteredSync = threadedOpsPerSecond(
+        1, count, [&](size_t) { LOG(TRACE) << "PrecompiledEngine call: " << toHex(param); });
+    double filteredAsync = threadedOpsPerSecond(1, count,
+        [&](size_t) { ASYNC_LOG(TRACE) << "PrecompiledEngine call: " << toHex(param); });
+    report("LOG(TRACE) filtered, toHex 256B", filteredSync);
+    report("ASYNC_LOG(TRACE) filtered, toHex 256B", filteredAsync, filteredSync);
+
+    /// RPC threads submitting to the txpool, logging the raw transaction as
+    /// Rpc::sendRawTransaction does: synchronously before, through the AsyncLogger after,
+    /// with the same configuration
+    size_t const txCount = 20000;
+    std::vector<std::string> rlps;
+    for (auto const& tx : signedTransactions(txCount, KeyPair::create()))
+    {
+        bytes data;
+        tx.encode(data);
+        rlps.push_back(toHex(data));
+    }
+    el::Loggers::reconfigureLogger(el::base::consts::kDefaultLoggerId, fileOnly);
+    AsyncLogger::loadEnabledLevels();
+    auto before = createTxPool(txCount);
+    double tpsBefore = threadedOpsPerSecond(threads, txCount, [&](size_t _i) {
+        LOG(INFO) << "sendRawTransaction # request = " << std::endl
+                  << "{ \"_rlp\" : " << rlps[_i] << " }";
+        bytes txBytes = fromHex(rlps[_i]);
+        before->submitAsync(dev::ref(txBytes));
+    });
+    auto after = createTxPool(txCount);
+    double tpsAfter = threadedOpsPerSecond(threads, txCount, [&](size_t _i) {
+        ASYNC_LOG(INFO) << "sendRawTransaction # request = " << std::endl
+                        << "{ \"_rlp\" : " << rlps[_i] << " }";
+        bytes txBytes = fromHex(rlps[_i]);
+        after->submitAsync(dev::ref(txBytes));
+    });
+    report("sendRawTransaction path, LOG(INFO)", tpsBefore);
+    report("sendRawTransaction path, ASYNC_LOG(INFO)", tpsAfter, tpsBefore);
+
+    el::Configurations defaults;
+    defaults.setToDefault();
+    el::Loggers::reconfigureLogger(el::base::consts::kDefaultLoggerId, defaults);
+    AsyncLogger::loadEnabledLevels();
+}
+
+BENCHMARK_REGISTER(log,
+    "hot path logs through LOG vs ASYNC_LOG/ASYNC_LOG_RATED, and submit TPS before/after",
+    logBenchmark);
@@ -0,0 +1,58 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : hashes per second of sha3 against sha3Batch
+ *
+ * @file SHA3Benchmark.cpp
+ * @date 2018-12-03
+ */
+#include "Benchmark.h"
+#include <libdevcore/SHA3.h>
+
+using namespace dev;
+using namespace dev::bench;
+
+static void sha3Benchmark()
+{
+    size_t const inputCount = 8192;
+    size_t const rounds = 20;
+    for (size_t size : {64, 256, 1024})
+    {
+        std::vector<bytes> inputs(inputCount, bytes(size));
+        std::vector<bytesConstRef> refs;
+        for (size_t i = 0; i < inputCount; i++)
+        {
+            for (size_t j = 0; j < size; j++)
+                inputs[i][j] = byte(i * 31 + j);
+            refs.push_back(ref(inputs[i]));
+        }
+        h256s hashes(inputCount);
+        double scalar = opsPerSecond(inputCount * rounds, [&]() {
+            for (size_t r = 0; r < rounds; r++)
+                for (size_t i = 0; i < inputCount; i++)
+                    hashes[i] = sha3(refs[i]);
+        });
+        double batch = opsPerSecond(inputCount * rounds, [&]() {
+            for (size_t r = 0; r < rounds; r++)
+                sha3Batch(refs.data(), refs.size(), hashes.data());
+        });
+        report("sha3 " + toString(size) + "B", scalar);
+        report("sha3Batch " + toString(size) + "B", batch, scalar);
+    }
+}
+
+BENCHMARK_REGISTER(sha3, "keccak-256 of 64B/256B/1KB inputs, one by one vs sha3Batch", sha3Benchmark);
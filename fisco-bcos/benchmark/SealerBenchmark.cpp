@@ -0,0 +1,96 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : time to fill a block while transactions keep arriving, loading with the avoid set
+ * of topTransactions against the cursor of topTransactionsSince
+ *
+ * @file SealerBenchmark.cpp
+ * @date 2018-12-17
+ */
+#include "Benchmark.h"
+#include "FakeModule.h"
+
+using namespace dev;
+using namespace dev::bench;
+using namespace dev::eth;
+
+namespace
+{
+/// transactions imported between two loads of the sealer
+size_t const c_arrivalBatch = 100;
+
+using LoadFunc = std::function<Transactions(txpool::TxPool&, uint64_t)>;
+
+/// import _txs batch after batch and load after each one as the sealer does, until the block
+/// holds all of them; @returns the seconds spent loading and sets _fill to the total seconds
+double fillBlock(Transactions const& _txs, LoadFunc const& _load, double& _fill)
+{
+    auto txPool = createTxPool(_txs.size());
+    Transactions block;
+    double loading = 0;
+    Timer fill;
+    for (size_t i = 0; i < _txs.size(); i += c_arrivalBatch)
+    {
+        Transactions batch(
+            _txs.begin() + i, _txs.begin() + std::min(i + c_arrivalBatch, _txs.size()));
+        txPool->batchImport(batch);
+        Timer load;
+        Transactions loaded = _load(*txPool, _txs.size() - block.size());
+        block.insert(block.end(), loaded.begin(), loaded.end());
+        loading += load.elapsed();
+    }
+    _fill = fill.elapsed();
+    return loading;
+}
+}  // namespace
+
+static void sealerBenchmark()
+{
+    for (size_t pending : {1000, 10000, 50000})
+    {
+        Transactions txs = signedTransactions(pending, KeyPair::create());
+        /// recover the senders once, outside of the measured imports
+        for (auto const& tx : txs)
+            tx.sender();
+
+        h256Hash avoid;
+        double avoidFill = 0;
+        double avoidLoad = fillBlock(txs,
+            [&](txpool::TxPool& _txPool, uint64_t _limit) {
+                return _txPool.topTransactions(_limit, avoid, true);
+            },
+            avoidFill);
+
+        uint64_t cursor = 0;
+        double cursorFill = 0;
+        double cursorLoad = fillBlock(txs,
+            [&](txpool::TxPool& _txPool, uint64_t _limit) {
+                return _txPool.topTransactionsSince(_limit, cursor);
+            },
+            cursorFill);
+
+        std::string suffix = " " + toString(pending) + " txs";
+        reportValue("fill avoid set" + suffix, avoidFill * 1000, "ms");
+        reportValue("fill cursor" + suffix, cursorFill * 1000, "ms");
+        reportValue("sealer load cpu avoid set" + suffix, avoidLoad * 1000, "ms");
+        reportValue("sealer load cpu cursor" + suffix, cursorLoad * 1000, "ms");
+    }
+}
+
+BENCHMARK_REGISTER(sealer,
+    "block filling with arriving transactions: avoid set against pool cursor, 1k/10k/50k txs",
+    sealerBenchmark);
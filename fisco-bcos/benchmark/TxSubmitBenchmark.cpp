@@ -0,0 +1,98 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : transactions per second that RPC threads submit to the txpool, synchronous submit
+ * against submitAsync with the batched ingress import
+ *
+ * @file TxSubmitBenchmark.cpp
+ * @date 2018-12-15
+ */
+#include "Benchmark.h"
+#include "FakeModule.h"
+#include <libethcore/SenderCache.h>
+#include <thread>
+
+using namespace dev;
+using namespace dev::bench;
+using namespace dev::eth;
+
+namespace
+{
+/// _clients threads, standing for the RPC workers, each submitting its share of _txs
+void runClients(size_t _clients, std::vector<bytes> const& _txs,
+    std::function<void(bytes const&)> const& _submit)
+{
+    std::vector<std::thread> clients;
+    for (size_t c = 0; c < _clients; c++)
+    {
+        clients.push_back(std::thread([&, c]() {
+            for (size_t i = c; i < _txs.size(); i += _clients)
+                _submit(_txs[i]);
+        }));
+    }
+    for (auto& client : clients)
+        client.join();
+}
+}  // namespace
+
+static void txSubmitBenchmark()
+{
+    size_t const count = 20000;
+    std::vector<bytes> txs;
+    for (auto const& tx : signedTransactions(count, KeyPair::create()))
+    {
+        bytes data;
+        tx.encode(data);
+        txs.push_back(data);
+    }
+
+    for (size_t clients : {1, 8, 32})
+    {
+        /// every run recovers all senders itself
+        SenderCache::instance().clear();
+        auto syncPool = createTxPool(count);
+        double submit = opsPerSecond(count, [&]() {
+            runClients(clients, txs, [&](bytes const& _tx) {
+                Transaction tx(_tx, CheckTransaction::Everything);
+                syncPool->submit(tx);
+            });
+        });
+
+        SenderCache::instance().clear();
+        auto asyncPool = createTxPool(count);
+        asyncPool->setIngressThreads(std::max(std::thread::hardware_concurrency(), 1u));
+        double accepted = 0;
+        double imported = opsPerSecond(count, [&]() {
+            accepted = opsPerSecond(count, [&]() {
+                runClients(clients, txs,
+                    [&](bytes const& _tx) { asyncPool->submitAsync(dev::ref(_tx)); });
+            });
+            Timer timer;
+            while (asyncPool->pendingSize() < count && timer.elapsed() < 60)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+
+        std::string suffix = " " + toString(clients) + " clients";
+        report("submit" + suffix, submit);
+        report("submitAsync accepted" + suffix, accepted, submit);
+        report("submitAsync imported" + suffix, imported, submit);
+    }
+}
+
+BENCHMARK_REGISTER(txSubmit,
+    "RPC transaction submission: submit per call against submitAsync, 1/8/32 client threads",
+    txSubmitBenchmark);
@@ -0,0 +1,441 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : uint256 kernels against u256, and opcode loops through the interpreter
+ *
+ * @file VMBenchmark.cpp
+ * @date 2018-12-10
+ */
+#include "Benchmark.h"
+#include <evmc/evmc.h>
+#include <libdevcore/FixedHash.h>
+#include <libethcore/Exceptions.h>
+#include <libinterpreter/Uint256.h>
+#include <libinterpreter/interpreter.h>
+
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::bench;
+
+namespace
+{
+/// secp256k1 field prime, the modulus of the signature verification loop
+u256 const c_fieldPrime("0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f");
+
+std::vector<u256> benchValues(size_t _count)
+{
+    std::vector<u256> values;
+    u256 v("0x6a09e667f3bcc908bb67ae8584caa73b3c6ef372fe94f82ba54ff53a5f1d36f1");
+    for (size_t i = 0; i < _count; i++)
+    {
+        v = v * u256("0x5851f42d4c957f2d") + 1442695040888963407;
+        values.push_back(i % 4 == 0 ? v >> 128 : v);
+    }
+    return values;
+}
+
+template <class T, class Op>
+double kernelOps(std::vector<T> const& _values, size_t _rounds, Op _op)
+{
+    T sink = 0;
+    double ops = opsPerSecond(_values.size() * _rounds, [&]() {
+        for (size_t r = 0; r < _rounds; r++)
+            for (size_t i = 0; i + 1 < _values.size(); i++)
+                sink = sink ^ _op(_values[i], _values[i + 1]);
+    });
+    // keep the results alive so the loop is not optimized away
+    asm volatile("" : : "g"(&sink) : "memory");
+    return ops;
+}
+
+void kernelBenchmark()
+{
+    size_t const count = 4096;
+    size_t const rounds = 200;
+    std::vector<u256> bigValues = benchValues(count);
+    std::vector<uint256> values;
+    for (auto const& v : bigValues)
+        values.push_back(fromU256(v));
+    uint256 const prime = fromU256(c_fieldPrime);
+
+    auto compare = [&](std::string const& _name, double _u256, double _uint256) {
+        report(_name + " u256", _u256);
+        report(_name + " uint256", _uint256, _u256);
+    };
+    compare("add", kernelOps(bigValues, rounds, [](u256 const& a, u256 const& b) { return a + b; }),
+        kernelOps(values, rounds, [](uint256 const& a, uint256 const& b) { return a + b; }));
+    compare("mul", kernelOps(bigValues, rounds, [](u256 const& a, u256 const& b) { return a * b; }),
+        kernelOps(values, rounds, [](uint256 const& a, uint256 const& b) { return a * b; }));
+    // a 192-bit divisor, the multi-digit path of the division
+    compare("div",
+        kernelOps(bigValues, rounds,
+            [](u256 const& a, u256 const& b) { return u256(a / ((b >> 64) | 1)); }),
+        kernelOps(values, rounds,
+            [](uint256 const& a, uint256 const& b) { return a / ((b >> 64) | 1); }));
+    compare("mulmod",
+        kernelOps(bigValues, rounds,
+            [](u256 const& a, u256 const& b) { return u256(u512(a) * u512(b) % c_fieldPrime); }),
+        kernelOps(values, rounds,
+            [&](uint256 const& a, uint256 const& b) { return mulmod(a, b, prime); }));
+    compare("exp",
+        kernelOps(bigValues, rounds / 10,
+            [](u256 const& a, u256 const& b) {
+                u256 base = a;
+                u256 exponent = b;
+                u256 result = 1;
+                for (; exponent; exponent >>= 1, base *= base)
+                    if (static_cast<uint64_t>(exponent & 1))
+                        result *= base;
+                return result;
+            }),
+        kernelOps(
+            values, rounds / 10, [](uint256 const& a, uint256 const& b) { return exp256(a, b); }));
+}
+
+/// host callbacks of a contract that never leaves the interpreter
+int accountExists(evmc_context*, evmc_address const*)
+{
+    return 1;
+}
+void getStorage(evmc_uint256be* o_result, evmc_context*, evmc_address const*, evmc_uint256be const*)
+{
+    *o_result = evmc_uint256be();
+}
+evmc_storage_status setStorage(
+    evmc_context*, evmc_address const*, evmc_uint256be const*, evmc_uint256be const*)
+{
+    return EVMC_STORAGE_MODIFIED;
+}
+void getBalance(evmc_uint256be* o_result, evmc_context*, evmc_address const*)
+{
+    *o_result = evmc_uint256be();
+}
+size_t getCodeSize(evmc_context*, evmc_address const*)
+{
+    return 0;
+}
+void getCodeHash(evmc_uint256be* o_result, evmc_context*, evmc_address const*)
+{
+    *o_result = evmc_uint256be();
+}
+size_t copyCode(evmc_context*, evmc_address const*, size_t, uint8_t*, size_t)
+{
+    return 0;
+}
+void selfdestruct(evmc_context*, evmc_address const*, evmc_address const*) {}
+void call(evmc_result* o_result, evmc_context*, evmc_message const*)
+{
+    *o_result = evmc_result();
+    o_result->status_code = EVMC_FAILURE;
+}
+void getTxContext(evmc_tx_context* o_result, evmc_context*)
+{
+    *o_result = evmc_tx_context();
+}
+void getBlockHash(evmc_uint256be* o_result, evmc_context*, int64_t)
+{
+    *o_result = evmc_uint256be();
+}
+void emitLog(evmc_context*, evmc_address const*, uint8_t const*, size_t, evmc_uint256be const*,
+    size_t)
+{}
+
+evmc_context_fn_table const c_benchFnTable = {accountExists, getStorage, setStorage, getBalance,
+    getCodeSize, getCodeHash, copyCode, selfdestruct, call, getTxContext, getBlockHash, emitLog};
+
+void push32(bytes& _code, u256 const& _value)
+{
+    _code.push_back(0x7f);
+    h256 word(_value);
+    _code.insert(_code.end(), word.begin(), word.end());
+}
+
+/**
+ * @brief code running _body _iterations times on an accumulator
+ *
+ * The loop keeps [accumulator, counter] on the stack; _body must take the accumulator
+ * from the top of the stack and leave exactly one word in its place.
+ */
+bytes loopCode(bytes const& _body, uint32_t _iterations)
+{
+    bytes code;
+    push32(code, u256("0x243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89"));
+    code.push_back(0x63);  // PUSH4 iterations
+    for (int shift = 24; shift >= 0; shift -= 8)
+        code.push_back(byte(_iterations >> shift));
+    size_t loop = code.size();
+    code.push_back(0x5b);  // JUMPDEST
+    code.push_back(0x90);  // SWAP1
+    code.insert(code.end(), _body.begin(), _body.end());
+    // SWAP1 PUSH1 1 SWAP1 SUB DUP1 PUSH2 loop JUMPI POP POP STOP
+    code.insert(code.end(), {0x90, 0x60, 0x01, 0x90, 0x03, 0x80, 0x61, byte(loop >> 8),
+                                byte(loop & 0xff), 0x57, 0x50, 0x50, 0x00});
+    return code;
+}
+
+double loopOps(bytes const& _code, uint32_t _iterations)
+{
+    evmc_instance* instance = evmc_create_interpreter();
+    evmc_context context{&c_benchFnTable};
+    evmc_message msg = {};
+    msg.gas = std::numeric_limits<int64_t>::max() / 2;
+    evmc_status_code status = EVMC_SUCCESS;
+    double ops = opsPerSecond(_iterations, [&]() {
+        evmc_result result =
+            instance->execute(instance, &context, EVMC_CONSTANTINOPLE, &msg, _code.data(),
+                _code.size());
+        status = result.status_code;
+        if (result.release)
+            result.release(&result);
+    });
+    if (status != EVMC_SUCCESS)
+        std::cout << "loop failed with status " << status << std::endl;
+    return ops;
+}
+
+void opcodeBenchmark()
+{
+    uint32_t const iterations = 200000;
+
+    // x = x * K + C; x += x % D; x ^= x ** 3
+    bytes arith;
+    push32(arith, u256("0x5851f42d4c957f2d14057b7ef767814f"));
+    arith.push_back(0x02);  // MUL
+    push32(arith, u256("0x14057b7ef767814f5851f42d4c957f2d"));
+    arith.insert(arith.end(), {0x01, 0x80, 0x68, 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef,
+                                  0x01, 0x90, 0x06, 0x01, 0x80, 0x60, 0x03, 0x90, 0x0a, 0x18});
+    report("vm arith loop (iterations)", loopOps(loopCode(arith, iterations), iterations));
+
+    // x = keccak256(x || 0)
+    bytes keccak = {0x60, 0x00, 0x52, 0x60, 0x40, 0x60, 0x00, 0x20};
+    report("vm keccak loop (iterations)", loopOps(loopCode(keccak, iterations), iterations));
+
+    // x = (x * x + G) mod p, the field operations of an ecrecover step
+    bytes field = {0x80, 0x80};
+    push32(field, c_fieldPrime);
+    field.insert(field.end(), {0x91, 0x09});  // SWAP2 MULMOD
+    push32(field, c_fieldPrime);
+    field.push_back(0x90);  // SWAP1
+    push32(field, u256("0x79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"));
+    field.insert(field.end(), {0x08, 0x90, 0x50});  // ADDMOD SWAP1 POP
+    report("vm field mulmod loop (iterations)", loopOps(loopCode(field, iterations), iterations));
+
+    // x = (x << 3) ^ (x >> 5) ^ sar(x, 7) ^ byte 3 of x
+    bytes bits = {0x80, 0x60, 0x03, 0x1b, 0x81, 0x60, 0x05, 0x1c, 0x18, 0x81, 0x60, 0x07, 0x1d,
+        0x18, 0x81, 0x60, 0x03, 0x1a, 0x18, 0x90, 0x50};
+    report("vm shift loop (iterations)", loopOps(loopCode(bits, iterations), iterations));
+}
+
+/// bytecode with forward references, patched into PUSH2 operands once the labels are placed
+class Assembler
+{
+public:
+    Assembler& ops(bytes const& _ops)
+    {
+        m_code.insert(m_code.end(), _ops.begin(), _ops.end());
+        return *this;
+    }
+    /// PUSH2 of a label's position
+    Assembler& push(std::string const& _label)
+    {
+        m_code.push_back(0x61);
+        m_fixups.emplace_back(m_code.size(), _label);
+        m_code.insert(m_code.end(), {0, 0});
+        return *this;
+    }
+    /// JUMPDEST named _label
+    Assembler& label(std::string const& _label)
+    {
+        m_labels[_label] = m_code.size();
+        m_code.push_back(0x5b);
+        return *this;
+    }
+    bytes code()
+    {
+        for (auto const& fixup : m_fixups)
+        {
+            size_t target = m_labels.at(fixup.second);
+            m_code[fixup.first] = byte(target >> 8);
+            m_code[fixup.first + 1] = byte(target & 0xff);
+        }
+        return m_code;
+    }
+
+private:
+    bytes m_code;
+    std::map<std::string, size_t> m_labels;
+    std::vector<std::pair<size_t, std::string>> m_fixups;
+};
+
+/**
+ * @brief a token transfer shaped like solc output, _iterations balance updates per call
+ *
+ * A selector dispatcher, mapping slots hashed with SHA3, a SafeMath overflow check and an
+ * internal function call, the instruction mix of compiled contracts: short blocks between
+ * JUMPDESTs and JUMPIs, PUSH followed by JUMP(I)/ADD/MSTORE and DUP followed by SWAP.
+ */
+bytes tokenCode(uint32_t _iterations)
+{
+    Assembler a;
+    // selector = calldataload(0) >> 224; dispatch on balanceOf and transfer
+    a.ops({0x60, 0x00, 0x35, 0x60, 0xe0, 0x1c, 0x80, 0x63, 0x70, 0xa0, 0x82, 0x31, 0x14});
+    a.push("balanceOf").ops({0x57, 0x80, 0x63, 0xa9, 0x05, 0x9c, 0xbb, 0x14});
+    a.push("transfer").ops({0x57, 0x60, 0x00, 0x80, 0xfd});
+    a.label("balanceOf").ops({0x00});
+    a.label("transfer").ops({0x50, 0x63, byte(_iterations >> 24), byte(_iterations >> 16),
+        byte(_iterations >> 8), byte(_iterations)});
+    // [counter]: slot = keccak256(counter . 0), kept in a 4KB memory window
+    a.label("loop").ops({0x80, 0x60, 0x00, 0x52, 0x60, 0x40, 0x60, 0x00, 0x20, 0x61, 0x0f, 0xe0,
+        0x16, 0x60, 0x40, 0x01});
+    // [counter, offset]: balance += counter & 0x0f, reverting on overflow
+    a.ops({0x80, 0x51, 0x82, 0x60, 0x0f, 0x16, 0x81, 0x01, 0x80, 0x82, 0x11});
+    a.push("fail").ops({0x57, 0x90, 0x50, 0x90, 0x52});
+    // [counter]: an internal call of the fee function, then the loop condition
+    a.push("return").ops({0x81});
+    a.push("fee").ops({0x56});
+    a.label("return").ops({0x50, 0x60, 0x01, 0x90, 0x03, 0x80});
+    a.push("loop").ops({0x57, 0x50, 0x60, 0x20, 0x60, 0x40, 0xf3});
+    a.label("fail").ops({0x60, 0x00, 0x80, 0xfd});
+    // fee(x) = x * 3 + 1
+    a.label("fee").ops({0x60, 0x03, 0x02, 0x60, 0x01, 0x01, 0x90, 0x56});
+    return a.code();
+}
+
+void solidityBenchmark()
+{
+    uint32_t const iterations = 200000;
+    bytes const code = tokenCode(iterations);
+    bytes input = fromHex("a9059cbb");
+    input.resize(68);
+    evmc_instance* instance = evmc_create_interpreter();
+    evmc_context context{&c_benchFnTable};
+    evmc_message msg = {};
+    msg.gas = std::numeric_limits<int64_t>::max() / 2;
+    msg.input_data = input.data();
+    msg.input_size = input.size();
+    evmc_status_code status = EVMC_SUCCESS;
+    double ops = opsPerSecond(iterations, [&]() {
+        evmc_result result = instance->execute(
+            instance, &context, EVMC_CONSTANTINOPLE, &msg, code.data(), code.size());
+        status = result.status_code;
+        if (result.release)
+            result.release(&result);
+    });
+    if (status != EVMC_SUCCESS)
+        std::cout << "token loop failed with status " << status << std::endl;
+    report("vm solidity-shaped token loop (iterations)", ops);
+}
+
+/**
+ * @brief executions per second of short contracts, dominated by the per-call setup of the VM
+ *
+ * _revertPercent out of every hundred calls run _revertCode instead of _code, like a block
+ * where some transactions fail a check of the contract.
+ */
+double callOps(bytes const& _code, size_t _count, bytes const& _revertCode = bytes(),
+    unsigned _revertPercent = 0)
+{
+    evmc_instance* instance = evmc_create_interpreter();
+    evmc_context context{&c_benchFnTable};
+    evmc_message msg = {};
+    msg.gas = 1000000;
+    size_t expectedReverts = 0;
+    size_t reverts = 0;
+    size_t failures = 0;
+    double ops = opsPerSecond(_count, [&]() {
+        for (size_t i = 0; i < _count; ++i)
+        {
+            bool revert = i % 100 < _revertPercent;
+            bytes const& code = revert ? _revertCode : _code;
+            evmc_result result = instance->execute(
+                instance, &context, EVMC_CONSTANTINOPLE, &msg, code.data(), code.size());
+            expectedReverts += revert;
+            reverts += result.status_code == EVMC_REVERT;
+            failures += result.status_code != EVMC_SUCCESS && result.status_code != EVMC_REVERT;
+            if (result.release)
+                result.release(&result);
+        }
+    });
+    if (reverts != expectedReverts || failures)
+        std::cout << "calls reverted " << reverts << " times, failed " << failures << " times"
+                  << std::endl;
+    return ops;
+}
+
+void callBenchmark()
+{
+    size_t const count = 200000;
+    // PUSH1 2a PUSH1 00 MSTORE PUSH1 20 PUSH1 00 RETURN
+    report("vm call returning 32 bytes (calls)", callOps(fromHex("602a60005260206000f3"), count));
+    // PUSH1 2a PUSH2 0fe0 MSTORE PUSH2 1000 PUSH1 00 RETURN
+    report("vm call returning 4KB (calls)", callOps(fromHex("602a610fe0526110006000f3"), count));
+}
+
+void revertBenchmark()
+{
+    size_t const count = 200000;
+    // PUSH1 2a PUSH1 00 MSTORE PUSH1 20 PUSH1 00 RETURN
+    bytes const success = fromHex("602a60005260206000f3");
+    // PUSH1 2a PUSH1 00 MSTORE PUSH1 20 PUSH1 00 REVERT
+    bytes const revert = fromHex("602a60005260206000fd");
+    double allSuccess = callOps(success, count);
+    report("vm block with 0% reverts (calls)", allSuccess);
+    for (unsigned percent : {10u, 50u, 100u})
+        report("vm block with " + std::to_string(percent) + "% reverts (calls)",
+            callOps(success, count, revert, percent), allSuccess);
+
+    // the cost each call level paid when a revert was carried up as an exception
+    size_t outputSize = 0;
+    double thrown = opsPerSecond(count, [&]() {
+        for (size_t i = 0; i < count; ++i)
+        {
+            try
+            {
+                throw RevertInstruction{owning_bytes_ref{bytes(32, 0x2a), 0, 32}};
+            }
+            catch (RevertInstruction& _e)
+            {
+                outputSize += _e.output().size();
+            }
+        }
+    });
+    double returned = opsPerSecond(count, [&]() {
+        for (size_t i = 0; i < count; ++i)
+        {
+            evmc_status_code status = EVMC_REVERT;
+            owning_bytes_ref output{bytes(32, 0x2a), 0, 32};
+            asm volatile("" : "+g"(status) : : "memory");
+            if (status == EVMC_REVERT)
+                outputSize += output.size();
+        }
+    });
+    asm volatile("" : : "g"(&outputSize) : "memory");
+    report("revert thrown to the caller (levels)", thrown);
+    report("revert returned as a status (levels)", returned, thrown);
+}
+}  // namespace
+
+BENCHMARK_REGISTER(uint256, "uint256 kernels of the interpreter against u256", kernelBenchmark);
+BENCHMARK_REGISTER(
+    opcode, "arithmetic, keccak, field mulmod and shift loops on the interpreter", opcodeBenchmark);
+BENCHMARK_REGISTER(solidity,
+    "a dispatcher, mapping, SafeMath and internal call loop shaped like solc output",
+    solidityBenchmark);
+BENCHMARK_REGISTER(
+    call, "short interpreter calls returning small and large outputs", callBenchmark);
+BENCHMARK_REGISTER(revert, "blocks with reverting calls, and revert by exception or status",
+    revertBenchmark);
@@ -0,0 +1,51 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : micro benchmarks of hot paths, usage: mini-benchmark [name...]
+ *
+ * @file benchmark_main.cpp
+ * @date 2018-12-03
+ */
+#include "Benchmark.h"
+#include <libdevcore/easylog.h>
+
+INITIALIZE_EASYLOGGINGPP
+using namespace dev::bench;
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cout << "usage: " << argv[0] << " <benchmark>... | all" << std::endl;
+        for (auto const& benchmark : benchmarks())
+            std::cout << "  " << benchmark.first << ": " << benchmark.second.description
+                      << std::endl;
+        return 0;
+    }
+    for (int i = 1; i < argc; i++)
+    {
+        std::string name = argv[i];
+        for (auto const& benchmark : benchmarks())
+        {
+            if (name != "all" && name != benchmark.first)
+                continue;
+            std::cout << "=== " << benchmark.first << std::endl;
+            benchmark.second.run();
+        }
+    }
+    return 0;
+}
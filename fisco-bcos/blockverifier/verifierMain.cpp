@@ -40,20 +40,13 @@ int main(int argc, char* argv[])
 {
     auto storagePath = std::string("test_storage/");
     boost::filesystem::create_directories(storagePath);
-    leveldb::Options option;
-    option.create_if_missing = true;
-    option.max_open_files = 100;
-    leveldb::DB* dbPtr = NULL;
-    leveldb::Status s = leveldb::DB::Open(option, storagePath, &dbPtr);
+    auto storage = std::make_shared<dev::storage::LevelDBStorage>();
+    leveldb::Status s = storage->open(storagePath);
     if (!s.ok())
     {
         LOG(ERROR) << "Open storage leveldb error: " << s.ToString();
     }
 
-    auto storageDB = std::shared_ptr<leveldb::DB>(dbPtr);
-    auto storage = std::make_shared<dev::storage::LevelDBStorage>();
-    storage->setDB(storageDB);
-
     auto blockChain = std::make_shared<dev::blockchain::BlockChainImp>();
     blockChain->setStateStorage(storage);
 
@@ -59,6 +59,7 @@ public:
     }
 
     void setThreadPool(std::shared_ptr<dev::ThreadPool> thread) {}
+    void setDispatcher(std::shared_ptr<MessageDispatcher> dispatcher) override {}
     void disconnect(DisconnectReason _reason) { m_disconnect = true; }
     bool isConnected() const { return !m_disconnect; }
     NodeID id() const { return NodeID(m_peer->id()); }
@@ -68,6 +69,8 @@ public:
     std::chrono::steady_clock::time_point lastReceived() const { return m_lastReceived; }
     void setP2PMsgHandler(std::shared_ptr<P2PMsgHandler> _p2pMsgHandler) {}
     void send(std::shared_ptr<bytes> _msg) {}
+    bool peerCompress() const override { return m_peerCompress; }
+    void setPeerCompress(bool _peerCompress) override { m_peerCompress = _peerCompress; }
     void setTopicSeq(uint32_t _topicSeq) {}
     uint32_t topicSeq() const { return 0; }
     void setTopics(std::shared_ptr<std::vector<std::string>> _topics) {}
@@ -88,6 +91,7 @@ public:
 public:
     bool m_start = false;
     bool m_disconnect = false;
+    bool m_peerCompress = false;
     Host* m_host;
     std::shared_ptr<Peer> m_peer;
     PeerSessionInfo m_info;
@@ -83,6 +83,11 @@ public:
             m_asyncSend[nodeID] = 1;
         m_asyncSendMsgs[nodeID] = message;
     }
+    void asyncMulticastMessageByNodeIDList(NodeIDs const& nodeIDs, Message::Ptr message) override
+    {
+        for (auto const& nodeID : nodeIDs)
+            asyncSendMessageByNodeID(nodeID, message);
+    }
     size_t getAsyncSendSizeByNodeID(NodeID const& nodeID)
     {
         if (!m_asyncSend.count(nodeID))
@@ -280,6 +285,11 @@ public:
     {
         return transactions;
     }
+    virtual dev::eth::Transactions topTransactionsSince(uint64_t const& _limit, uint64_t& _cursor,
+        std::function<bool(dev::eth::Transaction const&)> const& _admit = nullptr) override
+    {
+        return transactions;
+    }
     virtual bool drop(h256 const& _txHash) override { return true; }
     virtual bool dropBlockTrans(dev::eth::Block const& block) override { return true; }
     virtual PROTOCOL_ID const& getProtocolId() const override { return protocolId; }
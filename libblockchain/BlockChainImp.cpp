@@ -26,6 +26,7 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcore/easylog.h>
 #include <libethcore/Block.h>
+#include <libethcore/BlockView.h>
 #include <libethcore/Transaction.h>
 #include <libstorage/MemoryTableFactory.h>
 #include <libstorage/Table.h>
@@ -45,6 +46,28 @@ void BlockChainImp::setStateStorage(Storage::Ptr stateStorage)
     m_stateStorage = stateStorage;
 }
 
+void BlockChainImp::setBlockStore(BlockStore::Ptr _blockStore)
+{
+    if (_blockStore)
+    {
+        int64_t committed = number();
+        /// the block is stored before the state db commits, drop it if the commit did not happen
+        _blockStore->truncate(committed);
+        /// a store behind the state db lost blocks that are nowhere else, unless the store was
+        /// not in use when they were committed and the table has them
+        if (committed > 0 && _blockStore->head() < committed &&
+            !getBlockRLPByHash(numberHash(committed)))
+        {
+            LOG(ERROR) << "BlockStore blocks end at " << _blockStore->head()
+                       << " but block " << committed << " is committed";
+            BOOST_THROW_EXCEPTION(BlockStoreBehind() << errinfo_comment(
+                                      "block store head " + toString(_blockStore->head()) +
+                                      " behind block number " + toString(committed)));
+        }
+    }
+    m_blockStore = _blockStore;
+}
+
 shared_ptr<MemoryTableFactory> BlockChainImp::getMemoryTableFactory()
 {
     dev::storage::MemoryTableFactory::Ptr memoryTableFactory =
@@ -105,7 +128,22 @@ std::shared_ptr<Block> BlockChainImp::getBlockByHash(h256 const& _blockHash)
         block->setEmptyBlock();
         return block;
     }
-    string strblock = "";
+    auto blockRLP = getBlockRLPByHash(_blockHash);
+    if (blockRLP)
+    {
+        return std::make_shared<Block>(*blockRLP);
+    }
+    return nullptr;
+}
+
+std::shared_ptr<bytes> BlockChainImp::getBlockRLPByHash(h256 const& _blockHash)
+{
+    if (m_blockStore)
+    {
+        auto blockRLP = m_blockStore->get(_blockHash);
+        if (blockRLP)
+            return blockRLP;
+    }
     Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_HASH_2_BLOCK);
     if (tb)
     {
@@ -113,8 +151,7 @@ std::shared_ptr<Block> BlockChainImp::getBlockByHash(h256 const& _blockHash)
         if (entries->size() > 0)
         {
             auto entry = entries->get(0);
-            strblock = entry->getField(SYS_VALUE);
-            return std::make_shared<Block>(fromHex(strblock.c_str()));
+            return std::make_shared<bytes>(fromHex(entry->getField(SYS_VALUE)));
         }
     }
     return nullptr;
@@ -129,6 +166,12 @@ std::shared_ptr<Block> BlockChainImp::getBlockByNumber(int64_t _i)
         block->setEmptyBlock();
         return block;
     }
+    if (m_blockStore)
+    {
+        auto blockRLP = m_blockStore->get(_i);
+        if (blockRLP)
+            return std::make_shared<Block>(*blockRLP);
+    }
     string numberHash = "";
     string strblock = "";
     Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_NUMBER_2_HASH);
@@ -145,6 +188,68 @@ std::shared_ptr<Block> BlockChainImp::getBlockByNumber(int64_t _i)
     return nullptr;
 }
 
+std::shared_ptr<bytes> BlockChainImp::getBlockRLPByNumber(int64_t _i)
+{
+    if (_i == 0)
+    {
+        return BlockChainInterface::getBlockRLPByNumber(_i);
+    }
+    if (m_blockStore)
+    {
+        auto blockRLP = m_blockStore->get(_i);
+        if (blockRLP)
+            return blockRLP;
+    }
+    Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_NUMBER_2_HASH);
+    if (tb)
+    {
+        auto entries = tb->select(lexical_cast<std::string>(_i), tb->newCondition());
+        if (entries->size() > 0)
+        {
+            return getBlockRLPByHash(h256(entries->get(0)->getField(SYS_VALUE)));
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::shared_ptr<bytes>> BlockChainImp::getBlockRLPsByRange(int64_t _from, int64_t _to)
+{
+    std::vector<std::shared_ptr<bytes>> blocks;
+    if (m_blockStore && _from > 0)
+        blocks = m_blockStore->getRange(_from, _to);
+    /// blocks before the store was in use are read one by one from the table
+    int64_t next = _from + blocks.size();
+    if (next <= _to)
+    {
+        auto rest = BlockChainInterface::getBlockRLPsByRange(next, _to);
+        blocks.insert(blocks.end(), rest.begin(), rest.end());
+    }
+    return blocks;
+}
+
+dev::h256s BlockChainImp::getNonceDigests(int64_t _i)
+{
+    Table::Ptr tb = getMemoryTableFactory()->openTable(SYS_BLOCK_2_NONCES);
+    if (tb)
+    {
+        auto entries = tb->select(lexical_cast<std::string>(_i), tb->newCondition());
+        if (entries->size() > 0)
+        {
+            /// "0x" for a block without transactions, empty when the block predates the index
+            std::string value = entries->get(0)->getField(SYS_VALUE);
+            if (!value.empty())
+            {
+                bytes data = fromHex(value);
+                h256s digests(data.size() / h256::size);
+                for (size_t i = 0; i < digests.size(); ++i)
+                    digests[i] = h256(bytesConstRef(&data[i * h256::size], h256::size));
+                return digests;
+            }
+        }
+    }
+    return BlockChainInterface::getNonceDigests(_i);
+}
+
 Transaction BlockChainImp::getTxByHash(dev::h256 const& _txHash)
 {
     string strblock = "";
@@ -158,11 +263,14 @@ Transaction BlockChainImp::getTxByHash(dev::h256 const& _txHash)
             auto entry = entries->get(0);
             strblock = entry->getField(SYS_VALUE);
             txIndex = entry->getField("index");
-            std::shared_ptr<Block> pblock = getBlockByNumber(lexical_cast<int64_t>(strblock));
-            std::vector<Transaction> txs = pblock->transactions();
-            if (txs.size() > lexical_cast<uint>(txIndex))
+            /// only the transaction asked for is decoded, not every one of its block
+            auto blockRLP = getBlockRLPByNumber(lexical_cast<int64_t>(strblock));
+            if (!blockRLP)
+                return Transaction();
+            BlockView block(blockRLP);
+            if (block.transactionCount() > lexical_cast<uint>(txIndex))
             {
-                return txs[lexical_cast<uint>(txIndex)];
+                return block.transaction(lexical_cast<uint>(txIndex)).toTransaction();
             }
         }
     }
@@ -182,12 +290,15 @@ LocalisedTransaction BlockChainImp::getLocalisedTxByHash(dev::h256 const& _txHas
             auto entry = entries->get(0);
             strblockhash = entry->getField(SYS_VALUE);
             txIndex = entry->getField("index");
-            std::shared_ptr<Block> pblock = getBlockByNumber(lexical_cast<int64_t>(strblockhash));
-            std::vector<Transaction> txs = pblock->transactions();
-            if (txs.size() > lexical_cast<uint>(txIndex))
+            auto blockRLP = getBlockRLPByNumber(lexical_cast<int64_t>(strblockhash));
+            if (!blockRLP)
+                return LocalisedTransaction(Transaction(), h256(0), -1);
+            BlockView block(blockRLP);
+            if (block.transactionCount() > lexical_cast<uint>(txIndex))
             {
-                return LocalisedTransaction(txs[lexical_cast<uint>(txIndex)], pblock->headerHash(),
-                    lexical_cast<unsigned>(txIndex), pblock->blockHeader().number());
+                return LocalisedTransaction(
+                    block.transaction(lexical_cast<uint>(txIndex)).toTransaction(), block.hash(),
+                    lexical_cast<unsigned>(txIndex), block.number());
             }
         }
     }
@@ -207,11 +318,13 @@ TransactionReceipt BlockChainImp::getTransactionReceiptByHash(dev::h256 const& _
             auto entry = entries->get(0);
             strblock = entry->getField(SYS_VALUE);
             txIndex = entry->getField("index");
-            std::shared_ptr<Block> pblock = getBlockByNumber(lexical_cast<int64_t>(strblock));
-            std::vector<TransactionReceipt> receipts = pblock->transactionReceipts();
-            if (receipts.size() > lexical_cast<uint>(txIndex))
+            auto blockRLP = getBlockRLPByNumber(lexical_cast<int64_t>(strblock));
+            if (!blockRLP)
+                return TransactionReceipt();
+            BlockView block(blockRLP);
+            if (block.receiptCount() > lexical_cast<uint>(txIndex))
             {
-                return receipts[lexical_cast<uint>(txIndex)];
+                return block.receipt(lexical_cast<uint>(txIndex));
             }
         }
     }
@@ -277,10 +390,37 @@ void BlockChainImp::writeHash2Block(Block& block, std::shared_ptr<ExecutiveConte
     }
 }
 
+/// the (sender, nonce) digests of a block, packed as 32-byte words so that NonceCheck can slide
+/// its window without decoding whole blocks
+void BlockChainImp::writeNonceDigests(const Block& block, std::shared_ptr<ExecutiveContext> context)
+{
+    Table::Ptr tb = context->getMemoryTableFactory()->openTable(SYS_BLOCK_2_NONCES);
+    if (tb)
+    {
+        bytes data;
+        data.reserve(block.transactions().size() * h256::size);
+        for (auto const& tx : block.transactions())
+        {
+            h256 digest = tx.nonceDigest();
+            data.insert(data.end(), digest.begin(), digest.end());
+        }
+        Entry::Ptr entry = std::make_shared<Entry>();
+        entry->setField(SYS_VALUE, toHexPrefixed(data));
+        tb->insert(lexical_cast<std::string>(block.blockHeader().number()), entry);
+    }
+}
+
 void BlockChainImp::writeBlockInfo(Block& block, std::shared_ptr<ExecutiveContext> context)
 {
     writeNumber2Hash(block, context);
-    writeHash2Block(block, context);
+    if (m_blockStore)
+    {
+        bytes out;
+        block.encode(out);
+        m_blockStore->put(block.blockHeader().number(), block.blockHeader().hash(), ref(out));
+    }
+    else
+        writeHash2Block(block, context);
 }
 
 CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveContext> context)
@@ -304,8 +444,22 @@ CommitResult BlockChainImp::commitBlock(Block& block, std::shared_ptr<ExecutiveC
     {
         writeNumber(block, context);
         writeTxToBlock(block, context);
-        writeBlockInfo(block, context);
-        context->dbCommit();
+        writeNonceDigests(block, context);
+        try
+        {
+            writeBlockInfo(block, context);
+            context->dbCommit();
+        }
+        catch (...)
+        {
+            if (m_blockStore)
+                m_blockStore->truncate(num);
+            commitMutex.unlock();
+            throw;
+        }
+        /// blocks pruned from the store drop a whole segment at a time
+        if (m_blockStore && m_keepBlocks > 0)
+            m_blockStore->prune(block.blockHeader().number() - m_keepBlocks + 1);
         commitMutex.unlock();
         m_onReady();
         return CommitResult::OK;
@@ -23,6 +23,8 @@
 #pragma once
 
 #include "BlockChainInterface.h"
+#include "BlockStore.h"
+#include <libdevcore/Exceptions.h>
 #include <libethcore/Block.h>
 #include <libethcore/Common.h>
 #include <libethcore/Transaction.h>
@@ -42,6 +44,9 @@ class MemoryTableFactory;
 
 namespace blockchain
 {
+/// committed blocks are missing from the block store, lost in a crash of a node not syncing it
+DEV_SIMPLE_EXCEPTION(BlockStoreBehind);
+
 class BlockChainImp : public BlockChainInterface
 {
 public:
@@ -54,13 +59,25 @@ public:
     dev::eth::TransactionReceipt getTransactionReceiptByHash(dev::h256 const& _txHash) override;
     std::shared_ptr<dev::eth::Block> getBlockByHash(dev::h256 const& _blockHash) override;
     std::shared_ptr<dev::eth::Block> getBlockByNumber(int64_t _i) override;
+    std::shared_ptr<dev::bytes> getBlockRLPByNumber(int64_t _i) override;
+    std::vector<std::shared_ptr<dev::bytes>> getBlockRLPsByRange(
+        int64_t _from, int64_t _to) override;
     CommitResult commitBlock(dev::eth::Block& block,
         std::shared_ptr<dev::blockverifier::ExecutiveContext> context) override;
+    dev::h256s getNonceDigests(int64_t _i) override;
     virtual void setStateStorage(dev::storage::Storage::Ptr stateStorage);
+    /// keep the blocks in _blockStore rather than in the _sys_hash_2_block_ table, blocks written
+    /// to the table before are still read from it; set after the state storage, throws
+    /// BlockStoreBehind when the committed blocks are in neither
+    void setBlockStore(BlockStore::Ptr _blockStore);
+    BlockStore::Ptr blockStore() const { return m_blockStore; }
+    /// keep the latest _keepBlocks blocks in the block store, 0 keeps them all
+    void setKeepBlocks(int64_t _keepBlocks) { m_keepBlocks = _keepBlocks; }
     virtual std::shared_ptr<dev::storage::MemoryTableFactory> getMemoryTableFactory();
     void setGroupMark(std::string const& groupMark) override {}
 
 private:
+    std::shared_ptr<dev::bytes> getBlockRLPByHash(dev::h256 const& _blockHash);
     void writeNumber(const dev::eth::Block& block,
         std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
     void writeTxToBlock(const dev::eth::Block& block,
@@ -71,7 +88,11 @@ private:
         std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
     void writeHash2Block(
         dev::eth::Block& block, std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
+    void writeNonceDigests(const dev::eth::Block& block,
+        std::shared_ptr<dev::blockverifier::ExecutiveContext> context);
     dev::storage::Storage::Ptr m_stateStorage;
+    BlockStore::Ptr m_blockStore;
+    int64_t m_keepBlocks = 0;
     std::mutex commitMutex;
     const std::string c_genesisHash =
         "0xeb8b84af3f35165d52cb41abe1a9a3d684703aca4966ce720ecd940bd885517c";
@@ -55,6 +55,42 @@ public:
     virtual CommitResult commitBlock(
         dev::eth::Block& block, std::shared_ptr<dev::blockverifier::ExecutiveContext>) = 0;
 
+    /// RLP of block _i (Block::rlp), nullptr if there is no such block
+    virtual std::shared_ptr<dev::bytes> getBlockRLPByNumber(int64_t _i)
+    {
+        auto block = getBlockByNumber(_i);
+        if (!block)
+            return nullptr;
+        return std::make_shared<dev::bytes>(block->rlp());
+    }
+
+    /// RLPs of the blocks [_from, _to] up to the first missing one
+    virtual std::vector<std::shared_ptr<dev::bytes>> getBlockRLPsByRange(int64_t _from, int64_t _to)
+    {
+        std::vector<std::shared_ptr<dev::bytes>> blocks;
+        for (int64_t number = _from; number <= _to; number++)
+        {
+            auto block = getBlockRLPByNumber(number);
+            if (!block)
+                break;
+            blocks.push_back(block);
+        }
+        return blocks;
+    }
+
+    /// nonce digests (Transaction::nonceDigest) of the transactions in block _i
+    virtual dev::h256s getNonceDigests(int64_t _i)
+    {
+        dev::h256s digests;
+        auto block = getBlockByNumber(_i);
+        if (block)
+        {
+            for (auto const& tx : block->transactions())
+                digests.push_back(tx.nonceDigest());
+        }
+        return digests;
+    }
+
     /// set group mark to genesis block
     virtual void setGroupMark(std::string const& groupMark) = 0;
 
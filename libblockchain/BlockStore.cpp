@@ -0,0 +1,424 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+/**
+ * @brief : append-only store of the encoded blocks, kept apart from the state db
+ * @file: BlockStore.cpp
+ * @date: 2018-12-21
+ */
+
+#include "BlockStore.h"
+#include <fcntl.h>
+#include <libdevcore/Exceptions.h>
+#include <libdevcore/easylog.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::blockchain;
+
+namespace
+{
+void throwFileError(string const& _path, string const& _what)
+{
+    BOOST_THROW_EXCEPTION(
+        FileError() << errinfo_path(_path) << errinfo_comment(_what + ": " + strerror(errno)));
+}
+
+/// read _size bytes at _offset of _fd, false on an error or a file shorter than that
+bool readAt(int _fd, byte* _data, size_t _size, uint64_t _offset)
+{
+    while (_size > 0)
+    {
+        ssize_t n = ::pread(_fd, _data, _size, _offset);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        _data += n;
+        _size -= n;
+        _offset += n;
+    }
+    return true;
+}
+
+bool writeAt(int _fd, byte const* _data, size_t _size, uint64_t _offset)
+{
+    while (_size > 0)
+    {
+        ssize_t n = ::pwrite(_fd, _data, _size, _offset);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            return false;
+        _data += n;
+        _size -= n;
+        _offset += n;
+    }
+    return true;
+}
+
+/// flush the entries of _path to disk, so that files created in it survive a crash
+bool syncDirectory(string const& _path)
+{
+    int fd = ::open(_path.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd < 0)
+        return false;
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+}
+}  // namespace
+
+const uint64_t BlockStore::c_defaultBlocksPerSegment;
+const uintptr_t BlockStore::c_pageSize = ::sysconf(_SC_PAGESIZE);
+
+BlockStore::BlockStore(string const& _path, uint64_t _blocksPerSegment)
+  : m_path(_path), m_blocksPerSegment(max<uint64_t>(_blocksPerSegment, 1))
+{
+    boost::filesystem::create_directories(m_path);
+    vector<int64_t> firsts;
+    for (auto const& file : boost::filesystem::directory_iterator(m_path))
+    {
+        string name = file.path().stem().string();
+        if (file.path().extension() == ".index" && !name.empty() &&
+            all_of(name.begin(), name.end(), [](char _c) { return isdigit(_c); }))
+            firsts.push_back(stoll(name));
+    }
+    sort(firsts.begin(), firsts.end());
+
+    /// keep the blocks from the first stored one for as long as they follow each other; an entry
+    /// written before the data of its block made it to the file ends the store
+    bool ended = false;
+    for (int64_t first : firsts)
+    {
+        Segment& segment = openSegment(first);
+        uint64_t end = 0;
+        for (uint64_t i = 0; i < m_blocksPerSegment && !ended; i++)
+        {
+            IndexEntry const& entry = segment.index[i];
+            int64_t number = first + i;
+            if (entry.size == 0 && m_head < 0)
+                continue;
+            if (entry.size == 0 || (m_head >= 0 && number != m_head + 1) ||
+                entry.offset != end || entry.offset + entry.size > segment.size)
+            {
+                ended = true;
+                break;
+            }
+            m_numbers[entry.hash] = number;
+            end = entry.offset + entry.size;
+            m_head = number;
+            if (m_tail < 0)
+                m_tail = number;
+        }
+        if (m_head < first)
+        {
+            removeSegment(segment);
+            m_segments.erase(first);
+            continue;
+        }
+        truncateSegment(segment, m_head + 1);
+        ended = ended || m_head < first + (int64_t)m_blocksPerSegment - 1;
+    }
+    LOG(INFO) << "BlockStore opened " << m_path << " blocks [" << m_tail << ", " << m_head
+              << "] in " << m_segments.size() << " segments";
+}
+
+BlockStore::~BlockStore()
+{
+    for (auto& segment : m_segments)
+        closeSegment(segment.second);
+}
+
+void BlockStore::put(int64_t _number, h256 const& _hash, bytesConstRef _block)
+{
+    if (_number < 0 || _block.empty())
+        BOOST_THROW_EXCEPTION(FileError() << errinfo_path(m_path)
+                                          << errinfo_comment("invalid block " + toString(_number)));
+    WriteGuard l(x_segments);
+    if (m_head >= 0)
+    {
+        if (_number > m_head + 1 || _number < m_tail)
+            BOOST_THROW_EXCEPTION(
+                FileError() << errinfo_path(m_path)
+                            << errinfo_comment("block " + toString(_number) +
+                                               " does not follow the stored blocks"));
+        cut(_number - 1);
+    }
+    int64_t first = _number - _number % m_blocksPerSegment;
+    Segment& segment = openSegment(first);
+    if (!writeAt(segment.fd, _block.data(), _block.size(), segment.size) ||
+        ::fdatasync(segment.fd) != 0)
+        throwFileError(segmentPath(first, ".blocks"), "write block " + toString(_number));
+    /// the entry goes last, a crash before it leaves only bytes past the end of the segment
+    IndexEntry& entry = segment.index[_number - first];
+    entry.offset = segment.size;
+    entry.size = _block.size();
+    entry.reserved = 0;
+    entry.hash = _hash;
+    /// the block is on disk before the caller commits the state that refers to it
+    uintptr_t page = (uintptr_t)&entry & ~(uintptr_t)(c_pageSize - 1);
+    if (::msync((void*)page, (uintptr_t)(&entry + 1) - page, MS_SYNC) != 0)
+        throwFileError(segmentPath(first, ".index"), "sync block " + toString(_number));
+    segment.size += _block.size();
+    m_numbers[_hash] = _number;
+    m_head = _number;
+    if (m_tail < 0)
+        m_tail = _number;
+}
+
+void BlockStore::truncate(int64_t _number)
+{
+    WriteGuard l(x_segments);
+    cut(_number);
+}
+
+void BlockStore::prune(int64_t _number)
+{
+    WriteGuard l(x_segments);
+    for (auto it = m_segments.begin();
+         it != m_segments.end() && it->first + (int64_t)m_blocksPerSegment <= _number;)
+    {
+        removeSegment(it->second);
+        it = m_segments.erase(it);
+    }
+    if (m_segments.empty())
+        m_head = m_tail = -1;
+    else
+        m_tail = max(m_tail, m_segments.begin()->first);
+}
+
+shared_ptr<bytes> BlockStore::get(int64_t _number) const
+{
+    ReadGuard l(x_segments);
+    IndexEntry const* found = entry(_number);
+    if (!found)
+        return nullptr;
+    return read(m_segments.at(_number - _number % m_blocksPerSegment), *found);
+}
+
+shared_ptr<bytes> BlockStore::get(h256 const& _hash) const
+{
+    ReadGuard l(x_segments);
+    auto it = m_numbers.find(_hash);
+    if (it == m_numbers.end())
+        return nullptr;
+    int64_t number = it->second;
+    return read(m_segments.at(number - number % m_blocksPerSegment), *entry(number));
+}
+
+int64_t BlockStore::number(h256 const& _hash) const
+{
+    ReadGuard l(x_segments);
+    auto it = m_numbers.find(_hash);
+    return it == m_numbers.end() ? -1 : it->second;
+}
+
+vector<shared_ptr<bytes>> BlockStore::getRange(int64_t _from, int64_t _to) const
+{
+    vector<shared_ptr<bytes>> blocks;
+    ReadGuard l(x_segments);
+    if (m_head < 0 || _from < m_tail)
+        return blocks;
+    int64_t to = min(_to, m_head);
+    for (int64_t number = _from; number <= to;)
+    {
+        /// the blocks of a segment are adjacent in its file, one read covers all of them
+        int64_t first = number - number % m_blocksPerSegment;
+        int64_t last = min<int64_t>(to, first + m_blocksPerSegment - 1);
+        Segment const& segment = m_segments.at(first);
+        IndexEntry const& begin = segment.index[number - first];
+        IndexEntry const& end = segment.index[last - first];
+        bytes data(end.offset + end.size - begin.offset);
+        if (!readAt(segment.fd, data.data(), data.size(), begin.offset))
+        {
+            LOG(ERROR) << "BlockStore read blocks [" << number << ", " << last
+                       << "] failed: " << strerror(errno);
+            break;
+        }
+        for (; number <= last; number++)
+        {
+            IndexEntry const& entry = segment.index[number - first];
+            auto it = data.begin() + (entry.offset - begin.offset);
+            blocks.push_back(make_shared<bytes>(it, it + entry.size));
+        }
+    }
+    return blocks;
+}
+
+int64_t BlockStore::tail() const
+{
+    ReadGuard l(x_segments);
+    return m_tail;
+}
+
+int64_t BlockStore::head() const
+{
+    ReadGuard l(x_segments);
+    return m_head;
+}
+
+string BlockStore::segmentPath(int64_t _first, char const* _suffix) const
+{
+    ostringstream path;
+    path << m_path << "/" << setw(12) << setfill('0') << _first << _suffix;
+    return path.str();
+}
+
+BlockStore::Segment& BlockStore::openSegment(int64_t _first)
+{
+    auto it = m_segments.find(_first);
+    if (it != m_segments.end())
+        return it->second;
+
+    Segment segment;
+    segment.first = _first;
+    string dataPath = segmentPath(_first, ".blocks");
+    segment.fd = ::open(dataPath.c_str(), O_RDWR | O_CREAT, 0644);
+    struct stat status;
+    if (segment.fd < 0 || ::fstat(segment.fd, &status) != 0)
+        throwFileError(dataPath, "open");
+    segment.size = status.st_size;
+
+    string indexPath = segmentPath(_first, ".index");
+    size_t indexSize = m_blocksPerSegment * sizeof(IndexEntry);
+    int indexFd = ::open(indexPath.c_str(), O_RDWR | O_CREAT, 0644);
+    if (indexFd < 0 || ::fstat(indexFd, &status) != 0 ||
+        (status.st_size == 0 &&
+            (::ftruncate(indexFd, indexSize) != 0 || !syncDirectory(m_path))))
+    {
+        ::close(segment.fd);
+        throwFileError(indexPath, "open");
+    }
+    if ((size_t)status.st_size != indexSize && status.st_size != 0)
+    {
+        ::close(indexFd);
+        ::close(segment.fd);
+        BOOST_THROW_EXCEPTION(FileError() << errinfo_path(indexPath)
+                                          << errinfo_comment("written with another blocks "
+                                                             "per segment than " +
+                                                             toString(m_blocksPerSegment)));
+    }
+    void* index = ::mmap(nullptr, indexSize, PROT_READ | PROT_WRITE, MAP_SHARED, indexFd, 0);
+    ::close(indexFd);
+    if (index == MAP_FAILED)
+    {
+        ::close(segment.fd);
+        throwFileError(indexPath, "mmap");
+    }
+    segment.index = static_cast<IndexEntry*>(index);
+    return m_segments.emplace(_first, segment).first->second;
+}
+
+void BlockStore::closeSegment(Segment& _segment)
+{
+    if (_segment.index)
+        ::munmap(_segment.index, m_blocksPerSegment * sizeof(IndexEntry));
+    if (_segment.fd >= 0)
+        ::close(_segment.fd);
+    _segment.index = nullptr;
+    _segment.fd = -1;
+}
+
+void BlockStore::removeSegment(Segment& _segment)
+{
+    truncateSegment(_segment, _segment.first);
+    closeSegment(_segment);
+    boost::system::error_code error;
+    boost::filesystem::remove(segmentPath(_segment.first, ".blocks"), error);
+    boost::filesystem::remove(segmentPath(_segment.first, ".index"), error);
+}
+
+void BlockStore::cut(int64_t _number)
+{
+    if (m_head < 0 || _number >= m_head)
+        return;
+    for (auto it = m_segments.begin(); it != m_segments.end();)
+    {
+        if (it->first > _number)
+        {
+            removeSegment(it->second);
+            it = m_segments.erase(it);
+            continue;
+        }
+        if (_number + 1 < it->first + (int64_t)m_blocksPerSegment)
+            truncateSegment(it->second, _number + 1);
+        ++it;
+    }
+    m_head = _number;
+    if (m_head < m_tail)
+        m_head = m_tail = -1;
+}
+
+void BlockStore::truncateSegment(Segment& _segment, int64_t _number)
+{
+    uint64_t from = min<uint64_t>(max<int64_t>(_number - _segment.first, 0), m_blocksPerSegment);
+    for (uint64_t i = from; i < m_blocksPerSegment; i++)
+    {
+        IndexEntry& entry = _segment.index[i];
+        if (entry.size == 0)
+            continue;
+        auto it = m_numbers.find(entry.hash);
+        if (it != m_numbers.end() && it->second == _segment.first + (int64_t)i)
+            m_numbers.erase(it);
+        memset(&entry, 0, sizeof(IndexEntry));
+    }
+    uint64_t end = 0;
+    for (uint64_t i = from; i > 0; i--)
+    {
+        if (_segment.index[i - 1].size > 0)
+        {
+            end = _segment.index[i - 1].offset + _segment.index[i - 1].size;
+            break;
+        }
+    }
+    if (end != _segment.size)
+    {
+        if (::ftruncate(_segment.fd, end) != 0)
+            throwFileError(segmentPath(_segment.first, ".blocks"), "truncate");
+        _segment.size = end;
+    }
+}
+
+BlockStore::IndexEntry const* BlockStore::entry(int64_t _number) const
+{
+    if (m_head < 0 || _number < m_tail || _number > m_head)
+        return nullptr;
+    int64_t first = _number - _number % m_blocksPerSegment;
+    return &m_segments.at(first).index[_number - first];
+}
+
+shared_ptr<bytes> BlockStore::read(Segment const& _segment, IndexEntry const& _entry) const
+{
+    auto block = make_shared<bytes>(_entry.size);
+    if (!readAt(_segment.fd, block->data(), _entry.size, _entry.offset))
+    {
+        LOG(ERROR) << "BlockStore read " << _entry.hash.abridged() << " of segment "
+                   << _segment.first << " failed: " << strerror(errno);
+        return nullptr;
+    }
+    return block;
+}
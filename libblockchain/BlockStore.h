@@ -0,0 +1,117 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+/**
+ * @brief : append-only store of the encoded blocks, kept apart from the state db
+ * @file: BlockStore.h
+ * @date: 2018-12-21
+ */
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/FlatHash.h>
+#include <libdevcore/Guards.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace blockchain
+{
+/**
+ * @brief Blocks are appended to segment files of blocksPerSegment blocks each: block n lives in
+ * the segment starting at n - n % blocksPerSegment, whose <first>.blocks file holds the encoded
+ * blocks back to back and whose <first>.index file, mapped in memory, one IndexEntry per block.
+ * The hash -> number index is rebuilt from the index files when the store is opened.
+ * A segment is never rewritten but at its end, old segments are pruned by removing their files.
+ */
+class BlockStore
+{
+public:
+    typedef std::shared_ptr<BlockStore> Ptr;
+
+    /// open the store in _path, created if missing; a block cut short by a crash is dropped
+    BlockStore(std::string const& _path, uint64_t _blocksPerSegment = c_defaultBlocksPerSegment);
+    ~BlockStore();
+
+    /// append block _number, on disk when it returns; a _number up to the head replaces the
+    /// blocks from it on
+    void put(int64_t _number, h256 const& _hash, bytesConstRef _block);
+    /// drop the blocks after _number, those a node wrote but failed to commit before it stopped
+    void truncate(int64_t _number);
+    /// remove the segments whose blocks all lie below _number
+    void prune(int64_t _number);
+
+    /// the encoded block, nullptr if it is not stored
+    std::shared_ptr<bytes> get(int64_t _number) const;
+    std::shared_ptr<bytes> get(h256 const& _hash) const;
+    /// the number of the block _hash, -1 if it is not stored
+    int64_t number(h256 const& _hash) const;
+    /// the encoded blocks [_from, _to] up to the first missing one, read a segment at a time
+    std::vector<std::shared_ptr<bytes>> getRange(int64_t _from, int64_t _to) const;
+
+    /// the first and the last stored block, -1 when the store is empty
+    int64_t tail() const;
+    int64_t head() const;
+
+    static const uint64_t c_defaultBlocksPerSegment = 10000;
+
+private:
+    /// msync takes page aligned addresses
+    static const uintptr_t c_pageSize;
+
+    /// where a block is in the .blocks file of its segment, size 0 for a block not stored
+    struct IndexEntry
+    {
+        uint64_t offset;
+        uint32_t size;
+        uint32_t reserved;
+        h256 hash;
+    };
+    struct Segment
+    {
+        int64_t first = 0;
+        int fd = -1;
+        uint64_t size = 0;
+        IndexEntry* index = nullptr;
+    };
+
+    std::string segmentPath(int64_t _first, char const* _suffix) const;
+    Segment& openSegment(int64_t _first);
+    void closeSegment(Segment& _segment);
+    /// close _segment and remove its files, dropping its blocks from the hash index
+    void removeSegment(Segment& _segment);
+    /// drop the blocks after _number, the write lock held
+    void cut(int64_t _number);
+    /// drop the blocks of _segment from _number on
+    void truncateSegment(Segment& _segment, int64_t _number);
+    IndexEntry const* entry(int64_t _number) const;
+    std::shared_ptr<bytes> read(Segment const& _segment, IndexEntry const& _entry) const;
+
+    std::string m_path;
+    uint64_t m_blocksPerSegment;
+    mutable SharedMutex x_segments;
+    std::map<int64_t, Segment> m_segments;
+    FlatHashMap<h256, int64_t> m_numbers;
+    int64_t m_tail = -1;
+    int64_t m_head = -1;
+};
+}  // namespace blockchain
+}  // namespace dev
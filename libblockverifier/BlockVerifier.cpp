@@ -25,6 +25,7 @@
 #include <libethcore/TransactionReceipt.h>
 #include <libexecutive/ExecutionResult.h>
 #include <libexecutive/Executive.h>
+#include <chrono>
 #include <exception>
 using namespace dev;
 using namespace std;
@@ -39,7 +40,7 @@ ExecutiveContext::Ptr BlockVerifier::executeBlock(Block& block, h256 const& pare
                << " num: " << block.blockHeader().number()
                << " stateRoot: " << block.blockHeader().stateRoot()
                << " parentStateRoot: " << parentStateRoot << std::endl;
-    ExecutiveContext::Ptr executiveContext = std::make_shared<ExecutiveContext>();
+    ExecutiveContext::Ptr executiveContext = m_executiveContextFactory->newExecutiveContext();
     try
     {
         BlockInfo blockInfo;
@@ -55,17 +56,36 @@ ExecutiveContext::Ptr BlockVerifier::executeBlock(Block& block, h256 const& pare
     unsigned i = 0;
     BlockHeader tmpHeader = block.blockHeader();
     block.clearAllReceipts();
+    uint64_t predictedTime = 0;
+    uint64_t actualTime = 0;
     for (Transaction const& tr : block.transactions())
     {
-        EnvInfo envInfo(block.blockHeader(), m_pNumberHash,
-            block.getTransactionReceipts().size() > 0 ?
-                block.getTransactionReceipts().back().gasUsed() :
-                0);
+        u256 startGasUsed = block.getTransactionReceipts().size() > 0 ?
+                                block.getTransactionReceipts().back().gasUsed() :
+                                0;
+        EnvInfo envInfo(block.blockHeader(), m_pNumberHash, startGasUsed);
         envInfo.setPrecompiledEngine(executiveContext);
+        if (m_costModel)
+            predictedTime += m_costModel->predict(tr);
+        auto start = std::chrono::steady_clock::now();
         std::pair<ExecutionResult, TransactionReceipt> resultReceipt =
             execute(envInfo, tr, OnOpFunc(), executiveContext);
         block.appendTransactionReceipt(resultReceipt.second);
         executiveContext->getState()->commit();
+        if (m_costModel)
+        {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            uint64_t time = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+            actualTime += time;
+            m_costModel->update(tr, time, resultReceipt.second.gasUsed() - startGasUsed);
+        }
+    }
+    if (m_costModel && !block.transactions().empty())
+    {
+        m_costModel->reportBlock(predictedTime, actualTime);
+        LOG(DEBUG) << "BlockVerifier::executeBlock num: " << block.blockHeader().number()
+                   << " tx_num: " << block.transactions().size()
+                   << " predicted_us: " << predictedTime << " actual_us: " << actualTime;
     }
     block.calReceiptRoot();
     block.header().setStateRoot(executiveContext->getState()->rootHash());
@@ -83,7 +103,7 @@ ExecutiveContext::Ptr BlockVerifier::executeBlock(Block& block, h256 const& pare
 std::pair<ExecutionResult, TransactionReceipt> BlockVerifier::executeTransaction(
     const BlockHeader& blockHeader, dev::eth::Transaction const& _t)
 {
-    ExecutiveContext::Ptr executiveContext = std::make_shared<ExecutiveContext>();
+    ExecutiveContext::Ptr executiveContext = m_executiveContextFactory->newExecutiveContext();
     try
     {
         BlockInfo blockInfo;
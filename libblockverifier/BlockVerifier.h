@@ -21,6 +21,7 @@
 #pragma once
 
 #include "BlockVerifierInterface.h"
+#include "ExecutionCostModel.h"
 #include "ExecutiveContext.h"
 #include "ExecutiveContextFactory.h"
 #include "Precompiled.h"
@@ -82,10 +83,14 @@ public:
     {
         m_pNumberHash = _pNumberHash;
     }
+    /// the model learns the execution time of every transaction of the executed blocks
+    void setCostModel(ExecutionCostModel::Ptr _costModel) { m_costModel = _costModel; }
+    ExecutionCostModel::Ptr costModel() const { return m_costModel; }
 
 private:
     ExecutiveContextFactory::Ptr m_executiveContextFactory;
     NumberHashCallBackFunction m_pNumberHash;
+    ExecutionCostModel::Ptr m_costModel;
 };
 
 }  // namespace blockverifier
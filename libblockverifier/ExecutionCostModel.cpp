@@ -0,0 +1,113 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief: execution time of transactions learnt per contract and function selector
+ *
+ * @file ExecutionCostModel.cpp
+ * @date 2018-12-18
+ */
+#include "ExecutionCostModel.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::blockverifier;
+
+constexpr double ExecutionCostModel::c_smoothing;
+
+ExecutionCostModel::Key ExecutionCostModel::keyOf(Transaction const& _tx)
+{
+    Key key;
+    Address to = _tx.receiveAddress();
+    std::copy(to.begin(), to.end(), key.data());
+    /// contract creations share the zero address and the zero selector
+    bytes const& data = _tx.data();
+    if (!_tx.isCreation() && data.size() >= 4)
+        std::copy(data.begin(), data.begin() + 4, key.data() + Address::size);
+    return key;
+}
+
+void ExecutionCostModel::smooth(Cost& _cost, double _time, double _gas)
+{
+    double timePerGas = _time / std::max(_gas, 1.0);
+    if (_cost.samples == 0)
+    {
+        _cost.gas = _gas;
+        _cost.timePerGas = timePerGas;
+    }
+    else
+    {
+        _cost.gas += c_smoothing * (_gas - _cost.gas);
+        _cost.timePerGas += c_smoothing * (timePerGas - _cost.timePerGas);
+    }
+    _cost.samples++;
+}
+
+uint64_t ExecutionCostModel::predict(Transaction const& _tx) const
+{
+    Guard l(x_costs);
+    auto it = m_costs.find(keyOf(_tx));
+    Cost const& cost = it != m_costs.end() ? it->second->second : m_total;
+    return (uint64_t)std::llround(cost.gas * cost.timePerGas);
+}
+
+void ExecutionCostModel::update(Transaction const& _tx, uint64_t _time, u256 const& _gasUsed)
+{
+    double gas = _gasUsed.convert_to<double>();
+    Key key = keyOf(_tx);
+    Guard l(x_costs);
+    auto it = m_costs.find(key);
+    if (it != m_costs.end())
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+    else
+    {
+        if (m_costs.size() >= m_maxKeys)
+        {
+            m_costs.erase(m_lru.back().first);
+            m_lru.pop_back();
+        }
+        m_lru.emplace_front(key, Cost());
+        m_costs.emplace(key, m_lru.begin());
+    }
+    smooth(m_lru.front().second, (double)_time, gas);
+    smooth(m_total, (double)_time, gas);
+}
+
+void ExecutionCostModel::reportBlock(uint64_t _predicted, uint64_t _actual)
+{
+    Guard l(x_costs);
+    double error =
+        std::fabs((double)_predicted - (double)_actual) / std::max((double)_actual, 1.0);
+    m_stats.meanError += (error - m_stats.meanError) / (m_stats.blocks + 1);
+    m_stats.blocks++;
+    m_stats.lastPredicted = _predicted;
+    m_stats.lastActual = _actual;
+}
+
+bool ExecutionCostModel::trained() const
+{
+    Guard l(x_costs);
+    return m_total.samples > 0;
+}
+
+ExecutionCostModel::Stats ExecutionCostModel::stats() const
+{
+    Guard l(x_costs);
+    Stats stats = m_stats;
+    stats.keys = m_costs.size();
+    return stats;
+}
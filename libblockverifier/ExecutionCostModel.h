@@ -0,0 +1,107 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief: execution time of transactions learnt per contract and function selector
+ *
+ * @file ExecutionCostModel.h
+ * @date 2018-12-18
+ */
+#pragma once
+
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/Guards.h>
+#include <libethcore/Transaction.h>
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace dev
+{
+namespace blockverifier
+{
+/**
+ * @brief keeps the gas used and the time per gas of the transactions executed for each
+ * (receive address, function selector), smoothed over the recent executions, and predicts the
+ * execution time of a transaction from them. Transactions of a key not seen yet are predicted
+ * from the averages over all keys. When the table is full the least recently executed key
+ * leaves for the new one.
+ */
+class ExecutionCostModel
+{
+public:
+    typedef std::shared_ptr<ExecutionCostModel> Ptr;
+
+    explicit ExecutionCostModel(size_t _maxKeys = c_maxKeys)
+      : m_maxKeys(std::max<size_t>(_maxKeys, 1))
+    {}
+
+    /// predictions of the executed blocks against their measured execution time
+    struct Stats
+    {
+        uint64_t blocks = 0;
+        /// of the last executed block, in microseconds
+        uint64_t lastPredicted = 0;
+        uint64_t lastActual = 0;
+        /// mean of |predicted - actual| / actual over the executed blocks
+        double meanError = 0;
+        /// tracked (address, selector) keys
+        size_t keys = 0;
+    };
+
+    /// @returns the predicted execution time of _tx in microseconds, 0 before any execution
+    uint64_t predict(dev::eth::Transaction const& _tx) const;
+    /// learn from _tx executed in _time microseconds using _gasUsed
+    void update(dev::eth::Transaction const& _tx, uint64_t _time, u256 const& _gasUsed);
+    /// record the predicted and the measured execution time of a block, in microseconds
+    void reportBlock(uint64_t _predicted, uint64_t _actual);
+
+    /// whether a transaction has been learnt from
+    bool trained() const;
+    Stats stats() const;
+
+private:
+    /// receive address followed by the function selector
+    using Key = FixedHash<24>;
+    struct Cost
+    {
+        double gas = 0;
+        double timePerGas = 0;
+        uint64_t samples = 0;
+    };
+
+    static Key keyOf(dev::eth::Transaction const& _tx);
+    static void smooth(Cost& _cost, double _time, double _gas);
+
+    using Costs = std::list<std::pair<Key, Cost>>;
+
+    mutable Mutex x_costs;
+    /// most recently executed first
+    Costs m_lru;
+    std::unordered_map<Key, Costs::iterator, Key::hash> m_costs;
+    size_t m_maxKeys;
+    /// over all keys
+    Cost m_total;
+    Stats m_stats;
+
+    /// weight of a new execution in the smoothed values
+    static constexpr double c_smoothing = 0.2;
+    /// most keys tracked by default
+    static const size_t c_maxKeys = 10000;
+};
+
+}  // namespace blockverifier
+}  // namespace dev
@@ -35,8 +35,8 @@ bytes ExecutiveContext::call(Address address, bytesConstRef param)
 {
     try
     {
-        LOG(TRACE) << "PrecompiledEngine call:" << m_blockInfo.hash << " " << m_blockInfo.number
-                   << " " << address << " " << toHex(param);
+        ASYNC_LOG(TRACE) << "PrecompiledEngine call:" << m_blockInfo.hash << " "
+                         << m_blockInfo.number << " " << address << " " << toHex(param);
 
         auto p = getPrecompiled(address);
 
@@ -62,23 +62,20 @@ bytes ExecutiveContext::call(Address address, bytesConstRef param)
 
 Address ExecutiveContext::registerPrecompiled(Precompiled::Ptr p)
 {
-    Address address(++m_addressCount);
-
-    m_address2Precompiled.insert(std::make_pair(address, p));
-
-    return address;
+    m_handles.push_back(p);
+    return Address(c_handleBase + m_handles.size());
 }
 
 
 bool ExecutiveContext::isPrecompiled(Address address)
 {
-    LOG(TRACE) << "PrecompiledEngine isPrecompiled:" << m_blockInfo.hash << " " << address;
+    ASYNC_LOG(TRACE) << "PrecompiledEngine isPrecompiled:" << m_blockInfo.hash << " " << address;
 
     auto p = getPrecompiled(address);
 
     if (p)
     {
-        LOG(DEBUG) << "internal contract:" << address;
+        ASYNC_LOG(DEBUG) << "internal contract:" << address;
     }
 
     return p.get() != NULL;
@@ -86,9 +83,20 @@ bool ExecutiveContext::isPrecompiled(Address address)
 
 Precompiled::Ptr ExecutiveContext::getPrecompiled(Address address)
 {
-    LOG(TRACE) << "PrecompiledEngine getPrecompiled:" << m_blockInfo.hash << " " << address;
+    ASYNC_LOG(TRACE) << "PrecompiledEngine getPrecompiled:" << m_blockInfo.hash << " " << address;
+
+    /// handles are small integers, so everything but the low 4 bytes is zero
+    bool isHandle = true;
+    for (size_t i = 0; i < Address::size - 4 && isHandle; ++i)
+        isHandle = address[i] == 0;
+    if (isHandle)
+    {
+        uint32_t handle = fromBigEndian<uint32_t>(address.ref().cropped(Address::size - 4));
+        if (handle > c_handleBase && handle - c_handleBase <= m_handles.size())
+            return m_handles[handle - c_handleBase - 1];
+    }
 
-    LOG(TRACE) << "address size:" << m_address2Precompiled.size();
+    ASYNC_LOG(TRACE) << "address size:" << m_address2Precompiled.size();
     auto itPrecompiled = m_address2Precompiled.find(address);
 
     if (itPrecompiled != m_address2Precompiled.end())
@@ -133,6 +141,15 @@ void ExecutiveContext::setPrecompiledContract(
     m_precompiledContract = precompiledContract;
 }
 
+void ExecutiveContext::reset()
+{
+    m_handles.clear();
+    m_stateFace.reset();
+    m_blockInfo = BlockInfo();
+    if (m_memoryTableFactory)
+        m_memoryTableFactory->clear();
+}
+
 void ExecutiveContext::dbCommit()
 {
     m_stateFace->dbCommit(m_blockInfo.hash, m_blockInfo.number.convert_to<int64_t>());
@@ -54,6 +54,8 @@ public:
 
     virtual bytes call(Address address, bytesConstRef param);
 
+    /// register a per-call precompiled (table, entries, entry ...) and return its handle address;
+    /// handles are dense and only live until reset()
     virtual Address registerPrecompiled(Precompiled::Ptr p);
 
     virtual bool isPrecompiled(Address address);
@@ -94,10 +96,16 @@ public:
         return m_memoryTableFactory;
     }
 
+    /// drop everything bound to the last block so that the context can be pooled, the fixed
+    /// precompileds and the memory table factory are kept for reuse
+    void reset();
 
 private:
+    /// fixed addresses, set up once per context
     std::unordered_map<Address, Precompiled::Ptr> m_address2Precompiled;
-    int m_addressCount = 0x10000;
+    /// handle i lives at address c_handleBase + 1 + i
+    static const uint32_t c_handleBase = 0x10000;
+    std::vector<Precompiled::Ptr> m_handles;
     BlockInfo m_blockInfo;
     std::shared_ptr<dev::executive::StateFace> m_stateFace;
     std::unordered_map<Address, dev::eth::PrecompiledContract> m_precompiledContract;
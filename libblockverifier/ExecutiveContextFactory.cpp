@@ -1,6 +1,5 @@
 #include "ExecutiveContextFactory.h"
 #include <libdevcore/Common.h>
-#include <libstorage/CRUDPrecompiled.h>
 #include <libstorage/MemoryTableFactory.h>
 #include <libstorage/TableFactoryPrecompiled.h>
 
@@ -8,26 +7,61 @@ using namespace dev;
 using namespace dev::blockverifier;
 using namespace dev::executive;
 
+ExecutiveContext::Ptr ExecutiveContextFactory::newExecutiveContext()
+{
+    ExecutiveContext* context = nullptr;
+    DEV_GUARDED(m_contextPool->lock)
+    {
+        if (!m_contextPool->contexts.empty())
+        {
+            context = m_contextPool->contexts.back();
+            m_contextPool->contexts.pop_back();
+        }
+    }
+    if (!context)
+        context = new ExecutiveContext();
+
+    std::weak_ptr<ContextPool> weakPool = m_contextPool;
+    return ExecutiveContext::Ptr(context, [weakPool](ExecutiveContext* _context) {
+        auto pool = weakPool.lock();
+        if (pool)
+        {
+            _context->reset();
+            Guard l(pool->lock);
+            if (pool->contexts.size() < c_maxPooledContexts)
+            {
+                pool->contexts.push_back(_context);
+                return;
+            }
+        }
+        delete _context;
+    });
+}
+
 void ExecutiveContextFactory::initExecutiveContext(
     BlockInfo blockInfo, h256 stateRoot, ExecutiveContext::Ptr context)
 {
-    // DBFactoryPrecompiled
-    dev::storage::MemoryTableFactory::Ptr memoryTableFactory =
-        std::make_shared<dev::storage::MemoryTableFactory>();
+    /// a pooled context keeps its memory table factory and fixed precompileds
+    auto memoryTableFactory = context->getMemoryTableFactory();
+    if (!memoryTableFactory)
+    {
+        memoryTableFactory = std::make_shared<dev::storage::MemoryTableFactory>();
+
+        // DBFactoryPrecompiled
+        auto tableFactoryPrecompiled =
+            std::make_shared<dev::blockverifier::TableFactoryPrecompiled>();
+        tableFactoryPrecompiled->setMemoryTableFactory(memoryTableFactory);
+
+        context->setAddress2Precompiled(Address(0x1001), tableFactoryPrecompiled);
+        context->setAddress2Precompiled(Address(0x1002), m_crudPrecompiled);
+        context->setMemoryTableFactory(memoryTableFactory);
+        context->setPrecompiledContract(m_precompiledContract);
+    }
     memoryTableFactory->setStateStorage(m_stateStorage);
     memoryTableFactory->setBlockHash(blockInfo.hash);
     memoryTableFactory->setBlockNum(blockInfo.number.convert_to<int>());
 
-    auto tableFactoryPrecompiled = std::make_shared<dev::blockverifier::TableFactoryPrecompiled>();
-    tableFactoryPrecompiled->setMemoryTableFactory(memoryTableFactory);
-
-    context->setAddress2Precompiled(Address(0x1001), tableFactoryPrecompiled);
-    context->setAddress2Precompiled(
-        Address(0x1002), std::make_shared<dev::blockverifier::CRUDPrecompiled>());
-    context->setMemoryTableFactory(memoryTableFactory);
-
     context->setBlockInfo(blockInfo);
-    context->setPrecompiledContract(m_precompiledContract);
     context->setState(m_stateFactoryInterface->getState(stateRoot, memoryTableFactory));
 }
 
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "ExecutiveContext.h"
+#include <libdevcore/Guards.h>
 #include <libdevcore/OverlayDB.h>
 #include <libexecutive/StateFactoryInterface.h>
+#include <libstorage/CRUDPrecompiled.h>
 #include <libstorage/Storage.h>
 namespace dev
 {
@@ -12,7 +14,7 @@ class ExecutiveContextFactory : public std::enable_shared_from_this<ExecutiveCon
 {
 public:
     typedef std::shared_ptr<ExecutiveContextFactory> Ptr;
-    ExecutiveContextFactory()
+    ExecutiveContextFactory() : m_crudPrecompiled(std::make_shared<CRUDPrecompiled>())
     {
         m_precompiledContract.insert(std::make_pair(
             dev::Address(1), dev::eth::PrecompiledContract(
@@ -29,6 +31,9 @@ public:
     };
     virtual ~ExecutiveContextFactory(){};
 
+    /// @returns a context from the pool, it returns there once the last reference is dropped
+    virtual ExecutiveContext::Ptr newExecutiveContext();
+
     virtual void initExecutiveContext(
         BlockInfo blockInfo, h256 stateRoot, ExecutiveContext::Ptr context);
 
@@ -41,6 +46,22 @@ private:
     dev::storage::Storage::Ptr m_stateStorage;
     std::shared_ptr<dev::executive::StateFactoryInterface> m_stateFactoryInterface;
     std::unordered_map<Address, dev::eth::PrecompiledContract> m_precompiledContract;
+    /// stateless, shared by every context
+    Precompiled::Ptr m_crudPrecompiled;
+
+    struct ContextPool
+    {
+        ~ContextPool()
+        {
+            for (auto context : contexts)
+                delete context;
+        }
+        dev::Mutex lock;
+        std::vector<ExecutiveContext*> contexts;
+    };
+    /// enough for the executing block, blocks waiting for commit and concurrent RPC calls
+    static const size_t c_maxPooledContexts = 16;
+    std::shared_ptr<ContextPool> m_contextPool = std::make_shared<ContextPool>();
 };
 
 }  // namespace blockverifier
@@ -40,6 +40,7 @@
 #include <boost/range/algorithm/remove_if.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <string>
@@ -134,7 +135,9 @@ bool ChannelRPCServer::SendResponse(const std::string& _response, void* _addInfo
 
     if (it != _seq2session.end())
     {
-        LOG(INFO) << "send ethereum resp seq:" << it->first << " response:" << _response;
+        /// range and batch responses run to megabytes, only their size is worth an INFO line
+        LOG(INFO) << "send ethereum resp seq:" << it->first << " size:" << _response.size();
+        LOG(TRACE) << "send ethereum resp seq:" << it->first << " response:" << _response;
 
         std::shared_ptr<bytes> resp(new bytes());
 
@@ -203,7 +206,6 @@ void ChannelRPCServer::onDisconnect(
     {
         std::lock_guard<std::mutex> lockSession(_sessionMutex);
         std::lock_guard<std::mutex> lockSeqMutex(_seqMutex);
-        std::lock_guard<std::mutex> lockSeqMessageMutex(_seqMessageMutex);
 
         for (auto it : _sessions)
         {
@@ -224,17 +226,39 @@ void ChannelRPCServer::onDisconnect(
                 break;
             }
         }
+    }
 
-        for (auto it : _seq2MessageSession)
+    /// the requests of the session have nobody to answer, those pushed to it go to another session
+    std::vector<ChannelMessageSession::Ptr> finished;
+    std::vector<std::pair<std::string, ChannelMessageSession::Ptr> > pushed;
+    for (auto& shard : _seq2MessageSession)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto it = shard.sessions.begin(); it != shard.sessions.end();)
         {
-            if (it.second.fromSession == session || it.second.toSession == session)
+            if (it->second->fromSession == session)
             {
-                auto c = _seq2MessageSession.erase(it.first);
-                LOG(DEBUG) << "seq2MessageSession removed: " << c;
-                break;
+                finished.push_back(it->second);
+                it = shard.sessions.erase(it);
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> sessionLock(it->second->mutex);
+                if (it->second->toSession == session)
+                {
+                    it->second->failedSessions.insert(session);
+                    pushed.push_back(*it);
+                }
             }
+            ++it;
         }
     }
+    LOG(DEBUG) << "seq2MessageSession removed: " << finished.size()
+               << " repushed: " << pushed.size();
+    for (auto const& messageSession : finished)
+        finishMessageSession(messageSession);
+    for (auto const& it : pushed)
+        pushToSession(it.first, it.second);
 
     updateHostTopics();
 }
@@ -374,39 +398,21 @@ void dev::ChannelRPCServer::onClientChannelRequest(
 
     LOG(DEBUG) << "target topic:" << topic;
 
-    std::lock_guard<std::mutex> lock(_seqMessageMutex);
-    auto it = _seq2MessageSession.find(message->seq());
-
     if (message->type() == 0x30)
     {
         try
         {
             LOG(DEBUG) << "channel2 request:" << message->seq();
 
-            ChannelMessageSession messageSession;
-            messageSession.fromSession = session;
-            messageSession.message = message;
-
-            auto newIt = _seq2MessageSession.insert(std::make_pair(message->seq(), messageSession));
-            if (newIt.second == false)
-            {
-                LOG(WARNING) << "seq:" << message->seq() << " session repeat, overwrite";
+            auto messageSession = std::make_shared<ChannelMessageSession>();
+            messageSession->fromSession = session;
+            messageSession->message = message;
+            messageSession->topic = topic;
+            messageSession->buffer = std::make_shared<bytes>();
+            message->encode(*messageSession->buffer);
 
-                newIt.first->second.fromSession = session;
-            }
-            it = newIt.first;
-
-            LOG(DEBUG) << "send to node:" << it->second.message->seq();
-            it->second.failedNodeIDs.insert(it->second.toNodeID);
-            auto buffer = std::make_shared<bytes>();
-            it->second.message->encode(*buffer);
-            auto msg = make_shared<p2p::Message>();
-            msg->setBuffer(buffer);
-            msg->setProtocolID(dev::eth::ProtocolID::Topic);
-            msg->setPacketType(0u);
-            msg->setLength(p2p::Message::HEADER_LENGTH + msg->buffer()->size());
-
-            m_service->sendMessageByTopic(topic, msg);
+            insertMessageSession(message->seq(), messageSession);
+            forwardToNode(message->seq(), messageSession);
         }
         catch (exception& e)
         {
@@ -416,15 +422,15 @@ void dev::ChannelRPCServer::onClientChannelRequest(
             message->setResult(REMOTE_PEER_UNAVAILIBLE);
             message->clearData();
 
-            it->second.fromSession->asyncSendMessage(
-                message, dev::channel::ChannelSession::CallbackType(), 0);
+            session->asyncSendMessage(message, dev::channel::ChannelSession::CallbackType(), 0);
         }
     }
     else if (message->type() == 0x31)
     {
         try
         {
-            if (it == _seq2MessageSession.end())
+            auto messageSession = findMessageSession(message->seq());
+            if (!messageSession)
             {
                 LOG(WARNING) << "not found seq, may timeout?";
 
@@ -433,51 +439,28 @@ void dev::ChannelRPCServer::onClientChannelRequest(
 
             if (message->result() != 0)
             {
-                try
-                {
-                    LOG(DEBUG) << "seq" << message->seq() << " push to  "
-                               << it->second.toSession->host() << ":"
-                               << it->second.toSession->port() << " failed:" << message->result();
-                    it->second.failedSessions.insert(it->second.toSession);
-
-                    auto session =
-                        sendChannelMessageToSession(topic, message, it->second.failedSessions);
-
-                    LOG(DEBUG) << "try push to" << session->host() << ":" << session->port()
-                               << " failed:" << message->result();
-                    it->second.toSession = session;
-                }
-                catch (exception& e)
+                LOG(DEBUG) << "seq" << message->seq() << " push to  " << session->host() << ":"
+                           << session->port() << " failed:" << message->result();
                 {
-                    LOG(ERROR) << "message push totaly failed:" << e.what();
-
-                    message->setResult(REMOTE_CLIENT_PEER_UNAVAILBLE);
-                    message->setType(0x31);
-                    auto buffer = std::make_shared<bytes>();
-                    message->encode(*buffer);
-                    auto msg = make_shared<p2p::Message>();
-                    msg->setBuffer(buffer);
-                    msg->setProtocolID(dev::eth::ProtocolID::Topic);
-                    msg->setPacketType(0u);
-                    msg->setLength(p2p::Message::HEADER_LENGTH + msg->buffer()->size());
-                    m_service->sendMessageByNodeID(it->second.fromNodeID, msg);
+                    std::lock_guard<std::mutex> lock(messageSession->mutex);
+                    /// the session has timed out already, the message is elsewhere
+                    if (messageSession->toSession != session)
+                        return;
+                    messageSession->failedSessions.insert(session);
                 }
+                pushToSession(message->seq(), messageSession);
             }
             else
             {
+                if (!eraseMessageSession(message->seq(), messageSession))
+                    return;
+
                 LOG(DEBUG) << "from SDK channel2 response:" << message->seq();
                 auto buffer = std::make_shared<bytes>();
                 message->encode(*buffer);
-                auto msg = make_shared<p2p::Message>();
-                msg->setBuffer(buffer);
-                msg->setProtocolID(dev::eth::ProtocolID::Topic);
-                msg->setPacketType(0u);
-                msg->setLength(p2p::Message::HEADER_LENGTH + msg->buffer()->size());
-                m_service->sendMessageByNodeID(it->second.fromNodeID, msg);
-
-                LOG(DEBUG) << "send message to node:" << it->second.fromNodeID;
+                sendToNode(messageSession->fromNodeID, buffer);
 
-                _seq2MessageSession.erase(it);
+                LOG(DEBUG) << "send message to node:" << messageSession->fromNodeID;
             }
         }
         catch (exception& e)
@@ -534,58 +517,25 @@ void ChannelRPCServer::onNodeChannelRequest(h512 nodeID, dev::channel::Message::
 
         LOG(DEBUG) << "target topic:" << topic;
 
-        std::lock_guard<std::mutex> lock(_seqMessageMutex);
-        auto it = _seq2MessageSession.find(message->seq());
-
+        auto messageSession = findMessageSession(message->seq());
         if (message->type() == 0x30)
         {
-            try
+            if (!messageSession)
             {
-                if (it == _seq2MessageSession.end())
-                {
-                    LOG(DEBUG) << "new channel message";
-
-                    ChannelMessageSession messageSession;
-                    messageSession.fromNodeID = nodeID;
-                    messageSession.message = message;
-
-                    auto newIt =
-                        _seq2MessageSession.insert(std::make_pair(message->seq(), messageSession));
-                    if (newIt.second == false)
-                    {
-                        LOG(WARNING) << "seq:" << message->seq() << " session repeat, overwrite";
-
-                        newIt.first->second = messageSession;
-                    }
-
-                    it = newIt.first;
-                }
-
-                auto session =
-                    sendChannelMessageToSession(topic, message, it->second.failedSessions);
+                LOG(DEBUG) << "new channel message";
 
-                it->second.toSession = session;
+                messageSession = std::make_shared<ChannelMessageSession>();
+                messageSession->fromNodeID = nodeID;
+                messageSession->message = message;
+                messageSession->topic = topic;
+                insertMessageSession(message->seq(), messageSession);
             }
-            catch (std::exception& e)
-            {
-                LOG(ERROR) << "push message totaly failed:" << e.what();
-
-                message->setResult(REMOTE_CLIENT_PEER_UNAVAILBLE);
-                message->setType(0x31);
 
-                auto buffer = std::make_shared<bytes>();
-                message->encode(*buffer);
-                auto msg = make_shared<p2p::Message>();
-                msg->setBuffer(buffer);
-                msg->setProtocolID(dev::eth::ProtocolID::Topic);
-                msg->setPacketType(0u);
-                msg->setLength(p2p::Message::HEADER_LENGTH + msg->buffer()->size());
-                m_service->sendMessageByNodeID(it->second.fromNodeID, msg);
-            }
+            pushToSession(message->seq(), messageSession);
         }
         else if (message->type() == 0x31)
         {
-            if (it == _seq2MessageSession.end())
+            if (!messageSession)
             {
                 LOG(ERROR) << "error, not found session:" << message->seq();
                 return;
@@ -593,48 +543,33 @@ void ChannelRPCServer::onNodeChannelRequest(h512 nodeID, dev::channel::Message::
 
             if (message->result() != 0)
             {
-                LOG(DEBUG) << "message:" << message->seq() << " send to node" << it->second.toNodeID
+                LOG(DEBUG) << "message:" << message->seq() << " send to node" << nodeID
                            << "failed:" << message->result();
-                try
                 {
-                    it->second.failedNodeIDs.insert(it->second.toNodeID);
-                    auto buffer = std::make_shared<bytes>();
-                    it->second.message->encode(*buffer);
-                    auto msg = make_shared<p2p::Message>();
-                    msg->setBuffer(buffer);
-                    msg->setProtocolID(dev::eth::ProtocolID::Topic);
-                    msg->setPacketType(0u);
-                    msg->setLength(p2p::Message::HEADER_LENGTH + msg->buffer()->size());
-
-                    m_service->sendMessageByTopic(topic, msg);
-                }
-                catch (std::exception& e)
-                {
-                    LOG(ERROR) << "process node message failed:" << e.what();
-
-                    message->setType(0x31);
-                    message->setResult(REMOTE_PEER_UNAVAILIBLE);
-                    message->clearData();
-
-                    it->second.fromSession->asyncSendMessage(
-                        message, dev::channel::ChannelSession::CallbackType(), 0);
+                    std::lock_guard<std::mutex> lock(messageSession->mutex);
+                    /// the node has timed out already, the message is elsewhere
+                    if (messageSession->toNodeID != nodeID)
+                        return;
+                    messageSession->failedNodeIDs.insert(nodeID);
                 }
+                forwardToNode(message->seq(), messageSession);
             }
             else
             {
                 LOG(DEBUG) << "response seq:" << message->seq();
 
-                if (it->second.fromSession->actived())
+                if (!eraseMessageSession(message->seq(), messageSession))
+                    return;
+
+                if (messageSession->fromSession && messageSession->fromSession->actived())
                 {
-                    it->second.fromSession->asyncSendMessage(
+                    messageSession->fromSession->asyncSendMessage(
                         message, dev::channel::ChannelSession::CallbackType(), 0);
 
-                    LOG(DEBUG) << "response to seq[" << it->first << "] ["
-                               << it->second.fromSession->host() << ":"
-                               << it->second.fromSession->port() << "]success";
+                    LOG(DEBUG) << "response to seq[" << message->seq() << "] ["
+                               << messageSession->fromSession->host() << ":"
+                               << messageSession->fromSession->port() << "]success";
                 }
-
-                _seq2MessageSession.erase(it);
             }
         }
     }
@@ -852,42 +787,211 @@ std::string ChannelRPCServer::newSeq()
     return s;
 }
 
-dev::channel::ChannelSession::Ptr ChannelRPCServer::sendChannelMessageToSession(std::string topic,
-    dev::channel::Message::Ptr message, const std::set<dev::channel::ChannelSession::Ptr>& exclude)
+ChannelRPCServer::SeqMessageShard& ChannelRPCServer::seqMessageShard(std::string const& _seq)
 {
-    std::vector<dev::channel::ChannelSession::Ptr> activedSessions = getSessionByTopic(topic);
+    return _seq2MessageSession[std::hash<std::string>()(_seq) % c_seqMessageShards];
+}
 
-    for (auto sessionIt = activedSessions.begin(); sessionIt != activedSessions.end();)
+ChannelRPCServer::ChannelMessageSession::Ptr ChannelRPCServer::findMessageSession(
+    std::string const& _seq)
+{
+    auto& shard = seqMessageShard(_seq);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.sessions.find(_seq);
+    if (it == shard.sessions.end())
+        return nullptr;
+    return it->second;
+}
+
+void ChannelRPCServer::insertMessageSession(
+    std::string const& _seq, ChannelMessageSession::Ptr _session)
+{
+    ChannelMessageSession::Ptr replaced;
     {
-        if (exclude.find(*sessionIt) != exclude.end())
-        {
-            sessionIt = activedSessions.erase(sessionIt);
-        }
-        else
+        auto& shard = seqMessageShard(_seq);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto& session = shard.sessions[_seq];
+        replaced = session;
+        session = _session;
+    }
+    if (replaced)
+    {
+        LOG(WARNING) << "seq:" << _seq << " session repeat, overwrite";
+        finishMessageSession(replaced);
+    }
+}
+
+bool ChannelRPCServer::eraseMessageSession(
+    std::string const& _seq, ChannelMessageSession::Ptr _session)
+{
+    {
+        auto& shard = seqMessageShard(_seq);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.sessions.find(_seq);
+        if (it == shard.sessions.end() || it->second != _session)
+            return false;
+        shard.sessions.erase(it);
+    }
+    finishMessageSession(_session);
+    return true;
+}
+
+void ChannelRPCServer::finishMessageSession(ChannelMessageSession::Ptr _session)
+{
+    std::lock_guard<std::mutex> lock(_session->mutex);
+    ++_session->attempt;
+    if (_session->timer)
+    {
+        _session->timer->cancel();
+        _session->timer.reset();
+    }
+}
+
+void ChannelRPCServer::forwardToNode(std::string const& _seq, ChannelMessageSession::Ptr _session)
+{
+    NodeIDs nodeIDs = m_service->getPeersByTopic(_session->topic);
+    h512 nodeID;
+    uint32_t attempt = 0;
+    {
+        std::lock_guard<std::mutex> lock(_session->mutex);
+        nodeIDs.erase(
+            std::remove_if(nodeIDs.begin(), nodeIDs.end(),
+                [&](h512 const& _nodeID) { return _session->failedNodeIDs.count(_nodeID); }),
+            nodeIDs.end());
+        attempt = ++_session->attempt;
+        if (!nodeIDs.empty())
         {
-            ++sessionIt;
+            nodeID = nodeIDs[_nextTarget++ % nodeIDs.size()];
+            _session->toNodeID = nodeID;
         }
     }
 
-    if (activedSessions.empty())
+    if (nodeIDs.empty())
     {
-        LOG(ERROR) << "no session follow topic:" << topic;
-        throw dev::channel::ChannelException(104, "no session follow topic:" + topic);
+        if (!eraseMessageSession(_seq, _session))
+            return;
+        LOG(ERROR) << "no node follow topic:" << _session->topic << " seq:" << _seq;
+
+        auto message = _session->message;
+        message->setType(0x31);
+        message->setResult(REMOTE_PEER_UNAVAILIBLE);
+        message->clearData();
+        _session->fromSession->asyncSendMessage(
+            message, dev::channel::ChannelSession::CallbackType(), 0);
+        return;
     }
 
-    boost::mt19937 rng(static_cast<unsigned>(std::time(0)));
-    boost::uniform_int<int> index(0, activedSessions.size() - 1);
+    LOG(DEBUG) << "send to node:" << nodeID << " seq:" << _seq;
+    auto self = shared_from_this();
+    startTimer(_session, attempt, [self, _seq, _session, nodeID]() {
+        LOG(WARNING) << "seq:" << _seq << " node:" << nodeID << " timeout, try another";
+        {
+            std::lock_guard<std::mutex> lock(_session->mutex);
+            _session->failedNodeIDs.insert(nodeID);
+        }
+        self->forwardToNode(_seq, _session);
+    });
+    sendToNode(nodeID, _session->buffer);
+}
 
-    auto ri = index(rng);
-    LOG(DEBUG) << "random node:" << ri;
+void ChannelRPCServer::pushToSession(std::string const& _seq, ChannelMessageSession::Ptr _session)
+{
+    std::vector<dev::channel::ChannelSession::Ptr> activedSessions =
+        getSessionByTopic(_session->topic);
+    dev::channel::ChannelSession::Ptr session;
+    uint32_t attempt = 0;
+    {
+        std::lock_guard<std::mutex> lock(_session->mutex);
+        activedSessions.erase(
+            std::remove_if(activedSessions.begin(), activedSessions.end(),
+                [&](dev::channel::ChannelSession::Ptr const& _channelSession) {
+                    return _session->failedSessions.count(_channelSession);
+                }),
+            activedSessions.end());
+        attempt = ++_session->attempt;
+        if (!activedSessions.empty())
+        {
+            session = activedSessions[_nextTarget++ % activedSessions.size()];
+            _session->toSession = session;
+        }
+    }
 
-    auto session = activedSessions[ri];
+    if (!session)
+    {
+        if (!eraseMessageSession(_seq, _session))
+            return;
+        LOG(ERROR) << "push message totaly failed, no session follow topic:" << _session->topic;
+
+        auto message = _session->message;
+        message->setResult(REMOTE_CLIENT_PEER_UNAVAILBLE);
+        message->setType(0x31);
+        auto buffer = std::make_shared<bytes>();
+        message->encode(*buffer);
+        sendToNode(_session->fromNodeID, buffer);
+        return;
+    }
 
-    session->asyncSendMessage(message, dev::channel::ChannelSession::CallbackType(), 0);
+    auto self = shared_from_this();
+    startTimer(_session, attempt, [self, _seq, _session, session]() {
+        LOG(WARNING) << "seq:" << _seq << " push to " << session->host() << ":" << session->port()
+                     << " timeout, try another";
+        {
+            std::lock_guard<std::mutex> lock(_session->mutex);
+            _session->failedSessions.insert(session);
+        }
+        self->pushToSession(_seq, _session);
+    });
+    session->asyncSendMessage(_session->message, dev::channel::ChannelSession::CallbackType(), 0);
 
     LOG(DEBUG) << "push to session: " << session->host() << ":" << session->port() << " success";
+}
+
+void ChannelRPCServer::startTimer(ChannelMessageSession::Ptr _session, uint32_t _attempt,
+    std::function<void()> const& _onTimeout)
+{
+    auto ioService = _server ? _server->ioService() : nullptr;
+    if (!ioService || _messageTimeout == 0)
+        return;
+
+    auto timer = std::make_shared<boost::asio::deadline_timer>(
+        *ioService, boost::posix_time::milliseconds(_messageTimeout));
+    {
+        std::lock_guard<std::mutex> lock(_session->mutex);
+        /// answered before the timer is set
+        if (_session->attempt != _attempt)
+            return;
+        if (_session->timer)
+            _session->timer->cancel();
+        _session->timer = timer;
+    }
+    timer->async_wait([_session, _attempt, _onTimeout](const boost::system::error_code& error) {
+        if (error == boost::asio::error::operation_aborted)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(_session->mutex);
+            if (_session->attempt != _attempt)
+                return;
+        }
+        try
+        {
+            _onTimeout();
+        }
+        catch (std::exception& e)
+        {
+            LOG(ERROR) << "channel message timeout error:" << e.what();
+        }
+    });
+}
 
-    return session;
+void ChannelRPCServer::sendToNode(h512 const& _nodeID, std::shared_ptr<dev::bytes> _buffer)
+{
+    auto msg = make_shared<p2p::Message>();
+    msg->setBuffer(_buffer);
+    msg->setProtocolID(dev::eth::ProtocolID::Topic);
+    msg->setPacketType(0u);
+    msg->setLength(p2p::Message::HEADER_LENGTH + _buffer->size());
+    /// the answer comes back as a channel message of its own, nothing to wait for here
+    m_service->asyncSendMessageByNodeID(_nodeID, msg);
 }
 
 void ChannelRPCServer::updateHostTopics()
@@ -39,7 +39,12 @@
 #include <sys/types.h>
 #include <sys/un.h>
 #include <boost/asio.hpp>
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <queue>
+#include <set>
 #include <string>
 #include <thread>
 namespace dev
@@ -62,6 +67,8 @@ public:
 
     struct ChannelMessageSession
     {
+        typedef std::shared_ptr<ChannelMessageSession> Ptr;
+
         // When sending channelmessage
         dev::channel::ChannelSession::Ptr fromSession;
         h512 toNodeID;
@@ -74,6 +81,15 @@ public:
 
         // message
         dev::channel::Message::Ptr message;
+        std::string topic;
+        /// message encoded once for all the nodes tried
+        std::shared_ptr<dev::bytes> buffer;
+
+        /// bumped by every try and by the end of the session, a timeout of another try is stale
+        uint32_t attempt = 0;
+        std::shared_ptr<boost::asio::deadline_timer> timer;
+        /// guards toNodeID, failedNodeIDs, toSession, failedSessions, attempt and timer
+        std::mutex mutex;
     };
 
     typedef std::shared_ptr<ChannelRPCServer> Ptr;
@@ -135,12 +151,38 @@ public:
 
     virtual std::string newSeq();
 
+    /// milliseconds a node or an SDK has to answer a channel message before it goes to another
+    void setMessageTimeout(uint32_t _timeout) { _messageTimeout = _timeout; }
+
+    static const uint32_t c_defaultMessageTimeout = 2000;
+
 private:
+    /// the channel message sessions of the seqs hashed to it
+    struct SeqMessageShard
+    {
+        std::mutex mutex;
+        std::map<std::string, ChannelMessageSession::Ptr> sessions;
+    };
+
     void initSSLContext();
 
-    dev::channel::ChannelSession::Ptr sendChannelMessageToSession(std::string topic,
-        dev::channel::Message::Ptr message,
-        const std::set<dev::channel::ChannelSession::Ptr>& exclude);
+    SeqMessageShard& seqMessageShard(std::string const& _seq);
+    ChannelMessageSession::Ptr findMessageSession(std::string const& _seq);
+    /// a session already kept for _seq is replaced
+    void insertMessageSession(std::string const& _seq, ChannelMessageSession::Ptr _session);
+    /// false if _session is no longer the one of _seq: answered, failed or replaced meanwhile
+    bool eraseMessageSession(std::string const& _seq, ChannelMessageSession::Ptr _session);
+    /// stop the timer of a session taken out of the shards
+    void finishMessageSession(ChannelMessageSession::Ptr _session);
+
+    /// send the request of an SDK to a node following its topic that has not failed it yet
+    void forwardToNode(std::string const& _seq, ChannelMessageSession::Ptr _session);
+    /// push the request of a node to an SDK following its topic that has not failed it yet
+    void pushToSession(std::string const& _seq, ChannelMessageSession::Ptr _session);
+    /// call _onTimeout unless try _attempt of _session is answered within _messageTimeout
+    void startTimer(ChannelMessageSession::Ptr _session, uint32_t _attempt,
+        std::function<void()> const& _onTimeout);
+    void sendToNode(h512 const& _nodeID, std::shared_ptr<dev::bytes> _buffer);
 
     void updateHostTopics();
 
@@ -161,8 +203,13 @@ private:
     std::map<std::string, dev::channel::ChannelSession::Ptr> _seq2session;
     std::mutex _seqMutex;
 
-    std::map<std::string, ChannelMessageSession> _seq2MessageSession;
-    std::mutex _seqMessageMutex;
+    /// no lock is held while a channel message is encoded or sent, only its shard and its session
+    /// are locked to route it
+    static const size_t c_seqMessageShards = 16;
+    std::array<SeqMessageShard, c_seqMessageShards> _seq2MessageSession;
+    uint32_t _messageTimeout = c_defaultMessageTimeout;
+    /// spreads the messages of a topic over the nodes and the sessions following it
+    std::atomic<uint64_t> _nextTarget = {0};
 
     int _sessionCount = 1;
 
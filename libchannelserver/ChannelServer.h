@@ -72,6 +72,7 @@ public:
     {
         _ioService = ioService;
     };
+    std::shared_ptr<boost::asio::io_service> ioService() { return _ioService; }
     void setSSLContext(std::shared_ptr<boost::asio::ssl::context> sslContext)
     {
         _sslContext = sslContext;
@@ -23,6 +23,9 @@
 
 #include <libdevcore/Common.h>
 #include <libdevcore/easylog.h>
+#include <algorithm>
+#include <cstring>
+#include <future>
 #include <iostream>
 
 #include <boost/bind.hpp>
@@ -33,6 +36,8 @@
 
 using namespace dev::channel;
 
+const size_t ChannelSession::c_recvBufferSize;
+
 ChannelSession::ChannelSession()
 {
     _topics = std::make_shared<std::set<std::string> >();
@@ -42,43 +47,29 @@ Message::Ptr ChannelSession::sendMessage(Message::Ptr request, size_t timeout)
 {
     try
     {
-        class SessionCallback : public std::enable_shared_from_this<SessionCallback>
-        {
-        public:
-            typedef std::shared_ptr<SessionCallback> Ptr;
-
-            SessionCallback() { _mutex.lock(); }
-
-            void onResponse(dev::channel::ChannelException error, Message::Ptr message)
-            {
-                _error = error;
-                _response = message;
-
-                _mutex.unlock();
-            }
-
-            dev::channel::ChannelException _error;
-            Message::Ptr _response;
-            std::mutex _mutex;
-        };
-
-        SessionCallback::Ptr callback = std::make_shared<SessionCallback>();
-
-        std::function<void(dev::channel::ChannelException, Message::Ptr)> fp = std::bind(
-            &SessionCallback::onResponse, callback, std::placeholders::_1, std::placeholders::_2);
-        asyncSendMessage(request, fp, timeout);
-
-        callback->_mutex.lock();
-        callback->_mutex.unlock();
-
-        if (callback->_error.errorCode() != 0)
-        {
-            LOG(ERROR) << "asyncSendMessage ERROR:" << callback->_error.errorCode() << " "
-                       << callback->_error.what();
-            throw callback->_error;
-        }
+        auto promise = std::make_shared<std::promise<Message::Ptr> >();
+        std::future<Message::Ptr> response = promise->get_future();
+        asyncSendMessage(request,
+            [promise](dev::channel::ChannelException error, Message::Ptr message) {
+                try
+                {
+                    if (error.errorCode() != 0)
+                    {
+                        LOG(ERROR) << "asyncSendMessage ERROR:" << error.errorCode() << " "
+                                   << error.what();
+                        promise->set_exception(std::make_exception_ptr(error));
+                    }
+                    else
+                        promise->set_value(message);
+                }
+                catch (std::future_error&)
+                {
+                    /// a response racing its timeout, the first one is kept
+                }
+            },
+            timeout);
 
-        return callback->_response;
+        return response.get();
     }
     catch (std::exception& e)
     {
@@ -122,10 +113,12 @@ void ChannelSession::asyncSendMessage(Message::Ptr request,
 
                 responseCallback->timeoutHandler = timeoutHandler;
             }
+
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
             _responseCallbacks.insert(std::make_pair(request->seq(), responseCallback));
         }
 
-        std::shared_ptr<bytes> buffer = std::make_shared<bytes>();
+        std::shared_ptr<bytes> buffer = allocBuffer();
         request->encode(*buffer);
 
         writeBuffer(buffer);
@@ -169,14 +162,31 @@ void ChannelSession::startRead()
     {
         if (_actived)
         {
-            LOG(TRACE) << "Start read:" << bufferLength;
-
             std::lock_guard<std::recursive_mutex> lock(_mutex);
 
+            if (_recvBuffer.size() - _recvEnd < bufferLength)
+            {
+                if (_recvBegin > 0)
+                {
+                    std::memmove(
+                        _recvBuffer.data(), _recvBuffer.data() + _recvBegin, _recvEnd - _recvBegin);
+                    _recvEnd -= _recvBegin;
+                    _recvBegin = 0;
+                }
+                if (_recvBuffer.size() - _recvEnd < bufferLength)
+                {
+                    _recvBuffer.resize(std::max(_recvBuffer.size() * 2, c_recvBufferSize));
+                }
+            }
+
+            LOG(TRACE) << "Start read:" << _recvBuffer.size() - _recvEnd;
+
             auto session = shared_from_this();
+            auto buffer =
+                boost::asio::buffer(_recvBuffer.data() + _recvEnd, _recvBuffer.size() - _recvEnd);
             if (_enableSSL)
             {
-                _sslSocket->async_read_some(boost::asio::buffer(_recvBuffer, bufferLength),
+                _sslSocket->async_read_some(buffer,
                     [session](const boost::system::error_code& error, size_t bytesTransferred) {
                         auto s = session;
                         if (s)
@@ -187,8 +197,7 @@ void ChannelSession::startRead()
             }
             else
             {
-                _sslSocket->next_layer().async_read_some(
-                    boost::asio::buffer(_recvBuffer, bufferLength),
+                _sslSocket->next_layer().async_read_some(buffer,
                     [session](const boost::system::error_code& error, size_t bytesTransferred) {
                         auto s = session;
                         if (s)
@@ -226,17 +235,17 @@ void ChannelSession::onRead(const boost::system::error_code& error, size_t bytes
         if (!error)
         {
             LOG(TRACE) << "Read: " << bytesTransferred << " bytes data:"
-                       << std::string(_recvBuffer, _recvBuffer + bytesTransferred);
+                       << std::string(_recvBuffer.data() + _recvEnd,
+                              _recvBuffer.data() + _recvEnd + bytesTransferred);
 
-            _recvProtocolBuffer.insert(
-                _recvProtocolBuffer.end(), _recvBuffer, _recvBuffer + bytesTransferred);
+            _recvEnd += bytesTransferred;
 
             while (true)
             {
                 auto message = _messageFactory->buildMessage();
 
                 ssize_t result =
-                    message->decode(_recvProtocolBuffer.data(), _recvProtocolBuffer.size());
+                    message->decode(_recvBuffer.data() + _recvBegin, _recvEnd - _recvBegin);
                 LOG(TRACE) << "Parse result: " << result;
 
 
@@ -246,8 +255,11 @@ void ChannelSession::onRead(const boost::system::error_code& error, size_t bytes
 
                     onMessage(ChannelException(0, ""), message);
 
-                    _recvProtocolBuffer.erase(
-                        _recvProtocolBuffer.begin(), _recvProtocolBuffer.begin() + result);
+                    _recvBegin += result;
+                    if (_recvBegin == _recvEnd)
+                    {
+                        _recvBegin = _recvEnd = 0;
+                    }
                 }
                 else if (result == 0)
                 {
@@ -299,36 +311,62 @@ void ChannelSession::startWrite()
     {
         _writing = true;
 
-        auto buffer = _sendBufferList.front();
-        _sendBufferList.pop();
+        /// frames queued while the last write was in flight leave together
+        auto buffers = std::make_shared<std::vector<std::shared_ptr<bytes> > >();
+        size_t size = 0;
+        while (!_sendBufferList.empty() && buffers->size() < c_maxWriteFrames &&
+               (buffers->empty() || size + _sendBufferList.front()->size() <= c_maxWriteBytes))
+        {
+            size += _sendBufferList.front()->size();
+            buffers->push_back(_sendBufferList.front());
+            _sendBufferList.pop();
+        }
+
+        /// the ssl stream encrypts one buffer per record, so its frames are joined first
+        if (_enableSSL && buffers->size() > 1)
+        {
+            auto joined = allocBuffer();
+            joined->reserve(size);
+            for (auto const& buffer : *buffers)
+            {
+                joined->insert(joined->end(), buffer->begin(), buffer->end());
+                freeBuffer(buffer);
+            }
+            buffers->assign(1, joined);
+        }
 
         auto session = std::weak_ptr<ChannelSession>(shared_from_this());
 
-        _sslSocket->get_io_service().post([session, buffer] {
+        _sslSocket->get_io_service().post([session, buffers] {
             auto s = session.lock();
             if (s)
             {
+                std::vector<boost::asio::const_buffer> sequence;
+                sequence.reserve(buffers->size());
+                for (auto const& buffer : *buffers)
+                {
+                    sequence.push_back(boost::asio::buffer(buffer->data(), buffer->size()));
+                }
+
                 if (s->enableSSL())
                 {
-                    boost::asio::async_write(*s->sslSocket(),
-                        boost::asio::buffer(buffer->data(), buffer->size()),
+                    boost::asio::async_write(*s->sslSocket(), sequence,
                         [=](const boost::system::error_code& error, size_t bytesTransferred) {
                             auto s = session.lock();
                             if (s)
                             {
-                                s->onWrite(error, buffer, bytesTransferred);
+                                s->onWrite(error, buffers, bytesTransferred);
                             }
                         });
                 }
                 else
                 {
-                    boost::asio::async_write(s->sslSocket()->next_layer(),
-                        boost::asio::buffer(buffer->data(), buffer->size()),
+                    boost::asio::async_write(s->sslSocket()->next_layer(), sequence,
                         [=](const boost::system::error_code& error, size_t bytesTransferred) {
                             auto s = session.lock();
                             if (s)
                             {
-                                s->onWrite(error, buffer, bytesTransferred);
+                                s->onWrite(error, buffers, bytesTransferred);
                             }
                         });
                 }
@@ -357,8 +395,8 @@ void ChannelSession::writeBuffer(std::shared_ptr<bytes> buffer)
     }
 }
 
-void ChannelSession::onWrite(
-    const boost::system::error_code& error, std::shared_ptr<bytes> buffer, size_t bytesTransferred)
+void ChannelSession::onWrite(const boost::system::error_code& error,
+    std::shared_ptr<std::vector<std::shared_ptr<bytes> > > buffers, size_t bytesTransferred)
 {
     try
     {
@@ -375,7 +413,7 @@ void ChannelSession::onWrite(
 
         if (!error)
         {
-            LOG(TRACE) << "Write: " << bytesTransferred;
+            LOG(TRACE) << "Write: " << bytesTransferred << " frames: " << buffers->size();
         }
         else
         {
@@ -384,6 +422,11 @@ void ChannelSession::onWrite(
             disconnect(ChannelException(-1, "Write error, disconnect"));
         }
 
+        for (auto const& buffer : *buffers)
+        {
+            freeBuffer(buffer);
+        }
+
         _writing = false;
         startWrite();
     }
@@ -393,6 +436,31 @@ void ChannelSession::onWrite(
     }
 }
 
+std::shared_ptr<dev::bytes> ChannelSession::allocBuffer()
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    if (_freeBuffers.empty())
+    {
+        return std::make_shared<bytes>();
+    }
+
+    auto buffer = _freeBuffers.back();
+    _freeBuffers.pop_back();
+    return buffer;
+}
+
+void ChannelSession::freeBuffer(std::shared_ptr<bytes> buffer)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    if (_freeBuffers.size() < c_maxFreeBuffers && buffer->capacity() <= c_maxFreeBufferSize)
+    {
+        buffer->clear();
+        _freeBuffers.push_back(buffer);
+    }
+}
+
 void ChannelSession::onMessage(ChannelException e, Message::Ptr message)
 {
     try
@@ -404,26 +472,32 @@ void ChannelSession::onMessage(ChannelException e, Message::Ptr message)
             return;
         }
 
-        auto it = _responseCallbacks.find(message->seq());
-        if (it != _responseCallbacks.end())
+        /// senders insert concurrently, so the entry is taken out under the lock
+        ResponseCallback::Ptr responseCallback;
         {
-            if (it->second->timeoutHandler.get() != NULL)
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
+            auto it = _responseCallbacks.find(message->seq());
+            if (it != _responseCallbacks.end())
             {
-                it->second->timeoutHandler->cancel();
+                responseCallback = it->second;
+                _responseCallbacks.erase(it);
             }
+        }
 
-            if (it->second->callback)
+        if (responseCallback)
+        {
+            if (responseCallback->timeoutHandler.get() != NULL)
             {
-                _threadPool->enqueue([=]() {
-                    it->second->callback(e, message);
-                    _responseCallbacks.erase(it);
-                });
+                responseCallback->timeoutHandler->cancel();
+            }
+
+            if (responseCallback->callback)
+            {
+                _threadPool->enqueue([=]() { responseCallback->callback(e, message); });
             }
             else
             {
                 LOG(ERROR) << "Callback empty";
-
-                _responseCallbacks.erase(it);
             }
         }
         else
@@ -462,19 +536,33 @@ void ChannelSession::onTimeout(const boost::system::error_code& error, std::stri
             return;
         }
 
-        auto it = _responseCallbacks.find(seq);
-        if (it != _responseCallbacks.end())
+        if (error == boost::asio::error::operation_aborted)
+        {
+            return;
+        }
+
+        ResponseCallback::Ptr responseCallback;
+        {
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
+            auto it = _responseCallbacks.find(seq);
+            if (it != _responseCallbacks.end())
+            {
+                responseCallback = it->second;
+                _responseCallbacks.erase(it);
+            }
+        }
+
+        if (responseCallback)
         {
-            if (it->second->callback)
+            if (responseCallback->callback)
             {
-                it->second->callback(ChannelException(-2, "Response timeout"), Message::Ptr());
+                responseCallback->callback(
+                    ChannelException(-2, "Response timeout"), Message::Ptr());
             }
             else
             {
                 LOG(ERROR) << "Callback empty";
             }
-
-            _responseCallbacks.erase(it);
         }
         else
         {
@@ -28,6 +28,7 @@
 #include <queue>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <libdevcore/Common.h>
 #include <libdevcore/FixedHash.h>
@@ -109,10 +110,14 @@ private:
     void onRead(const boost::system::error_code& error, size_t bytesTransferred);
 
     void startWrite();
-    void onWrite(const boost::system::error_code& error, std::shared_ptr<bytes> buffer,
-        size_t bytesTransferred);
+    void onWrite(const boost::system::error_code& error,
+        std::shared_ptr<std::vector<std::shared_ptr<bytes> > > buffers, size_t bytesTransferred);
     void writeBuffer(std::shared_ptr<bytes> buffer);
 
+    /// an empty encode buffer, reusing the capacity of a written one when there is any
+    std::shared_ptr<bytes> allocBuffer();
+    void freeBuffer(std::shared_ptr<bytes> buffer);
+
     void onMessage(dev::channel::ChannelException e, Message::Ptr message);
     void onTimeout(const boost::system::error_code& error, std::string seq);
 
@@ -132,11 +137,25 @@ private:
     std::string _host;
     int _port = 0;
 
-    byte _recvBuffer[1024];
-    bytes _recvProtocolBuffer;
+    /// received data lives in [_recvBegin, _recvEnd), reads go straight to the space after it
+    /// and the unparsed tail is moved to the front only when that space runs short
+    bytes _recvBuffer;
+    size_t _recvBegin = 0;
+    size_t _recvEnd = 0;
 
     std::queue<std::shared_ptr<bytes> > _sendBufferList;
     bool _writing = false;
+    /// written buffers kept for the next encodes
+    std::vector<std::shared_ptr<bytes> > _freeBuffers;
+
+    /// initial size of _recvBuffer
+    static const size_t c_recvBufferSize = 64 * 1024;
+    /// frames queued meanwhile are written by one write of up to this many frames and bytes
+    static const size_t c_maxWriteFrames = 64;
+    static const size_t c_maxWriteBytes = 1024 * 1024;
+    /// pooled buffers, larger buffers are freed after their write
+    static const size_t c_maxFreeBuffers = 64;
+    static const size_t c_maxFreeBufferSize = 64 * 1024;
 
     std::shared_ptr<boost::asio::deadline_timer> _idleTimer;
     std::recursive_mutex _mutex;
@@ -47,8 +47,12 @@ enum NodeAccountType
 struct Sealing
 {
     dev::eth::Block block;
-    /// hash set for filter fetched transactions
-    h256Hash m_transactionSet;
+    /// transaction pool cursor after the fetched transactions
+    uint64_t m_txPoolCursor = 0;
+    /// predicted execution time of the fetched transactions, in microseconds
+    uint64_t m_predictedExecTime = 0;
+    /// a transaction was left out since the block would not execute within the budget
+    bool m_execTimeFull = false;
     dev::blockverifier::ExecutiveContext::Ptr p_execContext;
 };
 
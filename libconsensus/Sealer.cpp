@@ -37,6 +37,8 @@ namespace dev
 {
 namespace consensus
 {
+const uint64_t Sealer::c_maxWaitTime;
+
 /// start the Sealer module
 void Sealer::start()
 {
@@ -93,6 +95,7 @@ void Sealer::doWork(bool wait)
     reportNewBlock();
     if (shouldSeal())
     {
+        bool enough = true;
         DEV_WRITE_GUARDED(x_sealing)
         {
             /// get current transaction num
@@ -104,21 +107,28 @@ void Sealer::doWork(bool wait)
             if (m_syncTxPool.compare_exchange_strong(t, false) && !reachBlockIntervalTime())
                 loadTransactions(max_blockCanSeal - tx_num);
             /// check enough or reach block interval
-            if (!checkTxsEnough(max_blockCanSeal))
-            {
-                ///< 10 milliseconds to next loop
-                std::unique_lock<std::mutex> l(x_signalled);
-                m_signalled.wait_for(l, std::chrono::milliseconds(1));
-                return;
-            }
-            handleBlock();
+            enough = checkTxsEnough(max_blockCanSeal);
+            if (enough)
+                handleBlock();
+        }
+        /// sleep until new transactions arrive or the block interval ends
+        if (!enough)
+        {
+            uint64_t waitTime = std::min(timeToBlockInterval(), c_maxWaitTime);
+            waitSignal(std::max(waitTime, (uint64_t)1), true);
+            return;
         }
     }
     if (shouldWait(wait))
-    {
-        std::unique_lock<std::mutex> l(x_signalled);
-        m_signalled.wait_for(l, std::chrono::milliseconds(10));
-    }
+        waitSignal(c_maxWaitTime, false);
+}
+
+void Sealer::waitSignal(uint64_t _milliseconds, bool _wakeOnTransactions)
+{
+    std::unique_lock<std::mutex> l(x_signalled);
+    if (m_syncBlock || (_wakeOnTransactions && m_syncTxPool))
+        return;
+    m_signalled.wait_for(l, std::chrono::milliseconds(_milliseconds));
 }
 
 /**
@@ -127,9 +137,29 @@ void Sealer::doWork(bool wait)
  */
 void Sealer::loadTransactions(uint64_t const& transToFetch)
 {
-    /// fetch transactions and update m_transactionSet
-    m_sealing.block.appendTransactions(
-        m_txPool->topTransactions(transToFetch, m_sealing.m_transactionSet, true));
+    if (!m_costModel || !m_costModel->trained())
+    {
+        /// fetch transactions and move the pool cursor
+        m_sealing.block.appendTransactions(
+            m_txPool->topTransactionsSince(transToFetch, m_sealing.m_txPoolCursor));
+        return;
+    }
+    /// stop at the first transaction that would not execute within the budget
+    uint64_t budget = packTimeBudget();
+    size_t packed = m_sealing.block.getTransactionSize();
+    m_sealing.block.appendTransactions(m_txPool->topTransactionsSince(
+        transToFetch, m_sealing.m_txPoolCursor, [&](Transaction const& _tx) {
+            uint64_t cost = m_costModel->predict(_tx);
+            /// a block holds at least one transaction
+            if (packed > 0 && m_sealing.m_predictedExecTime + cost > budget)
+            {
+                m_sealing.m_execTimeFull = true;
+                return false;
+            }
+            m_sealing.m_predictedExecTime += cost;
+            packed++;
+            return true;
+        }));
 }
 
 /// check whether the blocksync module is syncing
@@ -142,7 +172,9 @@ bool Sealer::isBlockSyncing()
 void Sealer::resetSealingBlock(Sealing& sealing)
 {
     resetBlock(sealing.block);
-    sealing.m_transactionSet.clear();
+    sealing.m_txPoolCursor = 0;
+    sealing.m_predictedExecTime = 0;
+    sealing.m_execTimeFull = false;
     sealing.p_execContext = nullptr;
 }
 
@@ -29,12 +29,14 @@
 #pragma once
 #include "ConsensusEngineBase.h"
 #include <libblockchain/BlockChainInterface.h>
+#include <libblockverifier/ExecutionCostModel.h>
 #include <libdevcore/Worker.h>
 #include <libethcore/Block.h>
 #include <libethcore/Exceptions.h>
 #include <libsync/SyncInterface.h>
 #include <libtxpool/TxPool.h>
 #include <libtxpool/TxPoolInterface.h>
+#include <limits>
 namespace dev
 {
 namespace consensus
@@ -75,12 +77,12 @@ public:
     virtual void onTransactionQueueReady()
     {
         m_syncTxPool = true;
-        m_signalled.notify_all();
+        notifySealing();
     }
     virtual void onBlockChanged()
     {
         m_syncBlock = true;
-        m_signalled.notify_all();
+        notifySealing();
     }
 
     /// set the max number of transactions in a block
@@ -92,6 +94,11 @@ public:
     uint64_t maxBlockTransactions() const { return m_maxBlockTransactions; }
     void setExtraData(std::vector<bytes> const& _extra) { m_extraData = _extra; }
     std::vector<bytes> const& extraData() const { return m_extraData; }
+    /// pack blocks by the execution time _costModel predicts once it has learnt some
+    void setCostModel(dev::blockverifier::ExecutionCostModel::Ptr _costModel)
+    {
+        m_costModel = _costModel;
+    }
 
     bool inline shouldResetSealing()
     {
@@ -116,7 +123,8 @@ protected:
     virtual bool checkTxsEnough(uint64_t maxTxsCanSeal)
     {
         uint64_t tx_num = m_sealing.block.getTransactionSize();
-        bool enough = (tx_num >= maxTxsCanSeal) || reachBlockIntervalTime();
+        bool enough = (tx_num >= maxTxsCanSeal) || m_sealing.m_execTimeFull ||
+                      reachBlockIntervalTime();
         if (enough)
         {
             SEAL_LOG(DEBUG) << "[#checkTxsEnough] Tx enough: [txNum]: " << tx_num << std::endl;
@@ -126,10 +134,24 @@ protected:
     }
 
     virtual bool reachBlockIntervalTime() { return false; }
+    /// milliseconds until reachBlockIntervalTime() turns true
+    virtual uint64_t timeToBlockInterval() { return c_maxWaitTime; }
+    /// microseconds the transactions of the sealing block may take to execute
+    virtual uint64_t packTimeBudget() { return std::numeric_limits<uint64_t>::max(); }
     virtual void handleBlock() {}
     virtual void doWork(bool wait);
     void doWork() override { doWork(true); }
     bool isBlockSyncing();
+    /// wake the sealing thread, the flag of the event is set before
+    void notifySealing()
+    {
+        /// a waiter between checking the flags and waiting holds x_signalled
+        DEV_GUARDED(x_signalled) {}
+        m_signalled.notify_all();
+    }
+    /// sleep up to _milliseconds unless a block event, or a transaction event if
+    /// _wakeOnTransactions, is pending
+    void waitSignal(uint64_t _milliseconds, bool _wakeOnTransactions);
     inline void resetSealingBlock() { resetSealingBlock(m_sealing); }
     void resetSealingBlock(Sealing& sealing);
     void resetBlock(dev::eth::Block& block);
@@ -158,6 +180,8 @@ protected:
     mutable SharedMutex x_sealing;
     /// extra data
     std::vector<bytes> m_extraData;
+    /// predicts the execution time of the transactions to pack
+    dev::blockverifier::ExecutionCostModel::Ptr m_costModel;
 
     /// atomic value represents that whether is calling syncTransactionQueue now
     /// signal to notify all thread to work
@@ -176,6 +200,9 @@ protected:
     /// handler
     Handler<> m_tqReady;
     Handler<> m_blockSubmitted;
+
+    /// longest sleep of the sealing thread between events, in milliseconds
+    static const uint64_t c_maxWaitTime = 10;
 };
 }  // namespace consensus
 }  // namespace dev
@@ -316,7 +316,8 @@ bool PBFTEngine::broadcastMsg(unsigned const& packetType, std::string const& key
 {
     auto sessions = m_service->sessionInfosByProtocolID(m_protocolId);
     m_connectedNode = u256(sessions.size());
-    for (auto session : sessions)
+    NodeIDs nodeIdList;
+    for (auto const& session : sessions)
     {
         /// LOG(DEBUG) << "#### session id:" << session.nodeID;
         /// get node index of the miner from m_minerList failed ?
@@ -331,11 +332,13 @@ bool PBFTEngine::broadcastMsg(unsigned const& packetType, std::string const& key
         /// packet has been broadcasted?
         if (broadcastFilter(session.nodeID, packetType, key))
             continue;
-        /// send messages
-        m_service->asyncSendMessageByNodeID(
-            session.nodeID, transDataToMessage(data, packetType), nullptr);
+        nodeIdList.push_back(session.nodeID);
         broadcastMark(session.nodeID, packetType, key);
     }
+    /// send messages, encoded once for all the peers
+    if (!nodeIdList.empty())
+        m_service->asyncMulticastMessageByNodeIDList(
+            nodeIdList, transDataToMessage(data, packetType));
     return true;
 }
 
@@ -1031,6 +1034,18 @@ const std::string PBFTEngine::consensusStatus() const
     statusObj.push_back(json_spirit::Pair("leaderFailed", m_leaderFailed));
     statusObj.push_back(json_spirit::Pair("cfgErr", m_cfgErr));
     statusObj.push_back(json_spirit::Pair("omitEmptyBlock", m_omitEmptyBlock));
+    /// execution time predicted for the executed blocks against the measured one
+    if (m_costModel)
+    {
+        auto costStats = m_costModel->stats();
+        json_spirit::Object costObj;
+        costObj.push_back(json_spirit::Pair("blocks", costStats.blocks));
+        costObj.push_back(json_spirit::Pair("lastPredictedUs", costStats.lastPredicted));
+        costObj.push_back(json_spirit::Pair("lastActualUs", costStats.lastActual));
+        costObj.push_back(json_spirit::Pair("meanError", costStats.meanError));
+        costObj.push_back(json_spirit::Pair("keys", (uint64_t)costStats.keys));
+        statusObj.push_back(json_spirit::Pair("execCostModel", costObj));
+    }
     status.push_back(statusObj);
     /// get cache-related informations
     m_reqCache->getCacheConsensusStatus(status);
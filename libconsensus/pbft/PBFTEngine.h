@@ -26,6 +26,7 @@
 #include "PBFTMsgCache.h"
 #include "PBFTReqCache.h"
 #include "TimeManager.h"
+#include <libblockverifier/ExecutionCostModel.h>
 #include <libconsensus/ConsensusEngineBase.h>
 #include <libdevcore/FileSystem.h>
 #include <libdevcore/LevelDB.h>
@@ -85,12 +86,27 @@ public:
     {
         return (utcTime() - m_timeManager.m_lastConsensusTime) >= m_timeManager.m_intervalBlockTime;
     }
+    /// milliseconds until reachBlockIntervalTime turns true
+    uint64_t timeToBlockInterval()
+    {
+        uint64_t passed = utcTime() - m_timeManager.m_lastConsensusTime;
+        if (passed >= m_timeManager.m_intervalBlockTime)
+            return 0;
+        return m_timeManager.m_intervalBlockTime - passed;
+    }
     void rehandleCommitedPrepareCache(PrepareReq const& req);
     bool shouldSeal();
     uint64_t calculateMaxPackTxNum(uint64_t const maxTransactions)
     {
         return m_timeManager.calculateMaxPackTxNum(maxTransactions, m_view);
     }
+    /// milliseconds of the block interval left for executing the block being packed
+    uint64_t leftPackTime() { return m_timeManager.leftPackTime(m_view); }
+    /// report the predictions of _costModel in consensusStatus
+    void setCostModel(dev::blockverifier::ExecutionCostModel::Ptr _costModel)
+    {
+        m_costModel = _costModel;
+    }
     /// broadcast prepare message
     bool generatePrepare(dev::eth::Block const& block);
     /// update the context of PBFT after commit a block into the block-chain
@@ -412,6 +428,7 @@ protected:
     std::shared_ptr<PBFTBroadcastCache> m_broadCastCache;
     std::shared_ptr<PBFTReqCache> m_reqCache;
     TimeManager m_timeManager;
+    dev::blockverifier::ExecutionCostModel::Ptr m_costModel;
     PBFTMsgQueue m_msgQueue;
     mutable Mutex m_mutex;
 
@@ -28,9 +28,9 @@
 #include <libconsensus/pbft/Common.h>
 #include <libdevcore/Common.h>
 #include <libdevcore/FixedHash.h>
+#include <libdevcore/FlatHash.h>
 #include <libdevcore/Guards.h>
 #include <libdevcore/easylog.h>
-#include <unordered_map>
 namespace dev
 {
 namespace consensus
@@ -199,7 +199,7 @@ public:
 
 private:
     /// maps between node id and its broadcast cache
-    std::unordered_map<h512, std::shared_ptr<PBFTMsgCache>> m_broadCastKeyCache;
+    FlatHashMap<h512, std::shared_ptr<PBFTMsgCache>> m_broadCastKeyCache;
 };
 }  // namespace consensus
 }  // namespace dev
@@ -26,6 +26,7 @@
 #include <json_spirit/JsonSpiritHeaders.h>
 #include <libconsensus/pbft/Common.h>
 #include <libdevcore/CommonJS.h>
+#include <libdevcore/FlatHash.h>
 #include <libdevcore/easylog.h>
 #include <libethcore/Protocol.h>
 namespace dev
@@ -184,11 +185,11 @@ public:
     }
     void resetFuturePrepare() { m_futurePrepareCache = PrepareReq(); }
     /// complemented functions for UTs
-    std::unordered_map<h256, std::unordered_map<std::string, SignReq>>& mutableSignCache()
+    FlatHashMap<h256, std::unordered_map<std::string, SignReq>>& mutableSignCache()
     {
         return m_signCache;
     }
-    std::unordered_map<h256, std::unordered_map<std::string, CommitReq>>& mutableCommitCache()
+    FlatHashMap<h256, std::unordered_map<std::string, CommitReq>>& mutableCommitCache()
     {
         return m_commitCache;
     }
@@ -200,9 +201,9 @@ public:
 
 private:
     /// remove invalid requests cached in cache according to curretn block
-    template <typename T, typename U, typename S>
-    void inline removeInvalidEntryFromCache(dev::eth::BlockHeader const& highestBlockHeader,
-        std::unordered_map<T, std::unordered_map<U, S>>& cache)
+    template <typename T>
+    void inline removeInvalidEntryFromCache(
+        dev::eth::BlockHeader const& highestBlockHeader, T& cache)
     {
         for (auto it = cache.begin(); it != cache.end();)
         {
@@ -285,11 +286,11 @@ private:
     /// cache for raw prepare request
     PrepareReq m_rawPrepareCache;
     /// cache for signReq(maps between hash and sign requests)
-    std::unordered_map<h256, std::unordered_map<std::string, SignReq>> m_signCache;
+    FlatHashMap<h256, std::unordered_map<std::string, SignReq>> m_signCache;
     /// cache for received-viewChange requests(maps between view and view change requests)
     std::unordered_map<u256, std::unordered_map<u256, ViewChangeReq>> m_recvViewChangeReq;
     /// cache for commited requests(maps between hash and commited requests)
-    std::unordered_map<h256, std::unordered_map<std::string, CommitReq>> m_commitCache;
+    FlatHashMap<h256, std::unordered_map<std::string, CommitReq>> m_commitCache;
     /// cache for prepare request need to be backup and saved
     PrepareReq m_committedPrepareCache;
     /// cache for the future prepare cache
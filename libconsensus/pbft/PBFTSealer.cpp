@@ -79,6 +79,9 @@ bool PBFTSealer::shouldSeal()
 
 uint64_t PBFTSealer::calculateMaxPackTxNum()
 {
+    /// the cost model limits the block by its predicted execution time instead
+    if (m_costModel && m_costModel->trained())
+        return m_maxBlockTransactions;
     return m_pbftEngine->calculateMaxPackTxNum(m_maxBlockTransactions);
 }
 
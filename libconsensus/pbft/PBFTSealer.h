@@ -71,6 +71,8 @@ protected:
     {
         return m_pbftEngine->reachBlockIntervalTime();
     }
+    uint64_t timeToBlockInterval() override { return m_pbftEngine->timeToBlockInterval(); }
+    uint64_t packTimeBudget() override { return m_pbftEngine->leftPackTime() * 1000; }
     uint64_t calculateMaxPackTxNum() override;
 
 private:
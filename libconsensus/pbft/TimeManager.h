@@ -84,7 +84,8 @@ struct TimeManager
         }
     }
 
-    inline uint64_t calculateMaxPackTxNum(uint64_t defaultMaxTxNum, u256 const& view)
+    /// milliseconds of the block interval left for packing and executing the next block
+    inline uint64_t leftPackTime(u256 const& view)
     {
         auto last_exec_finish_time = m_lastExecFinishTime;
         unsigned passed_time = 0;
@@ -97,9 +98,15 @@ struct TimeManager
             else
                 passed_time = utcTime() - last_exec_finish_time;
         }
-        auto left_time = 0;
+        uint64_t left_time = 0;
         if (passed_time < m_intervalBlockTime)
             left_time = m_intervalBlockTime - passed_time;
+        return left_time;
+    }
+
+    inline uint64_t calculateMaxPackTxNum(uint64_t defaultMaxTxNum, u256 const& view)
+    {
+        uint64_t left_time = leftPackTime(view);
         uint64_t max_tx_num = defaultMaxTxNum;
         if (m_execTimePerTx != 0)
         {
@@ -0,0 +1,228 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief: logging for hot paths: levels checked before the arguments are evaluated, lines
+ * queued in per-thread rings and written to easylogging++ by a background thread
+ *
+ * @file AsyncLog.cpp
+ * @date 2018-12-20
+ */
+#include "AsyncLog.h"
+#include "easylog.h"
+#include <chrono>
+
+using namespace std;
+using namespace dev;
+
+namespace
+{
+/// the ring of the current thread, closed when the thread exits
+struct ThreadLogRing
+{
+    ~ThreadLogRing()
+    {
+        if (ring)
+            ring->closed = true;
+    }
+    shared_ptr<AsyncLogRing> ring;
+};
+thread_local ThreadLogRing t_logRing;
+}  // namespace
+
+AsyncLogRing::AsyncLogRing(size_t _capacity)
+{
+    size_t capacity = 1;
+    while (capacity < _capacity)
+        capacity <<= 1;
+    m_entries.resize(capacity);
+    m_mask = capacity - 1;
+}
+
+bool AsyncLogRing::push(AsyncLogEntry& _entry)
+{
+    size_t tail = m_tail.load(memory_order_relaxed);
+    if (tail - m_head.load(memory_order_acquire) > m_mask)
+        return false;
+    m_entries[tail & m_mask] = move(_entry);
+    m_tail.store(tail + 1, memory_order_release);
+    return true;
+}
+
+bool AsyncLogRing::pop(AsyncLogEntry& _entry)
+{
+    size_t head = m_head.load(memory_order_relaxed);
+    if (head == m_tail.load(memory_order_acquire))
+        return false;
+    _entry = move(m_entries[head & m_mask]);
+    m_head.store(head + 1, memory_order_release);
+    return true;
+}
+
+bool AsyncLogRing::empty() const
+{
+    return m_head.load(memory_order_acquire) == m_tail.load(memory_order_acquire);
+}
+
+/// everything until a configuration is loaded, easylogging++ still filters what it writes
+atomic<unsigned> AsyncLogger::s_enabledLevels{~0u};
+atomic<bool> AsyncLogger::s_destroyed{false};
+const size_t AsyncLogger::c_ringCapacity;
+const unsigned AsyncLogger::c_drainIntervalMs;
+
+AsyncLogger& AsyncLogger::instance()
+{
+    static AsyncLogger s_instance;
+    return s_instance;
+}
+
+AsyncLogger::AsyncLogger()
+{
+    loadEnabledLevels();
+    m_writer = thread([this]() { run(); });
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    {
+        lock_guard<mutex> l(x_signal);
+        m_stop = true;
+    }
+    m_signal.notify_all();
+    if (m_writer.joinable())
+        m_writer.join();
+    flush();
+    s_destroyed = true;
+}
+
+void AsyncLogger::loadEnabledLevels()
+{
+    el::Logger* logger = el::Loggers::getLogger(el::base::consts::kDefaultLoggerId, false);
+    if (!logger)
+        return;
+    unsigned mask = 0;
+    for (el::Level level : {el::Level::Trace, el::Level::Debug, el::Level::Info,
+             el::Level::Warning, el::Level::Error, el::Level::Fatal})
+    {
+        if (logger->typedConfigurations()->enabled(level))
+            mask |= (unsigned)level;
+    }
+    s_enabledLevels = mask;
+}
+
+void AsyncLogger::stamp(el::base::DefaultLogBuilder::Origin& _origin)
+{
+    /// the id of a thread never changes, its name is looked up when the line is written
+    thread_local string const t_threadId = el::base::threading::getCurrentThreadId();
+    el::base::utils::DateTime::gettimeofday(&_origin.time);
+    _origin.threadId = t_threadId;
+}
+
+void AsyncLogger::submit(AsyncLogEntry&& _entry)
+{
+    if (s_destroyed)
+        write(_entry);
+    else
+        instance().log(move(_entry));
+}
+
+void AsyncLogger::log(AsyncLogEntry&& _entry)
+{
+    if (!t_logRing.ring)
+    {
+        t_logRing.ring = make_shared<AsyncLogRing>(c_ringCapacity);
+        lock_guard<mutex> l(x_rings);
+        m_rings.push_back(t_logRing.ring);
+    }
+    if (!t_logRing.ring->push(_entry))
+        m_dropped++;
+}
+
+void AsyncLogger::flush()
+{
+    drain();
+}
+
+void AsyncLogger::run()
+{
+    pthread_setThreadName("asyncLog");
+    while (!m_stop)
+    {
+        if (drain())
+            continue;
+        unique_lock<mutex> l(x_signal);
+        m_signal.wait_for(
+            l, chrono::milliseconds(c_drainIntervalMs), [this]() { return m_stop.load(); });
+    }
+}
+
+bool AsyncLogger::drain()
+{
+    lock_guard<mutex> drainLock(x_drain);
+    vector<shared_ptr<AsyncLogRing>> rings;
+    {
+        lock_guard<mutex> l(x_rings);
+        /// rings of exited threads go once everything they hold is written
+        for (auto it = m_rings.begin(); it != m_rings.end();)
+        {
+            if ((*it)->closed && (*it)->empty())
+                it = m_rings.erase(it);
+            else
+                it++;
+        }
+        rings = m_rings;
+    }
+    bool written = false;
+    AsyncLogEntry entry;
+    for (auto const& ring : rings)
+    {
+        /// one ring at a time stays bounded, a busy thread cannot hold the others back
+        for (size_t i = 0; i < c_ringCapacity && ring->pop(entry); i++)
+        {
+            write(entry);
+            written = true;
+        }
+    }
+    uint64_t dropped = m_dropped;
+    if (dropped != m_reportedDropped)
+    {
+        LOG(WARNING) << "AsyncLogger dropped " << dropped - m_reportedDropped
+                     << " lines of threads logging faster than they are written";
+        m_reportedDropped = dropped;
+    }
+    return written;
+}
+
+void AsyncLogger::write(AsyncLogEntry const& _entry)
+{
+    el::base::DefaultLogBuilder::OriginScope origin(_entry.origin);
+    el::base::Writer(_entry.level, _entry.file, _entry.line, "")
+            .construct(1, el::base::consts::kDefaultLoggerId)
+        << _entry.message;
+}
+
+const int64_t LogRate::c_intervalMs;
+
+uint64_t LogRate::hit()
+{
+    m_events.fetch_add(1, memory_order_relaxed);
+    int64_t now = chrono::duration_cast<chrono::milliseconds>(
+        chrono::steady_clock::now().time_since_epoch())
+                      .count();
+    int64_t next = m_next.load(memory_order_relaxed);
+    if (now < next || !m_next.compare_exchange_strong(next, now + c_intervalMs))
+        return 0;
+    return m_events.exchange(0);
+}
@@ -0,0 +1,214 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief: logging for hot paths: levels checked before the arguments are evaluated, lines
+ * queued in per-thread rings and written to easylogging++ by a background thread
+ *
+ * @file AsyncLog.h
+ * @date 2018-12-20
+ */
+#pragma once
+
+#include "easylogging++.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+/// the levels ASYNC_LOG(LEVEL) takes, named as for LOG(LEVEL)
+namespace logLevel
+{
+static const el::Level TRACE = el::Level::Trace;
+static const el::Level DEBUG = el::Level::Debug;
+static const el::Level INFO = el::Level::Info;
+static const el::Level WARNING = el::Level::Warning;
+static const el::Level ERROR = el::Level::Error;
+static const el::Level FATAL = el::Level::Fatal;
+}  // namespace logLevel
+
+/// one line waiting to be written
+struct AsyncLogEntry
+{
+    el::Level level = el::Level::Info;
+    char const* file = "";
+    int line = 0;
+    std::string message;
+    /// when and on which thread the line was logged, written in place of the writer's
+    el::base::DefaultLogBuilder::Origin origin;
+};
+
+/// lock-free ring of log entries, pushed by the thread owning it and popped by the writer
+class AsyncLogRing
+{
+public:
+    explicit AsyncLogRing(size_t _capacity);
+
+    /// @returns false, leaving _entry as it is, when the ring is full
+    bool push(AsyncLogEntry& _entry);
+    bool pop(AsyncLogEntry& _entry);
+    bool empty() const;
+
+    /// set when the owning thread exits, the writer drops the ring once it is empty
+    std::atomic<bool> closed{false};
+
+private:
+    std::vector<AsyncLogEntry> m_entries;
+    size_t m_mask;
+    /// next entry to pop, only written by the writer
+    std::atomic<size_t> m_head{0};
+    /// next entry to push, only written by the owning thread
+    std::atomic<size_t> m_tail{0};
+};
+
+/**
+ * @brief writes the entries logged through ASYNC_LOG from a background thread, so that a
+ * logging thread only formats its message and never waits on the easylogging++ lock or the disk.
+ * A thread whose ring is full drops its lines, and the count of dropped lines is logged.
+ */
+class AsyncLogger
+{
+public:
+    static AsyncLogger& instance();
+    ~AsyncLogger();
+
+    /// whether ASYNC_LOG lines of _level are kept
+    static bool enabled(el::Level _level)
+    {
+        return (s_enabledLevels.load(std::memory_order_relaxed) & (unsigned)_level) != 0;
+    }
+    /// keep the levels in _mask, el::Level values or-ed together
+    static void setEnabledLevels(unsigned _mask) { s_enabledLevels = _mask; }
+    /// keep the levels enabled in the configuration of the default easylogging++ logger,
+    /// called whenever that configuration is loaded
+    static void loadEnabledLevels();
+    static unsigned enabledLevels() { return s_enabledLevels; }
+
+    /// set _origin to the current time and thread
+    static void stamp(el::base::DefaultLogBuilder::Origin& _origin);
+    /// queue _entry in the ring of the calling thread
+    static void submit(AsyncLogEntry&& _entry);
+    /// write out the entries queued so far
+    void flush();
+    uint64_t dropped() const { return m_dropped; }
+
+private:
+    AsyncLogger();
+    void log(AsyncLogEntry&& _entry);
+    void run();
+    /// @returns whether any entry was written
+    bool drain();
+    static void write(AsyncLogEntry const& _entry);
+
+    static std::atomic<unsigned> s_enabledLevels;
+    /// set once the instance is destroyed, later lines are written synchronously
+    static std::atomic<bool> s_destroyed;
+
+    std::mutex x_rings;
+    std::vector<std::shared_ptr<AsyncLogRing>> m_rings;
+    /// only one thread pops the rings at a time
+    std::mutex x_drain;
+    std::mutex x_signal;
+    std::condition_variable m_signal;
+    std::atomic<bool> m_stop{false};
+    std::atomic<uint64_t> m_dropped{0};
+    uint64_t m_reportedDropped = 0;
+    std::thread m_writer;
+
+    /// entries of each thread's ring
+    static const size_t c_ringCapacity = 4096;
+    /// longest wait of the writer between two drains
+    static const unsigned c_drainIntervalMs = 5;
+};
+
+/// one ASYNC_LOG line, formatted as it is streamed and queued when it goes out of scope
+class AsyncLogRecord
+{
+public:
+    AsyncLogRecord(el::Level _level, char const* _file, int _line)
+    {
+        m_entry.level = _level;
+        m_entry.file = _file;
+        m_entry.line = _line;
+        AsyncLogger::stamp(m_entry.origin);
+    }
+    ~AsyncLogRecord()
+    {
+        m_entry.message = m_stream.str();
+        AsyncLogger::submit(std::move(m_entry));
+    }
+
+    template <class T>
+    AsyncLogRecord& operator<<(T const& _value)
+    {
+        m_stream << _value;
+        return *this;
+    }
+    AsyncLogRecord& operator<<(std::ostream& (*_manipulator)(std::ostream&))
+    {
+        m_stream << _manipulator;
+        return *this;
+    }
+
+private:
+    AsyncLogEntry m_entry;
+    std::ostringstream m_stream;
+};
+
+/// lets one line of a log site through per interval, counting the events of the interval
+class LogRate
+{
+public:
+    /// @returns the events since the last line let through when this one is, 0 otherwise
+    uint64_t hit();
+
+private:
+    std::atomic<uint64_t> m_events{0};
+    /// steady clock milliseconds from which the next line goes through
+    std::atomic<int64_t> m_next{0};
+
+    static const int64_t c_intervalMs = 1000;
+};
+}  // namespace dev
+
+/// LOG(LEVEL) through the AsyncLogger; nothing after the macro is evaluated when LEVEL is off
+#define ASYNC_LOG(LEVEL)                                      \
+    if (!dev::AsyncLogger::enabled(dev::logLevel::LEVEL))     \
+    {                                                         \
+    }                                                         \
+    else                                                      \
+        dev::AsyncLogRecord(dev::logLevel::LEVEL, __FILE__, __LINE__)
+
+/// the LogRate of the call site
+#define ASYNC_LOG_RATE()                 \
+    []() -> dev::LogRate& {              \
+        static dev::LogRate s_logRate;   \
+        return s_logRate;                \
+    }()
+
+/// ASYNC_LOG(LEVEL) for the events of hot paths: at most one line a second per call site,
+/// prefixed with the number of events it stands for
+#define ASYNC_LOG_RATED(LEVEL)                                                                 \
+    for (uint64_t _logEvents =                                                                 \
+             dev::AsyncLogger::enabled(dev::logLevel::LEVEL) ? ASYNC_LOG_RATE().hit() : 0;     \
+         _logEvents; _logEvents = 0)                                                           \
+    dev::AsyncLogRecord(dev::logLevel::LEVEL, __FILE__, __LINE__) << "[" << _logEvents << "x] "
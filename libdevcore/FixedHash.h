@@ -24,10 +24,10 @@
 #pragma once
 
 #include "CommonData.h"
-#include <boost/functional/hash.hpp>
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <random>
 
 namespace dev
@@ -284,10 +284,26 @@ public:
 
     struct hash
     {
-        /// Make a hash of the object's data.
+        /// Make a hash of the object's data, folding it in a 64-bit word at a time.
         size_t operator()(FixedHash const& _value) const
         {
-            return boost::hash_range(_value.m_data.cbegin(), _value.m_data.cend());
+            uint64_t h = N;
+            unsigned i = 0;
+            for (; i + 8 <= N; i += 8)
+                h = (h ^ loadWord(_value.m_data.data() + i, 8)) * 0x9E3779B97F4A7C15ULL;
+            if (i < N)
+                h = (h ^ loadWord(_value.m_data.data() + i, N - i)) * 0x9E3779B97F4A7C15ULL;
+            /// fold the high bits the last bytes land in back into the low ones
+            h = (h ^ (h >> 32)) * 0x9E3779B97F4A7C15ULL;
+            return (size_t)(h ^ (h >> 29));
+        }
+
+    private:
+        static uint64_t loadWord(byte const* _data, unsigned _size)
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, _data, _size);
+            return word;
         }
     };
 
@@ -528,14 +544,6 @@ inline bool FixedHash<32>::operator==(FixedHash<32> const& _other) const
            (hash1[3] == hash2[3]);
 }
 
-/// Fast std::hash compatible hash function object for h256.
-template <>
-inline size_t FixedHash<32>::hash::operator()(FixedHash<32> const& value) const
-{
-    uint64_t const* data = reinterpret_cast<uint64_t const*>(value.data());
-    return boost::hash_range(data, data + 4);
-}
-
 /// Stream I/O for the FixedHash class.
 template <unsigned N>
 inline std::ostream& operator<<(std::ostream& _out, FixedHash<N> const& _h)
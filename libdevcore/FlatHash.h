@@ -0,0 +1,422 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief: open addressing hash map and set, for hot maps keyed by h256/h512
+ *
+ * @file FlatHash.h
+ * @date 2018-12-19
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace dev
+{
+namespace flat
+{
+/// key of a set element: the element itself
+struct SetKey
+{
+    template <class T>
+    static T const& get(T const& _value)
+    {
+        return _value;
+    }
+};
+
+/// key of a map element: the first of the pair
+struct MapKey
+{
+    template <class T>
+    static typename T::first_type const& get(T const& _value)
+    {
+        return _value.first;
+    }
+};
+
+/**
+ * @brief elements are stored in one array probed linearly from the slot of their hash, with a
+ * control byte per slot holding 7 bits of the hash, so a lookup compares keys only on a likely
+ * match and inserting allocates nothing unless the table grows.
+ *
+ * Erasing leaves a deleted mark instead of moving elements, so like std::unordered_map an erase
+ * invalidates iterators to the erased element only. Inserting invalidates all iterators when the
+ * table grows.
+ */
+template <class Value, class Key, class KeyOf, class Hash, class Equal>
+class FlatHashTable
+{
+public:
+    using key_type = Key;
+    using value_type = Value;
+    using size_type = size_t;
+    using hasher = Hash;
+    using key_equal = Equal;
+
+    template <bool Const>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, Value const*, Value*>::type;
+        using reference = typename std::conditional<Const, Value const&, Value&>::type;
+        using Table = typename std::conditional<Const, FlatHashTable const, FlatHashTable>::type;
+
+        Iterator() = default;
+        Iterator(Table* _table, size_t _index) : m_table(_table), m_index(_index) {}
+        /// an iterator converts to a const_iterator
+        template <bool C = Const, class = typename std::enable_if<C>::type>
+        Iterator(Iterator<false> const& _other) : m_table(_other.table()), m_index(_other.index())
+        {}
+
+        reference operator*() const { return m_table->slot(m_index); }
+        pointer operator->() const { return &m_table->slot(m_index); }
+        Iterator& operator++()
+        {
+            m_index = m_table->nextFull(m_index + 1);
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator ret = *this;
+            ++*this;
+            return ret;
+        }
+        template <bool C>
+        bool operator==(Iterator<C> const& _other) const
+        {
+            return m_index == _other.index();
+        }
+        template <bool C>
+        bool operator!=(Iterator<C> const& _other) const
+        {
+            return m_index != _other.index();
+        }
+
+        Table* table() const { return m_table; }
+        size_t index() const { return m_index; }
+
+    private:
+        Table* m_table = nullptr;
+        size_t m_index = 0;
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashTable() = default;
+    FlatHashTable(FlatHashTable const& _other) : m_hash(_other.m_hash), m_equal(_other.m_equal)
+    {
+        if (_other.m_size == 0)
+            return;
+        allocate(capacityFor(_other.m_size));
+        for (auto const& value : _other)
+            place(value);
+        m_size = _other.m_size;
+    }
+    FlatHashTable(FlatHashTable&& _other) { swap(_other); }
+    FlatHashTable& operator=(FlatHashTable _other)
+    {
+        swap(_other);
+        return *this;
+    }
+    ~FlatHashTable() { destroyAll(); }
+
+    void swap(FlatHashTable& _other)
+    {
+        std::swap(m_ctrl, _other.m_ctrl);
+        std::swap(m_slots, _other.m_slots);
+        std::swap(m_capacity, _other.m_capacity);
+        std::swap(m_shift, _other.m_shift);
+        std::swap(m_size, _other.m_size);
+        std::swap(m_deleted, _other.m_deleted);
+        std::swap(m_hash, _other.m_hash);
+        std::swap(m_equal, _other.m_equal);
+    }
+
+    iterator begin() { return iterator(this, nextFull(0)); }
+    iterator end() { return iterator(this, m_capacity); }
+    const_iterator begin() const { return const_iterator(this, nextFull(0)); }
+    const_iterator end() const { return const_iterator(this, m_capacity); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    /// slots allocated, elements and deleted marks stay below 7/8 of them
+    size_t capacity() const { return m_capacity; }
+
+    iterator find(Key const& _key) { return iterator(this, findIndex(_key)); }
+    const_iterator find(Key const& _key) const { return const_iterator(this, findIndex(_key)); }
+    size_t count(Key const& _key) const { return findIndex(_key) != m_capacity ? 1 : 0; }
+
+    std::pair<iterator, bool> insert(Value const& _value)
+    {
+        return emplaceKey(KeyOf::get(_value), _value);
+    }
+    std::pair<iterator, bool> insert(Value&& _value)
+    {
+        return emplaceKey(KeyOf::get(_value), std::move(_value));
+    }
+
+    /// @returns the iterator following _it
+    iterator erase(const_iterator _it)
+    {
+        eraseIndex(_it.index());
+        return iterator(this, nextFull(_it.index() + 1));
+    }
+    size_t erase(Key const& _key)
+    {
+        size_t index = findIndex(_key);
+        if (index == m_capacity)
+            return 0;
+        eraseIndex(index);
+        return 1;
+    }
+
+    /// remove all elements, keeping the slots allocated
+    void clear()
+    {
+        destroyAll();
+        if (m_capacity > 0)
+            std::memset(m_ctrl.get(), c_empty, m_capacity);
+        m_size = 0;
+        m_deleted = 0;
+    }
+
+    /// allocate for _count elements without growing again
+    void reserve(size_t _count)
+    {
+        size_t capacity = capacityFor(_count);
+        if (capacity > m_capacity)
+            rehash(capacity);
+    }
+
+protected:
+    /// construct the element of _key from _args unless _key is present
+    template <class... Args>
+    std::pair<iterator, bool> emplaceKey(Key const& _key, Args&&... _args)
+    {
+        uint64_t mixed = mix(m_hash(_key));
+        size_t free = m_capacity;
+        size_t index = probe(_key, mixed, free);
+        if (index != m_capacity)
+            return std::make_pair(iterator(this, index), false);
+        if ((m_size + m_deleted + 1) * 8 > m_capacity * 7)
+        {
+            /// grow by half of the elements, only dropping the deleted marks when they fill it
+            rehash(capacityFor(m_size + 1 + m_size / 2));
+            free = firstFree(mixed);
+        }
+        new (&m_slots[free]) Value(std::forward<Args>(_args)...);
+        if (m_ctrl[free] == c_deleted)
+            m_deleted--;
+        m_ctrl[free] = tag(mixed);
+        m_size++;
+        return std::make_pair(iterator(this, free), true);
+    }
+
+private:
+    using Slot = typename std::aligned_storage<sizeof(Value), alignof(Value)>::type;
+
+    /// control byte of a slot never used since the last rehash
+    static const int8_t c_empty = -128;
+    /// control byte of a slot whose element was erased; full slots hold their tag (0-127)
+    static const int8_t c_deleted = -2;
+    static const size_t c_minCapacity = 8;
+
+    /// spread the hash to the high bits the slot index is taken from
+    static uint64_t mix(size_t _hash) { return (uint64_t)_hash * 0x9E3779B97F4A7C15ULL; }
+    static int8_t tag(uint64_t _mixed) { return (int8_t)(_mixed & 0x7f); }
+    size_t home(uint64_t _mixed) const { return (size_t)(_mixed >> m_shift); }
+
+    static size_t capacityFor(size_t _count)
+    {
+        size_t capacity = c_minCapacity;
+        while (capacity * 7 < _count * 8)
+            capacity *= 2;
+        return capacity;
+    }
+
+    Value& slot(size_t _index) { return *reinterpret_cast<Value*>(&m_slots[_index]); }
+    Value const& slot(size_t _index) const
+    {
+        return *reinterpret_cast<Value const*>(&m_slots[_index]);
+    }
+
+    size_t nextFull(size_t _index) const
+    {
+        while (_index < m_capacity && m_ctrl[_index] < 0)
+            _index++;
+        return _index;
+    }
+
+    /// @returns the slot of _key or m_capacity, setting _free to the first slot it can go to
+    size_t probe(Key const& _key, uint64_t _mixed, size_t& _free) const
+    {
+        if (m_capacity == 0)
+            return m_capacity;
+        int8_t t = tag(_mixed);
+        for (size_t i = home(_mixed);; i = (i + 1) & (m_capacity - 1))
+        {
+            int8_t c = m_ctrl[i];
+            if (c == t && m_equal(KeyOf::get(slot(i)), _key))
+                return i;
+            if (c < 0 && _free == m_capacity)
+                _free = i;
+            if (c == c_empty)
+                return m_capacity;
+        }
+    }
+
+    size_t findIndex(Key const& _key) const
+    {
+        if (m_size == 0)
+            return m_capacity;
+        size_t free = m_capacity;
+        return probe(_key, mix(m_hash(_key)), free);
+    }
+
+    size_t firstFree(uint64_t _mixed) const
+    {
+        size_t i = home(_mixed);
+        while (m_ctrl[i] >= 0)
+            i = (i + 1) & (m_capacity - 1);
+        return i;
+    }
+
+    /// put an element known to be absent into the first free slot of its probe sequence
+    template <class V>
+    void place(V&& _value)
+    {
+        uint64_t mixed = mix(m_hash(KeyOf::get(_value)));
+        size_t index = firstFree(mixed);
+        new (&m_slots[index]) Value(std::forward<V>(_value));
+        m_ctrl[index] = tag(mixed);
+    }
+
+    void eraseIndex(size_t _index)
+    {
+        slot(_index).~Value();
+        /// no probe sequence goes on past a slot followed by an empty one
+        if (m_ctrl[(_index + 1) & (m_capacity - 1)] == c_empty)
+            m_ctrl[_index] = c_empty;
+        else
+        {
+            m_ctrl[_index] = c_deleted;
+            m_deleted++;
+        }
+        m_size--;
+    }
+
+    void allocate(size_t _capacity)
+    {
+        m_ctrl.reset(new int8_t[_capacity]);
+        std::memset(m_ctrl.get(), c_empty, _capacity);
+        m_slots.reset(new Slot[_capacity]);
+        m_capacity = _capacity;
+        m_shift = 64;
+        for (size_t i = _capacity; i > 1; i >>= 1)
+            m_shift--;
+        m_deleted = 0;
+    }
+
+    void rehash(size_t _capacity)
+    {
+        std::unique_ptr<int8_t[]> ctrl = std::move(m_ctrl);
+        std::unique_ptr<Slot[]> slots = std::move(m_slots);
+        size_t capacity = m_capacity;
+        allocate(_capacity);
+        for (size_t i = 0; i < capacity; i++)
+        {
+            if (ctrl[i] < 0)
+                continue;
+            Value& value = *reinterpret_cast<Value*>(&slots[i]);
+            place(std::move(value));
+            value.~Value();
+        }
+    }
+
+    void destroyAll()
+    {
+        if (std::is_trivially_destructible<Value>::value)
+            return;
+        for (size_t i = 0; i < m_capacity; i++)
+            if (m_ctrl[i] >= 0)
+                slot(i).~Value();
+    }
+
+    std::unique_ptr<int8_t[]> m_ctrl;
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_capacity = 0;
+    /// 64 - log2(m_capacity)
+    unsigned m_shift = 64;
+    size_t m_size = 0;
+    size_t m_deleted = 0;
+    Hash m_hash;
+    Equal m_equal;
+};
+}  // namespace flat
+
+/// open addressing replacement of std::unordered_map, see flat::FlatHashTable
+template <class Key, class T, class Hash = std::hash<Key>, class Equal = std::equal_to<Key>>
+class FlatHashMap
+  : public flat::FlatHashTable<std::pair<Key const, T>, Key, flat::MapKey, Hash, Equal>
+{
+    using Base = flat::FlatHashTable<std::pair<Key const, T>, Key, flat::MapKey, Hash, Equal>;
+
+public:
+    using mapped_type = T;
+    using typename Base::iterator;
+    using Base::insert;
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Key const& _key, Args&&... _args)
+    {
+        return this->emplaceKey(_key, std::piecewise_construct, std::forward_as_tuple(_key),
+            std::forward_as_tuple(std::forward<Args>(_args)...));
+    }
+    T& operator[](Key const& _key) { return emplace(_key).first->second; }
+};
+
+/// open addressing replacement of std::unordered_set, see flat::FlatHashTable
+template <class Key, class Hash = std::hash<Key>, class Equal = std::equal_to<Key>>
+class FlatHashSet : public flat::FlatHashTable<Key, Key, flat::SetKey, Hash, Equal>
+{
+    using Base = flat::FlatHashTable<Key, Key, flat::SetKey, Hash, Equal>;
+
+public:
+    using typename Base::iterator;
+    using Base::insert;
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... _args)
+    {
+        Key key(std::forward<Args>(_args)...);
+        return this->emplaceKey(key, std::move(key));
+    }
+};
+}  // namespace dev
@@ -0,0 +1,87 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief 4-lane Keccak-f[1600] on AVX2, built with -mavx2 (see CMakeLists.txt)
+ *
+ * @file KeccakAVX2.cpp
+ * @date 2018-12-03
+ */
+#include "KeccakLanes.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace
+{
+struct AVX2Ops
+{
+    typedef __m256i Word;
+    static Word xor2(Word _a, Word _b) { return _mm256_xor_si256(_a, _b); }
+    static Word xor3(Word _a, Word _b, Word _c)
+    {
+        return _mm256_xor_si256(_mm256_xor_si256(_a, _b), _c);
+    }
+    static Word chi(Word _a, Word _b, Word _c)
+    {
+        return _mm256_xor_si256(_a, _mm256_andnot_si256(_b, _c));
+    }
+    static Word rol(Word _a, unsigned _n)
+    {
+        return _mm256_or_si256(_mm256_sllv_epi64(_a, _mm256_set1_epi64x(_n)),
+            _mm256_srlv_epi64(_a, _mm256_set1_epi64x(64 - _n)));
+    }
+    static Word constant(uint64_t _v) { return _mm256_set1_epi64x((long long)_v); }
+};
+}  // namespace
+
+namespace dev
+{
+namespace keccak
+{
+bool hasKeccakf1600x4()
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+void keccakf1600x4(uint64_t* _states)
+{
+    __m256i a[25];
+    for (unsigned i = 0; i < 25; ++i)
+        a[i] = _mm256_loadu_si256((__m256i const*)(_states + i * 4));
+    lanes::permute<AVX2Ops>(a);
+    for (unsigned i = 0; i < 25; ++i)
+        _mm256_storeu_si256((__m256i*)(_states + i * 4), a[i]);
+}
+}  // namespace keccak
+}  // namespace dev
+
+#else
+
+namespace dev
+{
+namespace keccak
+{
+bool hasKeccakf1600x4()
+{
+    return false;
+}
+
+void keccakf1600x4(uint64_t*) {}
+}  // namespace keccak
+}  // namespace dev
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief 8-lane Keccak-f[1600] on AVX-512F, built with -mavx512f (see CMakeLists.txt)
+ *
+ * @file KeccakAVX512.cpp
+ * @date 2018-12-03
+ */
+#include "KeccakLanes.h"
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+namespace
+{
+struct AVX512Ops
+{
+    typedef __m512i Word;
+    static Word xor2(Word _a, Word _b) { return _mm512_xor_si512(_a, _b); }
+    /// 0x96: a ^ b ^ c
+    static Word xor3(Word _a, Word _b, Word _c) { return _mm512_ternarylogic_epi64(_a, _b, _c, 0x96); }
+    /// 0xd2: a ^ (~b & c)
+    static Word chi(Word _a, Word _b, Word _c) { return _mm512_ternarylogic_epi64(_a, _b, _c, 0xd2); }
+    /// the masked form avoids gcc's -Wuninitialized on _mm512_undefined_epi32
+    static Word rol(Word _a, unsigned _n)
+    {
+        return _mm512_mask_rolv_epi64(_a, 0xff, _a, _mm512_set1_epi64(_n));
+    }
+    static Word constant(uint64_t _v) { return _mm512_set1_epi64((long long)_v); }
+};
+}  // namespace
+
+namespace dev
+{
+namespace keccak
+{
+bool hasKeccakf1600x8()
+{
+    return __builtin_cpu_supports("avx512f");
+}
+
+void keccakf1600x8(uint64_t* _states)
+{
+    __m512i a[25];
+    for (unsigned i = 0; i < 25; ++i)
+        a[i] = _mm512_loadu_si512((void const*)(_states + i * 8));
+    lanes::permute<AVX512Ops>(a);
+    for (unsigned i = 0; i < 25; ++i)
+        _mm512_storeu_si512((void*)(_states + i * 8), a[i]);
+}
+}  // namespace keccak
+}  // namespace dev
+
+#else
+
+namespace dev
+{
+namespace keccak
+{
+bool hasKeccakf1600x8()
+{
+    return false;
+}
+
+void keccakf1600x8(uint64_t*) {}
+}  // namespace keccak
+}  // namespace dev
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief multi-lane Keccak-f[1600] kernels used by sha3Batch
+ *
+ * @file KeccakLanes.h
+ * @date 2018-12-03
+ *
+ * The kernels live in their own translation units (KeccakAVX2.cpp, KeccakAVX512.cpp) which are
+ * compiled with the matching instruction set enabled; callers must check hasKeccakf1600xN()
+ * before calling the kernel. This header is included by those units, so it must not pull in
+ * any other inline code.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace dev
+{
+namespace keccak
+{
+/// Interleaved layout: word i of state j lives at _states[i * Lanes + j].
+bool hasKeccakf1600x4();
+void keccakf1600x4(uint64_t* _states);
+
+bool hasKeccakf1600x8();
+void keccakf1600x8(uint64_t* _states);
+
+namespace lanes
+{
+static const unsigned c_rho[24] = {
+    1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44};
+static const unsigned c_pi[24] = {
+    10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1};
+static const uint64_t c_roundConstants[24] = {1ULL, 0x8082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x8aULL, 0x88ULL, 0x80008009ULL, 0x8000000aULL, 0x8000808bULL, 0x800000000000008bULL,
+    0x8000000000008089ULL, 0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x800aULL, 0x800000008000000aULL, 0x8000000080008081ULL, 0x8000000000008080ULL,
+    0x80000001ULL, 0x8000000080008008ULL};
+
+/**
+ * @brief Keccak-f[1600] over one vector register per state word.
+ *
+ * Ops supplies the vector type (Word) and xor2, xor3, chi (a ^ (~b & c)), rol and constant.
+ * Only instantiate with types from an anonymous namespace so the instantiation never
+ * leaks out of the instruction-set specific translation unit.
+ */
+template <class Ops>
+inline void permute(typename Ops::Word* _a)
+{
+    typedef typename Ops::Word Word;
+    Word c[5];
+    Word d[5];
+    for (unsigned round = 0; round < 24; ++round)
+    {
+        // Theta
+        for (unsigned x = 0; x < 5; ++x)
+            c[x] = Ops::xor3(Ops::xor3(_a[x], _a[x + 5], _a[x + 10]), _a[x + 15], _a[x + 20]);
+        for (unsigned x = 0; x < 5; ++x)
+            d[x] = Ops::xor2(c[(x + 4) % 5], Ops::rol(c[(x + 1) % 5], 1));
+        for (unsigned y = 0; y < 25; y += 5)
+            for (unsigned x = 0; x < 5; ++x)
+                _a[y + x] = Ops::xor2(_a[y + x], d[x]);
+        // Rho and pi
+        Word t = _a[1];
+        for (unsigned i = 0; i < 24; ++i)
+        {
+            Word b = _a[c_pi[i]];
+            _a[c_pi[i]] = Ops::rol(t, c_rho[i]);
+            t = b;
+        }
+        // Chi
+        for (unsigned y = 0; y < 25; y += 5)
+        {
+            for (unsigned x = 0; x < 5; ++x)
+                c[x] = _a[y + x];
+            for (unsigned x = 0; x < 5; ++x)
+                _a[y + x] = Ops::chi(c[x], c[(x + 1) % 5], c[(x + 2) % 5]);
+        }
+        // Iota
+        _a[0] = Ops::xor2(_a[0], Ops::constant(c_roundConstants[round]));
+    }
+}
+}  // namespace lanes
+}  // namespace keccak
+}  // namespace dev
@@ -20,7 +20,9 @@
  */
 
 #include "SHA3.h"
+#include "KeccakLanes.h"
 #include <libdevcore/easylog.h>
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
@@ -193,4 +195,99 @@ bool sha3(bytesConstRef _input, bytesRef o_output)
     return true;
 }
 
+namespace
+{
+/// keccak-256 absorbs 136 bytes per permutation
+size_t const c_keccakRate = 136;
+
+/// @returns the number of permutations needed to absorb @a _input including the padding block
+inline size_t keccakBlocks(bytesConstRef _input)
+{
+    return _input.size() / c_keccakRate + 1;
+}
+
+/// xor one rate block of @a _block into lane @a _lane of the interleaved states
+template <size_t Lanes>
+inline void absorbLane(uint64_t* _states, size_t _lane, byte const* _block)
+{
+    for (size_t w = 0; w < c_keccakRate / 8; ++w)
+    {
+        uint64_t word;
+        memcpy(&word, _block + w * 8, 8);
+        _states[w * Lanes + _lane] ^= word;
+    }
+}
+
+/// hash Lanes inputs that need the same number of permutations in lock step
+template <size_t Lanes>
+void sha3Lanes(bytesConstRef const* _inputs, size_t const* _order, size_t _blocks,
+    h256* o_outputs, void (*_permute)(uint64_t*))
+{
+    uint64_t states[25 * Lanes] = {0};
+    byte padded[c_keccakRate];
+    for (size_t b = 0; b < _blocks; ++b)
+    {
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            bytesConstRef input = _inputs[_order[lane]];
+            byte const* block = input.data() + b * c_keccakRate;
+            if (b + 1 < _blocks)
+            {
+                absorbLane<Lanes>(states, lane, block);
+                continue;
+            }
+            // last block: keccak padding, same as keccak::hash with delim 0x01
+            size_t remain = input.size() - b * c_keccakRate;
+            memset(padded, 0, c_keccakRate);
+            if (remain)
+                memcpy(padded, block, remain);
+            padded[remain] ^= 0x01;
+            padded[c_keccakRate - 1] ^= 0x80;
+            absorbLane<Lanes>(states, lane, padded);
+        }
+        _permute(states);
+    }
+    for (size_t lane = 0; lane < Lanes; ++lane)
+    {
+        byte* out = o_outputs[_order[lane]].data();
+        for (size_t w = 0; w < 4; ++w)
+            memcpy(out + w * 8, &states[w * Lanes + lane], 8);
+    }
+}
+}  // namespace
+
+void sha3Batch(bytesConstRef const* _inputs, size_t _count, h256* o_outputs)
+{
+    static bool const s_x8 = keccak::hasKeccakf1600x8();
+    static bool const s_x4 = keccak::hasKeccakf1600x4();
+    if (_count < 4 || !s_x4)
+    {
+        for (size_t i = 0; i < _count; ++i)
+            sha3(_inputs[i], o_outputs[i].ref());
+        return;
+    }
+    // group inputs of the same block count so that every lane of a kernel call finishes together
+    std::vector<std::pair<size_t, size_t>> blocksAndIndex(_count);
+    for (size_t i = 0; i < _count; ++i)
+        blocksAndIndex[i] = std::make_pair(keccakBlocks(_inputs[i]), i);
+    std::sort(blocksAndIndex.begin(), blocksAndIndex.end());
+    std::vector<size_t> order(_count);
+    for (size_t i = 0; i < _count; ++i)
+        order[i] = blocksAndIndex[i].second;
+    size_t i = 0;
+    while (i < _count)
+    {
+        size_t blocks = blocksAndIndex[i].first;
+        size_t end = i;
+        while (end < _count && blocksAndIndex[end].first == blocks)
+            ++end;
+        for (; s_x8 && end - i >= 8; i += 8)
+            sha3Lanes<8>(_inputs, &order[i], blocks, o_outputs, keccak::keccakf1600x8);
+        for (; end - i >= 4; i += 4)
+            sha3Lanes<4>(_inputs, &order[i], blocks, o_outputs, keccak::keccakf1600x4);
+        for (; i < end; ++i)
+            sha3(_inputs[order[i]], o_outputs[order[i]].ref());
+    }
+}
+
 }  // namespace dev
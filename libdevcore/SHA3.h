@@ -109,6 +109,18 @@ inline std::string sha3(std::string const& _input, bool _isNibbles)
     return asString((_isNibbles ? sha3(fromHex(_input)) : sha3(bytesConstRef(&_input))).asBytes());
 }
 
+/// Calculate SHA3-256 hashes of @a _count independent inputs, writing the hash of _inputs[i] to
+/// o_outputs[i]. Inputs are hashed several at a time with multi-lane SIMD Keccak kernels when the
+/// CPU supports them (AVX-512F: 8 lanes, AVX2: 4 lanes), otherwise one by one.
+void sha3Batch(bytesConstRef const* _inputs, size_t _count, h256* o_outputs);
+
+inline h256s sha3Batch(std::vector<bytesConstRef> const& _inputs)
+{
+    h256s ret(_inputs.size());
+    sha3Batch(_inputs.data(), _inputs.size(), ret.data());
+    return ret;
+}
+
 /// Calculate SHA3-256 MAC
 inline void sha3mac(bytesConstRef _secret, bytesConstRef _plain, bytesRef _output)
 {
@@ -64,17 +64,36 @@ void hash256rlp(HexMap const& _s, HexMap::const_iterator _begin, HexMap::const_i
             auto b = _begin;
             if (_preLen == b->first.size())
                 ++b;
+            // encode the children first so that those referenced by hash are hashed together
+            std::vector<bytes> children(16);
+            std::vector<bytesConstRef> hashedChildren;
             for (auto i = 0; i < 16; ++i)
             {
                 auto n = b;
                 for (; n != _end && n->first[_preLen] == i; ++n)
                 {
                 }
-                if (b == n)
+                if (b != n)
+                {
+                    RLPStream rlp;
+                    hash256rlp(_s, b, n, _preLen + 1, rlp);
+                    rlp.swapOut(children[i]);
+                    if (children[i].size() >= 32)
+                        hashedChildren.push_back(bytesConstRef(&children[i]));
+                }
+                b = n;
+            }
+            h256s childrenHash = sha3Batch(hashedChildren);
+            size_t hashIndex = 0;
+            for (auto const& child : children)
+            {
+                if (child.empty())
                     _rlp << "";
+                else if (child.size() < 32)
+                    // RECURSIVE RLP
+                    _rlp.appendRaw(child);
                 else
-                    hash256aux(_s, b, n, _preLen + 1, _rlp);
-                b = n;
+                    _rlp << childrenHash[hashIndex++];
             }
             if (_preLen == _begin->first.size())
                 _rlp << _begin->second;
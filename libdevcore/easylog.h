@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "AsyncLog.h"
 #include "Common.h"
 #include "CommonData.h"
 #include "CommonIO.h"
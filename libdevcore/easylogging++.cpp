@@ -2926,6 +2926,8 @@ void AsyncDispatchWorker::run(void)
 
 // DefaultLogBuilder
 
+thread_local const DefaultLogBuilder::Origin* DefaultLogBuilder::s_origin = nullptr;
+
 base::type::string_t DefaultLogBuilder::build(
     const LogMessage* logMessage, bool appendNewLine) const
 {
@@ -2944,14 +2946,18 @@ base::type::string_t DefaultLogBuilder::build(
     {
         // Thread ID
         base::utils::Str::replaceFirstWithEscape(logLine, base::consts::kThreadIdFormatSpecifier,
-            ELPP->getThreadName(base::threading::getCurrentThreadId()));
+            ELPP->getThreadName(
+                s_origin ? s_origin->threadId : base::threading::getCurrentThreadId()));
     }
     if (logFormat->hasFlag(base::FormatFlags::DateTime))
     {
         // DateTime
+        const base::SubsecondPrecision* ssPrec = &tc->subsecondPrecision(logMessage->level());
         base::utils::Str::replaceFirstWithEscape(logLine, base::consts::kDateTimeFormatSpecifier,
-            base::utils::DateTime::getDateTime(
-                logFormat->dateTimeFormat().c_str(), &tc->subsecondPrecision(logMessage->level())));
+            s_origin ? base::utils::DateTime::timevalToString(
+                           s_origin->time, logFormat->dateTimeFormat().c_str(), ssPrec) :
+                       base::utils::DateTime::getDateTime(
+                           logFormat->dateTimeFormat().c_str(), ssPrec));
     }
     if (logFormat->hasFlag(base::FormatFlags::Function))
     {
@@ -2954,6 +2954,29 @@ class DefaultLogBuilder : public LogBuilder
 {
 public:
     base::type::string_t build(const LogMessage* logMessage, bool appendNewLine) const;
+
+    // modify: lines queued by dev::AsyncLogger are written by its own thread, they keep the
+    // time and the thread they were logged at
+    /// @brief When and on which thread a line was logged
+    struct Origin
+    {
+        struct timeval time = {0, 0};
+        std::string threadId;
+    };
+    /// @brief Builds the lines of the current thread with origin in place of the current time
+    /// and thread while it is in scope
+    class OriginScope : base::NoCopy
+    {
+    public:
+        explicit OriginScope(const Origin& origin) : m_prior(s_origin) { s_origin = &origin; }
+        ~OriginScope(void) { s_origin = m_prior; }
+
+    private:
+        const Origin* m_prior;
+    };
+
+private:
+    static thread_local const Origin* s_origin;
 };
 /// @brief Dispatches log messages
 class LogDispatcher : base::NoCopy
@@ -24,6 +24,7 @@
 #include "Block.h"
 #include <libdevcore/Guards.h>
 #include <libdevcore/RLP.h>
+#include <libdevcore/SHA3.h>
 #include <libdevcore/easylog.h>
 namespace dev
 {
@@ -161,9 +162,19 @@ void Block::decode(bytesConstRef _block_bytes)
     /// get transaction list
     RLP transactions_rlp = block_rlp[1];
     m_transactions.resize(transactions_rlp.itemCount());
-    for (size_t i = 0; i < transactions_rlp.itemCount(); i++)
+    RLPs txsRlp = transactions_rlp.toList();
+    std::vector<bytesConstRef> txsData(txsRlp.size());
+    for (size_t i = 0; i < txsRlp.size(); i++)
     {
-        m_transactions[i].decode(transactions_rlp[i]);
+        txsData[i] = txsRlp[i].data();
+    }
+    /// hash all raw transactions together instead of re-encoding each one in Transaction::sha3,
+    /// the hashes also key the sender lookup so known transactions skip signature recovery;
+    /// Transaction::decode rejects a non-canonical encoding, whose raw hash is not its hash
+    h256s txsHash = sha3Batch(txsData);
+    for (size_t i = 0; i < txsRlp.size(); i++)
+    {
+        m_transactions[i].decode(txsRlp[i], CheckTransaction::Everything, txsHash[i]);
     }
     /// get transactionReceipt list
     RLP transactionReceipts_rlp = block_rlp[2];
@@ -0,0 +1,74 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : a block read in place from its RLP, the parts decoded when asked for
+ *
+ * @file BlockView.cpp
+ * @date 2018-12-25
+ */
+#include "BlockView.h"
+#include <libdevcore/SHA3.h>
+
+using namespace dev;
+using namespace dev::eth;
+
+BlockView::BlockView(std::shared_ptr<bytes const> _data, bytesConstRef _block)
+  : m_data(_data), m_rlp(BlockHeader::extractBlock(_block))
+{}
+
+BlockHeader const& BlockView::header() const
+{
+    if (!m_header)
+        m_header = std::make_shared<BlockHeader>(m_rlp[0].data(), HeaderData);
+    return *m_header;
+}
+
+TransactionView BlockView::transaction(size_t _index) const
+{
+    return TransactionView(m_data, m_rlp[1][_index].data());
+}
+
+TransactionViews BlockView::transactions() const
+{
+    RLPs txsRlp = m_rlp[1].toList();
+    std::vector<bytesConstRef> txsData(txsRlp.size());
+    for (size_t i = 0; i < txsRlp.size(); i++)
+        txsData[i] = txsRlp[i].data();
+    h256s txsHash = sha3Batch(txsData);
+
+    TransactionViews views;
+    views.reserve(txsRlp.size());
+    for (size_t i = 0; i < txsRlp.size(); i++)
+        views.emplace_back(m_data, txsData[i], txsHash[i]);
+    return views;
+}
+
+h256s BlockView::transactionHashes() const
+{
+    std::vector<bytesConstRef> txsData;
+    txsData.reserve(transactionCount());
+    for (auto const& tx : m_rlp[1])
+        txsData.push_back(tx.data());
+    return sha3Batch(txsData);
+}
+
+TransactionReceipt BlockView::receipt(size_t _index) const
+{
+    TransactionReceipt receipt;
+    receipt.decode(m_rlp[2][_index]);
+    return receipt;
+}
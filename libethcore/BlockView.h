@@ -0,0 +1,80 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : a block read in place from its RLP, the parts decoded when asked for
+ *
+ * @file BlockView.h
+ * @date 2018-12-25
+ */
+#pragma once
+#include "Block.h"
+#include "BlockHeader.h"
+#include "TransactionReceipt.h"
+#include "TransactionView.h"
+#include <libdevcore/RLP.h>
+#include <memory>
+
+namespace dev
+{
+namespace eth
+{
+/**
+ * @brief Keeps the buffer the block RLP lives in alive, a stored block or a whole sync packet,
+ * and decodes only what is asked for: the header, one transaction or receipt, the transaction
+ * hashes. Transactions are handed out as TransactionViews sharing the buffer. toBlock() decodes
+ * the whole block as Block::decode does.
+ * Like Block, a view caches its header without a lock, one thread at a time.
+ */
+class BlockView
+{
+public:
+    typedef std::shared_ptr<BlockView> Ptr;
+
+    /// _block is the block RLP within the bytes of _data
+    /// @throws InvalidBlockFormat if _block is not a list of a header and transactions
+    BlockView(std::shared_ptr<bytes const> _data, bytesConstRef _block);
+    explicit BlockView(std::shared_ptr<bytes const> _block) : BlockView(_block, ref(*_block)) {}
+
+    /// the header, decoded on first use
+    BlockHeader const& header() const;
+    int64_t number() const { return header().number(); }
+    h256 hash() const { return header().hash(); }
+
+    size_t transactionCount() const { return m_rlp[1].itemCount(); }
+    /// @throws if there is no transaction _index
+    TransactionView transaction(size_t _index) const;
+    /// all transactions, hashed together
+    TransactionViews transactions() const;
+    /// sha3 of each transaction RLP, hashed together without decoding any transaction
+    h256s transactionHashes() const;
+
+    size_t receiptCount() const { return m_rlp[2].itemCount(); }
+    TransactionReceipt receipt(size_t _index) const;
+
+    /// the block RLP, within the buffer of the view
+    bytesConstRef rlp() const { return m_rlp.data(); }
+    /// decode the whole block, straight from the buffer of the view
+    std::shared_ptr<Block> toBlock() const { return std::make_shared<Block>(m_rlp.data()); }
+
+private:
+    std::shared_ptr<bytes const> m_data;
+    RLP m_rlp;
+    mutable std::shared_ptr<BlockHeader> m_header;
+};
+
+}  // namespace eth
+}  // namespace dev
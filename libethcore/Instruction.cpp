@@ -218,6 +218,11 @@ static const std::map<Instruction, InstructionInfo> c_instructionInfo = {
     {Instruction::PUSHC, {"PUSHC", 0, 1, Tier::VeryLow}},
     {Instruction::JUMPC, {"JUMPC", 1, 0, Tier::Mid}},
     {Instruction::JUMPCI, {"JUMPCI", 2, 0, Tier::High}},
+    {Instruction::PUSHJUMP, {"PUSHJUMP", 0, 0, Tier::Special}},
+    {Instruction::PUSHJUMPI, {"PUSHJUMPI", 1, 0, Tier::Special}},
+    {Instruction::PUSHADD, {"PUSHADD", 1, 1, Tier::Special}},
+    {Instruction::PUSHMSTORE, {"PUSHMSTORE", 1, 0, Tier::Special}},
+    {Instruction::DUPSWAP, {"DUPSWAP", 0, 1, Tier::Special}},
 };
 
 InstructionInfo instructionInfo(Instruction _inst)
@@ -173,9 +173,14 @@ enum class Instruction : uint8_t
     LOG4,         ///< Makes a log entry; 4 topics.
 
     // these are generated by the interpreter - should never be in user code
-    PUSHC = 0xac,  ///< push value from constant pool
-    JUMPC,         ///< alter the program counter - pre-verified
-    JUMPCI,        ///< conditionally alter the program counter - pre-verified
+    PUSHJUMP = 0xa5,  ///< PUSHn followed by JUMP
+    PUSHJUMPI,        ///< PUSHn followed by JUMPI
+    PUSHADD,          ///< PUSHn followed by ADD
+    PUSHMSTORE,       ///< PUSHn followed by MSTORE
+    DUPSWAP,          ///< DUPn followed by SWAPm
+    PUSHC = 0xac,     ///< push value from constant pool
+    JUMPC,            ///< alter the program counter - pre-verified
+    JUMPCI,           ///< conditionally alter the program counter - pre-verified
 
     JUMPTO = 0xb0,  ///< alter the program counter to a jumpdest
     JUMPIF,         ///< conditionally alter the program counter
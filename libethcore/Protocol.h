@@ -42,6 +42,10 @@ enum ProtocolID
     TxPool = 10
 };
 
+/// first byte of the BlockSync messages that gossip transactions, c_syncPacketIDBase plus
+/// TransactionsPacket in libsync
+static uint8_t const c_syncTransactionsPacketID = 0x02;
+
 enum ExtraIndex
 {
     PBFTExtraData = 0,
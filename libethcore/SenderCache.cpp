@@ -0,0 +1,95 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : node-wide cache of recovered transaction senders
+ *
+ * @file SenderCache.cpp
+ * @date 2018-12-04
+ */
+#include "SenderCache.h"
+
+namespace dev
+{
+namespace eth
+{
+SenderCache& SenderCache::instance()
+{
+    static SenderCache s_cache;
+    return s_cache;
+}
+
+SenderCache::SenderCache(size_t _capacity)
+  : m_generationSize(std::max<size_t>(1, _capacity / c_shardCount / 2))
+{}
+
+bool SenderCache::get(h256 const& _txHash, Address& o_sender)
+{
+    Shard& s = shard(_txHash);
+    Guard l(s.lock);
+    auto it = s.current.find(_txHash);
+    if (it != s.current.end())
+    {
+        o_sender = it->second;
+        return true;
+    }
+    it = s.previous.find(_txHash);
+    if (it == s.previous.end())
+        return false;
+    o_sender = it->second;
+    /// keep the entry alive across the next generation switch
+    if (s.current.size() < m_generationSize)
+    {
+        s.current.insert(*it);
+        s.previous.erase(it);
+    }
+    return true;
+}
+
+void SenderCache::insert(h256 const& _txHash, Address const& _sender)
+{
+    Shard& s = shard(_txHash);
+    Guard l(s.lock);
+    if (s.current.size() >= m_generationSize)
+    {
+        s.previous.clear();
+        s.previous.swap(s.current);
+    }
+    s.current[_txHash] = _sender;
+}
+
+size_t SenderCache::size() const
+{
+    size_t ret = 0;
+    for (auto const& s : m_shards)
+    {
+        Guard l(s.lock);
+        ret += s.current.size() + s.previous.size();
+    }
+    return ret;
+}
+
+void SenderCache::clear()
+{
+    for (auto& s : m_shards)
+    {
+        Guard l(s.lock);
+        s.current.clear();
+        s.previous.clear();
+    }
+}
+}  // namespace eth
+}  // namespace dev
@@ -0,0 +1,76 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : node-wide cache of recovered transaction senders
+ *
+ * @file SenderCache.h
+ * @date 2018-12-04
+ */
+#pragma once
+#include <libdevcore/Address.h>
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/Guards.h>
+#include <array>
+#include <unordered_map>
+
+namespace dev
+{
+namespace eth
+{
+/**
+ * @brief maps the hash of a signed transaction's raw RLP to the sender recovered from it
+ *
+ * The same transaction is decoded by the pool (RPC/gossip), by every prepare-request and sync
+ * block that contains it and by block reads from storage; each decode used to pay an ECDSA
+ * recovery. The raw RLP determines both the signature and the signed payload, so its hash is
+ * a safe key for the sender.
+ *
+ * Bounded: each shard keeps two generations and drops the older one when the current one is
+ * full, so at most `capacity` entries are kept and recently used entries survive.
+ */
+class SenderCache
+{
+public:
+    static SenderCache& instance();
+
+    explicit SenderCache(size_t _capacity = c_defaultCapacity);
+
+    /// @returns true and sets o_sender if the sender of _txHash is cached
+    bool get(h256 const& _txHash, Address& o_sender);
+    void insert(h256 const& _txHash, Address const& _sender);
+
+    size_t size() const;
+    void clear();
+
+    static size_t const c_defaultCapacity = 200000;
+
+private:
+    struct Shard
+    {
+        mutable Mutex lock;
+        std::unordered_map<h256, Address> current;
+        std::unordered_map<h256, Address> previous;
+    };
+    static size_t const c_shardCount = 16;
+
+    Shard& shard(h256 const& _txHash) { return m_shards[_txHash[0] % c_shardCount]; }
+
+    size_t m_generationSize;
+    std::array<Shard, c_shardCount> m_shards;
+};
+}  // namespace eth
+}  // namespace dev
@@ -21,6 +21,7 @@
 
 #include "Transaction.h"
 #include "EVMSchedule.h"
+#include "SenderCache.h"
 #include <libdevcore/vector_ref.h>
 #include <libdevcrypto/Common.h>
 #include <libethcore/Exceptions.h>
@@ -42,11 +43,21 @@ void Transaction::decode(bytesConstRef tx_bytes, CheckTransaction _checkSig)
 
 void Transaction::decode(RLP const& rlp, CheckTransaction _checkSig)
 {
+    decode(rlp, _checkSig, h256());
+}
+
+void Transaction::decode(RLP const& rlp, CheckTransaction _checkSig, h256 const& _rlpHash)
+{
+    m_sender = Address();
+    m_hashWith = h256();
     try
     {
         if (!rlp.isList())
             BOOST_THROW_EXCEPTION(
                 InvalidTransactionFormat() << errinfo_comment("transaction RLP must be a list"));
+        if (rlp.itemCount() != 10)
+            BOOST_THROW_EXCEPTION(InvalidTransactionFormat()
+                                  << errinfo_comment("transaction RLP must have 10 fields"));
 
         m_nonce = rlp[0].toInt<u256>();
         m_gasPrice = rlp[1].toInt<u256>();
@@ -74,8 +85,25 @@ void Transaction::decode(RLP const& rlp, CheckTransaction _checkSig)
         if (_checkSig >= CheckTransaction::Cheap && !m_vrs->isValid())
             BOOST_THROW_EXCEPTION(InvalidSignature());
 
+        /// the hash of the raw rlp is the transaction hash with signature only for the canonical
+        /// encoding, otherwise the transaction is keyed by a hash its re-encoding in a block
+        /// does not have
+        if ((_rlpHash || _checkSig == CheckTransaction::Everything) &&
+            !rlp.data().contentsEqual(this->rlp()))
+            BOOST_THROW_EXCEPTION(InconsistentTransactionSha3()
+                                  << errinfo_comment("transaction RLP is not canonical"));
+        m_hashWith = _rlpHash;
+
         if (_checkSig == CheckTransaction::Everything)
-            m_sender = sender();
+        {
+            if (!m_hashWith)
+                m_hashWith = dev::sha3(rlp.data());
+            if (!SenderCache::instance().get(m_hashWith, m_sender))
+            {
+                m_sender = sender();
+                SenderCache::instance().insert(m_hashWith, m_sender);
+            }
+        }
     }
     catch (Exception& _e)
     {
@@ -182,3 +210,12 @@ h256 Transaction::sha3(IncludeSignature _sig) const
         m_hashWith = ret;
     return ret;
 }
+
+h256 Transaction::nonceDigest() const
+{
+    byte buf[Address::size + 32];
+    safeSender().ref().copyTo(bytesRef(buf, Address::size));
+    bytesRef nonce(buf + Address::size, 32);
+    toBigEndian(m_nonce, nonce);
+    return dev::sha3(bytesConstRef(buf, sizeof(buf)));
+}
@@ -128,6 +128,9 @@ public:
     void encode(bytes& _trans, IncludeSignature _sig = WithSignature) const;
     void decode(bytesConstRef tx_bytes, CheckTransaction _checkSig = CheckTransaction::Everything);
     void decode(RLP const& rlp, CheckTransaction _checkSig = CheckTransaction::Everything);
+    /// @param _rlpHash : sha3 of rlp.data() if the caller has already computed it (e.g. with
+    /// sha3Batch over a whole block), it keys the sender lookup in SenderCache
+    void decode(RLP const& rlp, CheckTransaction _checkSig, h256 const& _rlpHash);
     /// @returns the RLP serialisation of this transaction.
     bytes rlp(IncludeSignature _sig = WithSignature) const
     {
@@ -167,6 +170,9 @@ public:
     /// @returns the transaction-count of the sender.
     u256 nonce() const { return m_nonce; }
 
+    /// @returns the fixed-size key of the (sender, nonce) pair, as indexed by NonceCheck.
+    h256 nonceDigest() const;
+
     /// Sets the nonce to the given value. Clears any signature.
     void setNonce(u256 const& _n)
     {
@@ -0,0 +1,62 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : a transaction read in place from its RLP, the fields decoded when asked for
+ *
+ * @file TransactionView.cpp
+ * @date 2018-12-25
+ */
+#include "TransactionView.h"
+#include "SenderCache.h"
+#include <libdevcore/SHA3.h>
+
+using namespace dev;
+using namespace dev::eth;
+
+TransactionView::TransactionView(
+    std::shared_ptr<bytes const> _data, bytesConstRef _tx, h256 const& _hash)
+  : m_data(_data), m_rlp(_tx), m_hash(_hash)
+{
+    /// the checks Transaction::decode starts with, the fields themselves are read on demand
+    if (!m_rlp.isList() || m_rlp.itemCount() < 10)
+        BOOST_THROW_EXCEPTION(InvalidTransactionFormat() << errinfo_comment(
+                                  "transaction RLP must be a list of 10 fields"));
+    if (!m_rlp[6].isData())
+        BOOST_THROW_EXCEPTION(InvalidTransactionFormat()
+                              << errinfo_comment("transaction data RLP must be an array"));
+}
+
+h256 const& TransactionView::hash() const
+{
+    if (!m_hash)
+        m_hash = sha3(m_rlp.data());
+    return m_hash;
+}
+
+Address const& TransactionView::sender() const
+{
+    if (!m_sender && !SenderCache::instance().get(hash(), m_sender))
+        m_sender = toTransaction(CheckTransaction::Everything).sender();
+    return m_sender;
+}
+
+Transaction TransactionView::toTransaction(CheckTransaction _checkSig) const
+{
+    Transaction tx;
+    tx.decode(m_rlp, _checkSig, m_hash);
+    return tx;
+}
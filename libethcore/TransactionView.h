@@ -0,0 +1,82 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief : a transaction read in place from its RLP, the fields decoded when asked for
+ *
+ * @file TransactionView.h
+ * @date 2018-12-25
+ */
+#pragma once
+#include "Transaction.h"
+#include <libdevcore/RLP.h>
+#include <memory>
+
+namespace dev
+{
+namespace eth
+{
+/**
+ * @brief Keeps the buffer the transaction RLP lives in alive and reads the fields out of it on
+ * demand: hashing, reading the nonce or the data and looking the sender up cost no copy and no
+ * decode of the rest. toTransaction() decodes the whole transaction when one is needed.
+ * Like Transaction, a view caches its hash and sender without a lock, one thread at a time.
+ */
+class TransactionView
+{
+public:
+    /// _tx is the transaction RLP within the bytes of _data, _hash its sha3 if already known
+    /// @throws InvalidTransactionFormat if _tx is not a list of the transaction fields
+    TransactionView(
+        std::shared_ptr<bytes const> _data, bytesConstRef _tx, h256 const& _hash = h256());
+    explicit TransactionView(std::shared_ptr<bytes const> _tx)
+      : TransactionView(_tx, ref(*_tx))
+    {}
+
+    /// the hash of the signed transaction, sha3 of its RLP
+    h256 const& hash() const;
+    /// the sender recovered from the signature, from SenderCache when it is known there
+    Address const& sender() const;
+
+    u256 nonce() const { return m_rlp[0].toInt<u256>(); }
+    u256 gasPrice() const { return m_rlp[1].toInt<u256>(); }
+    u256 gas() const { return m_rlp[2].toInt<u256>(); }
+    u256 blockLimit() const { return m_rlp[3].toInt<u256>(); }
+    bool isCreation() const { return m_rlp[4].isEmpty(); }
+    Address receiveAddress() const
+    {
+        return isCreation() ? Address() : m_rlp[4].toHash<Address>(RLP::VeryStrict);
+    }
+    u256 value() const { return m_rlp[5].toInt<u256>(); }
+    /// the call data, within the buffer of the view
+    bytesConstRef data() const { return m_rlp[6].toBytesConstRef(); }
+
+    /// the transaction RLP, within the buffer of the view
+    bytesConstRef rlp() const { return m_rlp.data(); }
+    /// decode every field, the hash of the view spares Transaction its own hashing
+    Transaction toTransaction(CheckTransaction _checkSig = CheckTransaction::Everything) const;
+
+private:
+    std::shared_ptr<bytes const> m_data;
+    RLP m_rlp;
+    mutable h256 m_hash;
+    mutable Address m_sender;
+};
+
+using TransactionViews = std::vector<TransactionView>;
+
+}  // namespace eth
+}  // namespace dev
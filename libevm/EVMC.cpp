@@ -24,6 +24,7 @@
 #include "VMFactory.h"
 
 #include <libdevcore/easylog.h>
+#include <libinterpreter/interpreter.h>
 
 namespace dev
 {
@@ -43,34 +44,30 @@ EVM::EVM(evmc_instance* _instance) noexcept : m_instance(_instance)
             m_instance->set_option(m_instance, pair.first.c_str(), pair.second.c_str());
 }
 
-owning_bytes_ref EVMC::exec(u256& io_gas, ExtVMFace& _ext, const OnOpFunc& _onOp)
+owning_bytes_ref EVM::Result::takeOutput()
 {
-    assert(_ext.envInfo().number() >= 0);
-    assert(_ext.envInfo().timestamp() >= 0);
-
-    constexpr int64_t int64max = std::numeric_limits<int64_t>::max();
-
-    // TODO: The following checks should be removed by changing the types
-    //       used for gas, block number and timestamp.
-    (void)int64max;
-    assert(io_gas <= int64max);
-    assert(_ext.envInfo().gasLimit() <= int64max);
-    assert(_ext.depth() <= static_cast<size_t>(std::numeric_limits<int32_t>::max()));
-
-    auto gas = static_cast<int64_t>(io_gas);
-    EVM::Result r = execute(_ext, gas);
+    if (!m_result.output_size)
+        return owning_bytes_ref();
+    bytes buffer;
+    if (takeInterpreterOutput(m_result, buffer))
+    {
+        size_t begin = m_result.output_data - buffer.data();
+        return owning_bytes_ref{std::move(buffer), begin, m_result.output_size};
+    }
+    return owning_bytes_ref{output().toVector(), 0, m_result.output_size};
+}
 
-    switch (r.status())
+owning_bytes_ref EVMC::exec(u256& io_gas, ExtVMFace& _ext, const OnOpFunc& _onOp)
+{
+    evmc_status_code status;
+    owning_bytes_ref output = exec(io_gas, _ext, _onOp, status);
+    switch (status)
     {
     case EVMC_SUCCESS:
-        io_gas = r.gasLeft();
-        // FIXME: Copy the output for now, but copyless version possible.
-        return {r.output().toVector(), 0, r.output().size()};
+        return output;
 
     case EVMC_REVERT:
-        io_gas = r.gasLeft();
-        // FIXME: Copy the output for now, but copyless version possible.
-        throw RevertInstruction{{r.output().toVector(), 0, r.output().size()}};
+        throw RevertInstruction{std::move(output)};
 
     case EVMC_OUT_OF_GAS:
     case EVMC_FAILURE:
@@ -95,18 +92,48 @@ owning_bytes_ref EVMC::exec(u256& io_gas, ExtVMFace& _ext, const OnOpFunc& _onOp
     case EVMC_STATIC_MODE_VIOLATION:
         BOOST_THROW_EXCEPTION(DisallowedStateChange());
 
+    default:
+        // These cases aren't really internal errors, just more specific
+        // error codes returned by the VM. Map all of them to OOG.
+        BOOST_THROW_EXCEPTION(OutOfGas());
+    }
+}
+
+owning_bytes_ref EVMC::exec(
+    u256& io_gas, ExtVMFace& _ext, OnOpFunc const& _onOp, evmc_status_code& o_status)
+{
+    assert(_ext.envInfo().number() >= 0);
+    assert(_ext.envInfo().timestamp() >= 0);
+
+    constexpr int64_t int64max = std::numeric_limits<int64_t>::max();
+
+    // TODO: The following checks should be removed by changing the types
+    //       used for gas, block number and timestamp.
+    (void)int64max;
+    assert(io_gas <= int64max);
+    assert(_ext.envInfo().gasLimit() <= int64max);
+    assert(_ext.depth() <= static_cast<size_t>(std::numeric_limits<int32_t>::max()));
+
+    auto gas = static_cast<int64_t>(io_gas);
+    EVM::Result r = execute(_ext, gas);
+
+    o_status = r.status();
+    switch (r.status())
+    {
+    case EVMC_SUCCESS:
+    case EVMC_REVERT:
+        io_gas = r.gasLeft();
+        return r.takeOutput();
+
     case EVMC_REJECTED:
         LOG(WARNING) << "Execution rejected by EVMC, executing with default VM implementation";
-        return VMFactory::create(VMKind::Interpreter)->exec(io_gas, _ext, _onOp);
+        return VMFactory::create(VMKind::Interpreter)->exec(io_gas, _ext, _onOp, o_status);
 
-    case EVMC_INTERNAL_ERROR:
     default:
         if (r.status() <= EVMC_INTERNAL_ERROR)
             BOOST_THROW_EXCEPTION(InternalVMError{} << errinfo_evmcStatusCode(r.status()));
-        else
-            // These cases aren't really internal errors, just more specific
-            // error codes returned by the VM. Map all of them to OOG.
-            BOOST_THROW_EXCEPTION(OutOfGas());
+        // failures caused by the contract, all of the gas is consumed by the caller
+        return owning_bytes_ref();
     }
 }
 
@@ -72,6 +72,10 @@ public:
 
         bytesConstRef output() const { return {m_result.output_data, m_result.output_size}; }
 
+        /// Takes the output over without a copy if the buffer came from the built-in
+        /// interpreter, copies it otherwise.
+        owning_bytes_ref takeOutput();
+
     private:
         evmc_result m_result;
     };
@@ -103,6 +107,9 @@ public:
     explicit EVMC(evmc_instance* _instance) : EVM(_instance) {}
 
     owning_bytes_ref exec(u256& io_gas, ExtVMFace& _ext, OnOpFunc const& _onOp) final;
+
+    owning_bytes_ref exec(u256& io_gas, ExtVMFace& _ext, OnOpFunc const& _onOp,
+        evmc_status_code& o_status) final;
 };
 }  // namespace eth
 }  // namespace dev
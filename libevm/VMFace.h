@@ -41,6 +41,12 @@ public:
 
     /// VM implementation
     virtual owning_bytes_ref exec(u256& io_gas, ExtVMFace& _ext, OnOpFunc const& _onOp) = 0;
+
+    /// Same as exec() above, but the outcomes a contract can cause are reported through
+    /// o_status instead of exceptions: EVMC_SUCCESS, EVMC_REVERT with the revert data as the
+    /// output, or a failure code. Only errors of the VM itself are thrown.
+    virtual owning_bytes_ref exec(
+        u256& io_gas, ExtVMFace& _ext, OnOpFunc const& _onOp, evmc_status_code& o_status) = 0;
 };
 }  // namespace eth
 }  // namespace dev
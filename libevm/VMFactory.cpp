@@ -180,6 +180,19 @@ std::unique_ptr<VMFace> VMFactory::create()
     return create(g_kind);
 }
 
+VMFace& VMFactory::threadInstance()
+{
+    thread_local std::unique_ptr<VMFace> t_vm;
+    thread_local VMKind t_kind;
+    // g_kind is only set while parsing the command line, before any execution
+    if (!t_vm || t_kind != g_kind)
+    {
+        t_vm = create(g_kind);
+        t_kind = g_kind;
+    }
+    return *t_vm;
+}
+
 std::unique_ptr<VMFace> VMFactory::create(VMKind _kind)
 {
     switch (_kind)
@@ -59,6 +59,10 @@ public:
 
     /// Creates a VM instance of the kind provided.
     static std::unique_ptr<VMFace> create(VMKind _kind);
+
+    /// The VM instance of the global kind reused by all executions on the calling thread.
+    /// VMFace::exec keeps no state between calls, so nested calls share it as well.
+    static VMFace& threadInstance();
 };
 }  // namespace eth
 }  // namespace dev
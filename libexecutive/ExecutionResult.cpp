@@ -66,6 +66,32 @@ TransactionException dev::executive::toTransactionException(Exception const& _e)
     return TransactionException::Unknown;
 }
 
+TransactionException dev::executive::toTransactionException(evmc_status_code _status)
+{
+    switch (_status)
+    {
+    case EVMC_SUCCESS:
+        return TransactionException::None;
+    case EVMC_REVERT:
+        return TransactionException::RevertInstruction;
+    case EVMC_INVALID_INSTRUCTION:
+    case EVMC_UNDEFINED_INSTRUCTION:
+        return TransactionException::BadInstruction;
+    case EVMC_BAD_JUMP_DESTINATION:
+        return TransactionException::BadJumpDestination;
+    case EVMC_STACK_OVERFLOW:
+        return TransactionException::OutOfStack;
+    case EVMC_STACK_UNDERFLOW:
+        return TransactionException::StackUnderflow;
+    case EVMC_INVALID_MEMORY_ACCESS:
+    case EVMC_STATIC_MODE_VIOLATION:
+        return TransactionException::Unknown;
+    default:
+        // out of gas, generic failures and the more specific codes other VMs may return
+        return TransactionException::OutOfGas;
+    }
+}
+
 std::ostream& dev::executive::operator<<(std::ostream& _out, TransactionException const& _er)
 {
     switch (_er)
@@ -25,6 +25,7 @@
 #include <libdevcore/SHA3.h>
 #include <libethcore/Common.h>
 #include <libethcore/Exceptions.h>
+#include <evmc/evmc.h>
 
 
 namespace dev
@@ -73,6 +74,8 @@ enum class CodeDeposit
 };
 
 TransactionException toTransactionException(Exception const& _e);
+/// the exception of a VM execution that ended with _status, as if VMFace::exec had thrown it
+TransactionException toTransactionException(evmc_status_code _status);
 std::ostream& operator<<(std::ostream& _out, TransactionException const& _er);
 
 /// Description of the result of executing a transaction.
@@ -250,48 +250,51 @@ bool Executive::go(OnOpFunc const& _onOp)
 #endif
         try
         {
-            // Create VM instance. Force Interpreter if tracing requested.
-            auto vm = VMFactory::create();
+            // The VM instance is reused by every execution on this thread.
+            VMFace& vm = VMFactory::threadInstance();
+            // REVERT and failures caused by the contract come back as a status, not exceptions
+            evmc_status_code status = EVMC_SUCCESS;
             if (m_isCreation)
             {
                 m_s->clearStorage(m_ext->myAddress());
-                auto out = vm->exec(m_gas, *m_ext, _onOp);
-                if (m_res)
-                {
-                    m_res->gasForDeposit = m_gas;
-                    m_res->depositSize = out.size();
-                }
-                if (out.size() > m_ext->evmSchedule().maxCodeSize)
-                    BOOST_THROW_EXCEPTION(OutOfGas());
-                else if (out.size() * m_ext->evmSchedule().createDataGas <= m_gas)
-                {
-                    if (m_res)
-                        m_res->codeDeposit = CodeDeposit::Success;
-                    m_gas -= out.size() * m_ext->evmSchedule().createDataGas;
-                }
+                auto out = vm.exec(m_gas, *m_ext, _onOp, status);
+                if (status != EVMC_SUCCESS)
+                    m_output = std::move(out);
                 else
                 {
-                    if (m_ext->evmSchedule().exceptionalFailedCodeDeposit)
+                    if (m_res)
+                    {
+                        m_res->gasForDeposit = m_gas;
+                        m_res->depositSize = out.size();
+                    }
+                    if (out.size() > m_ext->evmSchedule().maxCodeSize)
                         BOOST_THROW_EXCEPTION(OutOfGas());
-                    else
+                    else if (out.size() * m_ext->evmSchedule().createDataGas <= m_gas)
                     {
                         if (m_res)
-                            m_res->codeDeposit = CodeDeposit::Failed;
-                        out = {};
+                            m_res->codeDeposit = CodeDeposit::Success;
+                        m_gas -= out.size() * m_ext->evmSchedule().createDataGas;
                     }
+                    else
+                    {
+                        if (m_ext->evmSchedule().exceptionalFailedCodeDeposit)
+                            BOOST_THROW_EXCEPTION(OutOfGas());
+                        else
+                        {
+                            if (m_res)
+                                m_res->codeDeposit = CodeDeposit::Failed;
+                            out = {};
+                        }
+                    }
+                    if (m_res)
+                        m_res->output = out.toVector();  // copy output to execution result
+                    m_s->setCode(m_ext->myAddress(), out.toVector());
                 }
-                if (m_res)
-                    m_res->output = out.toVector();  // copy output to execution result
-                m_s->setCode(m_ext->myAddress(), out.toVector());
             }
             else
-                m_output = vm->exec(m_gas, *m_ext, _onOp);
-        }
-        catch (RevertInstruction& _e)
-        {
-            revert();
-            m_output = _e.output();
-            m_excepted = TransactionException::RevertInstruction;
+                m_output = vm.exec(m_gas, *m_ext, _onOp, status);
+            if (status != EVMC_SUCCESS)
+                onExecutionFailed(status);
         }
         catch (VMException const& _e)
         {
@@ -341,6 +344,23 @@ bool Executive::go(OnOpFunc const& _onOp)
     return true;
 }
 
+void Executive::onExecutionFailed(evmc_status_code _status)
+{
+    if (_status == EVMC_REVERT)
+    {
+        revert();
+        m_excepted = TransactionException::RevertInstruction;
+    }
+    else
+    {
+        LOG(TRACE) << "Safe VM failure, status: " << _status;
+        m_output = owning_bytes_ref();
+        m_gas = 0;
+        m_excepted = toTransactionException(_status);
+        revert();
+    }
+}
+
 bool Executive::finalize()
 {
     // Accumulate refunds for suicides.
@@ -167,6 +167,9 @@ public:
     void revert();
 
 private:
+    /// Record a VM execution that did not succeed; m_output holds the revert data if any.
+    void onExecutionFailed(evmc_status_code _status);
+
     /// @returns false iff go() must be called (and thus a VM execution in required).
     bool executeCreate(Address const& _txSender, u256 const& _endowment, u256 const& _gasPrice,
         u256 const& _gas, bytesConstRef _code, Address const& _originAddress);
@@ -21,6 +21,9 @@
  */
 
 #include "CommonInitializer.h"
+#include <libdevcore/AsyncLog.h>
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/filesystem.hpp>
 
 using namespace dev;
 using namespace dev::initializer;
@@ -36,6 +39,14 @@ void CommonInitializer::initConfig(boost::property_tree::ptree const& _pt)
         LOG(ERROR) << "Data path unspecified.";
         BOOST_THROW_EXCEPTION(DataPathUnspecified());
     }
+    boost::algorithm::replace_all(m_logConfig, "${DATAPATH}", m_dataPath);
+    if (boost::filesystem::exists(m_logConfig))
+    {
+        el::Configurations conf(m_logConfig);
+        el::Loggers::reconfigureAllLoggers(conf);
+        /// ASYNC_LOG keeps the levels log.conf enables
+        AsyncLogger::loadEnabledLevels();
+    }
 }
 
 std::string CommonInitializer::dataPath()
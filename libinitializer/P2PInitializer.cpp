@@ -38,6 +38,9 @@ void P2PInitializer::initConfig(boost::property_tree::ptree const& _pt)
     std::string listenIP = _pt.get<std::string>("p2p.listen_ip", "0.0.0.0");
     int listenPort = _pt.get<int>("p2p.listen_port", 30300);
     NetworkConfig network_config = NetworkConfig(publicID, listenIP, listenPort);
+    /// payloads of at least this many bytes are compressed toward the peers that announced
+    /// CompressSupport when their session started, older peers get them raw; 0 disables it
+    Message::setCompressThreshold(_pt.get<size_t>("p2p.compress_threshold", 0));
 
     std::map<NodeIPEndpoint, NodeID> nodes;
     for (auto it : _pt.get_child("p2p"))
@@ -79,6 +82,9 @@ void P2PInitializer::initConfig(boost::property_tree::ptree const& _pt)
     auto host = std::make_shared<Host>("2.0", m_keyPair, network_config, asioInterface,
         socketFactory, sessionFactory, m_SSLContext);
     host->setStaticNodes(nodes);
+    /// the handlers of each protocol queued at most, a full queue stops the reads of its senders
+    host->setDispatchQueueCapacity(
+        _pt.get<size_t>("p2p.queue_capacity", MessageDispatcher::c_defaultQueueCapacity));
     m_p2pService = std::make_shared<Service>(host, p2pMsgHandler);
     m_p2pService->setMessageFactory(std::make_shared<P2PMessageFactory>());
     host->start();
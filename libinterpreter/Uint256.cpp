@@ -0,0 +1,236 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief division and modular kernels of uint256
+ *
+ * @file Uint256.cpp
+ * @date 2018-12-10
+ */
+#include "Uint256.h"
+
+namespace
+{
+using dev::eth::uint128;
+
+/// number of significant 64-bit digits of _d
+unsigned digits(uint64_t const* _d, unsigned _n)
+{
+    while (_n > 0 && _d[_n - 1] == 0)
+        --_n;
+    return _n;
+}
+
+/**
+ * Knuth's algorithm D (TAOCP 4.3.1) on 64-bit digits.
+ * _u has _m digits, _v has _n digits with _v[_n - 1] != 0 and _m >= _n >= 1; _m <= 8.
+ * Writes _m - _n + 1 quotient digits to _q (if not null) and _n remainder digits to _r.
+ */
+void divideDigits(
+    uint64_t* _q, uint64_t* _r, uint64_t const* _u, unsigned _m, uint64_t const* _v, unsigned _n)
+{
+    if (_n == 1)
+    {
+        uint128 rem = 0;
+        for (int j = _m - 1; j >= 0; --j)
+        {
+            uint128 cur = (rem << 64) | _u[j];
+            uint64_t digit = (uint64_t)(cur / _v[0]);
+            if (_q)
+                _q[j] = digit;
+            rem = cur - (uint128)digit * _v[0];
+        }
+        _r[0] = (uint64_t)rem;
+        return;
+    }
+
+    // normalize so that the top digit of the divisor has its high bit set
+    unsigned s = __builtin_clzll(_v[_n - 1]);
+    uint64_t vn[4];
+    uint64_t un[9];
+    for (unsigned i = _n - 1; i > 0; --i)
+        vn[i] = (_v[i] << s) | (s ? _v[i - 1] >> (64 - s) : 0);
+    vn[0] = _v[0] << s;
+    un[_m] = s ? _u[_m - 1] >> (64 - s) : 0;
+    for (unsigned i = _m - 1; i > 0; --i)
+        un[i] = (_u[i] << s) | (s ? _u[i - 1] >> (64 - s) : 0);
+    un[0] = _u[0] << s;
+
+    for (int j = _m - _n; j >= 0; --j)
+    {
+        // estimate the quotient digit from the top two digits, it is at most 2 too large
+        uint128 num = ((uint128)un[j + _n] << 64) | un[j + _n - 1];
+        uint128 qhat = num / vn[_n - 1];
+        uint128 rhat = num % vn[_n - 1];
+        while ((qhat >> 64) || qhat * vn[_n - 2] > ((rhat << 64) | un[j + _n - 2]))
+        {
+            --qhat;
+            rhat += vn[_n - 1];
+            if (rhat >> 64)
+                break;
+        }
+
+        // multiply and subtract
+        uint64_t borrow = 0;
+        uint64_t carry = 0;
+        for (unsigned i = 0; i < _n; ++i)
+        {
+            uint128 p = qhat * vn[i] + carry;
+            carry = (uint64_t)(p >> 64);
+            uint64_t low = (uint64_t)p;
+            uint64_t t = un[i + j] - low;
+            uint64_t b = un[i + j] < low;
+            un[i + j] = t - borrow;
+            borrow = b + (t < borrow);
+        }
+        uint64_t t = un[j + _n] - carry;
+        uint64_t b = un[j + _n] < carry;
+        un[j + _n] = t - borrow;
+        b += t < borrow;
+
+        // the estimate was one too large, add the divisor back
+        if (b)
+        {
+            --qhat;
+            uint64_t c = 0;
+            for (unsigned i = 0; i < _n; ++i)
+            {
+                uint128 sum = (uint128)un[i + j] + vn[i] + c;
+                un[i + j] = (uint64_t)sum;
+                c = (uint64_t)(sum >> 64);
+            }
+            un[j + _n] += c;
+        }
+        if (_q)
+            _q[j] = (uint64_t)qhat;
+    }
+
+    for (unsigned i = 0; i + 1 < _n; ++i)
+        _r[i] = (un[i] >> s) | (s ? un[i + 1] << (64 - s) : 0);
+    _r[_n - 1] = un[_n - 1] >> s;
+}
+
+/// _u (_m digits) % _v
+dev::eth::uint256 remainder(uint64_t const* _u, unsigned _m, dev::eth::uint256 const& _v)
+{
+    dev::eth::uint256 r;
+    unsigned m = digits(_u, _m);
+    unsigned n = digits(_v.w, 4);
+    if (n == 0)
+        return r;
+    if (m < n)
+    {
+        for (unsigned i = 0; i < m; ++i)
+            r.w[i] = _u[i];
+        return r;
+    }
+    divideDigits(nullptr, r.w, _u, m, _v.w, n);
+    return r;
+}
+}  // namespace
+
+namespace dev
+{
+namespace eth
+{
+uint256 divmod(uint256 const& _a, uint256 const& _b, uint256& o_remainder)
+{
+    uint256 q;
+    o_remainder = uint256();
+    if (_b.fitsUint64() && _a.fitsUint64())
+    {
+        if (_b.w[0])
+        {
+            q.w[0] = _a.w[0] / _b.w[0];
+            o_remainder.w[0] = _a.w[0] % _b.w[0];
+        }
+        return q;
+    }
+    unsigned n = digits(_b.w, 4);
+    if (n == 0)
+        return q;
+    if (_a < _b)
+    {
+        o_remainder = _a;
+        return q;
+    }
+    divideDigits(q.w, o_remainder.w, _a.w, digits(_a.w, 4), _b.w, n);
+    return q;
+}
+
+uint256 sdiv(uint256 const& _a, uint256 const& _b)
+{
+    bool aNegative = _a.isNegative();
+    bool bNegative = _b.isNegative();
+    uint256 r;
+    uint256 q = divmod(aNegative ? negate(_a) : _a, bNegative ? negate(_b) : _b, r);
+    return aNegative != bNegative ? negate(q) : q;
+}
+
+uint256 smod(uint256 const& _a, uint256 const& _b)
+{
+    bool aNegative = _a.isNegative();
+    uint256 r;
+    divmod(aNegative ? negate(_a) : _a, _b.isNegative() ? negate(_b) : _b, r);
+    return aNegative ? negate(r) : r;
+}
+
+uint256 addmod(uint256 const& _a, uint256 const& _b, uint256 const& _m)
+{
+    uint64_t sum[5];
+    uint128 carry = 0;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        carry += (uint128)_a.w[i] + _b.w[i];
+        sum[i] = (uint64_t)carry;
+        carry >>= 64;
+    }
+    sum[4] = (uint64_t)carry;
+    return remainder(sum, 5, _m);
+}
+
+uint256 mulmod(uint256 const& _a, uint256 const& _b, uint256 const& _m)
+{
+    uint64_t product[8] = {0};
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        uint64_t carry = 0;
+        for (unsigned j = 0; j < 4; ++j)
+        {
+            uint128 p = (uint128)_a.w[i] * _b.w[j] + product[i + j] + carry;
+            product[i + j] = (uint64_t)p;
+            carry = (uint64_t)(p >> 64);
+        }
+        product[i + 4] = carry;
+    }
+    return remainder(product, 8, _m);
+}
+
+// Exponentiation by squaring; no explicit mod is needed since multiplication wraps at 2^256.
+uint256 exp256(uint256 _base, uint256 _exponent)
+{
+    uint256 result = 1;
+    unsigned bits = 256 - _exponent.countLeadingZeros();
+    for (unsigned i = 0; i < bits; ++i)
+    {
+        if ((_exponent.w[i / 64] >> (i % 64)) & 1)
+            result = result * _base;
+        _base = _base * _base;
+    }
+    return result;
+}
+}  // namespace eth
+}  // namespace dev
@@ -0,0 +1,323 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+/**
+ * @brief fixed-width 256-bit word of the interpreter stack
+ *
+ * @file Uint256.h
+ * @date 2018-12-10
+ *
+ * The interpreter keeps its stack and constant pool in uint256 rather than the boost
+ * multiprecision u256, so every opcode runs on four 64-bit limbs with 128-bit intermediate
+ * products. Conversion to u256 is only needed outside of the interpreter loop.
+ */
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <cstring>
+#include <limits>
+#include <ostream>
+
+namespace dev
+{
+namespace eth
+{
+__extension__ typedef unsigned __int128 uint128;
+
+/**
+ * @brief four 64-bit limbs, least significant first
+ *
+ * All arithmetic wraps modulo 2^256 as the EVM does; division and modulo by zero yield zero.
+ * Signed operations read the word as two's complement.
+ */
+struct uint256
+{
+    uint64_t w[4];
+
+    uint256() : w{0, 0, 0, 0} {}
+    uint256(uint64_t _v) : w{_v, 0, 0, 0} {}
+    uint256(uint64_t _w0, uint64_t _w1, uint64_t _w2, uint64_t _w3) : w{_w0, _w1, _w2, _w3} {}
+
+    bool isZero() const { return (w[0] | w[1] | w[2] | w[3]) == 0; }
+    explicit operator bool() const { return !isZero(); }
+    /// true if the value is below 2^64, i.e. low64() is lossless
+    bool fitsUint64() const { return (w[1] | w[2] | w[3]) == 0; }
+    uint64_t low64() const { return w[0]; }
+    bool isNegative() const { return (w[3] >> 63) != 0; }
+    /// number of leading zero bits, 256 for zero
+    unsigned countLeadingZeros() const
+    {
+        for (int i = 3; i >= 0; --i)
+            if (w[i])
+                return (3 - i) * 64 + __builtin_clzll(w[i]);
+        return 256;
+    }
+
+    /// read/write 32 big-endian bytes, the layout of EVM memory, h256 and evmc_uint256be
+    static uint256 fromBigEndian(uint8_t const* _b)
+    {
+        uint256 r;
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            uint64_t v;
+            std::memcpy(&v, _b + (3 - i) * 8, 8);
+            r.w[i] = __builtin_bswap64(v);
+        }
+        return r;
+    }
+    void toBigEndian(uint8_t* _b) const
+    {
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            uint64_t v = __builtin_bswap64(w[i]);
+            std::memcpy(_b + (3 - i) * 8, &v, 8);
+        }
+    }
+};
+
+inline bool operator==(uint256 const& _a, uint256 const& _b)
+{
+    return ((_a.w[0] ^ _b.w[0]) | (_a.w[1] ^ _b.w[1]) | (_a.w[2] ^ _b.w[2]) |
+               (_a.w[3] ^ _b.w[3])) == 0;
+}
+
+inline bool operator!=(uint256 const& _a, uint256 const& _b)
+{
+    return !(_a == _b);
+}
+
+inline bool operator<(uint256 const& _a, uint256 const& _b)
+{
+    for (int i = 3; i > 0; --i)
+        if (_a.w[i] != _b.w[i])
+            return _a.w[i] < _b.w[i];
+    return _a.w[0] < _b.w[0];
+}
+
+inline bool operator>(uint256 const& _a, uint256 const& _b)
+{
+    return _b < _a;
+}
+
+inline bool operator<=(uint256 const& _a, uint256 const& _b)
+{
+    return !(_b < _a);
+}
+
+inline bool operator>=(uint256 const& _a, uint256 const& _b)
+{
+    return !(_a < _b);
+}
+
+inline uint256 operator+(uint256 const& _a, uint256 const& _b)
+{
+    uint256 r;
+    uint128 carry = 0;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        carry += (uint128)_a.w[i] + _b.w[i];
+        r.w[i] = (uint64_t)carry;
+        carry >>= 64;
+    }
+    return r;
+}
+
+inline uint256 operator-(uint256 const& _a, uint256 const& _b)
+{
+    uint256 r;
+    uint64_t borrow = 0;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        uint128 d = (uint128)_a.w[i] - _b.w[i] - borrow;
+        r.w[i] = (uint64_t)d;
+        borrow = (uint64_t)(d >> 64) & 1;
+    }
+    return r;
+}
+
+inline uint256 operator*(uint256 const& _a, uint256 const& _b)
+{
+    uint256 r;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        uint64_t carry = 0;
+        for (unsigned j = 0; i + j < 4; ++j)
+        {
+            uint128 p = (uint128)_a.w[i] * _b.w[j] + r.w[i + j] + carry;
+            r.w[i + j] = (uint64_t)p;
+            carry = (uint64_t)(p >> 64);
+        }
+    }
+    return r;
+}
+
+inline uint256 operator~(uint256 const& _a)
+{
+    return uint256(~_a.w[0], ~_a.w[1], ~_a.w[2], ~_a.w[3]);
+}
+
+inline uint256 operator&(uint256 const& _a, uint256 const& _b)
+{
+    return uint256(_a.w[0] & _b.w[0], _a.w[1] & _b.w[1], _a.w[2] & _b.w[2], _a.w[3] & _b.w[3]);
+}
+
+inline uint256 operator|(uint256 const& _a, uint256 const& _b)
+{
+    return uint256(_a.w[0] | _b.w[0], _a.w[1] | _b.w[1], _a.w[2] | _b.w[2], _a.w[3] | _b.w[3]);
+}
+
+inline uint256 operator^(uint256 const& _a, uint256 const& _b)
+{
+    return uint256(_a.w[0] ^ _b.w[0], _a.w[1] ^ _b.w[1], _a.w[2] ^ _b.w[2], _a.w[3] ^ _b.w[3]);
+}
+
+inline uint256& operator|=(uint256& _a, uint256 const& _b)
+{
+    return _a = _a | _b;
+}
+
+inline uint256& operator&=(uint256& _a, uint256 const& _b)
+{
+    return _a = _a & _b;
+}
+
+inline uint256 operator<<(uint256 const& _a, unsigned _n)
+{
+    uint256 r;
+    if (_n >= 256)
+        return r;
+    unsigned limbs = _n / 64;
+    unsigned bits = _n % 64;
+    for (unsigned i = limbs; i < 4; ++i)
+    {
+        r.w[i] = _a.w[i - limbs] << bits;
+        if (bits && i > limbs)
+            r.w[i] |= _a.w[i - limbs - 1] >> (64 - bits);
+    }
+    return r;
+}
+
+inline uint256 operator>>(uint256 const& _a, unsigned _n)
+{
+    uint256 r;
+    if (_n >= 256)
+        return r;
+    unsigned limbs = _n / 64;
+    unsigned bits = _n % 64;
+    for (unsigned i = 0; i + limbs < 4; ++i)
+    {
+        r.w[i] = _a.w[i + limbs] >> bits;
+        if (bits && i + limbs + 1 < 4)
+            r.w[i] |= _a.w[i + limbs + 1] << (64 - bits);
+    }
+    return r;
+}
+
+/// two's complement negation
+inline uint256 negate(uint256 const& _a)
+{
+    return uint256() - _a;
+}
+
+/// unsigned division, @returns the quotient and sets o_remainder; both are zero if _b is zero
+uint256 divmod(uint256 const& _a, uint256 const& _b, uint256& o_remainder);
+
+inline uint256 operator/(uint256 const& _a, uint256 const& _b)
+{
+    uint256 r;
+    return divmod(_a, _b, r);
+}
+
+inline uint256 operator%(uint256 const& _a, uint256 const& _b)
+{
+    uint256 r;
+    divmod(_a, _b, r);
+    return r;
+}
+
+/// SDIV, SMOD: signed division truncating towards zero, the remainder takes the dividend's sign
+uint256 sdiv(uint256 const& _a, uint256 const& _b);
+uint256 smod(uint256 const& _a, uint256 const& _b);
+
+/// ADDMOD, MULMOD: (_a + _b) % _m and (_a * _b) % _m without 256-bit overflow, zero if _m is zero
+uint256 addmod(uint256 const& _a, uint256 const& _b, uint256 const& _m);
+uint256 mulmod(uint256 const& _a, uint256 const& _b, uint256 const& _m);
+
+/// EXP: _base ** _exponent mod 2^256
+uint256 exp256(uint256 _base, uint256 _exponent);
+
+inline bool slt(uint256 const& _a, uint256 const& _b)
+{
+    bool aNegative = _a.isNegative();
+    return aNegative != _b.isNegative() ? aNegative : _a < _b;
+}
+
+inline bool sgt(uint256 const& _a, uint256 const& _b)
+{
+    return slt(_b, _a);
+}
+
+/// SAR: arithmetic shift right, shifts of 256 or more leave 0 or -1
+inline uint256 sar(uint256 const& _a, uint256 const& _shift)
+{
+    bool negative = _a.isNegative();
+    if (!_shift.fitsUint64() || _shift.low64() >= 256)
+        return negative ? ~uint256() : uint256();
+    unsigned n = unsigned(_shift.low64());
+    uint256 r = _a >> n;
+    if (negative && n)
+        r |= ~uint256() << (256 - n);
+    return r;
+}
+
+/// BYTE: byte _index of _a counting from the most significant end, zero if _index >= 32
+inline uint256 byteAt(uint256 const& _a, uint256 const& _index)
+{
+    if (!_index.fitsUint64() || _index.low64() >= 32)
+        return uint256();
+    unsigned n = 31 - unsigned(_index.low64());
+    return uint256((_a.w[n / 8] >> (n % 8 * 8)) & 0xff);
+}
+
+/// SIGNEXTEND: extend the sign of the (_byte + 1)-byte number in _a, unchanged if _byte >= 31
+inline uint256 signExtend(uint256 const& _byte, uint256 const& _a)
+{
+    if (!_byte.fitsUint64() || _byte.low64() >= 31)
+        return _a;
+    unsigned testBit = unsigned(_byte.low64()) * 8 + 7;
+    uint256 mask = (uint256(1) << testBit) - 1;
+    bool set = (_a.w[testBit / 64] >> (testBit % 64)) & 1;
+    return set ? _a | ~mask : _a & mask;
+}
+
+inline uint256 fromU256(u256 const& _v)
+{
+    u256 const mask = std::numeric_limits<uint64_t>::max();
+    return uint256(uint64_t(_v & mask), uint64_t((_v >> 64) & mask),
+        uint64_t((_v >> 128) & mask), uint64_t(_v >> 192));
+}
+
+inline u256 toU256(uint256 const& _v)
+{
+    return (u256(_v.w[3]) << 192) | (u256(_v.w[2]) << 128) | (u256(_v.w[1]) << 64) | _v.w[0];
+}
+
+inline std::ostream& operator<<(std::ostream& _out, uint256 const& _v)
+{
+    return _out << toU256(_v);
+}
+}  // namespace eth
+}  // namespace dev
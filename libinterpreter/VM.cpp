@@ -25,6 +25,7 @@
 
 #include <libdevcore/SHA3.h>
 
+#include <evmc/helpers.h>
 #include <include/BuildInfo.h>
 
 namespace
@@ -34,16 +35,53 @@ void destroy(evmc_instance* _instance)
     (void)_instance;
 }
 
-void delete_output(const evmc_result* result)
+void releaseOutput(evmc_result const* _result)
 {
-    delete[] result->output_data;
+    auto* data = evmc_get_const_optional_storage(_result);
+    auto& output = reinterpret_cast<dev::bytes const&>(*data);
+    // Explicitly call vector's destructor, the vector was placed with placement new.
+    using dev::bytes;
+    output.~bytes();
 }
 
+/// idle interpreters kept per thread, enough for the call depth of usual contracts
+constexpr size_t c_maxPooledVMs = 16;
+
+thread_local std::vector<std::unique_ptr<dev::eth::VM>> t_vmPool;
+
+/// Takes an interpreter of the thread's pool, or a new one, and gives it back when destroyed.
+/// A nested call made while this one runs takes another interpreter.
+struct PooledVM
+{
+    PooledVM()
+    {
+        if (t_vmPool.empty())
+            vm.reset(new dev::eth::VM);
+        else
+        {
+            vm = std::move(t_vmPool.back());
+            t_vmPool.pop_back();
+        }
+    }
+
+    ~PooledVM()
+    {
+        if (t_vmPool.size() < c_maxPooledVMs)
+        {
+            vm->reset();
+            t_vmPool.push_back(std::move(vm));
+        }
+    }
+
+    std::unique_ptr<dev::eth::VM> vm;
+};
+
 evmc_result execute(evmc_instance* _instance, evmc_context* _context, evmc_revision _rev,
     const evmc_message* _msg, uint8_t const* _code, size_t _codeSize) noexcept
 {
     (void)_instance;
-    std::unique_ptr<dev::eth::VM> vm{new dev::eth::VM};
+    PooledVM pooled;
+    dev::eth::VM* vm = pooled.vm.get();
 
     evmc_result result = {};
     dev::owning_bytes_ref output;
@@ -51,14 +89,8 @@ evmc_result execute(evmc_instance* _instance, evmc_context* _context, evmc_revis
     try
     {
         output = vm->exec(_context, _rev, _msg, _code, _codeSize);
-        result.status_code = EVMC_SUCCESS;
-        result.gas_left = vm->m_io_gas;
-    }
-    catch (dev::eth::RevertInstruction& ex)
-    {
-        result.status_code = EVMC_REVERT;
+        result.status_code = vm->m_reverted ? EVMC_REVERT : EVMC_SUCCESS;
         result.gas_left = vm->m_io_gas;
-        output = ex.output();  // This moves the output from the exception!
     }
     catch (dev::eth::BadInstruction const&)
     {
@@ -99,12 +131,14 @@ evmc_result execute(evmc_instance* _instance, evmc_context* _context, evmc_revis
 
     if (!output.empty())
     {
-        // Make a copy of the output.
-        auto outputData = new uint8_t[output.size()];
-        std::memcpy(outputData, output.data(), output.size());
-        result.output_data = outputData;
+        // Pass the output without a copy: the vector is placed in the result's reserved memory
+        // and destroyed by the release, or taken over by takeInterpreterOutput().
+        result.output_data = output.data();
         result.output_size = output.size();
-        result.release = delete_output;
+        auto* data = evmc_get_optional_storage(&result);
+        static_assert(sizeof(dev::bytes) <= sizeof(*data), "Vector is too big");
+        new (data) dev::bytes(output.takeBytes());
+        result.release = releaseOutput;
     }
 
     return result;
@@ -127,21 +161,22 @@ namespace dev
 {
 namespace eth
 {
-uint64_t VM::memNeed(u256 _offset, u256 _size)
+bool takeInterpreterOutput(evmc_result& _result, bytes& o_output)
 {
-    return toInt63(_size ? u512(_offset) + _size : u512(0));
+    if (_result.release != releaseOutput)
+        return false;
+    auto& output = reinterpret_cast<bytes&>(*evmc_get_optional_storage(&_result));
+    // output_data stays valid, moving a vector keeps its buffer
+    o_output = std::move(output);
+    output.~bytes();
+    _result.release = nullptr;
+    return true;
 }
 
-template <class S>
-S divWorkaround(S const& _a, S const& _b)
+uint64_t VM::memNeed(uint256 const& _offset, uint256 const& _size)
 {
-    return (S)(s512(_a) / s512(_b));
-}
-
-template <class S>
-S modWorkaround(S const& _a, S const& _b)
-{
-    return (S)(s512(_a) % s512(_b));
+    // both halves are below 2^63, so the sum cannot wrap
+    return _size ? toInt63(toInt63(_offset) + toInt63(_size)) : 0;
 }
 
 
@@ -177,22 +212,6 @@ uint64_t VM::decodeJumpvDest(const byte* const _code, uint64_t& _pc, byte _voff)
 }
 
 
-//
-// set current SP to SP', adjust SP' per _removed and _added items
-//
-void VM::adjustStack(int _removed, int _added)
-{
-    m_SP = m_SPP;
-
-    // adjust stack and check bounds
-    m_SPP += _removed;
-    if (m_stackEnd < m_SPP)
-        throwBadStack(_removed, _added);
-    m_SPP -= _added;
-    if (m_SPP < m_stack)
-        throwBadStack(_removed, _added);
-}
-
 uint64_t VM::gasForMem(u512 _size)
 {
     constexpr int64_t memoryGas = VMSchedule::memoryGas;
@@ -229,23 +248,70 @@ void VM::logGasMem()
 {
     unsigned n = (unsigned)m_OP - (unsigned)Instruction::LOG0;
     constexpr int64_t logDataGas = VMSchedule::logDataGas;
-    m_runGas =
-        toInt63(VMSchedule::logGas + VMSchedule::logTopicGas * n + logDataGas * u512(m_SP[1]));
+    m_runGas = toInt63(VMSchedule::logGas + VMSchedule::logTopicGas * n +
+                       logDataGas * u512(toInt63(m_SP[1])));
     updateMem(memNeed(m_SP[0], m_SP[1]));
 }
 
 void VM::fetchInstruction()
 {
     m_OP = Instruction(m_code[m_PC]);
-    auto const metric = c_metrics[static_cast<size_t>(m_OP)];
-    adjustStack(metric.num_stack_arguments, metric.num_stack_returned_items);
+    auto const op = c_fetch[static_cast<size_t>(m_OP)];
+
+    // set current SP to SP', adjust SP' by the items removed and added, the bounds have been
+    // checked on entry to the block
+    m_SP = m_SPP;
+    m_SPP += op.stackDelta;
 
     // FEES...
-    m_runGas = metric.gas_cost;
+    m_runGas = op.caseGas;
     m_newMemSize = m_mem.size();
     m_copyMemSize = 0;
 }
 
+void VM::enterBlock(uint32_t _block)
+{
+    Block const& block = m_blocks[_block];
+    m_nextBlock = block.next;
+    int64_t const height = m_stackEnd - m_SPP;
+    if (m_io_gas >= block.gas && height >= block.stackReq &&
+        height + block.stackGrowth <= VMSchedule::stackLimit)
+        m_io_gas -= block.gas;
+    else
+        resumeBlock();
+}
+
+void VM::jumpTo(uint256 const& _dest)
+{
+    // use binary search of array because hashtable collisions are exploitable
+    if (_dest.fitsUint64())
+    {
+        uint64_t const pc = _dest.low64();
+        auto it = std::lower_bound(m_jumpDests.begin(), m_jumpDests.end(), pc);
+        if (it != m_jumpDests.end() && *it == pc)
+        {
+            m_PC = pc;
+            enterBlock(m_jumpDestBlocks[it - m_jumpDests.begin()]);
+            return;
+        }
+    }
+    throwBadJumpDestination();
+}
+
+uint256 VM::decodePush(uint64_t _pc, int _numBytes) const
+{
+    if (_numBytes <= 8)
+    {
+        uint64_t value = 0;
+        for (int i = 1; i <= _numBytes; ++i)
+            value = (value << 8) | m_code[_pc + i];
+        return value;
+    }
+    uint8_t word[32] = {0};
+    std::memcpy(word + 32 - _numBytes, &m_code[_pc + 1], _numBytes);
+    return uint256::fromBigEndian(word);
+}
+
 evmc_tx_context const& VM::getTxContext()
 {
     if (!m_tx_context)
@@ -281,12 +347,51 @@ owning_bytes_ref VM::exec(evmc_context* _context, evmc_revision _rev, const evmc
     return std::move(m_output);
 }
 
+void VM::reset()
+{
+    m_context = nullptr;
+    m_message = nullptr;
+    m_tx_context.reset();
+    m_bounce = nullptr;
+    m_nSteps = 0;
+    m_output = owning_bytes_ref();
+    m_mem.clear();
+    if (m_mem.capacity() > c_maxRetainedMemory)
+        bytes().swap(m_mem);
+    m_pCode = nullptr;
+    m_codeSize = 0;
+    m_code.clear();
+    m_returnData.clear();
+    if (m_returnData.capacity() > c_maxRetainedMemory)
+        bytes().swap(m_returnData);
+    m_pool.clear();
+    m_PC = 0;
+    m_SP = m_SPP = m_stackEnd;
+    m_beginSubs.clear();
+    m_jumpDests.clear();
+    m_blocks.clear();
+    m_jumpDestBlocks.clear();
+    m_io_gas = 0;
+    m_reverted = false;
+}
+
+owning_bytes_ref VM::takeOutput(uint64_t _begin, uint64_t _size)
+{
+    if (_size == 0)
+        return owning_bytes_ref();
+    if (_size <= c_maxCopiedOutput)
+        return owning_bytes_ref{
+            bytes(m_mem.begin() + _begin, m_mem.begin() + _begin + _size), 0, _size};
+    return owning_bytes_ref{std::move(m_mem), _begin, _size};
+}
+
 //
 // main interpreter loop and switch
 //
 void VM::interpretCases()
 {
     INIT_CASES
+    enterBlock(m_nextBlock);
     DO_CASES
     {
         //
@@ -338,9 +443,9 @@ void VM::interpretCases()
             updateMem(memNeed(m_SP[0], m_SP[1]));
             updateIOGas();
 
-            uint64_t b = (uint64_t)m_SP[0];
-            uint64_t s = (uint64_t)m_SP[1];
-            m_output = owning_bytes_ref{std::move(m_mem), b, s};
+            uint64_t b = m_SP[0].low64();
+            uint64_t s = m_SP[1].low64();
+            m_output = takeOutput(b, s);
             m_bounce = 0;
         }
         BREAK
@@ -356,10 +461,11 @@ void VM::interpretCases()
             updateMem(memNeed(m_SP[0], m_SP[1]));
             updateIOGas();
 
-            uint64_t b = (uint64_t)m_SP[0];
-            uint64_t s = (uint64_t)m_SP[1];
-            owning_bytes_ref output{std::move(m_mem), b, s};
-            throwRevertInstruction(std::move(output));
+            uint64_t b = m_SP[0].low64();
+            uint64_t s = m_SP[1].low64();
+            m_output = takeOutput(b, s);
+            m_reverted = true;
+            m_bounce = 0;
         }
         BREAK;
 
@@ -370,13 +476,13 @@ void VM::interpretCases()
                 throwDisallowedStateChange();
 
             m_runGas = m_rev >= EVMC_TANGERINE_WHISTLE ? 5000 : 0;
-            evmc_address destination = toEvmC(asAddress(m_SP[0]));
+            evmc_address destination = toEvmCAddress(m_SP[0]);
 
             // After EIP158 zero-value suicides do not have to pay account creation gas.
             evmc_uint256be rawBalance;
             m_context->fn_table->get_balance(&rawBalance, m_context, &m_message->destination);
-            u256 balance = fromEvmC(rawBalance);
-            if (balance > 0 || m_rev < EVMC_SPURIOUS_DRAGON)
+            uint256 balance = wordFromEvmC(rawBalance);
+            if (balance || m_rev < EVMC_SPURIOUS_DRAGON)
             {
                 // After EIP150 hard fork charge additional cost of sending
                 // ethers to non-existing account.
@@ -411,9 +517,9 @@ void VM::interpretCases()
             updateMem(toInt63(m_SP[0]) + 32);
             updateIOGas();
 
-            m_SPP[0] = (u256) * (h256 const*)(m_mem.data() + (unsigned)m_SP[0]);
+            m_SPP[0] = uint256::fromBigEndian(m_mem.data() + m_SP[0].low64());
         }
-        NEXT
+        NEXT_DYNAMIC
 
             CASE(MSTORE)
         {
@@ -421,9 +527,9 @@ void VM::interpretCases()
             updateMem(toInt63(m_SP[0]) + 32);
             updateIOGas();
 
-            *(h256*)&m_mem[(unsigned)m_SP[0]] = (h256)m_SP[1];
+            m_SP[1].toBigEndian(m_mem.data() + m_SP[0].low64());
         }
-        NEXT
+        NEXT_DYNAMIC
 
             CASE(MSTORE8)
         {
@@ -431,24 +537,24 @@ void VM::interpretCases()
             updateMem(toInt63(m_SP[0]) + 1);
             updateIOGas();
 
-            m_mem[(unsigned)m_SP[0]] = (byte)(m_SP[1] & 0xff);
+            m_mem[m_SP[0].low64()] = (byte)m_SP[1].low64();
         }
-        NEXT
+        NEXT_DYNAMIC
 
             CASE(SHA3)
         {
             ON_OP();
-            constexpr int64_t sha3Gas = VMSchedule::sha3Gas;
             constexpr int64_t sha3WordGas = VMSchedule::sha3WordGas;
-            m_runGas = toInt63(sha3Gas + (u512(m_SP[1]) + 31) / 32 * sha3WordGas);
+            m_runGas += toInt63((u512(toInt63(m_SP[1])) + 31) / 32 * sha3WordGas);
             updateMem(memNeed(m_SP[0], m_SP[1]));
             updateIOGas();
 
-            uint64_t inOff = (uint64_t)m_SP[0];
-            uint64_t inSize = (uint64_t)m_SP[1];
-            m_SPP[0] = (u256)sha3(bytesConstRef(m_mem.data() + inOff, inSize));
+            uint64_t inOff = m_SP[0].low64();
+            uint64_t inSize = m_SP[1].low64();
+            h256 hash = sha3(bytesConstRef(m_mem.data() + inOff, inSize));
+            m_SPP[0] = uint256::fromBigEndian(hash.data());
         }
-        NEXT
+        NEXT_DYNAMIC
 
             CASE(LOG0)
         {
@@ -459,13 +565,13 @@ void VM::interpretCases()
             logGasMem();
             updateIOGas();
 
-            uint8_t const* data = m_mem.data() + size_t(m_SP[0]);
-            size_t dataSize = size_t(m_SP[1]);
+            uint8_t const* data = m_mem.data() + m_SP[0].low64();
+            size_t dataSize = m_SP[1].low64();
 
             m_context->fn_table->emit_log(
                 m_context, &m_message->destination, data, dataSize, nullptr, 0);
         }
-        NEXT
+        NEXT_BLOCK
 
             CASE(LOG1)
         {
@@ -476,8 +582,8 @@ void VM::interpretCases()
             logGasMem();
             updateIOGas();
 
-            uint8_t const* data = m_mem.data() + size_t(m_SP[0]);
-            size_t dataSize = size_t(m_SP[1]);
+            uint8_t const* data = m_mem.data() + m_SP[0].low64();
+            size_t dataSize = m_SP[1].low64();
 
             evmc_uint256be topics[] = {toEvmC(m_SP[2])};
             size_t numTopics = sizeof(topics) / sizeof(topics[0]);
@@ -485,7 +591,7 @@ void VM::interpretCases()
             m_context->fn_table->emit_log(
                 m_context, &m_message->destination, data, dataSize, topics, numTopics);
         }
-        NEXT
+        NEXT_BLOCK
 
             CASE(LOG2)
         {
@@ -496,8 +602,8 @@ void VM::interpretCases()
             logGasMem();
             updateIOGas();
 
-            uint8_t const* data = m_mem.data() + size_t(m_SP[0]);
-            size_t dataSize = size_t(m_SP[1]);
+            uint8_t const* data = m_mem.data() + m_SP[0].low64();
+            size_t dataSize = m_SP[1].low64();
 
             evmc_uint256be topics[] = {toEvmC(m_SP[2]), toEvmC(m_SP[3])};
             size_t numTopics = sizeof(topics) / sizeof(topics[0]);
@@ -505,7 +611,7 @@ void VM::interpretCases()
             m_context->fn_table->emit_log(
                 m_context, &m_message->destination, data, dataSize, topics, numTopics);
         }
-        NEXT
+        NEXT_BLOCK
 
             CASE(LOG3)
         {
@@ -516,8 +622,8 @@ void VM::interpretCases()
             logGasMem();
             updateIOGas();
 
-            uint8_t const* data = m_mem.data() + size_t(m_SP[0]);
-            size_t dataSize = size_t(m_SP[1]);
+            uint8_t const* data = m_mem.data() + m_SP[0].low64();
+            size_t dataSize = m_SP[1].low64();
 
             evmc_uint256be topics[] = {toEvmC(m_SP[2]), toEvmC(m_SP[3]), toEvmC(m_SP[4])};
             size_t numTopics = sizeof(topics) / sizeof(topics[0]);
@@ -525,7 +631,7 @@ void VM::interpretCases()
             m_context->fn_table->emit_log(
                 m_context, &m_message->destination, data, dataSize, topics, numTopics);
         }
-        NEXT
+        NEXT_BLOCK
 
             CASE(LOG4)
         {
@@ -536,8 +642,8 @@ void VM::interpretCases()
             logGasMem();
             updateIOGas();
 
-            uint8_t const* data = m_mem.data() + size_t(m_SP[0]);
-            size_t dataSize = size_t(m_SP[1]);
+            uint8_t const* data = m_mem.data() + m_SP[0].low64();
+            size_t dataSize = m_SP[1].low64();
 
             evmc_uint256be topics[] = {
                 toEvmC(m_SP[2]), toEvmC(m_SP[3]), toEvmC(m_SP[4]), toEvmC(m_SP[5])};
@@ -546,21 +652,19 @@ void VM::interpretCases()
             m_context->fn_table->emit_log(
                 m_context, &m_message->destination, data, dataSize, topics, numTopics);
         }
-        NEXT
+        NEXT_BLOCK
 
             CASE(EXP)
         {
-            u256 expon = m_SP[1];
+            uint256 expon = m_SP[1];
             const int64_t byteCost = m_rev >= EVMC_SPURIOUS_DRAGON ? 50 : 10;
-            m_runGas =
-                toInt63(VMSchedule::stepGas5 + byteCost * (32 - (h256(expon).firstBitSet() / 8)));
+            m_runGas += byteCost * (32 - (expon.countLeadingZeros() / 8));
             ON_OP();
             updateIOGas();
 
-            u256 base = m_SP[0];
-            m_SPP[0] = exp256(base, expon);
+            m_SPP[0] = exp256(m_SP[0], expon);
         }
-        NEXT
+        NEXT_DYNAMIC
 
             //
             // ordinary instructions
@@ -569,7 +673,6 @@ void VM::interpretCases()
             CASE(ADD)
         {
             ON_OP();
-            updateIOGas();
 
             // pops two items and pushes their sum mod 2^256.
             m_SPP[0] = m_SP[0] + m_SP[1];
@@ -579,7 +682,6 @@ void VM::interpretCases()
             CASE(MUL)
         {
             ON_OP();
-            updateIOGas();
 
             // pops two items and pushes their product mod 2^256.
             m_SPP[0] = m_SP[0] * m_SP[1];
@@ -589,7 +691,6 @@ void VM::interpretCases()
             CASE(SUB)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = m_SP[0] - m_SP[1];
         }
@@ -598,18 +699,16 @@ void VM::interpretCases()
             CASE(DIV)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = m_SP[1] ? divWorkaround(m_SP[0], m_SP[1]) : 0;
+            m_SPP[0] = m_SP[0] / m_SP[1];
         }
         NEXT
 
             CASE(SDIV)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = m_SP[1] ? s2u(divWorkaround(u2s(m_SP[0]), u2s(m_SP[1]))) : 0;
+            m_SPP[0] = sdiv(m_SP[0], m_SP[1]);
             --m_SP;
         }
         NEXT
@@ -617,25 +716,22 @@ void VM::interpretCases()
             CASE(MOD)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = m_SP[1] ? modWorkaround(m_SP[0], m_SP[1]) : 0;
+            m_SPP[0] = m_SP[0] % m_SP[1];
         }
         NEXT
 
             CASE(SMOD)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = m_SP[1] ? s2u(modWorkaround(u2s(m_SP[0]), u2s(m_SP[1]))) : 0;
+            m_SPP[0] = smod(m_SP[0], m_SP[1]);
         }
         NEXT
 
             CASE(NOT)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = ~m_SP[0];
         }
@@ -644,7 +740,6 @@ void VM::interpretCases()
             CASE(LT)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = m_SP[0] < m_SP[1] ? 1 : 0;
         }
@@ -653,7 +748,6 @@ void VM::interpretCases()
             CASE(GT)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = m_SP[0] > m_SP[1] ? 1 : 0;
         }
@@ -662,25 +756,22 @@ void VM::interpretCases()
             CASE(SLT)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = u2s(m_SP[0]) < u2s(m_SP[1]) ? 1 : 0;
+            m_SPP[0] = slt(m_SP[0], m_SP[1]) ? 1 : 0;
         }
         NEXT
 
             CASE(SGT)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = u2s(m_SP[0]) > u2s(m_SP[1]) ? 1 : 0;
+            m_SPP[0] = sgt(m_SP[0], m_SP[1]) ? 1 : 0;
         }
         NEXT
 
             CASE(EQ)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = m_SP[0] == m_SP[1] ? 1 : 0;
         }
@@ -689,7 +780,6 @@ void VM::interpretCases()
             CASE(ISZERO)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = m_SP[0] ? 0 : 1;
         }
@@ -698,7 +788,6 @@ void VM::interpretCases()
             CASE(AND)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = m_SP[0] & m_SP[1];
         }
@@ -707,7 +796,6 @@ void VM::interpretCases()
             CASE(OR)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = m_SP[0] | m_SP[1];
         }
@@ -716,7 +804,6 @@ void VM::interpretCases()
             CASE(XOR)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = m_SP[0] ^ m_SP[1];
         }
@@ -725,9 +812,8 @@ void VM::interpretCases()
             CASE(BYTE)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = m_SP[0] < 32 ? (m_SP[1] >> (unsigned)(8 * (31 - m_SP[0]))) & 0xff : 0;
+            m_SPP[0] = byteAt(m_SP[1], m_SP[0]);
         }
         NEXT
 
@@ -738,12 +824,11 @@ void VM::interpretCases()
                 throwBadInstruction();
 
             ON_OP();
-            updateIOGas();
 
             if (m_SP[0] >= 256)
                 m_SPP[0] = 0;
             else
-                m_SPP[0] = m_SP[1] << unsigned(m_SP[0]);
+                m_SPP[0] = m_SP[1] << unsigned(m_SP[0].low64());
         }
         NEXT
 
@@ -754,12 +839,11 @@ void VM::interpretCases()
                 throwBadInstruction();
 
             ON_OP();
-            updateIOGas();
 
             if (m_SP[0] >= 256)
                 m_SPP[0] = 0;
             else
-                m_SPP[0] = m_SP[1] >> unsigned(m_SP[0]);
+                m_SPP[0] = m_SP[1] >> unsigned(m_SP[0].low64());
         }
         NEXT
 
@@ -770,63 +854,32 @@ void VM::interpretCases()
                 throwBadInstruction();
 
             ON_OP();
-            updateIOGas();
-
-            static u256 const hibit = u256(1) << 255;
-            static u256 const allbits =
-                u256("0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
 
-            u256 shiftee = m_SP[1];
-            if (m_SP[0] >= 256)
-            {
-                if (shiftee & hibit)
-                    m_SPP[0] = allbits;
-                else
-                    m_SPP[0] = 0;
-            }
-            else
-            {
-                unsigned amount = unsigned(m_SP[0]);
-                m_SPP[0] = shiftee >> amount;
-                if (shiftee & hibit)
-                    m_SPP[0] |= allbits << (256 - amount);
-            }
+            m_SPP[0] = sar(m_SP[1], m_SP[0]);
         }
         NEXT
 
             CASE(ADDMOD)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = m_SP[2] ? u256((u512(m_SP[0]) + u512(m_SP[1])) % m_SP[2]) : 0;
+            m_SPP[0] = addmod(m_SP[0], m_SP[1], m_SP[2]);
         }
         NEXT
 
             CASE(MULMOD)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = m_SP[2] ? u256((u512(m_SP[0]) * u512(m_SP[1])) % m_SP[2]) : 0;
+            m_SPP[0] = mulmod(m_SP[0], m_SP[1], m_SP[2]);
         }
         NEXT
 
             CASE(SIGNEXTEND)
         {
             ON_OP();
-            updateIOGas();
 
-            if (m_SP[0] < 31)
-            {
-                unsigned testBit = static_cast<unsigned>(m_SP[0]) * 8 + 7;
-                u256& number = m_SP[1];
-                u256 mask = ((u256(1) << testBit) - 1);
-                if (boost::multiprecision::bit_test(number, testBit))
-                    number |= ~mask;
-                else
-                    number &= mask;
-            }
+            m_SPP[0] = signExtend(m_SP[0], m_SP[1]);
         }
         NEXT
 
@@ -875,18 +928,16 @@ void VM::interpretCases()
         CASE(ADDRESS)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = fromAddress(fromEvmC(m_message->destination));
+            m_SPP[0] = wordFromEvmC(m_message->destination);
         }
         NEXT
 
             CASE(ORIGIN)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = fromAddress(fromEvmC(getTxContext().tx_origin));
+            m_SPP[0] = wordFromEvmC(getTxContext().tx_origin);
         }
         NEXT
 
@@ -896,29 +947,27 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            evmc_address address = toEvmC(asAddress(m_SP[0]));
+            evmc_address address = toEvmCAddress(m_SP[0]);
             evmc_uint256be rawBalance;
             m_context->fn_table->get_balance(&rawBalance, m_context, &address);
-            m_SPP[0] = fromEvmC(rawBalance);
+            m_SPP[0] = wordFromEvmC(rawBalance);
         }
-        NEXT
+        NEXT_BLOCK
 
 
             CASE(CALLER)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = fromAddress(fromEvmC(m_message->sender));
+            m_SPP[0] = wordFromEvmC(m_message->sender);
         }
         NEXT
 
             CASE(CALLVALUE)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = fromEvmC(m_message->value);
+            m_SPP[0] = wordFromEvmC(m_message->value);
         }
         NEXT
 
@@ -926,23 +975,20 @@ void VM::interpretCases()
             CASE(CALLDATALOAD)
         {
             ON_OP();
-            updateIOGas();
 
             size_t const dataSize = m_message->input_size;
             uint8_t const* const data = m_message->input_data;
 
-            if (u512(m_SP[0]) + 31 < dataSize)
-                m_SP[0] = (u256) * (h256 const*)(data + (size_t)m_SP[0]);
-            else if (m_SP[0] >= dataSize)
-                m_SP[0] = u256(0);
+            if (m_SP[0] >= dataSize)
+                m_SP[0] = 0;
+            else if (dataSize - m_SP[0].low64() > 31)
+                m_SP[0] = uint256::fromBigEndian(data + m_SP[0].low64());
             else
             {
-                h256 r;
-                for (uint64_t i = (uint64_t)m_SP[0], e = (uint64_t)m_SP[0] + (uint64_t)32, j = 0;
-                     i < e; ++i, ++j)
-                    r[j] = i < dataSize ? data[i] : 0;
-                m_SP[0] = (u256)r;
-            };
+                uint8_t r[32] = {0};
+                std::memcpy(r, data + m_SP[0].low64(), dataSize - m_SP[0].low64());
+                m_SP[0] = uint256::fromBigEndian(r);
+            }
         }
         NEXT
 
@@ -950,7 +996,6 @@ void VM::interpretCases()
             CASE(CALLDATASIZE)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = m_message->input_size;
         }
@@ -962,7 +1007,6 @@ void VM::interpretCases()
                 throwBadInstruction();
 
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = m_returnData.size();
         }
@@ -971,7 +1015,6 @@ void VM::interpretCases()
             CASE(CODESIZE)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = m_codeSize;
         }
@@ -983,11 +1026,11 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            evmc_address address = toEvmC(asAddress(m_SP[0]));
+            evmc_address address = toEvmCAddress(m_SP[0]);
 
             m_SPP[0] = m_context->fn_table->get_code_size(m_context, &address);
         }
-        NEXT
+        NEXT_BLOCK
 
             CASE(CALLDATACOPY)
         {
@@ -999,14 +1042,14 @@ void VM::interpretCases()
             bytesConstRef data{m_message->input_data, m_message->input_size};
             copyDataToMemory(data, m_SP);
         }
-        NEXT
+        NEXT_DYNAMIC
 
             CASE(RETURNDATACOPY)
         {
             ON_OP();
             if (m_rev < EVMC_BYZANTIUM)
                 throwBadInstruction();
-            bigint const endOfAccess = bigint(m_SP[1]) + bigint(m_SP[2]);
+            bigint const endOfAccess = bigint(toU256(m_SP[1])) + bigint(toU256(m_SP[2]));
             if (m_returnData.size() < endOfAccess)
                 throwBufferOverrun(endOfAccess);
 
@@ -1016,7 +1059,7 @@ void VM::interpretCases()
 
             copyDataToMemory(&m_returnData, m_SP);
         }
-        NEXT
+        NEXT_BLOCK
 
             CASE(EXTCODEHASH)
         {
@@ -1026,13 +1069,13 @@ void VM::interpretCases()
 
             updateIOGas();
 
-            evmc_address address = toEvmC(asAddress(m_SP[0]));
+            evmc_address address = toEvmCAddress(m_SP[0]);
 
             evmc_uint256be hash;
             m_context->fn_table->get_code_hash(&hash, m_context, &address);
-            m_SPP[0] = fromEvmC(hash);
+            m_SPP[0] = wordFromEvmC(hash);
         }
-        NEXT
+        NEXT_BLOCK
 
             CASE(CODECOPY)
         {
@@ -1043,7 +1086,7 @@ void VM::interpretCases()
 
             copyDataToMemory({m_pCode, m_codeSize}, m_SP);
         }
-        NEXT
+        NEXT_DYNAMIC
 
             CASE(EXTCODECOPY)
         {
@@ -1054,12 +1097,12 @@ void VM::interpretCases()
             updateMem(memNeed(m_SP[1], m_SP[3]));
             updateIOGas();
 
-            evmc_address address = toEvmC(asAddress(m_SP[0]));
+            evmc_address address = toEvmCAddress(m_SP[0]);
 
-            size_t memoryOffset = static_cast<size_t>(m_SP[1]);
+            size_t memoryOffset = static_cast<size_t>(m_SP[1].low64());
             constexpr size_t codeOffsetMax = std::numeric_limits<size_t>::max();
             size_t codeOffset =
-                m_SP[2] > codeOffsetMax ? codeOffsetMax : static_cast<size_t>(m_SP[2]);
+                m_SP[2] > codeOffsetMax ? codeOffsetMax : static_cast<size_t>(m_SP[2].low64());
             size_t size = static_cast<size_t>(copyMemSize);
 
             size_t numCopied = m_context->fn_table->copy_code(
@@ -1067,15 +1110,14 @@ void VM::interpretCases()
 
             std::fill_n(&m_mem[memoryOffset + numCopied], size - numCopied, 0);
         }
-        NEXT
+        NEXT_BLOCK
 
 
             CASE(GASPRICE)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = fromEvmC(getTxContext().tx_gas_price);
+            m_SPP[0] = wordFromEvmC(getTxContext().tx_gas_price);
         }
         NEXT
 
@@ -1086,32 +1128,31 @@ void VM::interpretCases()
             updateIOGas();
 
             const int64_t blockNumber = getTxContext().block_number;
-            u256 number = m_SP[0];
+            uint256 const& number = m_SP[0];
 
-            if (number < blockNumber && number >= std::max(int64_t(256), blockNumber) - 256)
+            if (blockNumber > 0 && number < uint64_t(blockNumber) &&
+                number >= uint64_t(std::max(int64_t(256), blockNumber) - 256))
             {
                 evmc_uint256be hash;
-                m_context->fn_table->get_block_hash(&hash, m_context, int64_t(number));
-                m_SPP[0] = fromEvmC(hash);
+                m_context->fn_table->get_block_hash(&hash, m_context, int64_t(number.low64()));
+                m_SPP[0] = wordFromEvmC(hash);
             }
             else
                 m_SPP[0] = 0;
         }
-        NEXT
+        NEXT_BLOCK
 
             CASE(COINBASE)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = fromAddress(fromEvmC(getTxContext().block_coinbase));
+            m_SPP[0] = wordFromEvmC(getTxContext().block_coinbase);
         }
         NEXT
 
             CASE(TIMESTAMP)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = getTxContext().block_timestamp;
         }
@@ -1120,7 +1161,6 @@ void VM::interpretCases()
             CASE(NUMBER)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = getTxContext().block_number;
         }
@@ -1129,16 +1169,14 @@ void VM::interpretCases()
             CASE(DIFFICULTY)
         {
             ON_OP();
-            updateIOGas();
 
-            m_SPP[0] = fromEvmC(getTxContext().block_difficulty);
+            m_SPP[0] = wordFromEvmC(getTxContext().block_difficulty);
         }
         NEXT
 
             CASE(GASLIMIT)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = getTxContext().block_gas_limit;
         }
@@ -1147,7 +1185,6 @@ void VM::interpretCases()
             CASE(POP)
         {
             ON_OP();
-            updateIOGas();
 
             --m_SP;
         }
@@ -1157,7 +1194,6 @@ void VM::interpretCases()
         {
 #if EVM_USE_CONSTANT_POOL
             ON_OP();
-            updateIOGas();
 
             // get val at two-byte offset into const pool and advance pc by one-byte remainder
             TRACE_OP(2, m_PC, m_OP);
@@ -1177,7 +1213,6 @@ void VM::interpretCases()
         CASE(PUSH1)
         {
             ON_OP();
-            updateIOGas();
             ++m_PC;
             m_SPP[0] = m_code[m_PC];
             ++m_PC;
@@ -1217,15 +1252,15 @@ void VM::interpretCases()
         CASE(PUSH32)
         {
             ON_OP();
-            updateIOGas();
 
             int numBytes = (int)m_OP - (int)Instruction::PUSH1 + 1;
-            m_SPP[0] = 0;
             // Construct a number out of PUSH bytes.
             // This requires the code has been copied and extended by 32 zero
             // bytes to handle "out of code" push data here.
-            for (++m_PC; numBytes--; ++m_PC)
-                m_SPP[0] = (m_SPP[0] << 8) | m_code[m_PC];
+            uint8_t word[32] = {0};
+            std::memcpy(word + 32 - numBytes, &m_code[m_PC + 1], numBytes);
+            m_SPP[0] = uint256::fromBigEndian(word);
+            m_PC += numBytes + 1;
         }
         CONTINUE
 
@@ -1233,7 +1268,7 @@ void VM::interpretCases()
         {
             ON_OP();
             updateIOGas();
-            m_PC = verifyJumpDest(m_SP[0]);
+            jumpTo(m_SP[0]);
         }
         CONTINUE
 
@@ -1242,9 +1277,12 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
             if (m_SP[1])
-                m_PC = verifyJumpDest(m_SP[0]);
+                jumpTo(m_SP[0]);
             else
+            {
                 ++m_PC;
+                enterBlock(m_nextBlock);
+            }
         }
         CONTINUE
 
@@ -1254,7 +1292,7 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_PC = uint64_t(m_SP[0]);
+            jumpTo(m_SP[0]);
 #else
             throwBadInstruction();
 #endif
@@ -1268,15 +1306,85 @@ void VM::interpretCases()
             updateIOGas();
 
             if (m_SP[1])
-                m_PC = uint64_t(m_SP[0]);
+                jumpTo(m_SP[0]);
             else
+            {
                 ++m_PC;
+                enterBlock(m_nextBlock);
+            }
 #else
             throwBadInstruction();
 #endif
         }
         CONTINUE
 
+        //
+        // superinstructions, the instruction pairs fused by optimize()
+        //
+
+        CASE(PUSHJUMP)
+        {
+            ON_OP();
+            updateIOGas();
+
+            int numBytes = (int)m_pCode[m_PC] - (int)Instruction::PUSH1 + 1;
+            jumpTo(decodePush(m_PC, numBytes));
+        }
+        CONTINUE
+
+        CASE(PUSHJUMPI)
+        {
+            ON_OP();
+            updateIOGas();
+
+            int numBytes = (int)m_pCode[m_PC] - (int)Instruction::PUSH1 + 1;
+            if (m_SP[0])
+                jumpTo(decodePush(m_PC, numBytes));
+            else
+            {
+                m_PC += numBytes + 2;
+                enterBlock(m_nextBlock);
+            }
+        }
+        CONTINUE
+
+        CASE(PUSHADD)
+        {
+            ON_OP();
+
+            int numBytes = (int)m_pCode[m_PC] - (int)Instruction::PUSH1 + 1;
+            m_SPP[0] = m_SP[0] + decodePush(m_PC, numBytes);
+            m_PC += numBytes + 2;
+        }
+        CONTINUE
+
+        CASE(PUSHMSTORE)
+        {
+            ON_OP();
+            int numBytes = (int)m_pCode[m_PC] - (int)Instruction::PUSH1 + 1;
+            uint256 const offset = decodePush(m_PC, numBytes);
+            updateMem(toInt63(offset) + 32);
+            updateIOGas();
+
+            m_SP[0].toBigEndian(m_mem.data() + offset.low64());
+            m_PC += numBytes + 1;
+        }
+        NEXT_DYNAMIC
+
+            CASE(DUPSWAP)
+        {
+            ON_OP();
+
+            // DUPn pushes the n-th item, SWAPm then swaps it with the m-th item below it
+            unsigned n = (unsigned)m_pCode[m_PC] - (unsigned)Instruction::DUP1;
+            unsigned m = (unsigned)m_pCode[m_PC + 1] - (unsigned)Instruction::SWAP1;
+            uint256 const item = m_SP[n];
+            m_SPP[0] = m_SP[m];
+            m_SP[m] = item;
+            m_PC += 2;
+        }
+        CONTINUE
+
         CASE(DUP1)
         CASE(DUP2)
         CASE(DUP3)
@@ -1295,14 +1403,9 @@ void VM::interpretCases()
         CASE(DUP16)
         {
             ON_OP();
-            updateIOGas();
 
             unsigned n = (unsigned)m_OP - (unsigned)Instruction::DUP1;
-            *(uint64_t*)m_SPP = *(uint64_t*)(m_SP + n);
-
-            // the stack slot being copied into may no longer hold a u256
-            // so we construct a new one in the memory, rather than assign
-            new (m_SPP) u256(m_SP[n]);
+            m_SPP[0] = m_SP[n];
         }
         NEXT
 
@@ -1312,7 +1415,6 @@ void VM::interpretCases()
                     CASE(SWAP14) CASE(SWAP15) CASE(SWAP16)
         {
             ON_OP();
-            updateIOGas();
 
             unsigned n = (unsigned)m_OP - (unsigned)Instruction::SWAP1 + 1;
             std::swap(m_SP[0], m_SP[n]);
@@ -1329,9 +1431,9 @@ void VM::interpretCases()
             evmc_uint256be key = toEvmC(m_SP[0]);
             evmc_uint256be value;
             m_context->fn_table->get_storage(&value, m_context, &m_message->destination, &key);
-            m_SPP[0] = fromEvmC(value);
+            m_SPP[0] = wordFromEvmC(value);
         }
-        NEXT
+        NEXT_BLOCK
 
             CASE(SSTORE)
         {
@@ -1356,12 +1458,11 @@ void VM::interpretCases()
                 updateIOGas();
             }
         }
-        NEXT
+        NEXT_BLOCK
 
             CASE(PC)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = m_PC;
         }
@@ -1370,7 +1471,6 @@ void VM::interpretCases()
             CASE(MSIZE)
         {
             ON_OP();
-            updateIOGas();
 
             m_SPP[0] = m_mem.size();
         }
@@ -1383,13 +1483,11 @@ void VM::interpretCases()
 
             m_SPP[0] = m_io_gas;
         }
-        NEXT
+        NEXT_BLOCK
 
             CASE(JUMPDEST)
         {
-            m_runGas = VMSchedule::jumpdestGas;
             ON_OP();
-            updateIOGas();
         }
         NEXT
 
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "Uint256.h"
 #include "VMConfig.h"
 
 #include <libdevcore/Common.h>
@@ -73,7 +74,17 @@ public:
     owning_bytes_ref exec(evmc_context* _context, evmc_revision _rev, const evmc_message* _msg,
         uint8_t const* _code, size_t _codeSize);
 
+    /// clear the state of the last execution so the VM can run another one, keeping its buffers
+    void reset();
+
     uint64_t m_io_gas = 0;
+    /// set when exec() ended with REVERT, its output is then the revert data
+    bool m_reverted = false;
+
+    /// outputs up to this size are copied out so m_mem keeps its capacity for the next call
+    static constexpr size_t c_maxCopiedOutput = 1024;
+    /// reset() frees memory buffers larger than this instead of keeping them for the next call
+    static constexpr size_t c_maxRetainedMemory = 1024 * 1024;
 
 private:
     evmc_context* m_context = nullptr;
@@ -83,7 +94,23 @@ private:
 
     static std::array<evmc_instruction_metrics, 256> c_metrics;
     static void initMetrics();
-    static u256 exp256(u256 _base, u256 _exponent);
+
+    /// how the block analysis in optimize() treats an opcode
+    enum class OpKind : uint8_t
+    {
+        Static,     ///< fixed gas, charged on entry to its block
+        Dynamic,    ///< fixed gas on block entry, the case adds gas for memory or operands
+        Terminator  ///< ends its block and charges its own gas
+    };
+    static std::array<OpKind, 256> c_kinds;
+
+    /// what fetchInstruction() needs of an opcode
+    struct OpFetch
+    {
+        int32_t stackDelta;  ///< items removed less items added
+        int32_t caseGas;     ///< gas the case charges itself, the rest is charged per block
+    };
+    static std::array<OpFetch, 256> c_fetch;
     void copyCode(int);
     typedef void (VM::*MemFnPtr)();
     MemFnPtr m_bounce = nullptr;
@@ -91,6 +118,7 @@ private:
 
     // return bytes
     owning_bytes_ref m_output;
+    owning_bytes_ref takeOutput(uint64_t _begin, uint64_t _size);
 
     // space for memory
     bytes m_mem;
@@ -104,18 +132,18 @@ private:
     bytes m_returnData;
 
     // space for data stack, grows towards smaller addresses from the end
-    u256 m_stack[VMSchedule::stackLimit];
-    u256* m_stackEnd = &m_stack[VMSchedule::stackLimit];
+    uint256 m_stack[VMSchedule::stackLimit];
+    uint256* m_stackEnd = &m_stack[VMSchedule::stackLimit];
     size_t stackSize() { return m_stackEnd - m_SP; }
 
     // constant pool
-    std::vector<u256> m_pool;
+    std::vector<uint256> m_pool;
 
     // interpreter state
-    Instruction m_OP;         // current operation
-    uint64_t m_PC = 0;        // program counter
-    u256* m_SP = m_stackEnd;  // stack pointer
-    u256* m_SPP = m_SP;       // stack pointer prime (next SP)
+    Instruction m_OP;            // current operation
+    uint64_t m_PC = 0;           // program counter
+    uint256* m_SP = m_stackEnd;  // stack pointer
+    uint256* m_SPP = m_SP;       // stack pointer prime (next SP)
 
     // metering and memory state
     uint64_t m_runGas = 0;
@@ -126,6 +154,36 @@ private:
     void initEntry();
     void optimize();
 
+    /// Straight-line code from an entry point (the code start, a JUMPDEST or the instruction
+    /// after a terminator) up to and including the next terminator. Entering it checks the
+    /// stack bounds of all its instructions and charges their static gas at once.
+    struct Block
+    {
+        uint64_t gas;         ///< static gas of the instructions before the terminator
+        int32_t stackReq;     ///< stack items needed on entry
+        int32_t stackGrowth;  ///< largest growth of the stack over its height on entry
+        uint32_t next;        ///< block entered when the terminator falls through
+    };
+    std::vector<Block> m_blocks;
+    /// the block starting at each of m_jumpDests
+    std::vector<uint32_t> m_jumpDestBlocks;
+    /// scratch space of optimize(): instructions since the last terminator
+    std::vector<uint64_t> m_blockPCs;
+    uint32_t m_nextBlock = 0;
+    static constexpr uint64_t c_noResume = std::numeric_limits<uint64_t>::max();
+    /// after the dynamic instruction before this pc, resumeBlock() charges the rest of a block
+    /// that could not be charged on entry
+    uint64_t m_resumePC = c_noResume;
+
+    Instruction codeAt(uint64_t _pc) const;
+    OpKind blockKind(Instruction _op) const;
+    void closeBlocks();
+    void fuse(uint64_t _pc, uint64_t _nextPC);
+    void enterBlock(uint32_t _block);
+    void resumeBlock();
+    void jumpTo(uint256 const& _dest);
+    uint256 decodePush(uint64_t _pc, int _numBytes) const;
+
     // interpreter loop & switch
     void interpretCases();
 
@@ -134,25 +192,23 @@ private:
     bool caseCallSetup(evmc_message& _msg, bytesRef& o_output);
     void caseCall();
 
-    void copyDataToMemory(bytesConstRef _data, u256* _sp);
-    uint64_t memNeed(u256 _offset, u256 _size);
+    void copyDataToMemory(bytesConstRef _data, uint256* _sp);
+    uint64_t memNeed(uint256 const& _offset, uint256 const& _size);
 
     const evmc_tx_context& getTxContext();
 
     void throwOutOfGas();
     void throwBadInstruction();
     void throwBadJumpDestination();
-    void throwBadStack(int _removed, int _added);
-    void throwRevertInstruction(owning_bytes_ref&& _output);
+    void throwBadStack(int64_t _size, int _removed, int _added);
     void throwDisallowedStateChange();
     void throwBufferOverrun(bigint const& _enfOfAccess);
 
     std::vector<uint64_t> m_beginSubs;
     std::vector<uint64_t> m_jumpDests;
-    int64_t verifyJumpDest(u256 const& _dest, bool _throw = true);
+    int64_t verifyJumpDest(uint256 const& _dest, bool _throw = true);
 
     void onOperation() {}
-    void adjustStack(int _removed, int _added);
     uint64_t gasForMem(u512 _size);
     void updateIOGas();
     void updateGas();
@@ -173,6 +229,14 @@ private:
         return w;
     }
 
+    uint64_t toInt63(uint256 const& _v)
+    {
+        // check for overflow
+        if (!_v.fitsUint64() || _v.low64() > 0x7FFFFFFFFFFFFFFF)
+            throwOutOfGas();
+        return _v.low64();
+    }
+
     template <class T>
     uint64_t toInt15(T v)
     {
@@ -199,6 +263,36 @@ inline u256 fromEvmC(evmc_uint256be const& _n)
     return fromBigEndian<u256>(_n.bytes);
 }
 
+/// stack words to and from evmc values, without a detour through u256
+inline evmc_uint256be toEvmC(uint256 const& _n)
+{
+    evmc_uint256be r;
+    _n.toBigEndian(r.bytes);
+    return r;
+}
+
+inline uint256 wordFromEvmC(evmc_uint256be const& _n)
+{
+    return uint256::fromBigEndian(_n.bytes);
+}
+
+/// the low 160 bits of a stack word as an address
+inline evmc_address toEvmCAddress(uint256 const& _n)
+{
+    uint8_t word[32];
+    _n.toBigEndian(word);
+    evmc_address r;
+    std::memcpy(r.bytes, word + 12, 20);
+    return r;
+}
+
+inline uint256 wordFromEvmC(evmc_address const& _addr)
+{
+    uint8_t word[32] = {0};
+    std::memcpy(word + 12, _addr.bytes, 20);
+    return uint256::fromBigEndian(word);
+}
+
 inline Address fromEvmC(evmc_address const& _addr)
 {
     return reinterpret_cast<Address const&>(_addr);
@@ -26,15 +26,19 @@ namespace dev
 {
 namespace eth
 {
-void VM::copyDataToMemory(bytesConstRef _data, u256* _sp)
+void VM::copyDataToMemory(bytesConstRef _data, uint256* _sp)
 {
-    auto offset = static_cast<size_t>(_sp[0]);
-    s512 bigIndex = _sp[1];
-    auto index = static_cast<size_t>(bigIndex);
-    auto size = static_cast<size_t>(_sp[2]);
+    auto offset = static_cast<size_t>(_sp[0].low64());
+    auto size = static_cast<size_t>(_sp[2].low64());
 
-    size_t sizeToBeCopied =
-        bigIndex + size > _data.size() ? _data.size() < bigIndex ? 0 : _data.size() - index : size;
+    // an index past the end of _data copies zeros only
+    size_t index = 0;
+    size_t sizeToBeCopied = 0;
+    if (_sp[1] < _data.size())
+    {
+        index = static_cast<size_t>(_sp[1].low64());
+        sizeToBeCopied = std::min(size, _data.size() - index);
+    }
 
     if (sizeToBeCopied > 0)
         std::memcpy(m_mem.data() + offset, _data.data() + index, sizeToBeCopied);
@@ -47,7 +51,9 @@ void VM::copyDataToMemory(bytesConstRef _data, u256* _sp)
 
 void VM::throwOutOfGas()
 {
-    BOOST_THROW_EXCEPTION(OutOfGas());
+    // Caught by execute() and turned into a status code, so skip the diagnostic information
+    // BOOST_THROW_EXCEPTION would allocate.
+    throw OutOfGas();
 }
 
 void VM::throwBadInstruction()
@@ -65,39 +71,31 @@ void VM::throwDisallowedStateChange()
     BOOST_THROW_EXCEPTION(DisallowedStateChange());
 }
 
-// throwBadStack is called from fetchInstruction() -> adjustStack()
-// its the only exception that can happen before ON_OP() log is done for an opcode case in VM.cpp
-// so the call to m_onFail is needed here
-void VM::throwBadStack(int _removed, int _added)
+// throwBadStack is called from resumeBlock() when an instruction of a block does not fit the
+// stack of _size items, before ON_OP() is done for its case in VM.cpp
+void VM::throwBadStack(int64_t _size, int _removed, int _added)
 {
-    bigint size = m_stackEnd - m_SPP;
+    bigint size = _size;
     if (size < _removed)
         BOOST_THROW_EXCEPTION(StackUnderflow() << RequirementError((bigint)_removed, size));
     else
         BOOST_THROW_EXCEPTION(OutOfStack() << RequirementError((bigint)(_added - _removed), size));
 }
 
-void VM::throwRevertInstruction(owning_bytes_ref&& _output)
-{
-    // We can't use BOOST_THROW_EXCEPTION here because it makes a copy of exception inside and
-    // RevertInstruction has no copy constructor
-    throw RevertInstruction(std::move(_output));
-}
-
 void VM::throwBufferOverrun(bigint const& _endOfAccess)
 {
     BOOST_THROW_EXCEPTION(
         BufferOverrun() << RequirementError(_endOfAccess, bigint(m_returnData.size())));
 }
 
-int64_t VM::verifyJumpDest(u256 const& _dest, bool _throw)
+int64_t VM::verifyJumpDest(uint256 const& _dest, bool _throw)
 {
     // check for overflow
     if (_dest <= 0x7FFFFFFFFFFFFFFF)
     {
         // check for within bounds and to a jump destination
         // use binary search of array because hashtable collisions are exploitable
-        uint64_t pc = uint64_t(_dest);
+        uint64_t pc = _dest.low64();
         if (std::binary_search(m_jumpDests.begin(), m_jumpDests.end(), pc))
             return pc;
     }
@@ -117,11 +115,11 @@ void VM::caseCreate()
     m_runGas = VMSchedule::createGas;
 
     // Collect arguments.
-    u256 const endowment = m_SP[0];
-    u256 const initOff = m_SP[1];
-    u256 const initSize = m_SP[2];
+    uint256 const endowment = m_SP[0];
+    uint256 const initOff = m_SP[1];
+    uint256 const initSize = m_SP[2];
 
-    u256 salt;
+    uint256 salt;
     if (m_OP == Instruction::CREATE2)
         salt = m_SP[3];
 
@@ -133,7 +131,7 @@ void VM::caseCreate()
 
     evmc_uint256be rawBalance;
     m_context->fn_table->get_balance(&rawBalance, m_context, &m_message->destination);
-    u256 balance = fromEvmC(rawBalance);
+    uint256 balance = wordFromEvmC(rawBalance);
     if (balance >= endowment && m_message->depth < 1024)
     {
         evmc_message msg = {};
@@ -142,8 +140,8 @@ void VM::caseCreate()
             msg.gas -= msg.gas / 64;
 
         // Get init code. Casts are safe because the memory cost has been paid.
-        auto off = static_cast<size_t>(initOff);
-        auto size = static_cast<size_t>(initSize);
+        auto off = static_cast<size_t>(initOff.low64());
+        auto size = static_cast<size_t>(initSize.low64());
 
         msg.input_data = &m_mem[off];
         msg.input_size = size;
@@ -159,7 +157,7 @@ void VM::caseCreate()
         m_context->fn_table->call(&result, m_context, &msg);
 
         if (result.status_code == EVMC_SUCCESS)
-            m_SPP[0] = fromAddress(fromEvmC(result.create_address));
+            m_SPP[0] = wordFromEvmC(result.create_address);
         else
             m_SPP[0] = 0;
         m_returnData.assign(result.output_data, result.output_data + result.output_size);
@@ -230,7 +228,7 @@ bool VM::caseCallSetup(evmc_message& o_msg, bytesRef& o_output)
 
     bool const haveValueArg = m_OP == Instruction::CALL || m_OP == Instruction::CALLCODE;
 
-    evmc_address destination = toEvmC(asAddress(m_SP[1]));
+    evmc_address destination = toEvmCAddress(m_SP[1]);
     int destinationExists = m_context->fn_table->account_exists(m_context, &destination);
 
     if (m_OP == Instruction::CALL && !destinationExists)
@@ -243,10 +241,10 @@ bool VM::caseCallSetup(evmc_message& o_msg, bytesRef& o_output)
         m_runGas += VMSchedule::valueTransferGas;
 
     size_t const sizesOffset = haveValueArg ? 3 : 2;
-    u256 inputOffset = m_SP[sizesOffset];
-    u256 inputSize = m_SP[sizesOffset + 1];
-    u256 outputOffset = m_SP[sizesOffset + 2];
-    u256 outputSize = m_SP[sizesOffset + 3];
+    uint256 inputOffset = m_SP[sizesOffset];
+    uint256 inputSize = m_SP[sizesOffset + 1];
+    uint256 outputOffset = m_SP[sizesOffset + 2];
+    uint256 outputSize = m_SP[sizesOffset + 3];
     uint64_t inputMemNeed = memNeed(inputOffset, inputSize);
     uint64_t outputMemNeed = memNeed(outputOffset, outputSize);
 
@@ -255,11 +253,11 @@ bool VM::caseCallSetup(evmc_message& o_msg, bytesRef& o_output)
     updateIOGas();
 
     // "Static" costs already applied. Calculate call gas.
-    u256 callGas = m_SP[0];
+    uint256 callGas = m_SP[0];
     if (m_rev >= EVMC_TANGERINE_WHISTLE)
     {
         // Apply "all but one 64th" rule.
-        u256 maxAllowedCallGas = m_io_gas - m_io_gas / 64;
+        uint256 maxAllowedCallGas = m_io_gas - m_io_gas / 64;
         callGas = std::min(callGas, maxAllowedCallGas);
     }
 
@@ -269,21 +267,21 @@ bool VM::caseCallSetup(evmc_message& o_msg, bytesRef& o_output)
 
     o_msg.destination = destination;
     o_msg.sender = m_message->destination;
-    o_msg.input_data = m_mem.data() + size_t(inputOffset);
-    o_msg.input_size = size_t(inputSize);
+    o_msg.input_data = m_mem.data() + size_t(inputOffset.low64());
+    o_msg.input_size = size_t(inputSize.low64());
 
     bool balanceOk = true;
     if (haveValueArg)
     {
-        u256 value = m_SP[2];
-        if (value > 0)
+        uint256 value = m_SP[2];
+        if (value)
         {
             o_msg.value = toEvmC(m_SP[2]);
             o_msg.gas += VMSchedule::callStipend;
             {
                 evmc_uint256be rawBalance;
                 m_context->fn_table->get_balance(&rawBalance, m_context, &m_message->destination);
-                u256 balance = fromEvmC(rawBalance);
+                uint256 balance = wordFromEvmC(rawBalance);
                 balanceOk = balance >= value;
             }
         }
@@ -296,8 +294,8 @@ bool VM::caseCallSetup(evmc_message& o_msg, bytesRef& o_output)
 
     if (balanceOk && m_message->depth < 1024)
     {
-        size_t outOff = size_t(outputOffset);
-        size_t outSize = size_t(outputSize);
+        size_t outOff = size_t(outputOffset.low64());
+        size_t outSize = size_t(outputSize.low64());
         o_output = bytesRef(m_mem.data() + outOff, outSize);
         return true;
     }
@@ -40,6 +40,12 @@ namespace eth
 // EVM_REPLACE_CONST_JUMP - pre-verified jumps to save runtime lookup
 //
 // EVM_TRACE              - provides various levels of tracing
+//
+// Whatever the configuration, static gas and stack bounds are checked once per basic block
+// (see VM::optimize), so besides NEXT and CONTINUE the cases use
+//
+// NEXT_BLOCK             - after an instruction that ends a block and falls through
+// NEXT_DYNAMIC           - after an instruction that charges gas for memory or operands
 
 #ifndef EVM_JUMP_DISPATCH
 #ifdef __GNUC__
@@ -140,6 +146,15 @@ namespace eth
 #define NEXT \
     ++m_PC;  \
     break;
+#define NEXT_BLOCK           \
+    ++m_PC;                  \
+    enterBlock(m_nextBlock); \
+    break;
+#define NEXT_DYNAMIC        \
+    ++m_PC;                 \
+    if (m_PC == m_resumePC) \
+        resumeBlock();      \
+    break;
 #define CONTINUE continue;
 #define BREAK return;
 #define DEFAULT default:
@@ -323,11 +338,11 @@ namespace eth
         &&LOG2,                                 \
         &&LOG3,                                 \
         &&LOG4,                                 \
-        &&INVALID,                              \
-        &&INVALID,                              \
-        &&INVALID,                              \
-        &&INVALID,                              \
-        &&INVALID,                              \
+        &&PUSHJUMP,                             \
+        &&PUSHJUMPI,                            \
+        &&PUSHADD,                              \
+        &&PUSHMSTORE,                           \
+        &&DUPSWAP,                              \
         &&INVALID,                              \
         &&INVALID,                              \
         &&PUSHC,                                \
@@ -425,6 +440,17 @@ namespace eth
     ++m_PC;             \
     fetchInstruction(); \
     goto* jumpTable[(int)m_OP];
+#define NEXT_BLOCK           \
+    ++m_PC;                  \
+    enterBlock(m_nextBlock); \
+    fetchInstruction();      \
+    goto* jumpTable[(int)m_OP];
+#define NEXT_DYNAMIC        \
+    ++m_PC;                 \
+    if (m_PC == m_resumePC) \
+        resumeBlock();      \
+    fetchInstruction();     \
+    goto* jumpTable[(int)m_OP];
 #define CONTINUE        \
     fetchInstruction(); \
     goto* jumpTable[(int)m_OP];
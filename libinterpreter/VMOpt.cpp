@@ -27,6 +27,8 @@ namespace dev
 namespace eth
 {
 std::array<evmc_instruction_metrics, 256> VM::c_metrics{{}};
+std::array<VM::OpKind, 256> VM::c_kinds{{}};
+std::array<VM::OpFetch, 256> VM::c_fetch{{}};
 void VM::initMetrics()
 {
     static bool done = []() noexcept
@@ -35,16 +37,106 @@ void VM::initMetrics()
         std::memcpy(&c_metrics[0], evmc_get_instruction_metrics_table(EVMC_LATEST_REVISION),
             c_metrics.size() * sizeof(c_metrics[0]));
 
+        // The cases of these only add their dynamic gas to the fixed part charged from here.
+        c_metrics[uint8_t(Instruction::EXP)].gas_cost = VMSchedule::stepGas5;
+        c_metrics[uint8_t(Instruction::SHA3)].gas_cost = VMSchedule::sha3Gas;
+        c_metrics[uint8_t(Instruction::JUMPDEST)].gas_cost = VMSchedule::jumpdestGas;
+
         // Inject interpreter optimization opcodes.
         c_metrics[uint8_t(Instruction::PUSHC)] = c_metrics[uint8_t(Instruction::PUSH1)];
         c_metrics[uint8_t(Instruction::JUMPC)] = c_metrics[uint8_t(Instruction::JUMP)];
         c_metrics[uint8_t(Instruction::JUMPCI)] = c_metrics[uint8_t(Instruction::JUMPI)];
+
+        // Superinstructions take the stack effect of their pair. The PUSH or DUP half is
+        // charged with its block, so a fused jump only charges the jump.
+        c_metrics[uint8_t(Instruction::PUSHJUMP)] = {
+            c_metrics[uint8_t(Instruction::JUMP)].gas_cost, 0, 0};
+        c_metrics[uint8_t(Instruction::PUSHJUMPI)] = {
+            c_metrics[uint8_t(Instruction::JUMPI)].gas_cost, 1, 0};
+        c_metrics[uint8_t(Instruction::PUSHADD)] = {0, 1, 1};
+        c_metrics[uint8_t(Instruction::PUSHMSTORE)] = {0, 1, 0};
+        c_metrics[uint8_t(Instruction::DUPSWAP)] = {0, 0, 1};
+
+        // Everything else ends a block: jumps, calls, instructions reading the gas left,
+        // touching state or failing for other reasons than gas and stack bounds.
+        c_kinds.fill(OpKind::Terminator);
+        for (auto op : {Instruction::ADD, Instruction::MUL, Instruction::SUB, Instruction::DIV,
+                 Instruction::SDIV, Instruction::MOD, Instruction::SMOD, Instruction::ADDMOD,
+                 Instruction::MULMOD, Instruction::SIGNEXTEND, Instruction::LT, Instruction::GT,
+                 Instruction::SLT, Instruction::SGT, Instruction::EQ, Instruction::ISZERO,
+                 Instruction::AND, Instruction::OR, Instruction::XOR, Instruction::NOT,
+                 Instruction::BYTE, Instruction::SHL, Instruction::SHR, Instruction::SAR,
+                 Instruction::ADDRESS, Instruction::ORIGIN, Instruction::CALLER,
+                 Instruction::CALLVALUE, Instruction::CALLDATALOAD, Instruction::CALLDATASIZE,
+                 Instruction::CODESIZE, Instruction::GASPRICE, Instruction::RETURNDATASIZE,
+                 Instruction::COINBASE, Instruction::TIMESTAMP, Instruction::NUMBER,
+                 Instruction::DIFFICULTY, Instruction::GASLIMIT, Instruction::POP, Instruction::PC,
+                 Instruction::MSIZE, Instruction::JUMPDEST, Instruction::PUSHC,
+                 Instruction::PUSHADD, Instruction::DUPSWAP})
+            c_kinds[uint8_t(op)] = OpKind::Static;
+        for (unsigned op = uint8_t(Instruction::PUSH1); op <= uint8_t(Instruction::SWAP16); ++op)
+            c_kinds[op] = OpKind::Static;
+        for (auto op : {Instruction::MLOAD, Instruction::MSTORE, Instruction::MSTORE8,
+                 Instruction::SHA3, Instruction::EXP, Instruction::CALLDATACOPY,
+                 Instruction::CODECOPY, Instruction::PUSHMSTORE})
+            c_kinds[uint8_t(op)] = OpKind::Dynamic;
+
+        for (size_t op = 0; op < c_fetch.size(); ++op)
+        {
+            auto const& metric = c_metrics[op];
+            c_fetch[op].stackDelta = metric.num_stack_arguments - metric.num_stack_returned_items;
+            c_fetch[op].caseGas = c_kinds[op] == OpKind::Terminator ? metric.gas_cost : 0;
+        }
         return true;
     }
     ();
     (void)done;
 }
 
+namespace
+{
+/// opcodes the interpreter writes into its copy of the code, invalid in user code
+bool isInterpreterOp(byte _op)
+{
+    return (byte)Instruction::PUSHJUMP <= _op && _op <= (byte)Instruction::JUMPCI;
+}
+
+int pushBytes(Instruction _op)
+{
+    bool push = Instruction::PUSH1 <= _op && _op <= Instruction::PUSH32;
+    return push ? (int)_op - (int)Instruction::PUSH1 + 1 : 0;
+}
+}  // namespace
+
+Instruction VM::codeAt(uint64_t _pc) const
+{
+    // past the end the code is padded with STOP
+    if (_pc >= m_codeSize)
+        return Instruction::STOP;
+    return isInterpreterOp(m_pCode[_pc]) ? Instruction::INVALID : Instruction(m_pCode[_pc]);
+}
+
+VM::OpKind VM::blockKind(Instruction _op) const
+{
+    // undefined before their revision, the case throws before charging anything
+    switch (_op)
+    {
+    case Instruction::SHL:
+    case Instruction::SHR:
+    case Instruction::SAR:
+        if (m_rev < EVMC_CONSTANTINOPLE)
+            return OpKind::Terminator;
+        break;
+    case Instruction::RETURNDATASIZE:
+        if (m_rev < EVMC_BYZANTIUM)
+            return OpKind::Terminator;
+        break;
+    default:
+        break;
+    }
+    return c_kinds[(size_t)_op];
+}
+
 void VM::copyCode(int _extraBytes)
 {
     // Copy code so that it can be safely modified and extend code by
@@ -71,7 +163,7 @@ void VM::optimize()
         TRACE_OP(2, pc, op);
 
         // make synthetic ops in user code trigger invalid instruction if run
-        if (op == Instruction::PUSHC || op == Instruction::JUMPC || op == Instruction::JUMPCI)
+        if (isInterpreterOp((byte)op))
         {
             TRACE_OP(1, pc, op);
             m_code[pc] = (byte)Instruction::INVALID;
@@ -92,7 +184,7 @@ void VM::optimize()
     TRACE_STR(1, "Do first pass optimizations")
     for (size_t pc = 0; pc < nBytes; ++pc)
     {
-        u256 val = 0;
+        uint256 val = 0;
         Instruction op = Instruction(m_code[pc]);
 
         if ((byte)Instruction::PUSH1 <= (byte)op && (byte)op <= (byte)Instruction::PUSH32)
@@ -162,6 +254,135 @@ void VM::optimize()
     }
     TRACE_STR(1, "Finished optimizations")
 #endif
+
+    // Split the code into blocks ended by terminators, with a block entry at each JUMPDEST
+    // too, and fuse common pairs of instructions into superinstructions. Both work on the
+    // original code, the interpreter's own opcodes in it are invalid.
+    TRACE_STR(1, "Build blocks")
+    m_blockPCs.clear();
+    for (uint64_t pc = 0;;)
+    {
+        Instruction op = codeAt(pc);
+        m_blockPCs.push_back(pc);
+        uint64_t nextPC = pc + 1 + pushBytes(op);
+        if (blockKind(op) == OpKind::Terminator)
+        {
+            closeBlocks();
+            if (pc >= nBytes)
+                break;
+        }
+        else if (nextPC < nBytes)
+            fuse(pc, nextPC);
+        pc = nextPC;
+    }
+    assert(m_jumpDestBlocks.size() == m_jumpDests.size());
+}
+
+// Adds the blocks of the instructions in m_blockPCs, the last of which is a terminator: one
+// from the first instruction and one from each JUMPDEST, all up to the terminator.
+void VM::closeBlocks()
+{
+    size_t entries = 1;
+    size_t jumpDests = 0;
+    for (size_t i = 0; i < m_blockPCs.size(); ++i)
+        if (codeAt(m_blockPCs[i]) == Instruction::JUMPDEST)
+        {
+            ++jumpDests;
+            entries += i ? 1 : 0;
+        }
+    size_t block = m_blocks.size() + entries;
+    uint32_t const next = block;
+    m_blocks.resize(block);
+    size_t jumpDest = m_jumpDestBlocks.size() + jumpDests;
+    m_jumpDestBlocks.resize(jumpDest);
+
+    // accumulate from the terminator backwards, each entry sees the instructions after it
+    uint64_t gas = 0;
+    int64_t stackReq = 0;
+    int64_t stackGrowth = std::numeric_limits<int32_t>::min();
+    for (size_t i = m_blockPCs.size(); i-- > 0;)
+    {
+        Instruction op = codeAt(m_blockPCs[i]);
+        auto const& metric = c_metrics[(size_t)op];
+        int64_t const delta = metric.num_stack_returned_items - metric.num_stack_arguments;
+        stackReq = std::max<int64_t>(metric.num_stack_arguments, stackReq - delta);
+        stackGrowth = std::max(delta, delta + stackGrowth);
+        if (i + 1 < m_blockPCs.size())
+            gas += metric.gas_cost;
+
+        if (i == 0 || op == Instruction::JUMPDEST)
+        {
+            m_blocks[--block] = Block{gas, int32_t(stackReq), int32_t(stackGrowth), next};
+            if (op == Instruction::JUMPDEST)
+                m_jumpDestBlocks[--jumpDest] = block;
+        }
+    }
+    m_blockPCs.clear();
+}
+
+// Replaces the opcode at _pc by a superinstruction running it and the one at _nextPC. The
+// case reads the fused opcodes from the original code.
+void VM::fuse(uint64_t _pc, uint64_t _nextPC)
+{
+    Instruction const op = Instruction(m_code[_pc]);
+    Instruction const nextOp = Instruction(m_code[_nextPC]);
+    Instruction fused = op;
+    if (Instruction::PUSH1 <= op && op <= Instruction::PUSH32)
+    {
+        if (nextOp == Instruction::JUMP)
+            fused = Instruction::PUSHJUMP;
+        else if (nextOp == Instruction::JUMPI)
+            fused = Instruction::PUSHJUMPI;
+        else if (nextOp == Instruction::ADD)
+            fused = Instruction::PUSHADD;
+        else if (nextOp == Instruction::MSTORE)
+            fused = Instruction::PUSHMSTORE;
+    }
+    else if (Instruction::DUP1 <= op && op <= Instruction::DUP16 &&
+             Instruction::SWAP1 <= nextOp && nextOp <= Instruction::SWAP16)
+        fused = Instruction::DUPSWAP;
+
+    if (fused != op)
+    {
+        TRACE_PRE_OPT(1, _pc, op);
+        m_code[_pc] = (byte)fused;
+        TRACE_POST_OPT(1, _pc, fused);
+    }
+}
+
+// A block whose gas or stack bounds fail on entry. Check its instructions one at a time from
+// m_PC, as fetchInstruction() and the cases would, and throw at the first failure. The gas of
+// a dynamic instruction depends on its operands: when one comes first, charge up to it and
+// resume after it has run.
+void VM::resumeBlock()
+{
+    m_resumePC = c_noResume;
+    int64_t height = m_stackEnd - m_SPP;
+    uint64_t gas = 0;
+    for (uint64_t pc = m_PC;;)
+    {
+        Instruction op = codeAt(pc);
+        auto const& metric = c_metrics[(size_t)op];
+        if (height < metric.num_stack_arguments ||
+            height - metric.num_stack_arguments + metric.num_stack_returned_items >
+                VMSchedule::stackLimit)
+            throwBadStack(height, metric.num_stack_arguments, metric.num_stack_returned_items);
+        height += metric.num_stack_returned_items - metric.num_stack_arguments;
+
+        OpKind const kind = blockKind(op);
+        if (kind == OpKind::Terminator)
+            break;
+        if (m_io_gas - gas < uint64_t(metric.gas_cost))
+            throwOutOfGas();
+        gas += metric.gas_cost;
+        if (kind == OpKind::Dynamic)
+        {
+            m_resumePC = pc + 1;
+            break;
+        }
+        pc += 1 + pushBytes(op);
+    }
+    m_io_gas -= gas;
 }
 
 
@@ -173,27 +394,9 @@ void VM::initEntry()
     m_bounce = &VM::interpretCases;
     initMetrics();
     optimize();
+    m_nextBlock = 0;
+    m_resumePC = c_noResume;
 }
 
-
-// Implementation of EXP.
-//
-// This implements exponentiation by squaring algorithm.
-// Is faster than boost::multiprecision::powm() because it avoids explicit
-// mod operation.
-// Do not inline it.
-u256 VM::exp256(u256 _base, u256 _exponent)
-{
-    using boost::multiprecision::limb_type;
-    u256 result = 1;
-    while (_exponent)
-    {
-        if (static_cast<limb_type>(_exponent) & 1)  // If exponent is odd.
-            result *= _base;
-        _base *= _base;
-        _exponent >>= 1;
-    }
-    return result;
-}
 }  // namespace eth
 }  // namespace dev
@@ -21,4 +21,16 @@ EVMC_EXPORT struct evmc_instance* evmc_create_interpreter() EVMC_NOEXCEPT;
 
 #if __cplusplus
 }
+
+#include <libdevcore/Common.h>
+
+namespace dev
+{
+namespace eth
+{
+/// Moves the output buffer of a result returned by this interpreter into o_output and disarms
+/// the result's release. @returns false, leaving o_output untouched, for results of other VMs.
+bool takeInterpreterOutput(evmc_result& _result, bytes& o_output);
+}  // namespace eth
+}  // namespace dev
 #endif
@@ -57,27 +57,30 @@ void DBInitializer::initLevelDBStorage()
 {
     DBInitializer_LOG(INFO) << "[#initStorageDB] [#initLevelDBStorage] ..." << std::endl;
     /// open and init the levelDB
-    leveldb::Options ldb_option;
-    leveldb::DB* pleveldb = nullptr;
+    StorageParam const& storageParam = m_param->mutableStorageParam();
+    LevelDBConfig config;
+    config.cacheSize = storageParam.cacheSize;
+    config.bloomFilterBits = storageParam.bloomFilterBits;
+    config.writeBufferSize = storageParam.writeBufferSize;
+    config.blockSize = storageParam.blockSize;
+    config.maxOpenFiles = storageParam.maxOpenFiles;
+    config.compression = storageParam.compression;
     try
     {
         boost::filesystem::create_directories(m_param->baseDir());
-        ldb_option.create_if_missing = true;
-        ldb_option.max_open_files = 100;
         DBInitializer_LOG(DEBUG) << "[#initStorageDB] [#initLevelDBStorage]: open leveldb handler"
                                  << std::endl;
-        leveldb::Status status = leveldb::DB::Open(ldb_option, m_param->baseDir(), &(pleveldb));
+        std::shared_ptr<LevelDBStorage> leveldb_storage = std::make_shared<LevelDBStorage>();
+        leveldb::Status status = leveldb_storage->open(m_param->baseDir(), config);
         if (!status.ok())
         {
-            DBInitializer_LOG(ERROR) << "[#initStorageDB] [openLevelDBStorage failed]" << std::endl;
+            DBInitializer_LOG(ERROR) << "[#initStorageDB] [openLevelDBStorage failed] [EINFO]: "
+                                     << status.ToString() << std::endl;
             return;
         }
         DBInitializer_LOG(DEBUG) << "[#initStorageDB] [#initLevelDBStorage] [status]: "
                                  << status.ok() << std::endl;
-        std::shared_ptr<LevelDBStorage> leveldb_storage = std::make_shared<LevelDBStorage>();
-        assert(leveldb_storage);
-        std::shared_ptr<leveldb::DB> leveldb_handler = std::shared_ptr<leveldb::DB>(pleveldb);
-        leveldb_storage->setDB(leveldb_handler);
+        leveldb_storage->setHistoryBlocks(m_param->mutableStorageParam().historyBlocks);
         m_storage = leveldb_storage;
     }
     catch (std::exception& e)
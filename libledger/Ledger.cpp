@@ -104,8 +104,10 @@ void Ledger::initConfig(std::string const& configPath)
 void Ledger::initTxPoolConfig(ptree const& pt)
 {
     m_param->mutableTxPoolParam().txPoolLimit = pt.get<uint64_t>("txPool.limit", 102400);
-    Ledger_LOG(DEBUG) << "[#initTxPoolConfig] [limit]:  "
-                      << m_param->mutableTxPoolParam().txPoolLimit << std::endl;
+    m_param->mutableTxPoolParam().ingressThreads = pt.get<size_t>("txPool.ingressThreads", 4);
+    Ledger_LOG(DEBUG) << "[#initTxPoolConfig] [limit/ingressThreads]:  "
+                      << m_param->mutableTxPoolParam().txPoolLimit << "/"
+                      << m_param->mutableTxPoolParam().ingressThreads << std::endl;
 }
 
 /// init consensus configurations:
@@ -161,6 +163,15 @@ void Ledger::initSyncConfig(ptree const& pt)
 /// dbType: leveldb/AMDB, storage type, default is "AMDB"
 /// mpt: true/false, enable mpt or not, default is true
 /// dbpath: data to place all data of the group, default is "data"
+/// historyBlocks: recent blocks whose state stays readable, the older versions are pruned in the
+/// background, default is 10000; 0 keeps every version
+/// [storage]: leveldb engine settings
+/// cacheSize: MB of block cache, default is 128
+/// bloomFilterBits: bits per key of the bloom filters, 0 disables them, default is 10
+/// writeBufferSize: MB of memtable, default is 32
+/// blockSize: KB per table block, default is 4
+/// maxOpenFiles: default is 1000
+/// compression: snappy compression of the tables, default is true
 void Ledger::initDBConfig(ptree const& pt)
 {
     /// init the basic config
@@ -168,8 +179,28 @@ void Ledger::initDBConfig(ptree const& pt)
     m_param->setMptState(pt.get<bool>("statedb.mpt", true));
     std::string baseDir = m_param->baseDir() + "/" + pt.get<std::string>("statedb.dbpath", "data");
     m_param->setBaseDir(baseDir);
-    Ledger_LOG(DEBUG) << "[#initDBConfig] [type/enableMpt/baseDir]: " << m_param->dbType() << "/"
-                      << m_param->enableMpt() << "/" << baseDir << std::endl;
+    StorageParam& storageParam = m_param->mutableStorageParam();
+    storageParam.historyBlocks = pt.get<int64_t>("statedb.historyBlocks", 10000);
+    storageParam.blockStore = pt.get<bool>("statedb.blockStore", true);
+    storageParam.blocksPerSegment = pt.get<uint64_t>("statedb.blocksPerSegment", 10000);
+    storageParam.keepBlocks = pt.get<int64_t>("statedb.keepBlocks", 0);
+    storageParam.cacheSize = pt.get<size_t>("storage.cacheSize", 128);
+    storageParam.bloomFilterBits = pt.get<int>("storage.bloomFilterBits", 10);
+    storageParam.writeBufferSize = pt.get<size_t>("storage.writeBufferSize", 32);
+    storageParam.blockSize = pt.get<size_t>("storage.blockSize", 4);
+    storageParam.maxOpenFiles = pt.get<int>("storage.maxOpenFiles", 1000);
+    storageParam.compression = pt.get<bool>("storage.compression", true);
+    Ledger_LOG(DEBUG) << "[#initDBConfig] [type/enableMpt/baseDir/historyBlocks/blockStore/"
+                         "blocksPerSegment/keepBlocks]: "
+                      << m_param->dbType() << "/" << m_param->enableMpt() << "/" << baseDir << "/"
+                      << storageParam.historyBlocks << "/" << storageParam.blockStore << "/"
+                      << storageParam.blocksPerSegment << "/" << storageParam.keepBlocks
+                      << std::endl;
+    Ledger_LOG(DEBUG) << "[#initDBConfig] [cacheSize/bloomFilterBits/writeBufferSize/blockSize/"
+                         "maxOpenFiles/compression]: "
+                      << storageParam.cacheSize << "/" << storageParam.bloomFilterBits << "/"
+                      << storageParam.writeBufferSize << "/" << storageParam.blockSize << "/"
+                      << storageParam.maxOpenFiles << "/" << storageParam.compression << std::endl;
 }
 
 /// init genesis configuration
@@ -191,8 +222,10 @@ bool Ledger::initTxPool()
         Ledger_LOG(ERROR) << "[#initLedger] [#initTxPool Failed]" << std::endl;
         return false;
     }
-    m_txPool = std::make_shared<dev::txpool::TxPool>(
+    auto txPool = std::make_shared<dev::txpool::TxPool>(
         m_service, m_blockChain, protocol_id, m_param->mutableTxPoolParam().txPoolLimit);
+    txPool->setIngressThreads(m_param->mutableTxPoolParam().ingressThreads);
+    m_txPool = txPool;
     Ledger_LOG(DEBUG) << "[#initLedger] [#initTxPool SUCC] [Protocol ID]:  " << protocol_id
                       << std::endl;
     return true;
@@ -213,6 +246,8 @@ bool Ledger::initBlockVerifier()
     std::shared_ptr<BlockChainImp> blockChain =
         std::dynamic_pointer_cast<BlockChainImp>(m_blockChain);
     blockVerifier->setNumberHash(boost::bind(&BlockChainImp::numberHash, blockChain, _1));
+    /// learns the execution time of transactions for the sealer
+    blockVerifier->setCostModel(std::make_shared<ExecutionCostModel>());
     m_blockVerifier = blockVerifier;
     Ledger_LOG(DEBUG) << "[#initLedger] [#initBlockVerifier SUCC]" << std::endl;
     return true;
@@ -228,6 +263,22 @@ bool Ledger::initBlockChain()
     }
     std::shared_ptr<BlockChainImp> blockChain = std::make_shared<BlockChainImp>();
     blockChain->setStateStorage(m_dbInitializer->storage());
+    StorageParam const& storageParam = m_param->mutableStorageParam();
+    if (storageParam.blockStore)
+    {
+        try
+        {
+            blockChain->setBlockStore(std::make_shared<BlockStore>(
+                m_param->baseDir() + "/blocks", storageParam.blocksPerSegment));
+            blockChain->setKeepBlocks(storageParam.keepBlocks);
+        }
+        catch (std::exception& e)
+        {
+            Ledger_LOG(ERROR) << "[#initLedger] [#initBlockChain Failed] [EINFO]: "
+                              << boost::diagnostic_information(e);
+            return false;
+        }
+    }
     m_blockChain = blockChain;
     m_blockChain->setGroupMark(m_param->mutableGenesisParam().genesisMark);
     Ledger_LOG(DEBUG) << "[#initLedger] [#initBlockChain SUCC]";
@@ -261,6 +312,13 @@ std::shared_ptr<Sealer> Ledger::createPBFTSealer()
         std::dynamic_pointer_cast<PBFTEngine>(pbftSealer->consensusEngine());
     pbftEngine->setIntervalBlockTime(m_param->mutableConsensusParam().intervalBlockTime);
     pbftEngine->setStorage(m_dbInitializer->storage());
+    /// pack by the execution time predicted from the blocks executed so far
+    auto blockVerifier = std::dynamic_pointer_cast<BlockVerifier>(m_blockVerifier);
+    if (blockVerifier && blockVerifier->costModel())
+    {
+        pbftSealer->setCostModel(blockVerifier->costModel());
+        pbftEngine->setCostModel(blockVerifier->costModel());
+    }
     return pbftSealer;
 }
 
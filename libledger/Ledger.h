@@ -117,6 +117,10 @@ public:
     std::shared_ptr<dev::sync::SyncInterface> sync() const override { return m_sync; }
     virtual dev::GROUP_ID const& groupId() const { return m_groupId; }
     std::shared_ptr<LedgerParamInterface> getParam() const override { return m_param; }
+    dev::storage::Storage::Ptr storage() const override
+    {
+        return m_dbInitializer ? m_dbInitializer->storage() : nullptr;
+    }
 
 protected:
     void initConfig(std::string const& configPath) override;
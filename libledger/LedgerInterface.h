@@ -27,6 +27,7 @@
 #include <libblockverifier/BlockVerifierInterface.h>
 #include <libconsensus/ConsensusInterface.h>
 #include <libethcore/Protocol.h>
+#include <libstorage/Storage.h>
 #include <libsync/SyncInterface.h>
 #include <libtxpool/TxPoolInterface.h>
 #include <memory>
@@ -50,6 +51,8 @@ public:
     virtual std::shared_ptr<dev::sync::SyncInterface> sync() const = 0;
     virtual dev::GROUP_ID const& groupId() const = 0;
     virtual std::shared_ptr<LedgerParamInterface> getParam() const = 0;
+    /// the storage under the state and the blocks, nullptr if the ledger has none
+    virtual dev::storage::Storage::Ptr storage() const { return nullptr; }
     virtual void startAll() = 0;
     virtual void stopAll() = 0;
 };
@@ -160,6 +160,13 @@ public:
             return nullptr;
         return m_ledgerMap[groupId]->sync();
     }
+    /// get pointer of storage by group id
+    inline dev::storage::Storage::Ptr storage(dev::GROUP_ID const& groupId)
+    {
+        if (!m_ledgerMap.count(groupId))
+            return nullptr;
+        return m_ledgerMap[groupId]->storage();
+    }
     /// get ledger params by group id
     inline std::shared_ptr<LedgerParamInterface> getParamByGroupId(dev::GROUP_ID const& groupId)
     {
@@ -35,6 +35,8 @@ namespace ledger
 struct TxPoolParam
 {
     uint64_t txPoolLimit;
+    /// threads recovering the senders of the transactions sent through RPC
+    size_t ingressThreads = 4;
 };
 struct ConsensusParam
 {
@@ -51,6 +53,25 @@ struct AMDBParam
     int maxRetry = 0;
 };
 
+struct StorageParam
+{
+    /// number of recent blocks whose state stays readable, the older versions are pruned in the
+    /// background; 0 keeps every version and the state db grows without bound
+    int64_t historyBlocks = 10000;
+    /// keep the blocks in a BlockStore under <baseDir>/blocks instead of the state db
+    bool blockStore = true;
+    uint64_t blocksPerSegment = 10000;
+    /// number of recent blocks kept in the BlockStore, 0 keeps them all
+    int64_t keepBlocks = 0;
+    /// leveldb engine settings, see dev::storage::LevelDBConfig
+    size_t cacheSize = 128;
+    int bloomFilterBits = 10;
+    size_t writeBufferSize = 32;
+    size_t blockSize = 4;
+    int maxOpenFiles = 1000;
+    bool compression = true;
+};
+
 struct SyncParam
 {
     /// TODO: syncParam related
@@ -70,6 +91,7 @@ public:
     SyncParam& mutableSyncParam() override { return m_syncParam; }
     GenesisParam& mutableGenesisParam() override { return m_genesisParam; }
     AMDBParam& mutableAMDBParam() override { return m_amdbParam; }
+    StorageParam& mutableStorageParam() override { return m_storageParam; }
     std::string const& dbType() const override { return m_dbType; }
     bool enableMpt() const override { return m_enableMpt; }
     void setMptState(bool mptState) override { m_enableMpt = mptState; }
@@ -87,6 +109,7 @@ private:
     SyncParam m_syncParam;
     GenesisParam m_genesisParam;
     AMDBParam m_amdbParam;
+    StorageParam m_storageParam;
     std::string m_dbType;
     bool m_enableMpt;
     std::string m_baseDir;
@@ -39,6 +39,7 @@ struct P2pParam;
 /// struct GenesisParam;
 struct GenesisParam;
 struct AMDBParam;
+struct StorageParam;
 class LedgerParamInterface
 {
 public:
@@ -49,6 +50,7 @@ public:
     virtual SyncParam& mutableSyncParam() = 0;
     virtual GenesisParam& mutableGenesisParam() = 0;
     virtual AMDBParam& mutableAMDBParam() = 0;
+    virtual StorageParam& mutableStorageParam() = 0;
     virtual std::string const& dbType() const = 0;
     virtual bool enableMpt() const = 0;
     virtual void setMptState(bool mptState) = 0;
@@ -21,6 +21,8 @@
 
 #include "Common.h"
 #include "Network.h"
+#include <cryptopp/zdeflate.h>
+#include <cryptopp/zinflate.h>
 #include <libdevcore/CommonIO.h>
 
 using namespace std;
@@ -28,6 +30,21 @@ using namespace dev;
 using namespace dev::p2p;
 unsigned dev::p2p::c_defaultIPPort = 16789;
 bool dev::p2p::NodeIPEndpoint::test_allowLocal = false;
+std::atomic<size_t> dev::p2p::Message::s_compressThreshold = {0};
+CompressStatistics dev::p2p::Message::s_compressStatistics;
+
+namespace
+{
+/// compressed input handed to the inflater at a time. Deflate expands at most about 1032:1, so
+/// a chunk inflates to about MAX_LENGTH at most before the output is checked
+size_t const c_inflateChunk = 1024;
+
+uint64_t microsecondsSince(chrono::steady_clock::time_point const& _start)
+{
+    return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - _start)
+        .count();
+}
+}  // namespace
 
 bool p2p::isPublicAddress(std::string const& _addressToCheck)
 {
@@ -95,21 +112,57 @@ std::string p2p::reasonOf(DisconnectReason _r)
     }
 }
 
-void Message::encode(bytes& buffer)
+void Message::encode(bytes& buffer, bool _compress)
 {
     buffer.clear();  ///< It is not allowed to be assembled outside.
-    m_length = HEADER_LENGTH + m_buffer->size();
+    buffer.resize(HEADER_LENGTH);
+
+    PACKET_TYPE packetType = m_packetType;
+    size_t threshold = s_compressThreshold;
+    if (_compress && threshold > 0 && m_buffer->size() >= threshold && m_buffer->size() <= MAX_LENGTH &&
+        compress(buffer))
+        packetType |= COMPRESS_FLAG;
+    else
+        buffer.insert(buffer.end(), m_buffer->begin(), m_buffer->end());
+    m_length = buffer.size();
 
     uint32_t length = htonl(m_length);
     PROTOCOL_ID protocolID = htons(m_protocolID);
-    PACKET_TYPE packetType = htons(m_packetType);
+    packetType = htons(packetType);
     uint32_t seq = htonl(m_seq);
 
-    buffer.insert(buffer.end(), (byte*)&length, (byte*)&length + sizeof(length));
-    buffer.insert(buffer.end(), (byte*)&protocolID, (byte*)&protocolID + sizeof(protocolID));
-    buffer.insert(buffer.end(), (byte*)&packetType, (byte*)&packetType + sizeof(packetType));
-    buffer.insert(buffer.end(), (byte*)&seq, (byte*)&seq + sizeof(seq));
-    buffer.insert(buffer.end(), m_buffer->begin(), m_buffer->end());
+    byte* header = buffer.data();
+    memcpy(header, &length, sizeof(length));
+    header += sizeof(length);
+    memcpy(header, &protocolID, sizeof(protocolID));
+    header += sizeof(protocolID);
+    memcpy(header, &packetType, sizeof(packetType));
+    header += sizeof(packetType);
+    memcpy(header, &seq, sizeof(seq));
+}
+
+bool Message::compress(bytes& _out)
+{
+    auto start = chrono::steady_clock::now();
+    CryptoPP::Deflator deflator(nullptr, CryptoPP::Deflator::MIN_DEFLATE_LEVEL);
+    deflator.Put(m_buffer->data(), m_buffer->size());
+    deflator.MessageEnd();
+    size_t compressedSize = deflator.MaxRetrievable();
+    bool shrunk = compressedSize + sizeof(uint32_t) < m_buffer->size();
+    if (shrunk)
+    {
+        uint32_t rawLength = htonl(m_buffer->size());
+        size_t offset = _out.size();
+        _out.resize(offset + sizeof(rawLength) + compressedSize);
+        memcpy(&_out[offset], &rawLength, sizeof(rawLength));
+        deflator.Get(&_out[offset + sizeof(rawLength)], compressedSize);
+
+        s_compressStatistics.compressedPackets++;
+        s_compressStatistics.rawBytes += m_buffer->size();
+        s_compressStatistics.compressedBytes += sizeof(rawLength) + compressedSize;
+    }
+    s_compressStatistics.compressMicroseconds += microsecondsSince(start);
+    return shrunk;
 }
 
 ssize_t Message::decode(const byte* buffer, size_t size)
@@ -131,6 +184,10 @@ ssize_t Message::decode(const byte* buffer, size_t size)
     {
         return PACKET_INCOMPLETE;
     }
+    if (m_length < HEADER_LENGTH)
+    {
+        return PACKET_ERROR;
+    }
 
     offset += sizeof(m_length);
     m_protocolID = ntohs(*((PROTOCOL_ID*)&buffer[offset]));
@@ -138,12 +195,79 @@ ssize_t Message::decode(const byte* buffer, size_t size)
     m_packetType = ntohs(*((PACKET_TYPE*)&buffer[offset]));
     offset += sizeof(m_packetType);
     m_seq = ntohl(*((uint32_t*)&buffer[offset]));
+
+    if (m_packetType & COMPRESS_FLAG)
+    {
+        m_packetType &= ~COMPRESS_FLAG;
+        if (!decompress(&buffer[HEADER_LENGTH], m_length - HEADER_LENGTH))
+        {
+            return PACKET_ERROR;
+        }
+        return m_length;
+    }
     ///< TODO: assign to std::move
     m_buffer->assign(&buffer[HEADER_LENGTH], &buffer[HEADER_LENGTH] + m_length - HEADER_LENGTH);
 
     return m_length;
 }
 
+bool Message::decompress(const byte* _data, size_t _size)
+{
+    if (_size < sizeof(uint32_t))
+    {
+        return false;
+    }
+    auto start = chrono::steady_clock::now();
+    size_t rawLength = ntohl(*((uint32_t*)_data));
+    if (rawLength > MAX_LENGTH)
+    {
+        LOG(WARNING) << "Message::decompress refuses inflated length " << rawLength;
+        return false;
+    }
+    _data += sizeof(uint32_t);
+    _size -= sizeof(uint32_t);
+
+    /// the length is the peer's claim, the buffer only grows with the output actually inflated
+    m_buffer->clear();
+    size_t inflated = 0;
+    try
+    {
+        CryptoPP::Inflator inflator;
+        size_t consumed = 0;
+        do
+        {
+            size_t chunk = std::min(c_inflateChunk, _size - consumed);
+            inflator.Put(_data + consumed, chunk);
+            consumed += chunk;
+            if (consumed == _size)
+                inflator.MessageEnd();
+
+            size_t ready = inflator.MaxRetrievable();
+            if (ready > rawLength - inflated)
+            {
+                LOG(WARNING) << "Message::decompress payload exceeds its length " << rawLength;
+                return false;
+            }
+            m_buffer->resize(inflated + ready);
+            inflator.Get(m_buffer->data() + inflated, ready);
+            inflated += ready;
+        } while (consumed < _size);
+    }
+    catch (std::exception const& e)
+    {
+        LOG(WARNING) << "Message::decompress failed: " << e.what();
+        return false;
+    }
+
+    if (inflated != rawLength)
+    {
+        return false;
+    }
+    s_compressStatistics.decompressedPackets++;
+    s_compressStatistics.decompressMicroseconds += microsecondsSince(start);
+    return true;
+}
+
 void Message::encodeAMOPBuffer(std::string const& topic)
 {
     ///< check protocolID is AMOP message or not
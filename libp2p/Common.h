@@ -31,6 +31,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <future>
 #include <set>
 #include <string>
 #include <vector>
@@ -104,11 +106,12 @@ enum P2PExceptionType
     ProtocolError,
     NetworkTimeout,
     Disconnect,
+    Cancelled,
     P2PExceptionTypeCnt
 };
 
 static std::string g_P2PExceptionMsg[P2PExceptionTypeCnt] = {
-    "Success", "ProtocolError", "NetworkTimeout", "Disconnect"};
+    "Success", "ProtocolError", "NetworkTimeout", "Disconnect", "Cancelled"};
 
 enum PacketDecodeStatus
 {
@@ -118,9 +121,20 @@ enum PacketDecodeStatus
 
 struct Options
 {
-    uint32_t subTimeout;  ///< The timeout value of every node, used in send message to topic, in
-                          ///< milliseconds.
-    uint32_t timeout;     ///< The timeout value of async function, in milliseconds.
+    uint32_t subTimeout = 0;  ///< The timeout value of every node, used in send message to topic,
+                              ///< in milliseconds.
+    uint32_t timeout = 0;     ///< The timeout value of async function, in milliseconds, 0 for none.
+};
+
+/// counters of the payload compression done in Message::encode and Message::decode
+struct CompressStatistics
+{
+    std::atomic<uint64_t> compressedPackets = {0};       ///< packets sent compressed
+    std::atomic<uint64_t> rawBytes = {0};                ///< their payload size before
+    std::atomic<uint64_t> compressedBytes = {0};         ///< their payload size on the wire
+    std::atomic<uint64_t> compressMicroseconds = {0};    ///< includes payloads kept raw
+    std::atomic<uint64_t> decompressedPackets = {0};     ///< compressed packets received
+    std::atomic<uint64_t> decompressMicroseconds = {0};  ///< time spent inflating them
 };
 
 class Message : public std::enable_shared_from_this<Message>
@@ -130,6 +144,9 @@ public:
 
     const static size_t HEADER_LENGTH = 12;
     const static size_t MAX_LENGTH = 1024 * 1024;  ///< The maximum length of data is 1M.
+    /// set on the packet type of the wire header when the payload is deflated, in which case the
+    /// payload starts with the inflated length (4 bytes, network order), at most MAX_LENGTH
+    const static PACKET_TYPE COMPRESS_FLAG = 0x8000;
 
     Message() { m_buffer = std::make_shared<bytes>(); }
 
@@ -158,7 +175,17 @@ public:
             return 0;
     }
 
-    void encode(bytes& buffer);
+    /// @param _compress : whether the peer announced AMOPPacketType::CompressSupport, a payload
+    /// is only deflated toward such a peer
+    void encode(bytes& buffer, bool _compress = false);
+
+    /// payloads at least _threshold bytes and at most MAX_LENGTH long are deflated by encode; 0
+    /// (the default) disables compression. There is no other negotiation: a node compresses
+    /// only toward the peers whose session announced CompressSupport, older peers get raw
+    /// payloads.
+    static void setCompressThreshold(size_t _threshold) { s_compressThreshold = _threshold; }
+    static size_t compressThreshold() { return s_compressThreshold; }
+    static CompressStatistics& compressStatistics() { return s_compressStatistics; }
 
     /// < If the decoding is successful, the length of the decoded data is returned; otherwise, 0 is
     /// returned.
@@ -190,7 +217,15 @@ public:
     }
 
 private:
-    uint32_t m_length = 0;            ///< m_length = HEADER_LENGTH + length(m_buffer)
+    /// deflate m_buffer behind the inflated length, false if it does not get smaller
+    bool compress(bytes& _out);
+    /// inflate _data straight into m_buffer
+    bool decompress(const byte* _data, size_t _size);
+
+    static std::atomic<size_t> s_compressThreshold;
+    static CompressStatistics s_compressStatistics;
+
+    uint32_t m_length = 0;            ///< m_length = HEADER_LENGTH + length of the wire payload
     PROTOCOL_ID m_protocolID = 0;     ///< message type, the first two bytes of information, when
                                       ///< greater than 0 is the ID of the request package.
     PACKET_TYPE m_packetType = 0;     ///< message sub type, the second two bytes of information
@@ -202,7 +237,9 @@ enum AMOPPacketType
 {
     SendTopicSeq = 1,
     RequestTopics = 2,
-    SendTopics = 3
+    SendTopics = 3,
+    ///< sent as a session starts: the sender inflates COMPRESS_FLAG payloads, older nodes drop it
+    CompressSupport = 4
 };
 
 class MessageFactory : public std::enable_shared_from_this<MessageFactory>
@@ -243,23 +280,89 @@ struct ResponseCallback : public std::enable_shared_from_this<ResponseCallback>
     std::shared_ptr<boost::asio::deadline_timer> timeoutHandler;
 };
 
-struct SessionCallback : public std::enable_shared_from_this<SessionCallback>
+/// The response to a request of P2PInterface::requestByNodeID or requestByTopic. It is completed
+/// once, by the response, the deadline, a disconnection or cancel(); the first outcome wins.
+class ResponseFuture
 {
 public:
-    typedef std::shared_ptr<SessionCallback> Ptr;
+    typedef std::shared_ptr<ResponseFuture> Ptr;
 
-    SessionCallback() { mutex.lock(); }
+    ResponseFuture() : m_future(m_promise.get_future().share()) {}
 
-    void onResponse(P2PException _error, Message::Ptr _message)
+    /// wait for the response, throws the P2PException the request failed with
+    Message::Ptr get() const { return m_future.get(); }
+    /// false if the request is still pending after _timeout
+    bool waitFor(std::chrono::milliseconds const& _timeout) const
     {
-        error = _error;
-        response = _message;
-        mutex.unlock();
+        return m_future.wait_for(_timeout) == std::future_status::ready;
     }
 
-    P2PException error;
-    Message::Ptr response;
-    std::mutex mutex;
+    /// run _callback with the outcome, on the thread completing the request or at once if it is
+    /// complete, so that no thread has to wait for the round trip
+    void then(CallbackFunc const& _callback)
+    {
+        {
+            Guard l(x_state);
+            if (!m_done)
+            {
+                m_callbacks.push_back(_callback);
+                return;
+            }
+        }
+        _callback(m_error, m_response);
+    }
+
+    /// drop the request: get() throws a Cancelled P2PException and a late response is ignored
+    void cancel()
+    {
+        std::function<void()> onCancel;
+        {
+            Guard l(x_state);
+            onCancel = m_onCancel;
+        }
+        P2PException e(P2PExceptionType::Cancelled, g_P2PExceptionMsg[P2PExceptionType::Cancelled]);
+        if (complete(e, Message::Ptr()) && onCancel)
+            onCancel();
+    }
+
+    /// called by the sender with the outcome, @returns false if the request is already complete
+    bool complete(P2PException _error, Message::Ptr _response)
+    {
+        std::vector<CallbackFunc> callbacks;
+        {
+            Guard l(x_state);
+            if (m_done)
+                return false;
+            m_done = true;
+            m_error = _error;
+            m_response = _response;
+            m_onCancel = nullptr;
+            callbacks.swap(m_callbacks);
+        }
+        if (_error.errorCode() != 0)
+            m_promise.set_exception(std::make_exception_ptr(_error));
+        else
+            m_promise.set_value(_response);
+        for (auto const& callback : callbacks)
+            callback(_error, _response);
+        return true;
+    }
+    /// how the sender drops the pending request on cancel()
+    void setOnCancel(std::function<void()> const& _onCancel)
+    {
+        Guard l(x_state);
+        m_onCancel = _onCancel;
+    }
+
+private:
+    mutable Mutex x_state;
+    bool m_done = false;
+    P2PException m_error;
+    Message::Ptr m_response;
+    std::vector<CallbackFunc> m_callbacks;
+    std::function<void()> m_onCancel;
+    std::promise<Message::Ptr> m_promise;
+    std::shared_future<Message::Ptr> m_future;
 };
 
 /// @returns the string form of the given disconnection reason.
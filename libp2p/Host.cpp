@@ -107,6 +107,8 @@ void Host::start()
     DEV_TIMED_FUNCTION_ABOVE(500);
     /// set the thread pool for the session
     m_threadPool = std::make_shared<dev::ThreadPool>("SessionCallBackThreadPool", 8);
+    /// the handlers of the sessions wait in bounded queues, consensus first
+    m_dispatcher = std::make_shared<MessageDispatcher>(m_threadPool, m_dispatchQueueCapacity);
     /// implemented by the parent class Worker(libdevcore/Worker.*)
     startWorking();
     /// check the network and worker thread status
@@ -506,11 +508,21 @@ void Host::startPeerSession(Public const& _pub, std::shared_ptr<SocketFace> cons
             return;
         }
         ps->setThreadPool(m_threadPool);
+        ps->setDispatcher(m_dispatcher);
         /// set P2PMsgHandler to session before start session
         ps->setP2PMsgHandler(m_p2pMsgHandler);
         /// start session and modify m_sessions
         ps->start();
+        /// announce that this node inflates compressed payloads, see Message::encode
+        Message::Ptr msg = std::make_shared<Message>();
+        msg->setProtocolID(dev::eth::ProtocolID::AMOP);
+        msg->setPacketType(AMOPPacketType::CompressSupport);
+        msg->setLength(Message::HEADER_LENGTH);
+        std::shared_ptr<bytes> msgBuf = std::make_shared<bytes>();
+        msg->encode(*msgBuf);
+        ps->send(msgBuf);
         m_sessions[node_id] = ps;
+        onSessionsChanged();
         /// update the staticNodes
         HOST_LOG(INFO) << "[#startPeerSession] update staticNodes: [ip:port/nodeId]:  "
                        << _s->remoteEndpoint().address().to_string() << ":"
@@ -574,6 +586,7 @@ void Host::keepAlivePeers()
             HOST_LOG(WARNING) << "[#keepAlivePeers] Erase unconnected Session: [nodeId]:  "
                               << toHex(p->id());
             it = m_sessions.erase(it);
+            onSessionsChanged();
         }
     }
     /// update peers according the current-alive sessions
@@ -25,6 +25,7 @@
 
 #include "AsioInterface.h"
 #include "Common.h"
+#include "MessageDispatcher.h"
 #include "Network.h"
 #include "P2pFactory.h"
 #include "Peer.h"
@@ -89,6 +90,10 @@ public:
 
     /// get mutex of sessions
     RecursiveMutex& mutexSessions() { return x_sessions; }
+    /// moves on whenever sessions, their topics or the group members change; views derived
+    /// from the sessions (e.g. the peers of a group in Service) are rebuilt when it does
+    uint64_t sessionsVersion() const { return m_sessionsVersion; }
+    void onSessionsChanged() { ++m_sessionsVersion; }
     /// get m_staticNodes
     std::map<NodeIPEndpoint, NodeID>* staticNodes() { return &m_staticNodes; }
     /// get the peer slots
@@ -149,7 +154,12 @@ public:
     virtual void setThreadPool(std::shared_ptr<dev::ThreadPool> threadPool)
     {
         m_threadPool = threadPool;
+        m_dispatcher = std::make_shared<MessageDispatcher>(m_threadPool, m_dispatchQueueCapacity);
     }
+    /// set the capacity of the handler queue of each protocol, before start()
+    void setDispatchQueueCapacity(size_t capacity) { m_dispatchQueueCapacity = capacity; }
+    /// the queues the message handlers of all sessions wait in for the thread pool
+    MessageDispatcher::Ptr dispatcher() const { return m_dispatcher; }
 
     ///------ Network and worker threads related ------
     /// the working entry of libp2p(called by when init FISCO-BCOS to start the p2p network)
@@ -188,7 +198,8 @@ public:
     std::shared_ptr<SessionFace> peerSession(NodeID const& _id)
     {
         RecursiveGuard l(x_sessions);
-        return m_sessions.count(_id) ? m_sessions[_id] : nullptr;
+        auto it = m_sessions.find(_id);
+        return it != m_sessions.end() ? it->second : nullptr;
     }
     bytes saveNetwork() const;
 
@@ -204,6 +215,7 @@ public:
                 p->disconnect(DisconnectReason::UserReason);
                 m_sessions.erase(it);
                 m_peers.erase(p->id());
+                onSessionsChanged();
                 return true;
             }
         }
@@ -234,6 +246,7 @@ public:
             return;
         }
         m_groupID2NodeList = _groupID2NodeList;
+        onSessionsChanged();
     }
 
     ///< If I joined this group, return true and node members for this group.
@@ -342,6 +355,8 @@ protected:  /// protected members(for unit testing)
     std::unordered_map<NodeID, std::shared_ptr<Peer>> m_peers;
     /// mutex for accepting session information m_sessions and m_peers
     mutable RecursiveMutex x_sessions;
+    /// see sessionsVersion()
+    std::atomic<uint64_t> m_sessionsVersion = {0};
     /// control reconnecting, if set to be true, will reconnect peers immediately
     bool m_reconnectnow = true;
     /// mutex for m_reconnectnow
@@ -373,6 +388,8 @@ protected:  /// protected members(for unit testing)
     uint32_t m_topicSeq;
 
     std::shared_ptr<dev::ThreadPool> m_threadPool;
+    MessageDispatcher::Ptr m_dispatcher;
+    size_t m_dispatchQueueCapacity = MessageDispatcher::c_defaultQueueCapacity;
     ///< Topics being concerned by myself
     std::shared_ptr<std::vector<std::string>> m_topics;
 
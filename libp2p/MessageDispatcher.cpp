@@ -0,0 +1,172 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+/**
+ * @brief : bounded per-protocol queues between the sessions and the callback thread pool
+ * @file: MessageDispatcher.cpp
+ * @date: 2018-12-24
+ */
+#include "MessageDispatcher.h"
+#include <libdevcore/easylog.h>
+
+using namespace dev;
+using namespace dev::p2p;
+
+MessageDispatcher::MessageDispatcher(std::shared_ptr<dev::ThreadPool> _threadPool, size_t _capacity)
+  : m_threadPool(_threadPool), m_capacity(_capacity > 0 ? _capacity : c_defaultQueueCapacity)
+{
+    m_turns.fill(0);
+}
+
+PROTOCOL_ID MessageDispatcher::queueID(PROTOCOL_ID _protocolID, bytesConstRef _payload)
+{
+    auto groupAndProtocol = dev::eth::getGroupAndProtocol(_protocolID);
+    if (_protocolID > 0 && groupAndProtocol.second == dev::eth::ProtocolID::BlockSync &&
+        !_payload.empty() && _payload[0] == dev::eth::c_syncTransactionsPacketID)
+        return dev::eth::getGroupProtoclID(groupAndProtocol.first, dev::eth::ProtocolID::TxPool);
+    return _protocolID;
+}
+
+unsigned MessageDispatcher::priority(PROTOCOL_ID _protocolID)
+{
+    /// a response is as urgent as the request it answers
+    PROTOCOL_ID protocolID = _protocolID < 0 ? -_protocolID : _protocolID;
+    switch (dev::eth::getGroupAndProtocol(protocolID).second)
+    {
+    case dev::eth::ProtocolID::PBFT:
+        return 0;
+    case dev::eth::ProtocolID::TxPool:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+bool MessageDispatcher::lossy(PROTOCOL_ID _protocolID)
+{
+    /// a transaction missed is gossiped again by the other peers or resent by its client
+    PROTOCOL_ID protocolID = _protocolID < 0 ? -_protocolID : _protocolID;
+    return dev::eth::getGroupAndProtocol(protocolID).second == dev::eth::ProtocolID::TxPool;
+}
+
+bool MessageDispatcher::push(PROTOCOL_ID _protocolID, std::function<void()> const& _handler)
+{
+    bool full = false;
+    {
+        Guard l(x_queues);
+        auto it = m_queues.find(_protocolID);
+        if (it == m_queues.end())
+        {
+            it = m_queues.insert(std::make_pair(_protocolID, Queue())).first;
+            it->second.status.protocolID = _protocolID;
+            it->second.status.priority = priority(_protocolID);
+            m_levels[it->second.status.priority].push_back(_protocolID);
+        }
+        auto& queue = it->second;
+        if (queue.handlers.size() >= m_capacity && lossy(_protocolID))
+        {
+            queue.handlers.pop_front();
+            ++queue.status.dropped;
+        }
+        queue.handlers.push_back(std::make_pair(_handler, std::chrono::steady_clock::now()));
+        queue.status.maxDepth = std::max(queue.status.maxDepth, queue.handlers.size());
+        full = queue.handlers.size() >= m_capacity && !lossy(_protocolID);
+        if (full)
+            ++queue.status.paused;
+    }
+
+    std::weak_ptr<MessageDispatcher> self = shared_from_this();
+    m_threadPool->enqueue([self]() {
+        auto dispatcher = self.lock();
+        if (dispatcher)
+            dispatcher->runNext();
+    });
+    return !full;
+}
+
+void MessageDispatcher::onDrained(PROTOCOL_ID _protocolID, std::function<void()> const& _resume)
+{
+    {
+        Guard l(x_queues);
+        auto it = m_queues.find(_protocolID);
+        if (it != m_queues.end() && it->second.handlers.size() > m_capacity / 2)
+        {
+            it->second.waiters.push_back(_resume);
+            return;
+        }
+    }
+    /// drained before the sender asked
+    _resume();
+}
+
+void MessageDispatcher::runNext()
+{
+    std::function<void()> handler;
+    std::vector<std::function<void()>> waiters;
+    {
+        Guard l(x_queues);
+        for (unsigned level = 0; level < c_priorities && !handler; ++level)
+        {
+            auto const& protocolIDs = m_levels[level];
+            for (size_t i = 0; i < protocolIDs.size(); ++i)
+            {
+                size_t turn = (m_turns[level] + i) % protocolIDs.size();
+                auto& queue = m_queues[protocolIDs[turn]];
+                if (queue.handlers.empty())
+                    continue;
+
+                handler = queue.handlers.front().first;
+                uint64_t wait = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - queue.handlers.front().second)
+                                    .count();
+                queue.handlers.pop_front();
+                ++queue.status.dispatched;
+                queue.status.totalWaitMicroseconds += wait;
+                queue.status.maxWaitMicroseconds = std::max(queue.status.maxWaitMicroseconds, wait);
+                if (queue.handlers.size() <= m_capacity / 2)
+                    waiters.swap(queue.waiters);
+                m_turns[level] = turn + 1;
+                break;
+            }
+        }
+    }
+
+    for (auto const& resume : waiters)
+        resume();
+    if (!handler)
+        return;
+    try
+    {
+        handler();
+    }
+    catch (std::exception& e)
+    {
+        LOG(ERROR) << "MessageDispatcher handler error:" << e.what();
+    }
+}
+
+std::vector<DispatchQueueStatus> MessageDispatcher::status() const
+{
+    std::vector<DispatchQueueStatus> statuses;
+    Guard l(x_queues);
+    for (auto const& it : m_queues)
+    {
+        statuses.push_back(it.second.status);
+        statuses.back().depth = it.second.handlers.size();
+    }
+    return statuses;
+}
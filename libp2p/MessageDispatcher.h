@@ -0,0 +1,120 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+/**
+ * @brief : bounded per-protocol queues between the sessions and the callback thread pool
+ * @file: MessageDispatcher.h
+ * @date: 2018-12-24
+ */
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/Guards.h>
+#include <libdevcore/ThreadPool.h>
+#include <libethcore/Protocol.h>
+#include <array>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace dev
+{
+namespace p2p
+{
+/// what a queue of the dispatcher has been through
+struct DispatchQueueStatus
+{
+    PROTOCOL_ID protocolID = 0;
+    unsigned priority = 0;
+    size_t depth = 0;
+    size_t maxDepth = 0;
+    uint64_t dispatched = 0;
+    /// how many times the queue was full and its senders stopped reading
+    uint64_t paused = 0;
+    /// how many handlers a full gossip queue dropped, the oldest first
+    uint64_t dropped = 0;
+    uint64_t totalWaitMicroseconds = 0;
+    uint64_t maxWaitMicroseconds = 0;
+};
+
+/**
+ * @brief Each protocol ID, i.e. each module of each group, has a queue of the message handlers
+ * to run; the transactions gossiped on the sync protocol go to the queue of the txpool one. A
+ * free thread of the pool runs the oldest handler of the most urgent non-empty queue: consensus
+ * first, then sync and AMOP, then transaction gossip, the queues of a priority taking turns. A
+ * queue reaching its capacity tells the sender to stop reading its socket until the queue is
+ * down to half the capacity again, but for the transaction gossip queues: those drop their
+ * oldest handler instead, so that a gossip flood never holds back the consensus messages read
+ * from the same socket.
+ */
+class MessageDispatcher : public std::enable_shared_from_this<MessageDispatcher>
+{
+public:
+    typedef std::shared_ptr<MessageDispatcher> Ptr;
+
+    MessageDispatcher(
+        std::shared_ptr<dev::ThreadPool> _threadPool, size_t _capacity = c_defaultQueueCapacity);
+
+    /// queue _handler behind the messages of _protocolID
+    /// @returns false if the queue is full, the handler is queued still; a full gossip queue
+    /// drops its oldest handler and returns true
+    bool push(PROTOCOL_ID _protocolID, std::function<void()> const& _handler);
+    /// run _resume once the queue of _protocolID is down to half its capacity, at once if it is
+    void onDrained(PROTOCOL_ID _protocolID, std::function<void()> const& _resume);
+
+    std::vector<DispatchQueueStatus> status() const;
+    size_t capacity() const { return m_capacity; }
+
+    /// the queue of a message: the transactions packets of the sync protocol of a group are
+    /// transaction gossip and share the queue of its txpool protocol, the rest of the messages
+    /// queue on their own protocol ID
+    static PROTOCOL_ID queueID(PROTOCOL_ID _protocolID, bytesConstRef _payload);
+    /// 0 for consensus, 1 for sync, AMOP and the rest, 2 for transaction gossip
+    static unsigned priority(PROTOCOL_ID _protocolID);
+    /// whether the messages of _protocolID may be dropped rather than slow their sender down
+    static bool lossy(PROTOCOL_ID _protocolID);
+
+    static const size_t c_defaultQueueCapacity = 4096;
+    static const unsigned c_priorities = 3;
+
+private:
+    struct Queue
+    {
+        std::deque<std::pair<std::function<void()>, std::chrono::steady_clock::time_point>>
+            handlers;
+        std::vector<std::function<void()>> waiters;
+        DispatchQueueStatus status;
+    };
+
+    /// run the next handler, one is posted to the pool for each handler pushed
+    void runNext();
+
+    std::shared_ptr<dev::ThreadPool> m_threadPool;
+    size_t m_capacity;
+
+    mutable Mutex x_queues;
+    std::map<PROTOCOL_ID, Queue> m_queues;
+    /// the protocol IDs of each priority, and whose turn it is among them
+    std::array<std::vector<PROTOCOL_ID>, c_priorities> m_levels;
+    std::array<size_t, c_priorities> m_turns;
+};
+
+}  // namespace p2p
+}  // namespace dev
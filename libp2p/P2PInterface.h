@@ -31,18 +31,35 @@ class P2PInterface
 {
 public:
     /// < protocolID stored in Message struct
+    ///< Blocks the calling thread for the round trip, requestByNodeID does not.
     virtual Message::Ptr sendMessageByNodeID(NodeID const& nodeID, Message::Ptr message) = 0;
 
     virtual void asyncSendMessageByNodeID(NodeID const& nodeID, Message::Ptr message,
         CallbackFunc callback = nullptr, Options const& options = Options()) = 0;
 
+    ///< Blocks the calling thread for the round trip, requestByTopic does not.
     virtual Message::Ptr sendMessageByTopic(std::string const& topic, Message::Ptr message) = 0;
 
     virtual void asyncSendMessageByTopic(std::string const& topic, Message::Ptr message,
         CallbackFunc callback, Options const& options) = 0;
 
+    ///< Send a request to nodeID and return at once. The future is completed by the response, by
+    ///< a NetworkTimeout after options.timeout milliseconds (0 for no deadline), by a Disconnect
+    ///< if nodeID is not connected, or by its cancel().
+    virtual ResponseFuture::Ptr requestByNodeID(
+        NodeID const& nodeID, Message::Ptr message, Options const& options) = 0;
+
+    ///< Send a request to a node following topic and return at once; a node that does not answer
+    ///< within options.subTimeout is replaced by another until options.timeout.
+    virtual ResponseFuture::Ptr requestByTopic(
+        std::string const& topic, Message::Ptr message, Options const& options) = 0;
+
     virtual void asyncMulticastMessageByTopic(std::string const& topic, Message::Ptr message) = 0;
 
+    ///< The connected nodes following topic.
+    virtual NodeIDs getPeersByTopic(std::string const& topic) = 0;
+
+    ///< Encodes message once and sends the same buffer to every connected node in nodeIDs.
     virtual void asyncMulticastMessageByNodeIDList(
         NodeIDs const& nodeIDs, Message::Ptr message) = 0;
 
@@ -62,7 +79,7 @@ public:
     virtual SessionInfos sessionInfos() const = 0;
 
     ///< Get connecting sessions by topicID which is groupID and can be got by protocolID.
-    ///< TODO: Whether the session list needs caching, especially when the consensus module calls.
+    ///< The list is cached per group until the sessions or the group members change.
 
     virtual SessionInfos sessionInfosByProtocolID(PROTOCOL_ID _protocolID) const = 0;
 
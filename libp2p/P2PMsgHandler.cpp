@@ -167,7 +167,7 @@ void P2PMsgHandler::registerAMOP()
                 retMsg->setBuffer(buffer);
                 retMsg->setLength(Message::HEADER_LENGTH + retMsg->buffer()->size());
                 std::shared_ptr<bytes> msgBuf = std::make_shared<bytes>();
-                retMsg->encode(*msgBuf);
+                retMsg->encode(*msgBuf, s->peerCompress());
                 s->send(msgBuf);
                 break;
             }
@@ -199,6 +199,12 @@ void P2PMsgHandler::registerAMOP()
                 s->setTopicsAndTopicSeq(s->id(), topics, topicSeq);
                 break;
             }
+            case AMOPPacketType::CompressSupport:
+            {
+                LOG(INFO) << "HandleCompressSupport, peer inflates compressed payloads";
+                s->setPeerCompress(true);
+                break;
+            }
             default:
             {
                 LOG(INFO) << "Invalid packetType in AMOP message.";
@@ -27,98 +27,104 @@ namespace p2p
 {
 Message::Ptr Service::sendMessageByNodeID(NodeID const& nodeID, Message::Ptr message)
 {
-    LOG(INFO) << "Call Service::sendMessageByNodeID";
+    ASYNC_LOG_RATED(INFO) << "Call Service::sendMessageByNodeID";
     try
     {
-        bool findNodeID = false;
-        {
-            RecursiveGuard l(m_host->mutexSessions());
-            auto s = m_host->sessions();
-            for (auto const& i : s)
-            {
-                if (i.first == nodeID)
-                {
-                    findNodeID = true;
-                    break;
-                }
-            }
-        }
-        if (!findNodeID)
-        {
-            LOG(ERROR) << "Service::sendMessageByNodeID cannot find target.";
-            return Message::Ptr();
-        }
-
-        SessionCallback::Ptr callback = std::make_shared<SessionCallback>();
-        CallbackFunc fp = std::bind(
-            &SessionCallback::onResponse, callback, std::placeholders::_1, std::placeholders::_2);
-        asyncSendMessageByNodeID(nodeID, message, fp, Options());
+        Options options;
+        options.timeout = c_syncTimeout;
+        return requestByNodeID(nodeID, message, options)->get();
+    }
+    catch (std::exception& e)
+    {
+        LOG(ERROR) << "Service::sendMessageByNodeID error:" << e.what();
+    }
 
-        callback->mutex.lock();
-        callback->mutex.unlock();
-        LOG(INFO) << "Service::sendMessageByNodeID mutex unlock.";
+    return Message::Ptr();
+}
 
-        P2PException error = callback->error;
-        if (error.errorCode() != 0)
+void Service::asyncSendMessageByNodeID(
+    NodeID const& nodeID, Message::Ptr message, CallbackFunc callback, Options const& options)
+{
+    ASYNC_LOG_RATED(INFO) << "Call Service::asyncSendMessageByNodeID to NodeID="
+                          << nodeID.abridged();
+    try
+    {
+        std::shared_ptr<SessionFace> p = m_host->peerSession(nodeID);
+        if (!p)
         {
-            LOG(ERROR) << "asyncSendMessageByNodeID error:" << error.errorCode() << " "
-                       << error.what();
-            throw error;
+            if (callback)
+                callback(P2PException(P2PExceptionType::Disconnect,
+                             g_P2PExceptionMsg[P2PExceptionType::Disconnect]),
+                    Message::Ptr());
+            return;
         }
-
-        return callback->response;
+        sendRequest(p, ++m_seq, message, callback, options);
     }
     catch (std::exception& e)
     {
         LOG(ERROR) << "ERROR:" << e.what();
     }
+}
 
-    return Message::Ptr();
+void Service::sendRequest(std::shared_ptr<SessionFace> p, uint32_t seq, Message::Ptr message,
+    CallbackFunc callback, Options const& options)
+{
+    if (callback)
+    {
+        ResponseCallback::Ptr responseCallback = std::make_shared<ResponseCallback>();
+        responseCallback->callbackFunc = callback;
+        if (options.timeout > 0)
+        {
+            std::shared_ptr<boost::asio::deadline_timer> timeoutHandler =
+                std::make_shared<boost::asio::deadline_timer>(
+                    *m_ioService, boost::posix_time::milliseconds(options.timeout));
+            timeoutHandler->async_wait(boost::bind(&Service::onTimeoutByNode, shared_from_this(),
+                boost::asio::placeholders::error, seq, p));
+            responseCallback->timeoutHandler = timeoutHandler;
+        }
+        p->addSeq2Callback(seq, responseCallback);
+    }
+    p->send(encodeMessage(message, seq, p->peerCompress()));
 }
 
-void Service::asyncSendMessageByNodeID(
-    NodeID const& nodeID, Message::Ptr message, CallbackFunc callback, Options const& options)
+ResponseFuture::Ptr Service::requestByNodeID(
+    NodeID const& nodeID, Message::Ptr message, Options const& options)
 {
-    LOG(INFO) << "Call Service::asyncSendMessageByNodeID to NodeID=" << toJS(nodeID);
+    ASYNC_LOG(TRACE) << "Call Service::requestByNodeID to NodeID=" << nodeID.abridged();
+    ResponseFuture::Ptr future = std::make_shared<ResponseFuture>();
     try
     {
-        RecursiveGuard l(m_host->mutexSessions());
-        auto s = m_host->sessions();
-        for (auto const& i : s)
+        std::shared_ptr<SessionFace> p = m_host->peerSession(nodeID);
+        if (!p)
         {
-            if (i.first == nodeID)
-            {
-                std::shared_ptr<SessionFace> p = i.second;
-                uint32_t seq = ++m_seq;
-                if (callback)
-                {
-                    ResponseCallback::Ptr responseCallback = std::make_shared<ResponseCallback>();
-                    responseCallback->callbackFunc = callback;
-                    if (options.timeout > 0)
-                    {
-                        std::shared_ptr<boost::asio::deadline_timer> timeoutHandler =
-                            std::make_shared<boost::asio::deadline_timer>(
-                                *m_ioService, boost::posix_time::milliseconds(options.timeout));
-                        timeoutHandler->async_wait(boost::bind(&Service::onTimeoutByNode,
-                            shared_from_this(), boost::asio::placeholders::error, seq, p));
-                        responseCallback->timeoutHandler = timeoutHandler;
-                    }
-                    p->addSeq2Callback(seq, responseCallback);
-                }
-                ///< update seq and length
-                message->setSeq(seq);
-                message->setLength(Message::HEADER_LENGTH + message->buffer()->size());
-                std::shared_ptr<bytes> buf = std::make_shared<bytes>();
-                message->encode(*buf);
-                p->send(buf);
-                return;
-            }
+            future->complete(P2PException(P2PExceptionType::Disconnect,
+                                 g_P2PExceptionMsg[P2PExceptionType::Disconnect]),
+                Message::Ptr());
+            return future;
         }
+        uint32_t seq = ++m_seq;
+        /// the callback of the request is dropped at once, its timer cancelled
+        std::weak_ptr<SessionFace> session = p;
+        future->setOnCancel([session, seq]() {
+            auto p = session.lock();
+            if (!p)
+                return;
+            auto callback = p->getCallbackBySeq(seq);
+            if (callback && callback->timeoutHandler)
+                callback->timeoutHandler->cancel();
+            else if (callback)
+                p->eraseCallbackBySeq(seq);
+        });
+        sendRequest(p, seq, message,
+            [future](P2PException e, Message::Ptr response) { future->complete(e, response); },
+            options);
     }
     catch (std::exception& e)
     {
-        LOG(ERROR) << "ERROR:" << e.what();
+        LOG(ERROR) << "Service::requestByNodeID error:" << e.what();
+        future->complete(P2PException(P2PExceptionType::ProtocolError, e.what()), Message::Ptr());
     }
+    return future;
 }
 
 void Service::onTimeoutByTopic(const boost::system::error_code& error,
@@ -141,39 +147,34 @@ void Service::onTimeoutByTopic(const boost::system::error_code& error,
                 if (nodeIDsToSend.size() > 0 && totalTimeout < options.timeout)
                 {
                     NodeID nodeID = nodeIDsToSend[0];
-                    LOG(INFO) << "Call Service::asyncSendMessageByTopic to NodeID=" << toJS(nodeID);
+                    ASYNC_LOG_RATED(INFO) << "Call Service::asyncSendMessageByTopic to NodeID="
+                                          << toJS(nodeID);
                     try
                     {
-                        RecursiveGuard l(m_host->mutexSessions());
-                        auto s = m_host->sessions();
-                        for (auto const& i : s)
+                        std::shared_ptr<SessionFace> newSession = m_host->peerSession(nodeID);
+                        if (newSession)
                         {
-                            if (i.first == nodeID)
+                            if (callback)
                             {
-                                std::shared_ptr<SessionFace> newSession = i.second;
-                                if (callback)
-                                {
-                                    ResponseCallback::Ptr responseCallback =
-                                        std::make_shared<ResponseCallback>();
-                                    responseCallback->callbackFunc = callback;
-
-                                    std::shared_ptr<boost::asio::deadline_timer> timeoutHandler =
-                                        std::make_shared<boost::asio::deadline_timer>(*m_ioService,
-                                            boost::posix_time::milliseconds(options.subTimeout));
-                                    timeoutHandler->async_wait(
-                                        boost::bind(&Service::onTimeoutByTopic, shared_from_this(),
-                                            boost::asio::placeholders::error, newSession,
-                                            nodeIDsToSend, message, callback, options,
-                                            totalTimeout + options.subTimeout));
-                                    responseCallback->timeoutHandler = timeoutHandler;
-                                    newSession->addSeq2Callback(message->seq(), responseCallback);
-                                }
-
-                                std::shared_ptr<bytes> msgBuffer = std::make_shared<bytes>();
-                                message->encode(*msgBuffer);
-                                newSession->send(msgBuffer);
-                                return;
+                                ResponseCallback::Ptr responseCallback =
+                                    std::make_shared<ResponseCallback>();
+                                responseCallback->callbackFunc = callback;
+
+                                std::shared_ptr<boost::asio::deadline_timer> timeoutHandler =
+                                    std::make_shared<boost::asio::deadline_timer>(*m_ioService,
+                                        boost::posix_time::milliseconds(options.subTimeout));
+                                timeoutHandler->async_wait(boost::bind(&Service::onTimeoutByTopic,
+                                    shared_from_this(), boost::asio::placeholders::error,
+                                    newSession, nodeIDsToSend, message, callback, options,
+                                    totalTimeout + options.subTimeout));
+                                responseCallback->timeoutHandler = timeoutHandler;
+                                newSession->addSeq2Callback(message->seq(), responseCallback);
                             }
+
+                            std::shared_ptr<bytes> msgBuffer = std::make_shared<bytes>();
+                            message->encode(*msgBuffer, newSession->peerCompress());
+                            newSession->send(msgBuffer);
+                            return;
                         }
                     }
                     catch (std::exception& e)
@@ -181,6 +182,15 @@ void Service::onTimeoutByTopic(const boost::system::error_code& error,
                         LOG(ERROR) << "Service::onTimeoutByTopic error:" << e.what();
                     }
                     nodeIDsToSend.erase(nodeIDsToSend.begin());
+                    ///< the next node is gone, the request ends here rather than never
+                    if (it->callbackFunc)
+                    {
+                        P2PException e(P2PExceptionType::NetworkTimeout,
+                            g_P2PExceptionMsg[P2PExceptionType::NetworkTimeout]);
+                        Message::Ptr msg = make_shared<Message>();
+                        msg->setSeq(message->seq());
+                        it->callbackFunc(e, msg);
+                    }
                 }
                 else
                 {
@@ -258,27 +268,13 @@ void Service::onTimeoutByNode(
 
 Message::Ptr Service::sendMessageByTopic(std::string const& topic, Message::Ptr message)
 {
-    LOG(INFO) << "Call Service::sendMessageByTopic";
+    ASYNC_LOG_RATED(INFO) << "Call Service::sendMessageByTopic";
     try
     {
-        SessionCallback::Ptr callback = std::make_shared<SessionCallback>();
-        CallbackFunc fp = std::bind(
-            &SessionCallback::onResponse, callback, std::placeholders::_1, std::placeholders::_2);
-        asyncSendMessageByTopic(topic, message, fp, Options());
-
-        callback->mutex.lock();
-        callback->mutex.unlock();
-        LOG(INFO) << "Service::sendMessageByTopic mutex unlock.";
-
-        P2PException error = callback->error;
-        if (error.errorCode() != 0)
-        {
-            LOG(ERROR) << "Service::sendMessageByTopic error:" << error.errorCode() << " "
-                       << error.what();
-            throw error;
-        }
-
-        return callback->response;
+        Options options;
+        options.subTimeout = c_syncSubTimeout;
+        options.timeout = c_syncTimeout;
+        return requestByTopic(topic, message, options)->get();
     }
     catch (std::exception& e)
     {
@@ -288,53 +284,63 @@ Message::Ptr Service::sendMessageByTopic(std::string const& topic, Message::Ptr
     return Message::Ptr();
 }
 
+ResponseFuture::Ptr Service::requestByTopic(
+    std::string const& topic, Message::Ptr message, Options const& options)
+{
+    ResponseFuture::Ptr future = std::make_shared<ResponseFuture>();
+    /// the callback of a cancelled request stays until its deadline, where it is ignored
+    asyncSendMessageByTopic(topic, message,
+        [future](P2PException e, Message::Ptr response) { future->complete(e, response); },
+        options);
+    return future;
+}
+
 void Service::asyncSendMessageByTopic(
     std::string const& topic, Message::Ptr message, CallbackFunc callback, Options const& options)
 {
-    LOG(INFO) << "Call Service::asyncSendMessageByTopic, topic=" << topic;
+    ASYNC_LOG_RATED(INFO) << "Call Service::asyncSendMessageByTopic, topic=" << topic;
     assert(options.timeout > 0 && options.subTimeout > 0);
     NodeIDs nodeIDsToSend = getPeersByTopic(topic);
     if (nodeIDsToSend.size() == 0)
     {
         LOG(INFO) << "Call Service::asyncSendMessageByTopic, nodeIDsToSend size=0.";
+        if (callback)
+            callback(P2PException(P2PExceptionType::Disconnect,
+                         g_P2PExceptionMsg[P2PExceptionType::Disconnect]),
+                Message::Ptr());
         return;
     }
     NodeID nodeID = nodeIDsToSend[0];
     nodeIDsToSend.erase(nodeIDsToSend.begin());
-    LOG(INFO) << "Call Service::asyncSendMessageByTopic to NodeID=" << toJS(nodeID);
+    ASYNC_LOG_RATED(INFO) << "Call Service::asyncSendMessageByTopic to NodeID=" << toJS(nodeID);
 
     try
     {
-        RecursiveGuard l(m_host->mutexSessions());
-        auto s = m_host->sessions();
-        for (auto const& i : s)
+        std::shared_ptr<SessionFace> p = m_host->peerSession(nodeID);
+        if (!p)
         {
-            if (i.first == nodeID)
-            {
-                std::shared_ptr<SessionFace> p = i.second;
-                uint32_t seq = ++m_seq;
-                ///< update seq and length
-                message->setSeq(seq);
-                message->setLength(Message::HEADER_LENGTH + message->buffer()->size());
-                if (callback)
-                {
-                    ResponseCallback::Ptr responseCallback = std::make_shared<ResponseCallback>();
-                    responseCallback->callbackFunc = callback;
-                    std::shared_ptr<boost::asio::deadline_timer> timeoutHandler =
-                        std::make_shared<boost::asio::deadline_timer>(
-                            *m_ioService, boost::posix_time::milliseconds(options.subTimeout));
-                    timeoutHandler->async_wait(boost::bind(&Service::onTimeoutByTopic,
-                        shared_from_this(), boost::asio::placeholders::error, p, nodeIDsToSend,
-                        message, callback, options, 0));
-                    responseCallback->timeoutHandler = timeoutHandler;
-                    p->addSeq2Callback(seq, responseCallback);
-                }
-                std::shared_ptr<bytes> buf = std::make_shared<bytes>();
-                message->encode(*buf);
-                p->send(buf);
-                return;
-            }
+            if (callback)
+                callback(P2PException(P2PExceptionType::Disconnect,
+                             g_P2PExceptionMsg[P2PExceptionType::Disconnect]),
+                    Message::Ptr());
+            return;
         }
+        uint32_t seq = ++m_seq;
+        std::shared_ptr<bytes> buf = encodeMessage(message, seq, p->peerCompress());
+        if (callback)
+        {
+            ResponseCallback::Ptr responseCallback = std::make_shared<ResponseCallback>();
+            responseCallback->callbackFunc = callback;
+            std::shared_ptr<boost::asio::deadline_timer> timeoutHandler =
+                std::make_shared<boost::asio::deadline_timer>(
+                    *m_ioService, boost::posix_time::milliseconds(options.subTimeout));
+            timeoutHandler->async_wait(boost::bind(&Service::onTimeoutByTopic, shared_from_this(),
+                boost::asio::placeholders::error, p, nodeIDsToSend, message, callback, options,
+                0));
+            responseCallback->timeoutHandler = timeoutHandler;
+            p->addSeq2Callback(seq, responseCallback);
+        }
+        p->send(buf);
     }
     catch (std::exception& e)
     {
@@ -345,22 +351,11 @@ void Service::asyncSendMessageByTopic(
 void Service::asyncMulticastMessageByTopic(std::string const& topic, Message::Ptr message)
 {
     NodeIDs nodeIDsToSend = getPeersByTopic(topic);
-    LOG(INFO) << "Call Service::asyncMulticastMessageByTopic nodes size=" << nodeIDsToSend.size();
+    ASYNC_LOG_RATED(INFO) << "Call Service::asyncMulticastMessageByTopic nodes size="
+                          << nodeIDsToSend.size();
     try
     {
-        uint32_t seq = ++m_seq;
-        message->setSeq(seq);
-        message->setLength(Message::HEADER_LENGTH + message->buffer()->size());
-        std::shared_ptr<bytes> buf = std::make_shared<bytes>();
-        message->encode(*buf);
-
-        RecursiveGuard l(m_host->mutexSessions());
-        auto s = m_host->sessions();
-        for (auto const& i : s)
-        {
-            if (isSessionInNodeIDList(i.first, nodeIDsToSend))
-                i.second->send(buf);
-        }
+        multicast(nodeIDsToSend, message);
     }
     catch (std::exception& e)
     {
@@ -370,22 +365,11 @@ void Service::asyncMulticastMessageByTopic(std::string const& topic, Message::Pt
 
 void Service::asyncMulticastMessageByNodeIDList(NodeIDs const& nodeIDs, Message::Ptr message)
 {
-    LOG(INFO) << "Call Service::asyncMulticastMessageByNodeIDList nodes size=" << nodeIDs.size();
+    ASYNC_LOG_RATED(INFO) << "Call Service::asyncMulticastMessageByNodeIDList nodes size="
+                          << nodeIDs.size();
     try
     {
-        uint32_t seq = ++m_seq;
-        message->setSeq(seq);
-        message->setLength(Message::HEADER_LENGTH + message->buffer()->size());
-        std::shared_ptr<bytes> buf = std::make_shared<bytes>();
-        message->encode(*buf);
-
-        RecursiveGuard l(m_host->mutexSessions());
-        auto s = m_host->sessions();
-        for (auto const& i : s)
-        {
-            if (isSessionInNodeIDList(i.first, nodeIDs))
-                i.second->send(buf);
-        }
+        multicast(nodeIDs, message);
     }
     catch (std::exception& e)
     {
@@ -393,33 +377,64 @@ void Service::asyncMulticastMessageByNodeIDList(NodeIDs const& nodeIDs, Message:
     }
 }
 
-bool Service::isSessionInNodeIDList(NodeID const& targetNodeID, NodeIDs const& nodeIDs)
+void Service::multicast(NodeIDs const& nodeIDs, Message::Ptr message)
 {
-    for (auto const& nodeID : nodeIDs)
+    std::vector<std::shared_ptr<SessionFace>> sessions;
+    sessions.reserve(nodeIDs.size());
     {
-        if (targetNodeID == nodeID)
-            return true;
+        RecursiveGuard l(m_host->mutexSessions());
+        auto const& s = m_host->sessions();
+        for (auto const& nodeID : nodeIDs)
+        {
+            auto it = s.find(nodeID);
+            if (it != s.end())
+                sessions.push_back(it->second);
+        }
     }
-    return false;
+    if (sessions.empty())
+        return;
+    sendToSessions(sessions, message);
+}
+
+void Service::sendToSessions(
+    std::vector<std::shared_ptr<SessionFace>> const& sessions, Message::Ptr message)
+{
+    ///< the sessions of each form queue the same encoded buffer
+    uint32_t seq = ++m_seq;
+    std::shared_ptr<bytes> compressed;
+    std::shared_ptr<bytes> raw;
+    for (auto const& session : sessions)
+    {
+        bool compress = session->peerCompress();
+        auto& buf = compress ? compressed : raw;
+        if (!buf)
+            buf = encodeMessage(message, seq, compress);
+        session->send(buf);
+    }
+}
+
+std::shared_ptr<bytes> Service::encodeMessage(Message::Ptr message, uint32_t seq, bool _compress)
+{
+    ///< update seq and length
+    message->setSeq(seq);
+    message->setLength(Message::HEADER_LENGTH + message->buffer()->size());
+    std::shared_ptr<bytes> buf = std::make_shared<bytes>();
+    message->encode(*buf, _compress);
+    return buf;
 }
 
 void Service::asyncBroadcastMessage(Message::Ptr message, Options const& options)
 {
-    LOG(INFO) << "Call Service::asyncBroadcastMessage";
+    ASYNC_LOG_RATED(INFO) << "Call Service::asyncBroadcastMessage";
     try
     {
-        uint32_t seq = ++m_seq;
-        message->setSeq(seq);
-        message->setLength(Message::HEADER_LENGTH + message->buffer()->size());
-        std::shared_ptr<bytes> buf = std::make_shared<bytes>();
-        message->encode(*buf);
-
-        RecursiveGuard l(m_host->mutexSessions());
-        auto s = m_host->sessions();
-        for (auto const& i : s)
+        std::vector<std::shared_ptr<SessionFace>> sessions;
         {
-            i.second->send(buf);
+            RecursiveGuard l(m_host->mutexSessions());
+            for (auto const& i : m_host->sessions())
+                sessions.push_back(i.second);
         }
+        sendToSessions(sessions, message);
     }
     catch (std::exception& e)
     {
@@ -442,7 +457,8 @@ void Service::registerHandlerByTopic(std::string const& topic, CallbackFuncWithS
     {
         registerHandlerByProtoclID(dev::eth::ProtocolID::Topic,
             [=](P2PException e, std::shared_ptr<Session> s, Message::Ptr msg) {
-                LOG(INFO) << "Session::onMessage, call callbackFunc by Topic protocolID.";
+                ASYNC_LOG_RATED(INFO)
+                    << "Session::onMessage, call callbackFunc by Topic protocolID.";
                 if (msg->buffer()->size() <= Message::MAX_LENGTH)
                 {
                     ///< Get topic from message buffer.
@@ -469,7 +485,8 @@ void Service::registerHandlerByTopic(std::string const& topic, CallbackFuncWithS
                         bool ret = m_p2pMsgHandler->getHandlerByTopic(topic, callbackFunc);
                         if (ret && callbackFunc)
                         {
-                            LOG(INFO) << "Session::onMessage, call callbackFunc by topic=" << topic;
+                            ASYNC_LOG_RATED(INFO)
+                                << "Session::onMessage, call callbackFunc by topic=" << topic;
                             ///< execute funtion, send response packet by user in callbackFunc
                             ///< TODO: use threadPool
                             callbackFunc(e, s, msg);
@@ -501,17 +518,13 @@ void Service::setTopicsByNode(
     LOG(INFO) << "Call Service::setTopicsByNode to nodeID=" << toJS(_nodeID);
     try
     {
-        RecursiveGuard l(m_host->mutexSessions());
-        auto s = m_host->sessions();
-        for (auto const& i : s)
+        std::shared_ptr<SessionFace> p = m_host->peerSession(_nodeID);
+        if (p)
         {
-            if (i.first == _nodeID)
-            {
-                i.second->setTopics(_topics);
-                LOG(INFO) << "Service::setTopicsByNode completed, topics size="
-                          << getTopicsByNode(_nodeID)->size();
-                break;
-            }
+            p->setTopics(_topics);
+            m_host->onSessionsChanged();
+            LOG(INFO) << "Service::setTopicsByNode completed, topics size="
+                      << getTopicsByNode(_nodeID)->size();
         }
     }
     catch (std::exception& e)
@@ -526,16 +539,11 @@ std::shared_ptr<std::vector<std::string>> Service::getTopicsByNode(NodeID const&
     std::shared_ptr<std::vector<std::string>> ret = make_shared<std::vector<std::string>>();
     try
     {
-        RecursiveGuard l(m_host->mutexSessions());
-        auto s = m_host->sessions();
-        for (auto const& i : s)
+        std::shared_ptr<SessionFace> p = m_host->peerSession(_nodeID);
+        if (p)
         {
-            if (i.first == _nodeID)
-            {
-                ret = i.second->topics();
-                LOG(INFO) << "Service::getTopicsByNode success, topics size=" << ret->size();
-                break;
-            }
+            ret = p->topics();
+            LOG(INFO) << "Service::getTopicsByNode success, topics size=" << ret->size();
         }
     }
     catch (std::exception& e)
@@ -552,8 +560,7 @@ SessionInfos Service::sessionInfos() const
     try
     {
         RecursiveGuard l(m_host->mutexSessions());
-        auto s = m_host->sessions();
-        for (auto const& i : s)
+        for (auto const& i : m_host->sessions())
         {
             infos.push_back(
                 SessionInfo(i.first, i.second->nodeIPEndpoint(), *(i.second->topics())));
@@ -568,34 +575,45 @@ SessionInfos Service::sessionInfos() const
 
 SessionInfos Service::sessionInfosByProtocolID(PROTOCOL_ID _protocolID) const
 {
-    std::pair<GROUP_ID, MODULE_ID> ret = getGroupAndProtocol(_protocolID);
+    GROUP_ID groupID = getGroupAndProtocol(_protocolID).first;
+    ///< read before the sessions, a change while building only makes the next call rebuild
+    uint64_t version = m_host->sessionsVersion();
+    {
+        Guard l(x_groupSessions);
+        auto it = m_groupSessions.find(groupID);
+        if (it != m_groupSessions.end() && it->second.version == version)
+            return it->second.infos;
+    }
+
     h512s nodeList;
     SessionInfos infos;
-
-    if (true == m_host->getNodeListByGroupID(int(ret.first), nodeList))
+    if (true == m_host->getNodeListByGroupID(int(groupID), nodeList))
     {
-        LOG(INFO) << "Service::sessionInfosByProtocolID, getNodeListByGroupID list size:"
-                  << nodeList.size();
         try
         {
             RecursiveGuard l(m_host->mutexSessions());
-            auto s = m_host->sessions();
-            for (auto const& i : s)
+            auto const& s = m_host->sessions();
+            for (auto const& nodeID : nodeList)
             {
-                if (find(nodeList.begin(), nodeList.end(), i.first) != nodeList.end())
+                auto it = s.find(nodeID);
+                if (it != s.end())
                 {
-                    infos.push_back(
-                        SessionInfo(i.first, i.second->nodeIPEndpoint(), *(i.second->topics())));
+                    infos.push_back(SessionInfo(
+                        it->first, it->second->nodeIPEndpoint(), *(it->second->topics())));
                 }
             }
         }
         catch (std::exception& e)
         {
             LOG(ERROR) << "Service::sessionInfosByProtocolID error:" << e.what();
+            return infos;
         }
     }
 
-    LOG(INFO) << "Service::sessionInfosByProtocolID, return list size:" << infos.size();
+    LOG(INFO) << "Service::sessionInfosByProtocolID, group " << int(groupID)
+              << " members:" << nodeList.size() << ", connected:" << infos.size();
+    Guard l(x_groupSessions);
+    m_groupSessions[groupID] = GroupSessions{version, infos};
     return infos;
 }
 
@@ -605,10 +623,9 @@ NodeIDs Service::getPeersByTopic(std::string const& topic)
     try
     {
         RecursiveGuard l(m_host->mutexSessions());
-        auto s = m_host->sessions();
-        for (auto const& i : s)
+        for (auto const& i : m_host->sessions())
         {
-            for (auto j : *(i.second->topics()))
+            for (auto const& j : *(i.second->topics()))
             {
                 if (j == topic)
                 {
@@ -621,7 +638,8 @@ NodeIDs Service::getPeersByTopic(std::string const& topic)
     {
         LOG(ERROR) << "Service::getPeersByTopic error:" << e.what();
     }
-    LOG(INFO) << "Service::getPeersByTopic topic=" << topic << ", peers size=" << nodeList.size();
+    ASYNC_LOG_RATED(INFO) << "Service::getPeersByTopic topic=" << topic
+                          << ", peers size=" << nodeList.size();
     return nodeList;
 }
 
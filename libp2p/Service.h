@@ -61,8 +61,20 @@ public:
     void asyncSendMessageByTopic(std::string const& topic, Message::Ptr message,
         CallbackFunc callback, Options const& options) override;
 
+    ResponseFuture::Ptr requestByNodeID(
+        NodeID const& nodeID, Message::Ptr message, Options const& options) override;
+
+    ResponseFuture::Ptr requestByTopic(
+        std::string const& topic, Message::Ptr message, Options const& options) override;
+
+    ///< Deadlines of sendMessageByNodeID and sendMessageByTopic, in milliseconds.
+    static const uint32_t c_syncTimeout = 30000;
+    static const uint32_t c_syncSubTimeout = 10000;
+
     void asyncMulticastMessageByTopic(std::string const& topic, Message::Ptr message) override;
 
+    NodeIDs getPeersByTopic(std::string const& topic) override;
+
     void asyncMulticastMessageByNodeIDList(NodeIDs const& nodeIDs, Message::Ptr message) override;
 
     void asyncBroadcastMessage(Message::Ptr message, Options const& options) override;
@@ -110,9 +122,18 @@ private:
     void onTimeoutByNode(
         const boost::system::error_code& error, uint32_t seq, std::shared_ptr<SessionFace> p);
 
-    NodeIDs getPeersByTopic(std::string const& topic);
-
-    bool isSessionInNodeIDList(NodeID const& targetNodeID, NodeIDs const& nodeIDs);
+    ///< Encode message once and queue the buffer on the sessions of nodeIDs that are connected.
+    void multicast(NodeIDs const& nodeIDs, Message::Ptr message);
+    ///< Send message to p under seq, callback is called with its response or after
+    ///< options.timeout.
+    void sendRequest(std::shared_ptr<SessionFace> p, uint32_t seq, Message::Ptr message,
+        CallbackFunc callback, Options const& options);
+    ///< Set seq and length of message and encode it, compressed if _compress, see Message::encode.
+    std::shared_ptr<bytes> encodeMessage(Message::Ptr message, uint32_t seq, bool _compress);
+    ///< Encode message at most twice, compressed for the sessions whose peer announced
+    ///< CompressSupport and raw for the others, and queue the buffers on sessions.
+    void sendToSessions(
+        std::vector<std::shared_ptr<SessionFace>> const& sessions, Message::Ptr message);
 
     std::shared_ptr<Host> m_host;
     boost::asio::io_service* m_ioService;
@@ -120,6 +141,15 @@ private:
     std::shared_ptr<P2PMsgHandler> m_p2pMsgHandler;
     std::atomic<uint32_t> m_seq = {0};  ///< The message identify is generated by the service by
                                         ///< autoincrement.
+
+    ///< Connected members of each group, valid while Host::sessionsVersion() is unchanged.
+    struct GroupSessions
+    {
+        uint64_t version;
+        SessionInfos infos;
+    };
+    mutable std::map<GROUP_ID, GroupSessions> m_groupSessions;
+    mutable Mutex x_groupSessions;
 };
 
 }  // namespace p2p
@@ -278,36 +278,7 @@ void Session::doRead()
         ///           << " bytes data:" << std::string(m_recvBuffer, m_recvBuffer +
         ///           bytesTransferred);
         m_data.insert(m_data.end(), m_recvBuffer, m_recvBuffer + bytesTransferred);
-
-        ThreadContext tc(info().id.abridged());
-        ThreadContext tc2(info().host);
-
-        while (true)
-        {
-            Message::Ptr message = m_messageFactory->buildMessage();
-            ssize_t result = message->decode(m_data.data(), m_data.size());
-            /// LOG(TRACE) << "Parse result: " << result;
-            if (result > 0)
-            {
-                LOG(TRACE) << "Decode success: " << result;
-                P2PException e(
-                    P2PExceptionType::Success, g_P2PExceptionMsg[P2PExceptionType::Success]);
-                onMessage(e, self, message);
-                m_data.erase(m_data.begin(), m_data.begin() + result);
-            }
-            else if (result == 0)
-            {
-                doRead();
-                break;
-            }
-            else
-            {
-                P2PException e(P2PExceptionType::ProtocolError,
-                    g_P2PExceptionMsg[P2PExceptionType::ProtocolError]);
-                onMessage(e, self, message);
-                break;
-            }
-        }
+        readMessages();
     };
     if (m_socket->isConnected())
     {
@@ -323,6 +294,75 @@ void Session::doRead()
     }
 }
 
+void Session::readMessages()
+{
+    auto self(shared_from_this());
+    ThreadContext tc(info().id.abridged());
+    ThreadContext tc2(info().host);
+
+    while (true)
+    {
+        Message::Ptr message = m_messageFactory->buildMessage();
+        ssize_t result = message->decode(m_data.data(), m_data.size());
+        /// LOG(TRACE) << "Parse result: " << result;
+        if (result > 0)
+        {
+            LOG(TRACE) << "Decode success: " << result;
+            P2PException e(
+                P2PExceptionType::Success, g_P2PExceptionMsg[P2PExceptionType::Success]);
+            onMessage(e, self, message);
+            m_data.erase(m_data.begin(), m_data.begin() + result);
+            ///< the queue of the message is full, resumeRead() goes on with the rest
+            if (m_readPaused)
+                break;
+        }
+        else if (result == 0)
+        {
+            doRead();
+            break;
+        }
+        else
+        {
+            P2PException e(P2PExceptionType::ProtocolError,
+                g_P2PExceptionMsg[P2PExceptionType::ProtocolError]);
+            onMessage(e, self, message);
+            break;
+        }
+    }
+}
+
+void Session::resumeRead()
+{
+    m_readPaused = false;
+    if (m_dropped)
+        return;
+    LOG(DEBUG) << "Session::resumeRead, handler queue drained";
+    readMessages();
+}
+
+void Session::dispatch(Message::Ptr message, std::function<void()> const& handler)
+{
+    if (!m_dispatcher)
+    {
+        m_threadPool->enqueue(handler);
+        return;
+    }
+    PROTOCOL_ID queueID =
+        MessageDispatcher::queueID(message->protocolID(), ref(*message->buffer()));
+    ///< responses answer our own requests, only requests hold the reads back
+    if (m_dispatcher->push(queueID, handler) || !message->isRequestPacket())
+        return;
+
+    LOG(WARNING) << "Session::dispatch, handler queue full, pause reading, protocolID="
+                 << message->protocolID();
+    m_readPaused = true;
+    auto self(shared_from_this());
+    m_dispatcher->onDrained(queueID, [self]() {
+        self->m_server->asioInterface()->strand_post(
+            *self->m_strand, boost::bind(&Session::resumeRead, self));
+    });
+}
+
 bool Session::checkRead(boost::system::error_code _ec)
 {
     if (_ec && _ec.category() != boost::asio::error::get_misc_category() &&
@@ -382,8 +422,7 @@ void Session::onMessage(
         {
             LOG(INFO) << "Session::onMessage, call callbackFunc by protocolID=" << protocolID;
             ///< execute funtion, send response packet by user in callbackFunc
-            ///< TODO: use threadPool
-            m_threadPool->enqueue(
+            dispatch(message,
                 [callbackFunc, e, session, message]() { callbackFunc(e, session, message); });
         }
         else
@@ -405,9 +444,7 @@ void Session::onMessage(
             if (callback->callbackFunc)
             {
                 LOG(INFO) << "Session::onMessage, call callbackFunc by seq=" << message->seq();
-                ///< TODO: use threadPool
-                m_threadPool->enqueue(
-                    [callback, e, message]() { callback->callbackFunc(e, message); });
+                dispatch(message, [callback, e, message]() { callback->callbackFunc(e, message); });
             }
             else
             {
@@ -475,16 +512,9 @@ uint32_t Session::peerTopicSeq(NodeID const& nodeID)
     uint32_t seq = uint32_t(-1);
     try
     {
-        RecursiveGuard l(m_server->mutexSessions());
-        auto s = m_server->sessions();
-        for (auto const& i : s)
-        {
-            if (i.first == nodeID)
-            {
-                seq = i.second->topicSeq();
-                break;
-            }
-        }
+        std::shared_ptr<SessionFace> p = m_server->peerSession(nodeID);
+        if (p)
+            seq = p->topicSeq();
     }
     catch (std::exception& e)
     {
@@ -498,17 +528,12 @@ void Session::setTopicsAndTopicSeq(
 {
     try
     {
-        RecursiveGuard l(m_server->mutexSessions());
-        auto s = m_server->sessions();
-        for (auto const& i : s)
+        std::shared_ptr<SessionFace> p = m_server->peerSession(nodeID);
+        if (p)
         {
-            if (i.first == nodeID)
-            {
-                std::shared_ptr<SessionFace> p = i.second;
-                p->setTopics(_topics);
-                p->setTopicSeq(_topicSeq);
-                break;
-            }
+            p->setTopics(_topics);
+            p->setTopicSeq(_topicSeq);
+            m_server->onSessionsChanged();
         }
     }
     catch (std::exception& e)
@@ -33,6 +33,7 @@
 #include <libdevcore/ThreadPool.h>
 #include <boost/heap/priority_queue.hpp>
 #include <array>
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -108,6 +109,10 @@ public:
     void setTopicsAndTopicSeq(NodeID const& nodeID,
         std::shared_ptr<std::vector<std::string>> _topics, uint32_t _topicSeq);
     void setThreadPool(std::shared_ptr<dev::ThreadPool> threadPool) { m_threadPool = threadPool; }
+    void setDispatcher(MessageDispatcher::Ptr dispatcher) override { m_dispatcher = dispatcher; }
+
+    bool peerCompress() const override { return m_peerCompress; }
+    void setPeerCompress(bool _peerCompress) override { m_peerCompress = _peerCompress; }
 
     MessageFactory::Ptr messageFactory() const override { return m_messageFactory; }
 
@@ -143,8 +148,16 @@ private:
     void onWrite(boost::system::error_code ec, std::size_t length);
     void write();
 
+    /// decode the messages read so far and hand them over, read more when all are decoded
+    void readMessages();
+    /// go on reading once the full handler queue that paused the reads has drained
+    void resumeRead();
+
     /// call by doRead() to deal with mesage
     void onMessage(P2PException const& e, std::shared_ptr<Session> session, Message::Ptr message);
+    /// queue the handler of message in the dispatcher, pause reading if its queue is full and
+    /// may not drop handlers
+    void dispatch(Message::Ptr message, std::function<void()> const& handler);
 
     bool CheckGroupIDAndSender(PROTOCOL_ID protocolID, std::shared_ptr<Session> session);
 
@@ -201,6 +214,9 @@ private:
     mutable RecursiveMutex x_seq2Callback;
     std::shared_ptr<std::unordered_map<uint32_t, ResponseCallback::Ptr>> m_seq2Callback;
     std::shared_ptr<dev::ThreadPool> m_threadPool;
+    MessageDispatcher::Ptr m_dispatcher;
+    bool m_readPaused = false;  ///< a handler queue is full, no read until it drains
+    std::atomic<bool> m_peerCompress{false};  ///< the peer announced CompressSupport
 };
 
 }  // namespace p2p
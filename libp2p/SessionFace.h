@@ -27,6 +27,7 @@
  */
 
 #pragma once
+#include "MessageDispatcher.h"
 #include <libdevcore/ThreadPool.h>
 #include <memory>
 namespace dev
@@ -60,6 +61,10 @@ public:
 
     virtual void send(std::shared_ptr<bytes> _msg) = 0;
 
+    ///< whether the peer announced that it inflates COMPRESS_FLAG payloads
+    virtual bool peerCompress() const = 0;
+    virtual void setPeerCompress(bool _peerCompress) = 0;
+
     ///< interface to set and get topicSeq
     virtual void setTopicSeq(uint32_t _topicSeq) = 0;
     virtual uint32_t topicSeq() const = 0;
@@ -81,6 +86,7 @@ public:
     virtual void setMessageFactory(MessageFactory::Ptr _messageFactory) = 0;
 
     virtual void setThreadPool(std::shared_ptr<dev::ThreadPool> threadPool) = 0;
+    virtual void setDispatcher(std::shared_ptr<MessageDispatcher> dispatcher) = 0;
 };
 }  // namespace p2p
 }  // namespace dev
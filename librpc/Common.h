@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace dev
@@ -36,12 +37,18 @@ enum RPCExceptionType
     Host,
     BlockHash,
     BlockNumberT,
-    TransactionIndex
+    TransactionIndex,
+    BlockRange
 };
 
 const std::string RPCMsg[] = {"Success", "GroupID does not exist.", "Response json parse error.",
     "Host is null", "BlockHash does not exist.", "BlockNumber does not exist.",
-    "TransactionIndex is out of bounds."};
+    "TransactionIndex is out of bounds.", "Block range is invalid."};
+
+///< the most blocks getBlocksByRange returns at once
+const int64_t c_maxBlocksRange = 100;
+///< the most transactions sendRawTransactions accepts at once
+const unsigned c_maxRawTransactions = 1000;
 
 }  // namespace rpc
 }  // namespace dev
@@ -54,6 +54,33 @@ Json::Value toJson(
     return res;
 }
 
+void writeTransaction(JsonWriter& _writer, Transaction const& _t,
+    std::pair<h256, unsigned> _location, BlockNumber _blockNumber)
+{
+    if (!_t)
+    {
+        _writer.null();
+        return;
+    }
+    /// in the key order of Json::Value
+    _writer.beginObject();
+    _writer.key("blockHash").hex(_location.first);
+    _writer.key("blockNumber").quantity(_blockNumber);
+    _writer.key("from").hex(_t.safeSender());
+    _writer.key("gas").quantity(_t.gas());
+    _writer.key("gasPrice").quantity(_t.gasPrice());
+    _writer.key("hash").hex(_t.sha3());
+    _writer.key("input").hex(_t.data());
+    _writer.key("nonce").quantity(_t.nonce());
+    if (_t.isCreation())
+        _writer.key("to").null();
+    else
+        _writer.key("to").hex(_t.receiveAddress());
+    _writer.key("transactionIndex").quantity(_location.second);
+    _writer.key("value").quantity(_t.value());
+    _writer.endObject();
+}
+
 TransactionSkeleton toTransactionSkeleton(Json::Value const& _json)
 {
     TransactionSkeleton ret;
@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include "JsonWriter.h"
 #include <json/json.h>
 #include <libethcore/Common.h>
 #include <libp2p/Common.h>
@@ -30,6 +31,9 @@ namespace rpc
 {
 Json::Value toJson(dev::eth::Transaction const& _t, std::pair<h256, unsigned> _location,
     dev::eth::BlockNumber _blockNumber);
+/// writes the members of toJson straight into _writer
+void writeTransaction(JsonWriter& _writer, dev::eth::Transaction const& _t,
+    std::pair<h256, unsigned> _location, dev::eth::BlockNumber _blockNumber);
 dev::eth::TransactionSkeleton toTransactionSkeleton(Json::Value const& _json);
 
 }  // namespace rpc
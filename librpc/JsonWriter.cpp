@@ -0,0 +1,156 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief: writes JSON text straight into a response buffer, without building a Json::Value
+ *
+ * @file JsonWriter.cpp
+ * @date 2018-12-14
+ */
+#include "JsonWriter.h"
+#include <libdevcore/CommonData.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::rpc;
+
+namespace
+{
+char const c_hexDigits[] = "0123456789abcdef";
+
+/// hex of the big-endian _data without the leading zero nibble, "0" if _data is empty
+void appendQuantity(std::string& _out, byte const* _data, size_t _size)
+{
+    _out += "\"0x";
+    if (_size == 0)
+        _out += '0';
+    else
+    {
+        if (_data[0] >> 4)
+            _out += c_hexDigits[_data[0] >> 4];
+        _out += c_hexDigits[_data[0] & 0x0f];
+        for (size_t i = 1; i < _size; ++i)
+        {
+            _out += c_hexDigits[_data[i] >> 4];
+            _out += c_hexDigits[_data[i] & 0x0f];
+        }
+    }
+    _out += '"';
+}
+}  // namespace
+
+JsonWriter& JsonWriter::beginObject()
+{
+    separate();
+    m_out += '{';
+    m_needComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject()
+{
+    m_out += '}';
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray()
+{
+    separate();
+    m_out += '[';
+    m_needComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray()
+{
+    m_out += ']';
+    m_needComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(char const* _key)
+{
+    separate();
+    m_out += '"';
+    m_out += _key;
+    m_out += "\":";
+    m_needComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string const& _value)
+{
+    separate();
+    m_out += Json::valueToQuotedString(_value.c_str());
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(Json::Value const& _value)
+{
+    separate();
+    Json::FastWriter writer;
+    m_out += writer.write(_value);
+    /// FastWriter terminates the document with a line feed
+    if (!m_out.empty() && m_out.back() == '\n')
+        m_out.pop_back();
+    return *this;
+}
+
+JsonWriter& JsonWriter::null()
+{
+    separate();
+    m_out += "null";
+    return *this;
+}
+
+JsonWriter& JsonWriter::hex(bytesConstRef _data)
+{
+    separate();
+    size_t offset = m_out.size();
+    m_out.resize(offset + _data.size() * 2 + 4);
+    char* p = &m_out[offset];
+    *p++ = '"';
+    *p++ = '0';
+    *p++ = 'x';
+    for (byte b : _data)
+    {
+        *p++ = c_hexDigits[b >> 4];
+        *p++ = c_hexDigits[b & 0x0f];
+    }
+    *p = '"';
+    return *this;
+}
+
+JsonWriter& JsonWriter::quantity(u256 const& _value)
+{
+    separate();
+    bytes data = toCompactBigEndian(_value);
+    appendQuantity(m_out, data.data(), data.size());
+    return *this;
+}
+
+JsonWriter& JsonWriter::quantity(uint64_t _value)
+{
+    separate();
+    byte data[sizeof(uint64_t)];
+    size_t size = 0;
+    for (uint64_t v = _value; v; v >>= 8)
+        size++;
+    for (size_t i = 0; i < size; ++i)
+        data[i] = (byte)(_value >> (8 * (size - 1 - i)));
+    appendQuantity(m_out, data, size);
+    return *this;
+}
@@ -0,0 +1,79 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief: writes JSON text straight into a response buffer, without building a Json::Value
+ *
+ * @file JsonWriter.h
+ * @date 2018-12-14
+ */
+#pragma once
+
+#include <json/json.h>
+#include <libdevcore/Common.h>
+#include <libdevcore/FixedHash.h>
+#include <string>
+
+namespace dev
+{
+namespace rpc
+{
+/**
+ * @brief appends compact JSON to a string; numbers and binary data are written in the formats
+ * of toJS, so the text equals Json::FastWriter's output for the same members in key order.
+ */
+class JsonWriter
+{
+public:
+    explicit JsonWriter(std::string& _out) : m_out(_out) {}
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+    /// starts a member of the current object, the next call writes its value
+    JsonWriter& key(char const* _key);
+
+    JsonWriter& value(std::string const& _value);
+    JsonWriter& value(Json::Value const& _value);
+    JsonWriter& null();
+    /// "0x" prefixed hex of _data, as toHexPrefixed
+    JsonWriter& hex(bytesConstRef _data);
+    JsonWriter& hex(bytes const& _data) { return hex(ref(_data)); }
+    template <unsigned N>
+    JsonWriter& hex(FixedHash<N> const& _hash)
+    {
+        return hex(_hash.ref());
+    }
+    /// "0x" prefixed hex without leading zeros, as toJS of a number
+    JsonWriter& quantity(u256 const& _value);
+    JsonWriter& quantity(uint64_t _value);
+
+    std::string& out() { return m_out; }
+
+private:
+    void separate()
+    {
+        if (m_needComma)
+            m_out += ',';
+        m_needComma = true;
+    }
+
+    std::string& m_out;
+    bool m_needComma = false;  ///< a value has been written at the current level
+};
+
+}  // namespace rpc
+}  // namespace dev
@@ -21,12 +21,15 @@
 
 #pragma once
 
+#include <jsonrpccpp/common/exception.h>
 #include <jsonrpccpp/common/procedure.h>
 #include <jsonrpccpp/server/abstractserverconnector.h>
+#include <jsonrpccpp/server/iclientconnectionhandler.h>
 #include <jsonrpccpp/server/iprocedureinvokationhandler.h>
 #include <jsonrpccpp/server/requesthandlerfactory.h>
 #include <libdevcore/easylog.h>
 #include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -37,6 +40,10 @@ template <class I>
 using AbstractMethodPointer = void (I::*)(Json::Value const& _parameter, Json::Value& _result);
 template <class I>
 using AbstractNotificationPointer = void (I::*)(Json::Value const& _parameter);
+/// writes the JSON text of the result into _result instead of building a Json::Value
+template <class I>
+using AbstractStreamMethodPointer = void (I::*)(
+    Json::Value const& _parameter, std::string& _result);
 
 template <class I>
 class ServerInterface
@@ -47,8 +54,12 @@ public:
 
     using MethodBinding = std::tuple<jsonrpc::Procedure, AbstractMethodPointer<I>>;
     using NotificationBinding = std::tuple<jsonrpc::Procedure, AbstractNotificationPointer<I>>;
+    /// method name, types of the positional parameters and the streaming implementation
+    using StreamMethodBinding =
+        std::tuple<std::string, std::vector<Json::ValueType>, AbstractStreamMethodPointer<I>>;
     using Methods = std::vector<MethodBinding>;
     using Notifications = std::vector<NotificationBinding>;
+    using StreamMethods = std::vector<StreamMethodBinding>;
     struct RPCModule
     {
         std::string name;
@@ -59,6 +70,7 @@ public:
     virtual ~ServerInterface() {}
     Methods const& methods() const { return m_methods; }
     Notifications const& notifications() const { return m_notifications; }
+    StreamMethods const& streamMethods() const { return m_streamMethods; }
     /// @returns which interfaces (eth, admin, db, ...) this class implements in which version.
     virtual RPCModules implementedModules() const = 0;
 
@@ -71,10 +83,172 @@ protected:
     {
         m_notifications.emplace_back(_proc, _pointer);
     }
+    /// serve the already bound method _name with _pointer when its parameters have _types
+    void bindStreamMethod(std::string const& _name, std::vector<Json::ValueType> const& _types,
+        AbstractStreamMethodPointer<I> _pointer)
+    {
+        m_streamMethods.emplace_back(_name, _types, _pointer);
+    }
 
 private:
     Methods m_methods;
     Notifications m_notifications;
+    StreamMethods m_streamMethods;
+};
+
+/**
+ * @brief answers requests of the streaming methods with a response written around the JSON text
+ * they produce, and the calls of a batch one by one so those among them stream too.
+ * Requests that name no streaming method go to the jsonrpccpp protocol handler unparsed, as do
+ * notifications and parameters of other types. A streaming method that throws is answered as
+ * ModularServer::HandleMethodCall answers the other methods, with ret_code -1 and detail_info.
+ */
+class StreamRequestHandler : public jsonrpc::IClientConnectionHandler
+{
+public:
+    using StreamMethod = std::function<void(Json::Value const& _parameter, std::string& _result)>;
+
+    explicit StreamRequestHandler(jsonrpc::IClientConnectionHandler& _handler)
+      : m_handler(_handler)
+    {}
+
+    void addMethod(std::string const& _name, std::vector<Json::ValueType> const& _types,
+        StreamMethod const& _method)
+    {
+        m_methods[_name] = std::make_pair(_types, _method);
+    }
+
+    void HandleRequest(const std::string& _request, std::string& _retValue) override
+    {
+        Json::Value request;
+        Json::Reader reader;
+        if (namesStreamMethod(_request) && reader.parse(_request, request, false))
+        {
+            if (request.isObject() && handleStreamRequest(request, _retValue))
+                return;
+            if (request.isArray() && !request.empty())
+            {
+                handleBatch(request, _retValue);
+                return;
+            }
+        }
+        m_handler.HandleRequest(_request, _retValue);
+    }
+
+private:
+    /// whether a "method" member of the request text is a streaming method, without parsing it;
+    /// names written with escapes are not recognised and simply go to jsonrpccpp
+    bool namesStreamMethod(std::string const& _request) const
+    {
+        static std::string const c_member = "\"method\"";
+        static char const* const c_space = " \t\r\n";
+        if (m_methods.empty())
+            return false;
+        size_t pos = _request.find(c_member);
+        while (pos != std::string::npos)
+        {
+            pos = _request.find_first_not_of(c_space, pos + c_member.size());
+            if (pos != std::string::npos && _request[pos] == ':')
+                pos = _request.find_first_not_of(c_space, pos + 1);
+            if (pos != std::string::npos && _request[pos] == '"')
+            {
+                size_t end = _request.find('"', pos + 1);
+                if (end == std::string::npos)
+                    return false;
+                if (m_methods.count(_request.substr(pos + 1, end - pos - 1)))
+                    return true;
+                pos = end;
+            }
+            pos = _request.find(c_member, pos);
+        }
+        return false;
+    }
+
+    /// the response ModularServer::HandleMethodCall writes for an exception of a method
+    static void writeFailure(Json::Value const& _id, std::string const& _method,
+        std::exception const& _e, std::string& _retValue)
+    {
+        std::string errorMsg = "callback " + _method + " exceptioned, error msg:" + _e.what();
+        LOG(ERROR) << errorMsg;
+        Json::Value response;
+        response["id"] = _id;
+        response["jsonrpc"] = "2.0";
+        response["result"]["ret_code"] = -1;
+        response["result"]["detail_info"] = errorMsg;
+        _retValue = Json::FastWriter().write(response);
+    }
+
+    /// responses of the calls in order, calls without one (notifications) are left out
+    void handleBatch(Json::Value const& _requests, std::string& _retValue)
+    {
+        std::string response = "[";
+        Json::FastWriter writer;
+        for (auto const& request : _requests)
+        {
+            std::string single;
+            if (!request.isObject() || !handleStreamRequest(request, single))
+                m_handler.HandleRequest(writer.write(request), single);
+            if (!single.empty() && single.back() == '\n')
+                single.pop_back();
+            if (single.empty())
+                continue;
+            if (response.size() > 1)
+                response += ',';
+            response += single;
+        }
+        if (response.size() == 1)
+        {
+            _retValue.clear();
+            return;
+        }
+        response += "]\n";
+        _retValue.swap(response);
+    }
+
+    bool handleStreamRequest(Json::Value const& _request, std::string& _retValue)
+    {
+        if (!_request["method"].isString() || !_request["params"].isArray() ||
+            !(_request["id"].isIntegral() || _request["id"].isString()) ||
+            _request["jsonrpc"] != "2.0")
+            return false;
+        auto it = m_methods.find(_request["method"].asString());
+        if (it == m_methods.end())
+            return false;
+
+        Json::Value const& params = _request["params"];
+        std::vector<Json::ValueType> const& types = it->second.first;
+        if (params.size() != types.size())
+            return false;
+        for (Json::ArrayIndex i = 0; i < params.size(); ++i)
+        {
+            if (params[i].type() != types[i] &&
+                !(types[i] == Json::intValue && params[i].isInt()))
+                return false;
+        }
+
+        /// members in the key order jsonrpccpp writes them
+        std::string response = "{\"id\":";
+        Json::FastWriter writer;
+        response += writer.write(_request["id"]);
+        response.pop_back();
+        response += ",\"jsonrpc\":\"2.0\",\"result\":";
+        /// a method that throws has run, it is answered with the error and never run again
+        try
+        {
+            it->second.second(params, response);
+        }
+        catch (std::exception const& e)
+        {
+            writeFailure(_request["id"], it->first, e, _retValue);
+            return true;
+        }
+        response += "}\n";
+        _retValue.swap(response);
+        return true;
+    }
+
+    jsonrpc::IClientConnectionHandler& m_handler;
+    std::map<std::string, std::pair<std::vector<Json::ValueType>, StreamMethod>> m_methods;
 };
 
 template <class... Is>
@@ -83,7 +257,8 @@ class ModularServer : public jsonrpc::IProcedureInvokationHandler
 public:
     ModularServer()
       : m_handler(jsonrpc::RequestHandlerFactory::createProtocolHandler(
-            jsonrpc::JSONRPC_SERVER_V2, *this))
+            jsonrpc::JSONRPC_SERVER_V2, *this)),
+        m_streamHandler(*m_handler)
     {
         m_handler->AddProcedure(jsonrpc::Procedure(
             "rpc_modules", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, NULL));
@@ -132,7 +307,7 @@ public:
     unsigned addConnector(jsonrpc::AbstractServerConnector* _connector)
     {
         m_connectors.emplace_back(_connector);
-        _connector->SetHandler(m_handler.get());
+        _connector->SetHandler(&m_streamHandler);
         return m_connectors.size() - 1;
     }
 
@@ -144,6 +319,8 @@ public:
 protected:
     std::vector<std::unique_ptr<jsonrpc::AbstractServerConnector>> m_connectors;
     std::unique_ptr<jsonrpc::IProtocolHandler> m_handler;
+    /// in front of m_handler for the methods with a streaming implementation
+    StreamRequestHandler m_streamHandler;
     /// Mapping for implemented modules, to be filled by subclasses during construction.
     Json::Value m_implementedModules;
 };
@@ -171,6 +348,12 @@ public:
                 std::get<1>(notification);
             this->m_handler->AddProcedure(std::get<0>(notification));
         }
+        for (auto const& method : m_interface->streamMethods())
+        {
+            this->m_streamHandler.addMethod(std::get<0>(method), std::get<1>(method),
+                std::bind(std::get<2>(method), m_interface.get(), std::placeholders::_1,
+                    std::placeholders::_2));
+        }
         // Store module with version.
         for (auto const& module : m_interface->implementedModules())
             this->m_implementedModules[module.name] = module.version;
@@ -29,6 +29,7 @@
 #include <libethcore/CommonJS.h>
 #include <libethcore/Transaction.h>
 #include <libexecutive/ExecutionResult.h>
+#include <libstorage/LevelDBStorage.h>
 #include <libsync/SyncStatus.h>
 #include <libtxpool/TxPoolInterface.h>
 #include <boost/algorithm/hex.hpp>
@@ -38,6 +39,152 @@ using namespace jsonrpc;
 using namespace dev::rpc;
 using namespace dev::sync;
 
+namespace
+{
+/// the members of the getBlockByHash/getBlockByNumber response, in the key order of Json::Value
+void writeBlock(JsonWriter& _writer, dev::eth::Block const& _block, dev::h256 const& _hash,
+    bool _includeTransactions)
+{
+    dev::eth::BlockHeader const& header = _block.blockHeader();
+    _writer.beginObject();
+    _writer.key("extraData").beginArray();
+    for (auto const& data : header.extraData())
+        _writer.hex(data);
+    _writer.endArray();
+    _writer.key("gasLimit").quantity(header.gasLimit());
+    _writer.key("gasUsed").quantity(header.gasUsed());
+    _writer.key("hash").hex(_hash);
+    _writer.key("logsBloom").hex(header.logBloom());
+    _writer.key("number").quantity(header.number());
+    _writer.key("parentHash").hex(header.parentHash());
+    _writer.key("sealer").quantity(header.sealer());
+    _writer.key("stateRoot").hex(header.stateRoot());
+    _writer.key("timestamp").quantity(header.timestamp());
+    _writer.key("transactions").beginArray();
+    auto const& transactions = _block.transactions();
+    for (unsigned i = 0; i < transactions.size(); i++)
+    {
+        if (_includeTransactions)
+            writeTransaction(_writer, transactions[i], std::make_pair(_hash, i), header.number());
+        else
+            _writer.hex(transactions[i].sha3());
+    }
+    _writer.endArray();
+    _writer.key("transactionsRoot").hex(header.transactionsRoot());
+    _writer.endObject();
+}
+
+/// the receipts of a block, members as getTransactionReceipt in the key order of Json::Value
+void writeReceipts(JsonWriter& _writer, dev::eth::Block const& _block)
+{
+    dev::eth::BlockHeader const& header = _block.blockHeader();
+    dev::h256 hash = _block.headerHash();
+    auto const& transactions = _block.transactions();
+    auto const& receipts = _block.transactionReceipts();
+    _writer.beginArray();
+    for (unsigned i = 0; i < receipts.size() && i < transactions.size(); i++)
+    {
+        auto const& receipt = receipts[i];
+        _writer.beginObject();
+        _writer.key("blockHash").hex(hash);
+        _writer.key("blockNumber").quantity(header.number());
+        _writer.key("contractAddress").hex(receipt.contractAddress());
+        _writer.key("from").hex(transactions[i].from());
+        _writer.key("gasUsed").quantity(receipt.gasUsed());
+        _writer.key("logs").beginArray();
+        for (auto const& log : receipt.log())
+        {
+            _writer.beginObject();
+            _writer.key("address").hex(log.address);
+            _writer.key("data").hex(log.data);
+            _writer.key("topics").beginArray();
+            for (auto const& topic : log.topics)
+                _writer.hex(topic);
+            _writer.endArray();
+            _writer.endObject();
+        }
+        _writer.endArray();
+        _writer.key("logsBloom").hex(receipt.bloom());
+        _writer.key("status").quantity(receipt.status());
+        _writer.key("to").hex(transactions[i].to());
+        _writer.key("transactionHash").hex(transactions[i].sha3());
+        _writer.key("transactionIndex").quantity((uint64_t)i);
+        _writer.endObject();
+    }
+    _writer.endArray();
+}
+
+/// the tree of writeBlock
+Json::Value blockJson(
+    dev::eth::Block const& _block, dev::h256 const& _hash, bool _includeTransactions)
+{
+    dev::eth::BlockHeader const& header = _block.blockHeader();
+    Json::Value response;
+    response["number"] = dev::toJS(header.number());
+    response["hash"] = dev::toJS(_hash);
+    response["parentHash"] = dev::toJS(header.parentHash());
+    response["logsBloom"] = dev::toJS(header.logBloom());
+    response["transactionsRoot"] = dev::toJS(header.transactionsRoot());
+    response["stateRoot"] = dev::toJS(header.stateRoot());
+    response["sealer"] = dev::toJS(header.sealer());
+    response["extraData"] = Json::Value(Json::arrayValue);
+    for (auto const& data : header.extraData())
+        response["extraData"].append(dev::toJS(data));
+    response["gasLimit"] = dev::toJS(header.gasLimit());
+    response["gasUsed"] = dev::toJS(header.gasUsed());
+    response["timestamp"] = dev::toJS(header.timestamp());
+    response["transactions"] = Json::Value(Json::arrayValue);
+    auto const& transactions = _block.transactions();
+    for (unsigned i = 0; i < transactions.size(); i++)
+    {
+        if (_includeTransactions)
+            response["transactions"].append(
+                toJson(transactions[i], std::make_pair(_hash, i), header.number()));
+        else
+            response["transactions"].append(dev::toJS(transactions[i].sha3()));
+    }
+    return response;
+}
+
+/// the tree of writeReceipts
+Json::Value receiptsJson(dev::eth::Block const& _block)
+{
+    dev::eth::BlockHeader const& header = _block.blockHeader();
+    dev::h256 hash = _block.headerHash();
+    auto const& transactions = _block.transactions();
+    auto const& receipts = _block.transactionReceipts();
+    Json::Value response(Json::arrayValue);
+    for (unsigned i = 0; i < receipts.size() && i < transactions.size(); i++)
+    {
+        auto const& receipt = receipts[i];
+        Json::Value item;
+        item["blockHash"] = dev::toJS(hash);
+        item["blockNumber"] = dev::toJS(header.number());
+        item["contractAddress"] = dev::toJS(receipt.contractAddress());
+        item["from"] = dev::toJS(transactions[i].from());
+        item["gasUsed"] = dev::toJS(receipt.gasUsed());
+        item["logs"] = Json::Value(Json::arrayValue);
+        for (auto const& log : receipt.log())
+        {
+            Json::Value logJson;
+            logJson["address"] = dev::toJS(log.address);
+            logJson["data"] = dev::toJS(log.data);
+            logJson["topics"] = Json::Value(Json::arrayValue);
+            for (auto const& topic : log.topics)
+                logJson["topics"].append(dev::toJS(topic));
+            item["logs"].append(logJson);
+        }
+        item["logsBloom"] = dev::toJS(receipt.bloom());
+        item["status"] = dev::toJS(receipt.status());
+        item["to"] = dev::toJS(transactions[i].to());
+        item["transactionHash"] = dev::toJS(transactions[i].sha3());
+        item["transactionIndex"] = dev::toJS((uint64_t)i);
+        response.append(item);
+    }
+    return response;
+}
+}  // namespace
+
 
 Rpc::Rpc(std::shared_ptr<dev::ledger::LedgerManager> _ledgerManager,
     std::shared_ptr<dev::p2p::P2PInterface> _service)
@@ -173,6 +320,37 @@ Json::Value Rpc::syncStatus(int _groupID)
     }
 }
 
+Json::Value Rpc::storageStatus(int _groupID)
+{
+    try
+    {
+        LOG(INFO) << "storageStatus # request = " << std::endl
+                  << "{ " << std::endl
+                  << "\"_groupID\" : " << _groupID << std::endl
+                  << "}";
+
+        auto blockChain = ledgerManager()->blockChain(_groupID);
+        if (!blockChain)
+            BOOST_THROW_EXCEPTION(
+                JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
+
+        /// only the leveldb engine has internal stats to show
+        auto storage = std::dynamic_pointer_cast<dev::storage::LevelDBStorage>(
+            ledgerManager()->storage(_groupID));
+        if (!storage)
+            return Json::Value(Json::objectValue);
+        return storage->status();
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (...)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+    }
+}
+
 
 std::string Rpc::version()
 {
@@ -290,6 +468,63 @@ Json::Value Rpc::groupList()
     }
 }
 
+Json::Value Rpc::queueStatus()
+{
+    try
+    {
+        Json::Value response = Json::Value(Json::arrayValue);
+
+        auto host = service()->host();
+        if (!host)
+            BOOST_THROW_EXCEPTION(
+                JsonRpcException(RPCExceptionType::Host, RPCMsg[RPCExceptionType::Host]));
+
+        /// no queue before the network is started
+        auto dispatcher = host->dispatcher();
+        if (!dispatcher)
+            return response;
+        for (auto const& status : dispatcher->status())
+        {
+            Json::Value queue;
+            queue["protocolID"] = status.protocolID;
+            queue["priority"] = status.priority;
+            queue["depth"] = Json::UInt64(status.depth);
+            queue["maxDepth"] = Json::UInt64(status.maxDepth);
+            queue["capacity"] = Json::UInt64(dispatcher->capacity());
+            queue["dispatched"] = Json::UInt64(status.dispatched);
+            queue["paused"] = Json::UInt64(status.paused);
+            queue["dropped"] = Json::UInt64(status.dropped);
+            queue["averageWaitMicroseconds"] = Json::UInt64(
+                status.dispatched ? status.totalWaitMicroseconds / status.dispatched : 0);
+            queue["maxWaitMicroseconds"] = Json::UInt64(status.maxWaitMicroseconds);
+            response.append(queue);
+        }
+
+        return response;
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (...)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+    }
+}
+
+Json::Value Rpc::compressStatus()
+{
+    CompressStatistics const& stat = Message::compressStatistics();
+    Json::Value response;
+    response["compressThreshold"] = Json::UInt64(Message::compressThreshold());
+    response["compressedPackets"] = Json::UInt64(stat.compressedPackets);
+    response["rawBytes"] = Json::UInt64(stat.rawBytes);
+    response["compressedBytes"] = Json::UInt64(stat.compressedBytes);
+    response["compressMicroseconds"] = Json::UInt64(stat.compressMicroseconds);
+    response["decompressedPackets"] = Json::UInt64(stat.decompressedPackets);
+    response["decompressMicroseconds"] = Json::UInt64(stat.decompressMicroseconds);
+    return response;
+}
 
 Json::Value Rpc::getBlockByHash(
     int _groupID, const std::string& _blockHash, bool _includeTransactions)
@@ -305,20 +540,11 @@ Json::Value Rpc::getBlockByHash(
 
         Json::Value response;
 
-        auto blockchain = ledgerManager()->blockChain(_groupID);
-
-        if (!blockchain)
-            BOOST_THROW_EXCEPTION(
-                JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
-
         h256 hash = jsToFixed<32>(_blockHash);
-        auto block = blockchain->getBlockByHash(hash);
-        if (!block)
-            BOOST_THROW_EXCEPTION(
-                JsonRpcException(RPCExceptionType::BlockHash, RPCMsg[RPCExceptionType::BlockHash]));
+        auto block = blockByHash(_groupID, hash);
 
         response["number"] = toJS(block->header().number());
-        response["hash"] = _blockHash;
+        response["hash"] = toJS(hash);
         response["parentHash"] = toJS(block->header().parentHash());
         response["logsBloom"] = toJS(block->header().logBloom());
         response["transactionsRoot"] = toJS(block->header().transactionsRoot());
@@ -331,7 +557,7 @@ Json::Value Rpc::getBlockByHash(
         response["gasLimit"] = toJS(block->header().gasLimit());
         response["gasUsed"] = toJS(block->header().gasUsed());
         response["timestamp"] = toJS(block->header().timestamp());
-        auto transactions = block->transactions();
+        auto const& transactions = block->transactions();
         response["transactions"] = Json::Value(Json::arrayValue);
         for (unsigned i = 0; i < transactions.size(); i++)
         {
@@ -370,15 +596,7 @@ Json::Value Rpc::getBlockByNumber(
         Json::Value response;
 
         BlockNumber number = jsToBlockNumber(_blockNumber);
-        auto blockchain = ledgerManager()->blockChain(_groupID);
-        if (!blockchain)
-            BOOST_THROW_EXCEPTION(
-                JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
-
-        auto block = blockchain->getBlockByNumber(number);
-        if (!block)
-            BOOST_THROW_EXCEPTION(JsonRpcException(
-                RPCExceptionType::BlockNumberT, RPCMsg[RPCExceptionType::BlockNumberT]));
+        auto block = blockByNumber(_groupID, number);
 
         response["number"] = toJS(number);
         response["hash"] = toJS(block->headerHash());
@@ -394,7 +612,7 @@ Json::Value Rpc::getBlockByNumber(
         response["gasLimit"] = toJS(block->header().gasLimit());
         response["gasUsed"] = toJS(block->header().gasUsed());
         response["timestamp"] = toJS(block->header().timestamp());
-        auto transactions = block->transactions();
+        auto const& transactions = block->transactions();
         response["transactions"] = Json::Value(Json::arrayValue);
         for (unsigned i = 0; i < transactions.size(); i++)
         {
@@ -418,6 +636,303 @@ Json::Value Rpc::getBlockByNumber(
 }
 
 
+void Rpc::getBlockByHash(
+    JsonWriter& _writer, int _groupID, const std::string& _blockHash, bool _includeTransactions)
+{
+    try
+    {
+        LOG(INFO) << "getBlockByHash # request = " << std::endl
+                  << "{ " << std::endl
+                  << "\"_groupID\" : " << _groupID << "," << std::endl
+                  << "\"_blockHash\" : " << _blockHash << "," << std::endl
+                  << "\"_includeTransactions\" : " << _includeTransactions << std::endl
+                  << "}";
+
+        h256 hash = jsToFixed<32>(_blockHash);
+        auto block = blockByHash(_groupID, hash);
+        writeBlock(_writer, *block, hash, _includeTransactions);
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (...)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+    }
+}
+
+
+void Rpc::getBlockByNumber(
+    JsonWriter& _writer, int _groupID, const std::string& _blockNumber, bool _includeTransactions)
+{
+    try
+    {
+        LOG(INFO) << "getBlockByNumber # request = " << std::endl
+                  << "{ " << std::endl
+                  << "\"_groupID\" : " << _groupID << "," << std::endl
+                  << "\"_blockNumber\" : " << _blockNumber << "," << std::endl
+                  << "\"_includeTransactions\" : " << _includeTransactions << std::endl
+                  << "}";
+
+        auto block = blockByNumber(_groupID, jsToBlockNumber(_blockNumber));
+        writeBlock(_writer, *block, block->headerHash(), _includeTransactions);
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (...)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+    }
+}
+
+
+std::string Rpc::getBlockRLPByNumber(int _groupID, const std::string& _blockNumber)
+{
+    std::string response;
+    JsonWriter writer(response);
+    getBlockRLPByNumber(writer, _groupID, _blockNumber);
+    /// without the quotes
+    return response.substr(1, response.size() - 2);
+}
+
+
+void Rpc::getBlockRLPByNumber(JsonWriter& _writer, int _groupID, const std::string& _blockNumber)
+{
+    try
+    {
+        LOG(INFO) << "getBlockRLPByNumber # request = " << std::endl
+                  << "{ " << std::endl
+                  << "\"_groupID\" : " << _groupID << "," << std::endl
+                  << "\"_blockNumber\" : " << _blockNumber << std::endl
+                  << "}";
+
+        auto blockRLP = blockRLPByNumber(_groupID, jsToBlockNumber(_blockNumber));
+        _writer.hex(*blockRLP);
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (...)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+    }
+}
+
+
+std::string Rpc::getReceiptsRLPByNumber(int _groupID, const std::string& _blockNumber)
+{
+    std::string response;
+    JsonWriter writer(response);
+    getReceiptsRLPByNumber(writer, _groupID, _blockNumber);
+    /// without the quotes
+    return response.substr(1, response.size() - 2);
+}
+
+
+void Rpc::getReceiptsRLPByNumber(
+    JsonWriter& _writer, int _groupID, const std::string& _blockNumber)
+{
+    try
+    {
+        LOG(INFO) << "getReceiptsRLPByNumber # request = " << std::endl
+                  << "{ " << std::endl
+                  << "\"_groupID\" : " << _groupID << "," << std::endl
+                  << "\"_blockNumber\" : " << _blockNumber << std::endl
+                  << "}";
+
+        auto blockRLP = blockRLPByNumber(_groupID, jsToBlockNumber(_blockNumber));
+        /// the block RLP is [header, transactions, receipts, hash, sigList]
+        _writer.hex(RLP(*blockRLP)[2].data());
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (...)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+    }
+}
+
+
+Json::Value Rpc::getBlocksByRange(int _groupID, const std::string& _from,
+    const std::string& _count, bool _includeTransactions)
+{
+    try
+    {
+        LOG(INFO) << "getBlocksByRange # request = " << std::endl
+                  << "{ " << std::endl
+                  << "\"_groupID\" : " << _groupID << "," << std::endl
+                  << "\"_from\" : " << _from << "," << std::endl
+                  << "\"_count\" : " << _count << "," << std::endl
+                  << "\"_includeTransactions\" : " << _includeTransactions << std::endl
+                  << "}";
+
+        Json::Value response(Json::arrayValue);
+        forEachBlockInRange(_groupID, _from, _count, [&](Block const& _block) {
+            response.append(blockJson(_block, _block.headerHash(), _includeTransactions));
+        });
+        return response;
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (...)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+    }
+}
+
+
+void Rpc::getBlocksByRange(JsonWriter& _writer, int _groupID, const std::string& _from,
+    const std::string& _count, bool _includeTransactions)
+{
+    try
+    {
+        LOG(INFO) << "getBlocksByRange # request = " << std::endl
+                  << "{ " << std::endl
+                  << "\"_groupID\" : " << _groupID << "," << std::endl
+                  << "\"_from\" : " << _from << "," << std::endl
+                  << "\"_count\" : " << _count << "," << std::endl
+                  << "\"_includeTransactions\" : " << _includeTransactions << std::endl
+                  << "}";
+
+        /// one block decoded at a time, written out before the next is read
+        _writer.beginArray();
+        forEachBlockInRange(_groupID, _from, _count, [&](Block const& _block) {
+            writeBlock(_writer, _block, _block.headerHash(), _includeTransactions);
+        });
+        _writer.endArray();
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (...)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+    }
+}
+
+
+Json::Value Rpc::getBlockReceipts(int _groupID, const std::string& _blockNumber)
+{
+    try
+    {
+        LOG(INFO) << "getBlockReceipts # request = " << std::endl
+                  << "{ " << std::endl
+                  << "\"_groupID\" : " << _groupID << "," << std::endl
+                  << "\"_blockNumber\" : " << _blockNumber << std::endl
+                  << "}";
+
+        auto block = blockByNumber(_groupID, jsToBlockNumber(_blockNumber));
+        return receiptsJson(*block);
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (...)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+    }
+}
+
+
+void Rpc::getBlockReceipts(JsonWriter& _writer, int _groupID, const std::string& _blockNumber)
+{
+    try
+    {
+        LOG(INFO) << "getBlockReceipts # request = " << std::endl
+                  << "{ " << std::endl
+                  << "\"_groupID\" : " << _groupID << "," << std::endl
+                  << "\"_blockNumber\" : " << _blockNumber << std::endl
+                  << "}";
+
+        auto block = blockByNumber(_groupID, jsToBlockNumber(_blockNumber));
+        writeReceipts(_writer, *block);
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (...)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+    }
+}
+
+
+std::shared_ptr<dev::blockchain::BlockChainInterface> Rpc::blockChain(int _groupID)
+{
+    auto blockchain = ledgerManager()->blockChain(_groupID);
+    if (!blockchain)
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
+    return blockchain;
+}
+
+
+void Rpc::forEachBlockInRange(int _groupID, const std::string& _from, const std::string& _count,
+    std::function<void(Block const&)> const& _onBlock)
+{
+    auto blockchain = blockChain(_groupID);
+    BlockNumber from = jsToBlockNumber(_from);
+    int64_t count = jsToInt(_count);
+    if (from < 0 || count <= 0 || count > c_maxBlocksRange)
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(RPCExceptionType::BlockRange, RPCMsg[RPCExceptionType::BlockRange]));
+
+    BlockNumber to = std::min<int64_t>(blockchain->number(), from + count - 1);
+    for (BlockNumber number = from; number <= to; number++)
+    {
+        auto block = blockchain->getBlockByNumber(number);
+        if (!block)
+            BOOST_THROW_EXCEPTION(JsonRpcException(
+                RPCExceptionType::BlockNumberT, RPCMsg[RPCExceptionType::BlockNumberT]));
+        _onBlock(*block);
+    }
+}
+
+
+std::shared_ptr<Block> Rpc::blockByHash(int _groupID, h256 const& _blockHash)
+{
+    auto blockchain = blockChain(_groupID);
+    auto block = blockchain->getBlockByHash(_blockHash);
+    if (!block)
+        BOOST_THROW_EXCEPTION(
+            JsonRpcException(RPCExceptionType::BlockHash, RPCMsg[RPCExceptionType::BlockHash]));
+    return block;
+}
+
+
+std::shared_ptr<Block> Rpc::blockByNumber(int _groupID, BlockNumber _blockNumber)
+{
+    auto blockchain = blockChain(_groupID);
+    auto block = blockchain->getBlockByNumber(_blockNumber);
+    if (!block)
+        BOOST_THROW_EXCEPTION(JsonRpcException(
+            RPCExceptionType::BlockNumberT, RPCMsg[RPCExceptionType::BlockNumberT]));
+    return block;
+}
+
+
+std::shared_ptr<dev::bytes> Rpc::blockRLPByNumber(int _groupID, BlockNumber _blockNumber)
+{
+    auto blockchain = blockChain(_groupID);
+    auto blockRLP = blockchain->getBlockRLPByNumber(_blockNumber);
+    if (!blockRLP)
+        BOOST_THROW_EXCEPTION(JsonRpcException(
+            RPCExceptionType::BlockNumberT, RPCMsg[RPCExceptionType::BlockNumberT]));
+    return blockRLP;
+}
+
+
 Json::Value Rpc::getTransactionByHash(int _groupID, const std::string& _transactionHash)
 {
     try
@@ -486,7 +1001,7 @@ Json::Value Rpc::getTransactionByBlockHashAndIndex(
             BOOST_THROW_EXCEPTION(
                 JsonRpcException(RPCExceptionType::BlockHash, RPCMsg[RPCExceptionType::BlockHash]));
 
-        auto transactions = block->transactions();
+        auto const& transactions = block->transactions();
         unsigned int txIndex = jsToInt(_transactionIndex);
         if (txIndex >= transactions.size())
             BOOST_THROW_EXCEPTION(JsonRpcException(
@@ -648,7 +1163,7 @@ Json::Value Rpc::pendingTransactions(int _groupID)
         Transactions transactions = txPool->pendingList();
         for (size_t i = 0; i < transactions.size(); ++i)
         {
-            auto tx = transactions[i];
+            auto const& tx = transactions[i];
             Json::Value txJson;
             txJson["from"] = toJS(tx.from());
             txJson["gas"] = toJS(tx.gas());
@@ -674,6 +1189,50 @@ Json::Value Rpc::pendingTransactions(int _groupID)
 }
 
 
+void Rpc::pendingTransactions(JsonWriter& _writer, int _groupID)
+{
+    try
+    {
+        LOG(INFO) << "pendingTransactions # request = " << std::endl
+                  << "{ " << std::endl
+                  << "\"_groupID\" : " << _groupID << std::endl
+                  << "}";
+
+        auto txPool = ledgerManager()->txPool(_groupID);
+        if (!txPool)
+            BOOST_THROW_EXCEPTION(
+                JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
+
+        Transactions transactions = txPool->pendingList();
+        _writer.beginObject();
+        _writer.key("pending").beginArray();
+        for (auto const& tx : transactions)
+        {
+            _writer.beginObject();
+            _writer.key("from").hex(tx.from());
+            _writer.key("gas").quantity(tx.gas());
+            _writer.key("gasPrice").quantity(tx.gasPrice());
+            _writer.key("hash").hex(tx.sha3());
+            _writer.key("input").hex(tx.data());
+            _writer.key("nonce").quantity(tx.nonce());
+            _writer.key("to").hex(tx.to());
+            _writer.key("value").quantity(tx.value());
+            _writer.endObject();
+        }
+        _writer.endArray();
+        _writer.endObject();
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (...)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+    }
+}
+
+
 std::string Rpc::call(int _groupID, const Json::Value& request)
 {
     try
@@ -690,6 +1249,15 @@ std::string Rpc::call(int _groupID, const Json::Value& request)
                 JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
 
         BlockNumber blockNumber = blockchain->number();
+        /// an optional "blockNumber" runs the call against the state of an earlier block
+        if (request.isMember("blockNumber"))
+        {
+            BlockNumber requested = jsToBlockNumber(request["blockNumber"].asString());
+            if (requested > blockNumber)
+                BOOST_THROW_EXCEPTION(JsonRpcException(
+                    RPCExceptionType::BlockNumberT, RPCMsg[RPCExceptionType::BlockNumberT]));
+            blockNumber = requested;
+        }
         auto block = blockchain->getBlockByNumber(blockNumber);
         if (!block)
             BOOST_THROW_EXCEPTION(JsonRpcException(
@@ -717,21 +1285,61 @@ std::string Rpc::sendRawTransaction(int _groupID, const std::string& _rlp)
 {
     try
     {
-        LOG(INFO) << "sendRawTransaction # request = " << std::endl
-                  << "{ " << std::endl
-                  << "\"_groupID\" : " << _groupID << "," << std::endl
-                  << "\"_rlp\" : " << _rlp << std::endl
-                  << "}";
+        ASYNC_LOG_RATED(INFO) << "sendRawTransaction # request, groupID=" << _groupID;
+        ASYNC_LOG(TRACE) << "sendRawTransaction # request = " << std::endl
+                         << "{ " << std::endl
+                         << "\"_groupID\" : " << _groupID << "," << std::endl
+                         << "\"_rlp\" : " << _rlp << std::endl
+                         << "}";
 
         auto txPool = ledgerManager()->txPool(_groupID);
         if (!txPool)
             BOOST_THROW_EXCEPTION(
                 JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
 
-        Transaction tx(jsToBytes(_rlp, OnFailed::Throw), CheckTransaction::Everything);
-        std::pair<h256, Address> ret = txPool->submit(tx);
+        /// the sender is recovered and the transaction imported after the response
+        bytes txBytes = jsToBytes(_rlp, OnFailed::Throw);
+        return toJS(txPool->submitAsync(dev::ref(txBytes)));
+    }
+    catch (JsonRpcException& e)
+    {
+        throw e;
+    }
+    catch (...)
+    {
+        BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INTERNAL_ERROR));
+    }
+}
 
-        return toJS(ret.first);
+Json::Value Rpc::sendRawTransactions(int _groupID, const Json::Value& _rlps)
+{
+    try
+    {
+        ASYNC_LOG_RATED(INFO) << "sendRawTransactions # request, groupID=" << _groupID
+                              << ", transactions=" << _rlps.size();
+
+        auto txPool = ledgerManager()->txPool(_groupID);
+        if (!txPool)
+            BOOST_THROW_EXCEPTION(
+                JsonRpcException(RPCExceptionType::GroupID, RPCMsg[RPCExceptionType::GroupID]));
+        if (!_rlps.isArray() || _rlps.size() > c_maxRawTransactions)
+            BOOST_THROW_EXCEPTION(JsonRpcException(Errors::ERROR_RPC_INVALID_PARAMS));
+
+        Json::Value response(Json::arrayValue);
+        for (auto const& rlp : _rlps)
+        {
+            try
+            {
+                bytes txBytes = jsToBytes(rlp.asString(), OnFailed::Throw);
+                response.append(toJS(txPool->submitAsync(dev::ref(txBytes))));
+            }
+            catch (std::exception const& e)
+            {
+                ASYNC_LOG(DEBUG) << "sendRawTransactions refused a transaction: " << e.what();
+                response.append(Json::Value());
+            }
+        }
+        return response;
     }
     catch (JsonRpcException& e)
     {
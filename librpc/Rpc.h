@@ -58,17 +58,43 @@ public:
     // sync part
     virtual Json::Value syncStatus(int _groupID) override;
 
+    // storage part
+    virtual Json::Value storageStatus(int _groupID) override;
+
     // p2p part
     virtual std::string version() override;
     virtual Json::Value peers() override;
     virtual Json::Value groupPeers(int _groupID) override;
     virtual Json::Value groupList() override;
+    virtual Json::Value queueStatus() override;
+    virtual Json::Value compressStatus() override;
 
     // block part
     virtual Json::Value getBlockByHash(
         int _groupID, const std::string& _blockHash, bool _includeTransactions) override;
     virtual Json::Value getBlockByNumber(
         int _groupID, const std::string& _blockNumber, bool _includeTransactions) override;
+    virtual void getBlockByHash(JsonWriter& _writer, int _groupID, const std::string& _blockHash,
+        bool _includeTransactions) override;
+    virtual void getBlockByNumber(JsonWriter& _writer, int _groupID,
+        const std::string& _blockNumber, bool _includeTransactions) override;
+    /// bulk fetching without decoding: the stored block, or the receipts list in it, as hex RLP
+    virtual std::string getBlockRLPByNumber(int _groupID, const std::string& _blockNumber) override;
+    virtual void getBlockRLPByNumber(
+        JsonWriter& _writer, int _groupID, const std::string& _blockNumber) override;
+    virtual std::string getReceiptsRLPByNumber(
+        int _groupID, const std::string& _blockNumber) override;
+    virtual void getReceiptsRLPByNumber(
+        JsonWriter& _writer, int _groupID, const std::string& _blockNumber) override;
+    /// up to c_maxBlocksRange consecutive blocks from _from, fewer at the head of the chain
+    virtual Json::Value getBlocksByRange(int _groupID, const std::string& _from,
+        const std::string& _count, bool _includeTransactions) override;
+    virtual void getBlocksByRange(JsonWriter& _writer, int _groupID, const std::string& _from,
+        const std::string& _count, bool _includeTransactions) override;
+    /// the receipts of all transactions in a block, in the format of getTransactionReceipt
+    virtual Json::Value getBlockReceipts(int _groupID, const std::string& _blockNumber) override;
+    virtual void getBlockReceipts(
+        JsonWriter& _writer, int _groupID, const std::string& _blockNumber) override;
 
     // transaction part
     /// @return the information about a transaction requested by transaction hash.
@@ -86,13 +112,28 @@ public:
         int _groupID, const std::string& _transactionHash) override;
     /// @return information about pendingTransactions.
     virtual Json::Value pendingTransactions(int _groupID) override;
+    virtual void pendingTransactions(JsonWriter& _writer, int _groupID) override;
     /// Executes a new message call immediately without creating a transaction on the blockchain.
     virtual std::string call(int _groupID, const Json::Value& request) override;
     // Creates new message call transaction or a contract creation for signed transactions.
     virtual std::string sendRawTransaction(int _groupID, const std::string& _rlp) override;
+    /// up to c_maxRawTransactions at once, a refused transaction leaves null at its index
+    virtual Json::Value sendRawTransactions(int _groupID, const Json::Value& _rlps) override;
 
 
 protected:
+    /// the blockchain of the group, throws the RPC error of a missing group
+    std::shared_ptr<dev::blockchain::BlockChainInterface> blockChain(int _groupID);
+    /// the requested block, throws the RPC error of a missing group or block
+    std::shared_ptr<dev::eth::Block> blockByHash(int _groupID, h256 const& _blockHash);
+    std::shared_ptr<dev::eth::Block> blockByNumber(
+        int _groupID, dev::eth::BlockNumber _blockNumber);
+    /// hand the blocks of getBlocksByRange to _onBlock one at a time, throws the RPC error of a
+    /// missing group or an invalid range
+    void forEachBlockInRange(int _groupID, const std::string& _from, const std::string& _count,
+        std::function<void(dev::eth::Block const&)> const& _onBlock);
+    std::shared_ptr<bytes> blockRLPByNumber(int _groupID, dev::eth::BlockNumber _blockNumber);
+
     std::shared_ptr<dev::ledger::LedgerManager> ledgerManager() { return m_ledgerManager; }
     std::shared_ptr<dev::ledger::LedgerManager> m_ledgerManager;
     std::shared_ptr<dev::p2p::P2PInterface> service() { return m_service; }
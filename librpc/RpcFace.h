@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include "JsonWriter.h"
 #include "ModularServer.h"
 
 namespace dev
@@ -44,6 +45,9 @@ public:
         this->bindAndAddMethod(jsonrpc::Procedure("syncStatus", jsonrpc::PARAMS_BY_POSITION,
                                    jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, NULL),
             &dev::rpc::RpcFace::syncStatusI);
+        this->bindAndAddMethod(jsonrpc::Procedure("storageStatus", jsonrpc::PARAMS_BY_POSITION,
+                                   jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, NULL),
+            &dev::rpc::RpcFace::storageStatusI);
 
         this->bindAndAddMethod(
             jsonrpc::Procedure("version", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_STRING, NULL),
@@ -57,6 +61,12 @@ public:
         this->bindAndAddMethod(jsonrpc::Procedure("groupList", jsonrpc::PARAMS_BY_POSITION,
                                    jsonrpc::JSON_OBJECT, NULL),
             &dev::rpc::RpcFace::groupListI);
+        this->bindAndAddMethod(jsonrpc::Procedure("queueStatus", jsonrpc::PARAMS_BY_POSITION,
+                                   jsonrpc::JSON_OBJECT, NULL),
+            &dev::rpc::RpcFace::queueStatusI);
+        this->bindAndAddMethod(jsonrpc::Procedure("compressStatus", jsonrpc::PARAMS_BY_POSITION,
+                                   jsonrpc::JSON_OBJECT, NULL),
+            &dev::rpc::RpcFace::compressStatusI);
 
         this->bindAndAddMethod(jsonrpc::Procedure("getBlockByHash", jsonrpc::PARAMS_BY_POSITION,
                                    jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, "param2",
@@ -66,6 +76,23 @@ public:
                                    jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, "param2",
                                    jsonrpc::JSON_STRING, "param3", jsonrpc::JSON_BOOLEAN, NULL),
             &dev::rpc::RpcFace::getBlockByNumberI);
+        this->bindAndAddMethod(jsonrpc::Procedure("getBlocksByRange", jsonrpc::PARAMS_BY_POSITION,
+                                   jsonrpc::JSON_ARRAY, "param1", jsonrpc::JSON_INTEGER, "param2",
+                                   jsonrpc::JSON_STRING, "param3", jsonrpc::JSON_STRING, "param4",
+                                   jsonrpc::JSON_BOOLEAN, NULL),
+            &dev::rpc::RpcFace::getBlocksByRangeI);
+        this->bindAndAddMethod(jsonrpc::Procedure("getBlockReceipts", jsonrpc::PARAMS_BY_POSITION,
+                                   jsonrpc::JSON_ARRAY, "param1", jsonrpc::JSON_INTEGER, "param2",
+                                   jsonrpc::JSON_STRING, NULL),
+            &dev::rpc::RpcFace::getBlockReceiptsI);
+        this->bindAndAddMethod(jsonrpc::Procedure("getBlockRLPByNumber",
+                                   jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_STRING, "param1",
+                                   jsonrpc::JSON_INTEGER, "param2", jsonrpc::JSON_STRING, NULL),
+            &dev::rpc::RpcFace::getBlockRLPByNumberI);
+        this->bindAndAddMethod(jsonrpc::Procedure("getReceiptsRLPByNumber",
+                                   jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_STRING, "param1",
+                                   jsonrpc::JSON_INTEGER, "param2", jsonrpc::JSON_STRING, NULL),
+            &dev::rpc::RpcFace::getReceiptsRLPByNumberI);
 
         this->bindAndAddMethod(jsonrpc::Procedure("getTransactionByHash",
                                    jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",
@@ -98,6 +125,30 @@ public:
                                    jsonrpc::JSON_OBJECT, "param1", jsonrpc::JSON_INTEGER, "param2",
                                    jsonrpc::JSON_STRING, NULL),
             &dev::rpc::RpcFace::sendRawTransactionI);
+        this->bindAndAddMethod(
+            jsonrpc::Procedure("sendRawTransactions", jsonrpc::PARAMS_BY_POSITION,
+                jsonrpc::JSON_ARRAY, "param1", jsonrpc::JSON_INTEGER, "param2", jsonrpc::JSON_ARRAY,
+                NULL),
+            &dev::rpc::RpcFace::sendRawTransactionsI);
+
+        /// bulk queries are written straight into the response
+        this->bindStreamMethod("getBlockByHash",
+            {Json::intValue, Json::stringValue, Json::booleanValue},
+            &dev::rpc::RpcFace::getBlockByHashS);
+        this->bindStreamMethod("getBlockByNumber",
+            {Json::intValue, Json::stringValue, Json::booleanValue},
+            &dev::rpc::RpcFace::getBlockByNumberS);
+        this->bindStreamMethod("getBlocksByRange",
+            {Json::intValue, Json::stringValue, Json::stringValue, Json::booleanValue},
+            &dev::rpc::RpcFace::getBlocksByRangeS);
+        this->bindStreamMethod("getBlockReceipts", {Json::intValue, Json::stringValue},
+            &dev::rpc::RpcFace::getBlockReceiptsS);
+        this->bindStreamMethod("getBlockRLPByNumber", {Json::intValue, Json::stringValue},
+            &dev::rpc::RpcFace::getBlockRLPByNumberS);
+        this->bindStreamMethod("getReceiptsRLPByNumber", {Json::intValue, Json::stringValue},
+            &dev::rpc::RpcFace::getReceiptsRLPByNumberS);
+        this->bindStreamMethod("pendingTransactions", {Json::intValue},
+            &dev::rpc::RpcFace::pendingTransactionsS);
     }
 
     inline virtual void blockNumberI(const Json::Value& request, Json::Value& response)
@@ -117,6 +168,10 @@ public:
     {
         response = this->syncStatus(request[0u].asInt());
     }
+    inline virtual void storageStatusI(const Json::Value& request, Json::Value& response)
+    {
+        response = this->storageStatus(request[0u].asInt());
+    }
 
     inline virtual void versionI(const Json::Value& request, Json::Value& response)
     {
@@ -134,6 +189,14 @@ public:
     {
         response = this->groupList();
     }
+    inline virtual void queueStatusI(const Json::Value& request, Json::Value& response)
+    {
+        response = this->queueStatus();
+    }
+    inline virtual void compressStatusI(const Json::Value& request, Json::Value& response)
+    {
+        response = this->compressStatus();
+    }
 
     inline virtual void getBlockByHashI(const Json::Value& request, Json::Value& response)
     {
@@ -145,6 +208,23 @@ public:
         response = this->getBlockByNumber(
             request[0u].asInt(), request[1u].asString(), request[2u].asBool());
     }
+    inline virtual void getBlocksByRangeI(const Json::Value& request, Json::Value& response)
+    {
+        response = this->getBlocksByRange(request[0u].asInt(), request[1u].asString(),
+            request[2u].asString(), request[3u].asBool());
+    }
+    inline virtual void getBlockReceiptsI(const Json::Value& request, Json::Value& response)
+    {
+        response = this->getBlockReceipts(request[0u].asInt(), request[1u].asString());
+    }
+    inline virtual void getBlockRLPByNumberI(const Json::Value& request, Json::Value& response)
+    {
+        response = this->getBlockRLPByNumber(request[0u].asInt(), request[1u].asString());
+    }
+    inline virtual void getReceiptsRLPByNumberI(const Json::Value& request, Json::Value& response)
+    {
+        response = this->getReceiptsRLPByNumber(request[0u].asInt(), request[1u].asString());
+    }
 
     inline virtual void getTransactionByHashI(const Json::Value& request, Json::Value& response)
     {
@@ -179,6 +259,49 @@ public:
     {
         response = this->sendRawTransaction(request[0u].asInt(), request[1u].asString());
     }
+    inline virtual void sendRawTransactionsI(const Json::Value& request, Json::Value& response)
+    {
+        response = this->sendRawTransactions(request[0u].asInt(), request[1u]);
+    }
+
+    inline virtual void getBlockByHashS(const Json::Value& request, std::string& response)
+    {
+        JsonWriter writer(response);
+        this->getBlockByHash(
+            writer, request[0u].asInt(), request[1u].asString(), request[2u].asBool());
+    }
+    inline virtual void getBlockByNumberS(const Json::Value& request, std::string& response)
+    {
+        JsonWriter writer(response);
+        this->getBlockByNumber(
+            writer, request[0u].asInt(), request[1u].asString(), request[2u].asBool());
+    }
+    inline virtual void getBlocksByRangeS(const Json::Value& request, std::string& response)
+    {
+        JsonWriter writer(response);
+        this->getBlocksByRange(writer, request[0u].asInt(), request[1u].asString(),
+            request[2u].asString(), request[3u].asBool());
+    }
+    inline virtual void getBlockReceiptsS(const Json::Value& request, std::string& response)
+    {
+        JsonWriter writer(response);
+        this->getBlockReceipts(writer, request[0u].asInt(), request[1u].asString());
+    }
+    inline virtual void getBlockRLPByNumberS(const Json::Value& request, std::string& response)
+    {
+        JsonWriter writer(response);
+        this->getBlockRLPByNumber(writer, request[0u].asInt(), request[1u].asString());
+    }
+    inline virtual void getReceiptsRLPByNumberS(const Json::Value& request, std::string& response)
+    {
+        JsonWriter writer(response);
+        this->getReceiptsRLPByNumber(writer, request[0u].asInt(), request[1u].asString());
+    }
+    inline virtual void pendingTransactionsS(const Json::Value& request, std::string& response)
+    {
+        JsonWriter writer(response);
+        this->pendingTransactions(writer, request[0u].asInt());
+    }
 
     // consensus part
     virtual std::string blockNumber(int param1) = 0;
@@ -188,15 +311,61 @@ public:
     // sync part
     virtual Json::Value syncStatus(int param1) = 0;
 
+    // storage part
+    virtual Json::Value storageStatus(int param1) = 0;
+
     // p2p part
     virtual std::string version() = 0;
     virtual Json::Value peers() = 0;
     virtual Json::Value groupPeers(int param1) = 0;
     virtual Json::Value groupList() = 0;
+    /// depth and wait times of the handler queue of each protocol
+    virtual Json::Value queueStatus() = 0;
+    /// packets and bytes compressed and decompressed by this node, and the time it took
+    virtual Json::Value compressStatus() = 0;
 
     // block part
     virtual Json::Value getBlockByHash(int param1, const std::string& param2, bool param3) = 0;
     virtual Json::Value getBlockByNumber(int param1, const std::string& param2, bool param3) = 0;
+    /// at most c_maxBlocksRange blocks from number param2 on, up to the highest block
+    virtual Json::Value getBlocksByRange(
+        int param1, const std::string& param2, const std::string& param3, bool param4) = 0;
+    /// the receipts of all the transactions in block param2, from one decode of the block
+    virtual Json::Value getBlockReceipts(int param1, const std::string& param2) = 0;
+    /// the block as stored (RLP, hex), without decoding it
+    virtual std::string getBlockRLPByNumber(int param1, const std::string& param2) = 0;
+    /// the RLP list of the receipts of a block, taken from the stored block without decoding it
+    virtual std::string getReceiptsRLPByNumber(int param1, const std::string& param2) = 0;
+
+    /// streaming variants, the defaults write the Json::Value results
+    virtual void getBlockByHash(
+        JsonWriter& _writer, int param1, const std::string& param2, bool param3)
+    {
+        _writer.value(getBlockByHash(param1, param2, param3));
+    }
+    virtual void getBlockByNumber(
+        JsonWriter& _writer, int param1, const std::string& param2, bool param3)
+    {
+        _writer.value(getBlockByNumber(param1, param2, param3));
+    }
+    virtual void getBlocksByRange(JsonWriter& _writer, int param1, const std::string& param2,
+        const std::string& param3, bool param4)
+    {
+        _writer.value(getBlocksByRange(param1, param2, param3, param4));
+    }
+    virtual void getBlockReceipts(JsonWriter& _writer, int param1, const std::string& param2)
+    {
+        _writer.value(getBlockReceipts(param1, param2));
+    }
+    virtual void getBlockRLPByNumber(JsonWriter& _writer, int param1, const std::string& param2)
+    {
+        _writer.value(getBlockRLPByNumber(param1, param2));
+    }
+    virtual void getReceiptsRLPByNumber(
+        JsonWriter& _writer, int param1, const std::string& param2)
+    {
+        _writer.value(getReceiptsRLPByNumber(param1, param2));
+    }
 
     // transaction part
     /// @return the information about a transaction requested by transaction hash.
@@ -212,10 +381,16 @@ public:
     virtual Json::Value getTransactionReceipt(int param1, const std::string& param2) = 0;
     /// @return information about pendingTransactions.
     virtual Json::Value pendingTransactions(int param1) = 0;
+    virtual void pendingTransactions(JsonWriter& _writer, int param1)
+    {
+        _writer.value(pendingTransactions(param1));
+    }
     /// Executes a new message call immediately without creating a transaction on the blockchain.
     virtual std::string call(int param1, const Json::Value& param2) = 0;
     // Creates new message call transaction or a contract creation for signed transactions.
     virtual std::string sendRawTransaction(int param1, const std::string& param2) = 0;
+    /// sendRawTransaction of each element of param2, null for the transactions refused
+    virtual Json::Value sendRawTransactions(int param1, const Json::Value& param2) = 0;
 };
 
 }  // namespace rpc
@@ -19,6 +19,7 @@
  *  @date 20180921
  */
 #pragma once
+#include <limits>
 #include <string>
 
 namespace dev
@@ -35,5 +36,8 @@ const std::string SYS_VALUE = "value";
 const std::string SYS_TX_HASH_2_BLOCK = "_sys_tx_hash_2_block_";
 const std::string SYS_NUMBER_2_HASH = "_sys_number_2_hash_";
 const std::string SYS_HASH_2_BLOCK = "_sys_hash_2_block_";
+const std::string SYS_BLOCK_2_NONCES = "_sys_block_2_nonces_";
+/// \brief Block number that selects the newest committed version of every entry
+const int LATEST_BLOCK_NUM = std::numeric_limits<int>::max();
 }  // namespace storage
 }  // namespace dev
\ No newline at end of file
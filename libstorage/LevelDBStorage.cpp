@@ -19,8 +19,6 @@
  *  @date 20180921
  */
 #include "LevelDBStorage.h"
-
-#include "LevelDBStorage.h"
 #include "Table.h"
 #include <leveldb/db.h>
 #include <leveldb/write_batch.h>
@@ -29,15 +27,58 @@
 using namespace dev;
 using namespace dev::storage;
 
+namespace
+{
+/// records the lowest readable block once versions below it start being pruned
+const std::string c_oldestReadableKey = "_leveldb_storage_oldest_readable_";
+}  // namespace
+
+std::string LevelDBStorage::versionKey(std::string const& _entryKey, int64_t _num) const
+{
+    /// inverted so that a forward seek finds the newest version first
+    uint64_t version = ~(uint64_t)_num;
+    std::string key = _entryKey;
+    key.push_back('\0');
+    for (int shift = 56; shift >= 0; shift -= 8)
+        key.push_back((char)((version >> shift) & 0xff));
+    return key;
+}
+
 Entries::Ptr LevelDBStorage::select(
     h256 hash, int num, const std::string& table, const std::string& key)
 {
     try
     {
+        if (num < m_oldestReadable)
+        {
+            BOOST_THROW_EXCEPTION(StorageException(-1, "Query leveldb exception: block " +
+                                                           std::to_string(num) + " is pruned"));
+        }
+
         std::string entryKey = table + "_" + key;
+        std::string seekKey = versionKey(entryKey, num);
+        leveldb::Slice prefix(seekKey.data(), entryKey.size() + 1);
         std::string value;
-        ReadGuard l(m_remoteDBMutex);
-        auto s = m_db->Get(leveldb::ReadOptions(), leveldb::Slice(entryKey), &value);
+        bool found = false;
+
+        std::unique_ptr<leveldb::Iterator> it(m_db->NewIterator(leveldb::ReadOptions()));
+        for (it->Seek(seekKey); it->Valid() && it->key().starts_with(prefix); it->Next())
+        {
+            /// skip other entries whose key extends this one
+            if (it->key().size() == seekKey.size())
+            {
+                value = it->value().ToString();
+                found = true;
+                break;
+            }
+        }
+        auto s = it->status();
+        if (!found && s.ok())
+        {
+            /// written before versioning
+            s = m_db->Get(leveldb::ReadOptions(), leveldb::Slice(entryKey), &value);
+            found = s.ok();
+        }
         if (!s.ok() && !s.IsNotFound())
         {
             LOG(ERROR) << "Query leveldb failed:" + s.ToString();
@@ -46,7 +87,7 @@ Entries::Ptr LevelDBStorage::select(
         }
 
         Entries::Ptr entries = std::make_shared<Entries>();
-        if (!s.IsNotFound())
+        if (found)
         {
             // parse json
             std::stringstream ssIn;
@@ -85,12 +126,81 @@ Entries::Ptr LevelDBStorage::select(
     return Entries::Ptr();
 }
 
+LevelDBStorage::~LevelDBStorage()
+{
+    /// a running pass stops at its next key
+    m_stopping = true;
+    m_pruneThread.reset();
+}
+
+/// the versions of an entry are adjacent and newest first: past the watermark, the first version
+/// of an entry is the one reads at the watermark see and every later one is unreachable
+size_t LevelDBStorage::prune()
+{
+    int64_t floor = m_oldestReadable;
+    leveldb::ReadOptions readOptions;
+    readOptions.fill_cache = false;
+    std::unique_ptr<leveldb::Iterator> it(m_db->NewIterator(readOptions));
+
+    /// a version key is the entry key, a \0 and 8 bytes of inverted block number
+    size_t const suffixSize = 9;
+    std::string entryKey;
+    bool visibleSeen = false;
+    size_t deleted = 0;
+    leveldb::WriteBatch batch;
+    leveldb::WriteOptions writeOptions;
+    for (it->SeekToFirst(); it->Valid() && !m_stopping; it->Next())
+    {
+        leveldb::Slice key = it->key();
+        if (key.size() < suffixSize || key[key.size() - suffixSize] != '\0')
+            continue;
+        leveldb::Slice prefix(key.data(), key.size() - suffixSize);
+        if (prefix != leveldb::Slice(entryKey))
+        {
+            entryKey = prefix.ToString();
+            visibleSeen = false;
+        }
+        uint64_t version = 0;
+        for (size_t i = key.size() - 8; i < key.size(); ++i)
+            version = (version << 8) | (uint8_t)key[i];
+        if ((int64_t)~version > floor)
+            continue;
+        if (!visibleSeen)
+        {
+            visibleSeen = true;
+            continue;
+        }
+        batch.Delete(key);
+        if (++deleted % c_pruneBatchSize == 0)
+        {
+            auto s = m_db->Write(writeOptions, &batch);
+            if (!s.ok())
+            {
+                BOOST_THROW_EXCEPTION(
+                    StorageException(-1, "Prune leveldb exception:" + s.ToString()));
+            }
+            batch.Clear();
+        }
+    }
+    auto s = it->status();
+    if (s.ok())
+        s = m_db->Write(writeOptions, &batch);
+    if (!s.ok())
+    {
+        BOOST_THROW_EXCEPTION(StorageException(-1, "Prune leveldb exception:" + s.ToString()));
+    }
+    if (!m_stopping)
+        m_prunedBlock = floor;
+    return deleted;
+}
+
 size_t LevelDBStorage::commit(
     h256 hash, int64_t num, const std::vector<TableData::Ptr>& datas, h256 blockHash)
 {
     try
     {
         leveldb::WriteBatch batch;
+        int64_t floor = m_historyBlocks > 0 ? num - m_historyBlocks : 0;
 
         size_t total = 0;
         for (auto it : datas)
@@ -116,15 +226,18 @@ size_t LevelDBStorage::commit(
                 std::stringstream ssOut;
                 ssOut << entry;
 
-                batch.Put(leveldb::Slice(entryKey), leveldb::Slice(ssOut.str()));
+                batch.Put(leveldb::Slice(versionKey(entryKey, num)), leveldb::Slice(ssOut.str()));
                 ++total;
                 /// LOG(TRACE) << "leveldb commit key:" << entryKey;
             }
         }
+        if (floor > m_oldestReadable)
+        {
+            batch.Put(leveldb::Slice(c_oldestReadableKey), leveldb::Slice(std::to_string(floor)));
+        }
 
         leveldb::WriteOptions writeOptions;
         writeOptions.sync = false;
-        WriteGuard l(m_remoteDBMutex);
         auto s = m_db->Write(writeOptions, &batch);
         if (!s.ok())
         {
@@ -132,6 +245,28 @@ size_t LevelDBStorage::commit(
 
             BOOST_THROW_EXCEPTION(StorageException(-1, "Commit leveldb exception:" + s.ToString()));
         }
+        if (floor > m_oldestReadable)
+        {
+            m_oldestReadable = floor;
+        }
+        if (floor - m_prunedBlock >= c_pruneInterval && !m_pruning.exchange(true))
+        {
+            if (!m_pruneThread)
+                m_pruneThread.reset(new ThreadPool("LevelDBPrune", 1));
+            m_pruneThread->enqueue([this]() {
+                try
+                {
+                    size_t deleted = prune();
+                    LOG(INFO) << "Prune leveldb [oldestReadable/deleted]: " << m_prunedBlock
+                              << "/" << deleted;
+                }
+                catch (std::exception& e)
+                {
+                    LOG(ERROR) << "Prune leveldb exception:" << boost::diagnostic_information(e);
+                }
+                m_pruning = false;
+            });
+        }
 
         return total;
     }
@@ -153,4 +288,79 @@ bool LevelDBStorage::onlyDirty()
 void LevelDBStorage::setDB(std::shared_ptr<leveldb::DB> db)
 {
     m_db = db;
+
+    std::string value;
+    auto s = m_db->Get(leveldb::ReadOptions(), leveldb::Slice(c_oldestReadableKey), &value);
+    m_oldestReadable = s.ok() ? std::stoll(value) : 0;
+    /// versions left below the mark by a pass the last run did not finish go with the next one
+    m_prunedBlock = 0;
+}
+
+leveldb::Status LevelDBStorage::open(std::string const& _path, LevelDBConfig const& _config)
+{
+    leveldb::Options options;
+    options.create_if_missing = true;
+    options.max_open_files = _config.maxOpenFiles;
+    options.write_buffer_size = _config.writeBufferSize << 20;
+    options.block_size = _config.blockSize << 10;
+    options.compression =
+        _config.compression ? leveldb::kSnappyCompression : leveldb::kNoCompression;
+    std::unique_ptr<leveldb::Cache> cache;
+    if (_config.cacheSize > 0)
+    {
+        cache.reset(leveldb::NewLRUCache(_config.cacheSize << 20));
+        options.block_cache = cache.get();
+    }
+    /// versions are found by a seek, the filters help the Get of the keys written unversioned
+    /// and of the records read by key
+    std::unique_ptr<const leveldb::FilterPolicy> filterPolicy;
+    if (_config.bloomFilterBits > 0)
+    {
+        filterPolicy.reset(leveldb::NewBloomFilterPolicy(_config.bloomFilterBits));
+        options.filter_policy = filterPolicy.get();
+    }
+
+    leveldb::DB* db = nullptr;
+    leveldb::Status status = leveldb::DB::Open(options, _path, &db);
+    if (!status.ok())
+        return status;
+    m_db.reset();
+    m_cache = std::move(cache);
+    m_filterPolicy = std::move(filterPolicy);
+    setDB(std::shared_ptr<leveldb::DB>(db));
+    LOG(INFO) << "Open leveldb " << _path << " [cacheSize/bloomFilterBits/writeBufferSize/"
+              << "blockSize/maxOpenFiles/compression]: " << _config.cacheSize << "MB/"
+              << _config.bloomFilterBits << "/" << _config.writeBufferSize << "MB/"
+              << _config.blockSize << "KB/" << _config.maxOpenFiles << "/"
+              << _config.compression;
+    return status;
+}
+
+Json::Value LevelDBStorage::status() const
+{
+    Json::Value status(Json::objectValue);
+    if (!m_db)
+        return status;
+    std::string value;
+    for (std::string property : {"leveldb.stats", "leveldb.approximate-memory-usage"})
+    {
+        if (m_db->GetProperty(property, &value))
+            status[property] = value;
+    }
+    Json::Value files(Json::arrayValue);
+    for (int level = 0; level < c_levels; ++level)
+    {
+        if (!m_db->GetProperty("leveldb.num-files-at-level" + std::to_string(level), &value))
+            break;
+        files.append(std::atoi(value.c_str()));
+    }
+    status["leveldb.num-files-at-level"] = files;
+
+    leveldb::Range all("", "\xff");
+    uint64_t size = 0;
+    m_db->GetApproximateSizes(&all, 1, &size);
+    status["approximateSize"] = (Json::UInt64)size;
+    if (m_cache)
+        status["blockCacheUsage"] = (Json::UInt64)m_cache->TotalCharge();
+    return status;
 }
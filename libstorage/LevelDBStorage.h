@@ -24,19 +24,50 @@
 #include "StorageException.h"
 #include "Table.h"
 #include <json/json.h>
+#include <leveldb/cache.h>
 #include <leveldb/db.h>
+#include <leveldb/filter_policy.h>
+#include <leveldb/write_batch.h>
 #include <libdevcore/FixedHash.h>
-#include <libdevcore/Guards.h>
+#include <libdevcore/ThreadPool.h>
+#include <atomic>
+#include <memory>
 namespace dev
 {
 namespace storage
 {
+/// engine settings of the leveldb under a LevelDBStorage
+struct LevelDBConfig
+{
+    /// MB of uncompressed table blocks cached for reads, 0 leaves the 8MB leveldb default
+    size_t cacheSize = 128;
+    /// bits per key of the bloom filters that let a Get skip the table files without its key,
+    /// 0 for no filter
+    int bloomFilterBits = 10;
+    /// MB of writes kept in memory before they are sorted into a table file
+    size_t writeBufferSize = 32;
+    /// KB of keys and values per table block, the unit read from disk and cached
+    size_t blockSize = 4;
+    int maxOpenFiles = 1000;
+    /// snappy compression of the table blocks
+    bool compression = true;
+};
+
+/**
+ * Multi-version storage on leveldb.
+ * Every committed value is stored under table_key\0<~num as 8 big-endian bytes>, so the versions
+ * of an entry are adjacent and sorted from the newest to the oldest block. select(num) seeks to
+ * the first version committed at or before num; leveldb writes a block atomically, so readers
+ * need no lock and never observe a block that is being committed.
+ * With a bounded history, commits only move the watermark below which reads fail; the versions
+ * under it are deleted by a pass over the whole leveldb on a background thread.
+ */
 class LevelDBStorage : public Storage
 {
 public:
     typedef std::shared_ptr<LevelDBStorage> Ptr;
 
-    virtual ~LevelDBStorage(){};
+    virtual ~LevelDBStorage();
 
     virtual Entries::Ptr select(
         h256 hash, int num, const std::string& table, const std::string& key) override;
@@ -45,10 +76,43 @@ public:
     virtual bool onlyDirty() override;
 
     void setDB(std::shared_ptr<leveldb::DB> db);
+    /// open the leveldb in _path, created if missing, with _config
+    leveldb::Status open(std::string const& _path, LevelDBConfig const& _config = LevelDBConfig());
+    /// leveldb.stats, the table files per level, the approximate size on disk and the memory of
+    /// the memtables and the block cache
+    Json::Value status() const;
+
+    /// keep enough versions to read the latest _historyBlocks blocks, 0 keeps every version
+    void setHistoryBlocks(int64_t _historyBlocks) { m_historyBlocks = _historyBlocks; }
+    int64_t historyBlocks() const { return m_historyBlocks; }
+    /// the lowest block number select() can still serve
+    int64_t oldestReadableBlock() const { return m_oldestReadable; }
+    /// delete every version no read at or above oldestReadableBlock() can reach,
+    /// @returns the number of versions deleted
+    size_t prune();
+
+    /// blocks the watermark moves between two background prune passes
+    static const int64_t c_pruneInterval = 1000;
 
 private:
+    std::string versionKey(std::string const& _entryKey, int64_t _num) const;
+    /// levels of the leveldb LSM tree, leveldb::config::kNumLevels
+    static const int c_levels = 7;
+    /// deletes written by prune() per leveldb write
+    static const size_t c_pruneBatchSize = 1024;
+
+    /// owned by the storage as leveldb does not free them, and destroyed after m_db
+    std::unique_ptr<leveldb::Cache> m_cache;
+    std::unique_ptr<const leveldb::FilterPolicy> m_filterPolicy;
     std::shared_ptr<leveldb::DB> m_db;
-    dev::SharedMutex m_remoteDBMutex;
+    int64_t m_historyBlocks = 0;
+    std::atomic<int64_t> m_oldestReadable{0};
+    /// the watermark of the last prune pass
+    std::atomic<int64_t> m_prunedBlock{0};
+    std::atomic<bool> m_pruning{false};
+    std::atomic<bool> m_stopping{false};
+    /// runs the prune passes, destroyed before m_db
+    std::unique_ptr<ThreadPool> m_pruneThread;
 };
 
 }  // namespace storage
@@ -83,7 +83,7 @@ size_t dev::storage::MemoryTable::update(
 {
     try
     {
-        LOG(DEBUG) << "Update MemoryTable: " << key;
+        ASYNC_LOG(DEBUG) << "Update MemoryTable: " << key;
 
         Entries::Ptr entries = std::make_shared<Entries>();
 
@@ -141,7 +141,7 @@ size_t dev::storage::MemoryTable::insert(const std::string& key, Entry::Ptr entr
 {
     try
     {
-        LOG(DEBUG) << "Insert MemoryTable: " << key;
+        ASYNC_LOG(DEBUG) << "Insert MemoryTable: " << key;
 
         Entries::Ptr entries = std::make_shared<Entries>();
         Condition::Ptr condition = std::make_shared<Condition>();
@@ -188,7 +188,7 @@ size_t dev::storage::MemoryTable::insert(const std::string& key, Entry::Ptr entr
 
 size_t dev::storage::MemoryTable::remove(const std::string& key, Condition::Ptr condition)
 {
-    LOG(DEBUG) << "Remove MemoryTable data" << key;
+    ASYNC_LOG(DEBUG) << "Remove MemoryTable data" << key;
 
     Entries::Ptr entries = std::make_shared<Entries>();
 
@@ -199,7 +199,7 @@ size_t dev::storage::MemoryTable::remove(const std::string& key, Condition::Ptr
         {
             entries = m_remoteDB->select(m_blockHash, m_blockNum, m_tableInfo->name, key);
 
-            LOG(DEBUG) << "AMOPDB selects:" << entries->size() << " record(s)";
+            ASYNC_LOG(DEBUG) << "AMOPDB selects:" << entries->size() << " record(s)";
 
             m_cache.insert(std::make_pair(key, entries));
         }
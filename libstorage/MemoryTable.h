@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include "Common.h"
 #include "Storage.h"
 #include "Table.h"
 
@@ -59,7 +60,7 @@ private:
     TableInfo::Ptr m_tableInfo;
     std::map<std::string, Entries::Ptr> m_cache;
     h256 m_blockHash;
-    int m_blockNum = 0;
+    int m_blockNum = LATEST_BLOCK_NUM;
 };
 
 }  // namespace storage
@@ -31,7 +31,7 @@ using namespace dev;
 using namespace dev::storage;
 using namespace std;
 
-MemoryTableFactory::MemoryTableFactory() : m_blockHash(h256(0)), m_blockNum(0)
+MemoryTableFactory::MemoryTableFactory() : m_blockHash(h256(0)), m_blockNum(LATEST_BLOCK_NUM)
 {
     m_sysTables.push_back(SYS_MINERS);
     m_sysTables.push_back(SYS_TABLES);
@@ -39,6 +39,7 @@ MemoryTableFactory::MemoryTableFactory() : m_blockHash(h256(0)), m_blockNum(0)
     m_sysTables.push_back(SYS_NUMBER_2_HASH);
     m_sysTables.push_back(SYS_TX_HASH_2_BLOCK);
     m_sysTables.push_back(SYS_HASH_2_BLOCK);
+    m_sysTables.push_back(SYS_BLOCK_2_NONCES);
 }
 
 Table::Ptr MemoryTableFactory::openTable(const string& tableName)
@@ -245,6 +246,13 @@ void MemoryTableFactory::commitDB(h256 const& _blockHash, int64_t _blockNumber)
     m_changeLog.clear();
 }
 
+void MemoryTableFactory::clear()
+{
+    m_name2Table.clear();
+    m_changeLog.clear();
+    m_hash = h256();
+}
+
 storage::TableInfo::Ptr MemoryTableFactory::getSysTableInfo(const std::string& tableName)
 {
     auto tableInfo = make_shared<storage::TableInfo>();
@@ -279,6 +287,11 @@ storage::TableInfo::Ptr MemoryTableFactory::getSysTableInfo(const std::string& t
         tableInfo->key = "key";
         tableInfo->fields = std::vector<std::string>{"value"};
     }
+    else if (tableName == SYS_BLOCK_2_NONCES)
+    {
+        tableInfo->key = "number";
+        tableInfo->fields = std::vector<std::string>{"value"};
+    }
     tableInfo->fields.emplace_back(tableInfo->key);
     tableInfo->fields.emplace_back(STATUS);
 
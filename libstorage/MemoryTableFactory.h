@@ -53,6 +53,8 @@ public:
     void rollback(size_t _savepoint);
     void commit();
     void commitDB(h256 const& _blockHash, int64_t _blockNumber);
+    /// forget the opened tables and changes without committing them
+    void clear();
 
 private:
     storage::TableInfo::Ptr getSysTableInfo(const std::string& tableName);
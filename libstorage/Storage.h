@@ -42,6 +42,7 @@ public:
 
     virtual ~Storage(){};
 
+    /// @return the entries of table/key as committed by the newest block whose number <= num
     virtual Entries::Ptr select(
         h256 hash, int num, const std::string& table, const std::string& key) = 0;
     virtual size_t commit(
@@ -68,6 +68,8 @@ enum SyncPacketType : byte
     ReqBlocskPacket = 0x03,
     PacketCount
 };
+static_assert(c_syncPacketIDBase + TransactionsPacket == dev::eth::c_syncTransactionsPacketID,
+    "MessageDispatcher queues the transactions packets on their first byte");
 
 enum class SyncState
 {
@@ -142,6 +142,9 @@ void DownloadingBlockQueue::flushBufferToQueue()
         SYNCLOG(TRACE) << "[Rcv] [Download] Decoding block buffer [size]: "
                        << blocksShard->blocksBytes.size() << endl;
 
+        /// the blocks are read in place from the shard, one behind the chain is dropped on its
+        /// header without decoding its transactions
+        std::shared_ptr<bytes const> blocksBytes(blocksShard, &blocksShard->blocksBytes);
         RLP const& rlps = RLP(ref(blocksShard->blocksBytes));
         unsigned itemCount = rlps.itemCount();
         size_t successCnt = 0;
@@ -149,11 +152,11 @@ void DownloadingBlockQueue::flushBufferToQueue()
         {
             try
             {
-                shared_ptr<Block> block = make_shared<Block>(rlps[i].toBytes());
-                if (isNewerBlock(block))
+                BlockView view(blocksBytes, rlps[i].data());
+                if (isNewerBlock(view.header()))
                 {
                     successCnt++;
-                    m_blocks.push(block);
+                    m_blocks.push(view.toBlock());
                 }
             }
             catch (std::exception& e)
@@ -184,9 +187,9 @@ void DownloadingBlockQueue::clearFullQueueIfNotHas(int64_t _blockNumber)
         clearQueue();
 }
 
-bool DownloadingBlockQueue::isNewerBlock(shared_ptr<Block> _block)
+bool DownloadingBlockQueue::isNewerBlock(BlockHeader const& _header)
 {
-    if (m_blockChain != nullptr && _block->header().number() <= m_blockChain->number())
+    if (m_blockChain != nullptr && _header.number() <= m_blockChain->number())
         return false;
 
     // if (block->header()->)
@@ -25,6 +25,7 @@
 #include <libblockchain/BlockChainInterface.h>
 #include <libdevcore/Guards.h>
 #include <libethcore/Block.h>
+#include <libethcore/BlockView.h>
 #include <climits>
 #include <queue>
 #include <set>
@@ -37,8 +38,8 @@ namespace sync
 class DownloadBlocksShard
 {
 public:
-    DownloadBlocksShard(int64_t _fromNumber, int64_t _size, bytes const& _blocksBytes)
-      : fromNumber(_fromNumber), size(_size), blocksBytes(_blocksBytes)
+    DownloadBlocksShard(int64_t _fromNumber, int64_t _size, bytes _blocksBytes)
+      : fromNumber(_fromNumber), size(_size), blocksBytes(std::move(_blocksBytes))
     {}
     int64_t fromNumber;
     int64_t size;
@@ -114,7 +115,7 @@ private:
     mutable SharedMutex x_buffer;
 
 private:
-    bool isNewerBlock(std::shared_ptr<dev::eth::Block> _block);
+    bool isNewerBlock(dev::eth::BlockHeader const& _header);
 };
 
 }  // namespace sync
@@ -185,7 +185,7 @@ bool SyncMaster::isSyncing() const
 
 void SyncMaster::maintainTransactions()
 {
-    unordered_map<NodeID, std::vector<size_t>> peerTransactions;
+    FlatHashMap<NodeID, std::vector<size_t>> peerTransactions;
 
     auto ts =
         m_txPool->topTransactionsCondition(c_maxSendTransactions, [&](Transaction const& _tx) {
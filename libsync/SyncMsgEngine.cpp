@@ -150,10 +150,23 @@ void SyncMsgEngine::onPeerTransactions(SyncMsgPacket const& _packet)
 
     size_t successCnt = 0;
 
+    RLPs txsRlp = rlps.toList();
+    std::vector<bytesConstRef> txsData(itemCount);
+    for (unsigned i = 0; i < itemCount; ++i)
+        txsData[i] = txsRlp[i].data();
+    h256s txsHash = sha3Batch(txsData);
+
     for (unsigned i = 0; i < itemCount; ++i)
     {
+        /// gossip repeats a transaction once per peer, one already in the pool is dropped on its
+        /// hash before decoding it; a rejected one is decoded and verified again
+        if (m_txPool->isTransactionInPool(txsHash[i]))
+        {
+            m_txPool->transactionIsKonwnBy(txsHash[i], _packet.nodeId);
+            continue;
+        }
         Transaction tx;
-        tx.decode(rlps[i]);
+        tx.decode(txsRlp[i], CheckTransaction::Everything, txsHash[i]);
 
         auto importResult = m_txPool->import(tx);
         if (ImportResult::Success == importResult)
@@ -200,46 +213,47 @@ void SyncMsgEngine::onPeerRequestBlocks(SyncMsgPacket const& _packet)
     SYNCLOG(TRACE) << "[Rcv] [Send] [Download] Block request from " << _packet.nodeId << " req["
                    << from << ", " << from + size - 1 << "]" << endl;
 
-    // fetch block into downloading blocks container
+    // fetch block into downloading blocks container, the encoded blocks are read as a range
+    // and sent without being decoded
     DownloadBlocksContainer blockContainer(m_service, m_protocolId, from);
-    for (int64_t number = from; number < from + size; ++number)
+    auto blockRLPs = m_blockChain->getBlockRLPsByRange(from, from + size - 1);
+    if (blockRLPs.size() < size)
     {
-        shared_ptr<Block> block = m_blockChain->getBlockByNumber(number);
-        if (!block)
-        {
-            SYNCLOG(TRACE)
-                << "[Rcv] [Send] [Download] Get block for node failed [reason/number/nodeId]: "
-                << "block is null/" << number << "/" << _packet.nodeId << endl;
-            break;
-        }
-        else if (block->header().number() != number)
+        SYNCLOG(TRACE)
+            << "[Rcv] [Send] [Download] Get block for node failed [reason/number/nodeId]: "
+            << "block is null/" << from + blockRLPs.size() << "/" << _packet.nodeId << endl;
+    }
+    int64_t number = from;
+    for (auto const& blockRLP : blockRLPs)
+    {
+        /// only the header is decoded to check the block is the one requested
+        if (BlockHeader(ref(*blockRLP)).number() != number)
         {
             SYNCLOG(TRACE)
                 << "[Rcv] [Send] [Download] Get block for node failed [reason/number/nodeId]: "
                 << number << "number incorrect /" << _packet.nodeId << endl;
             break;
         }
-
-        blockContainer.push(block);
+        blockContainer.push(*blockRLP);
+        ++number;
     }
 
     // send it
     blockContainer.send(_packet.nodeId);
 }
 
-void DownloadBlocksContainer::push(BlockPtr _block)
+void DownloadBlocksContainer::push(bytes const& _blockRLP)
 {
-    bytes blockRLP = _block->rlp();
-    if ((m_currentShardSize + blockRLP.size()) > c_maxPayload &&
+    if ((m_currentShardSize + _blockRLP.size()) > c_maxPayload &&
         0 != m_blockRLPShards.back().size())
     {
         m_blockRLPShards.emplace_back(vector<bytes>());
         m_currentShardSize = 0;
     }
-    m_blockRLPShards.back().emplace_back(blockRLP);
-    m_currentShardSize += blockRLP.size();
+    m_blockRLPShards.back().emplace_back(_blockRLP);
+    m_currentShardSize += _blockRLP.size();
 
-    // Note that: if _block->rlp().size() > c_maxPayload
+    // Note that: if _blockRLP.size() > c_maxPayload
     // We also send it as a packet
 }
 
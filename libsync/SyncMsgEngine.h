@@ -95,7 +95,7 @@ public:
         m_startBlockNumber(_startNumber),
         m_blockRLPShards(1, std::vector<dev::bytes>())
     {}
-    void push(BlockPtr _block);
+    void push(dev::bytes const& _blockRLP);
     void send(NodeID _nodeId);
 
 private:
@@ -24,13 +24,13 @@
 #include "DownloadingBlockQueue.h"
 #include <libblockchain/BlockChainInterface.h>
 #include <libdevcore/FixedHash.h>
+#include <libdevcore/FlatHash.h>
 #include <libdevcore/Worker.h>
 #include <libethcore/Exceptions.h>
 #include <libp2p/Common.h>
 #include <libp2p/P2PInterface.h>
 #include <libp2p/Session.h>
 #include <libtxpool/TxPoolInterface.h>
-#include <map>
 #include <queue>
 #include <set>
 #include <vector>
@@ -132,7 +132,7 @@ public:
 
 private:
     mutable SharedMutex x_peerStatus;
-    std::map<NodeID, std::shared_ptr<SyncPeerStatus>> m_peersStatus;
+    FlatHashMap<NodeID, std::shared_ptr<SyncPeerStatus>> m_peersStatus;
 
     DownloadingBlockQueue m_downloadingBlockQueue;
 };
@@ -36,47 +36,64 @@ void NonceCheck::init()
     m_endblk = 0;
     updateCache(true);
 }
-std::string NonceCheck::generateKey(Transaction const& _t)
+
+bool NonceCheck::ok(Transaction const& _transaction, bool _needinsert)
 {
-    Address account = _t.from();
-    std::string key = toHex(account.ref());
-    key += "_" + toString(_t.nonce());
-    return key;
+    h256 digest = _transaction.nonceDigest();
+    Shard& shard = shardOf(digest);
+    Guard l(shard.lock);
+    if (shard.digests.count(digest))
+        return false;
+    if (_needinsert)
+        shard.digests.insert(digest);
+    return true;
 }
 
-bool NonceCheck::ok(Transaction const& _transaction, bool _needinsert)
+void NonceCheck::delCache(Transactions const& _transcations)
+{
+    h256s digests;
+    digests.reserve(_transcations.size());
+    for (auto const& tx : _transcations)
+        digests.push_back(tx.nonceDigest());
+    eraseDigests(digests);
+}
+
+size_t NonceCheck::size() const
 {
-    DEV_WRITE_GUARDED(m_lock)
+    size_t total = 0;
+    for (auto const& shard : m_shards)
     {
-        string key = this->generateKey(_transaction);
-        auto iter = m_cache.find(key);
-        if (iter != m_cache.end())
-            return false;
-        if (_needinsert)
-        {
-            m_cache.insert(std::pair<std::string, bool>(key, true));
-        }
+        Guard l(shard.lock);
+        total += shard.digests.size();
     }
-    return true;
+    return total;
 }
 
-void NonceCheck::delCache(Transactions const& _transcations)
+void NonceCheck::insertDigests(h256s const& _digests)
 {
-    DEV_WRITE_GUARDED(m_lock)
+    for (auto const& digest : _digests)
     {
-        for (unsigned i = 0; i < _transcations.size(); i++)
-        {
-            string key = this->generateKey(_transcations[i]);
-            auto iter = m_cache.find(key);
-            if (iter != m_cache.end())
-                m_cache.erase(iter);
-        }  // for
+        Shard& shard = shardOf(digest);
+        Guard l(shard.lock);
+        shard.digests.insert(digest);
+    }
+}
+
+void NonceCheck::eraseDigests(h256s const& _digests)
+{
+    for (auto const& digest : _digests)
+    {
+        Shard& shard = shardOf(digest);
+        Guard l(shard.lock);
+        shard.digests.erase(digest);
     }
 }
 
+/// the window is [number - maxblocksize, number]; only the blocks entering and leaving it are
+/// read, through their persisted nonce digests rather than the decoded block
 void NonceCheck::updateCache(bool _rebuild)
 {
-    DEV_WRITE_GUARDED(m_lock)
+    DEV_GUARDED(m_windowLock)
     {
         try
         {
@@ -97,40 +114,22 @@ void NonceCheck::updateCache(bool _rebuild)
                 << std::endl;
             if (_rebuild)
             {
-                m_cache.clear();
+                for (auto& shard : m_shards)
+                {
+                    Guard l(shard.lock);
+                    shard.digests.clear();
+                }
                 preendblk = 0;
             }
             else
             {
                 for (unsigned i = prestartblk; i < m_startblk; i++)
-                {
-                    h256 blockhash = m_blockChain->numberHash(i);
-
-                    Transactions trans = m_blockChain->getBlockByHash(blockhash)->transactions();
-                    for (unsigned j = 0; j < trans.size(); j++)
-                    {
-                        string key = this->generateKey(trans[j]);
-                        auto iter = m_cache.find(key);
-                        if (iter != m_cache.end())
-                            m_cache.erase(iter);
-                    }  // for
-                }      // for
+                    eraseDigests(m_blockChain->getNonceDigests(i));
             }
             for (unsigned i = std::max(preendblk + 1, m_startblk); i <= m_endblk; i++)
-            {
-                h256 blockhash = m_blockChain->numberHash(i);
-
-                Transactions trans = m_blockChain->getBlockByHash(blockhash)->transactions();
-                for (unsigned j = 0; j < trans.size(); j++)
-                {
-                    string key = this->generateKey(trans[j]);
-                    auto iter = m_cache.find(key);
-                    if (iter == m_cache.end())
-                        m_cache.insert(std::pair<std::string, bool>(key, true));
-                }  // for
-            }      // for
-            NONCECHECKER_LOG(TRACE) << "[#updateCache] [cacheSize/costTime]:  " << m_cache.size()
-                                    << "/" << (timer.elapsed() * 1000) << std::endl;
+                insertDigests(m_blockChain->getNonceDigests(i));
+            NONCECHECKER_LOG(TRACE) << "[#updateCache] [cacheSize/costTime]:  " << size() << "/"
+                                    << (timer.elapsed() * 1000) << std::endl;
         }
         catch (...)
         {
@@ -32,7 +32,9 @@
 #include <libethcore/Protocol.h>
 #include <libethcore/Transaction.h>
 #include <boost/timer.hpp>
+#include <array>
 #include <thread>
+#include <unordered_set>
 
 using namespace std;
 using namespace dev::eth;
@@ -59,16 +61,28 @@ public:
     bool ok(Transaction const& _transaction, bool _needinsert = false);
     void updateCache(bool _rebuild = false);
     void delCache(Transactions const& _transcations);
+    /// number of (sender, nonce) pairs currently in the window
+    size_t size() const;
 
 private:
+    /// the digests are sha3 outputs, so their first byte spreads them evenly over the shards
+    static const unsigned c_shardCount = 16;
+    struct Shard
+    {
+        mutable Mutex lock;
+        std::unordered_set<h256> digests;
+    };
+    Shard& shardOf(h256 const& _digest) { return m_shards[_digest[0] % c_shardCount]; }
+    void insertDigests(h256s const& _digests);
+    void eraseDigests(h256s const& _digests);
+
     std::shared_ptr<BlockChainInterface> m_blockChain;
     dev::PROTOCOL_ID m_protocolId;
-    std::unordered_map<std::string, bool> m_cache;
+    std::array<Shard, c_shardCount> m_shards;
     unsigned m_startblk;
     unsigned m_endblk;
-    mutable SharedMutex m_lock;
-
-    std::string generateKey(Transaction const& _t);
+    /// serialises window maintenance, lookups only lock one shard
+    mutable Mutex m_windowLock;
 };
 }  // namespace eth
 }  // namespace dev
@@ -23,6 +23,7 @@
  */
 #include "TxPool.h"
 #include <libethcore/Exceptions.h>
+#include <libethcore/SenderCache.h>
 using namespace dev::p2p;
 using namespace dev::eth;
 namespace dev
@@ -72,6 +73,144 @@ std::pair<h256, Address> TxPool::submit(Transaction& _tx)
     return make_pair(_tx.sha3(), toAddress(_tx.from(), _tx.nonce()));
 }
 
+size_t const TxPool::c_maxIngressBatch;
+
+/**
+ * @brief accept a transaction through RPC without waiting for the import:
+ *  1. decode the transaction and check its signature values, block limit and the ingress size
+ *  2. queue it for the ingress threads, which recover the senders and import in batches
+ * @param _txBytes : RLP of the signed transaction
+ * @return h256 : hash of the transaction
+ */
+h256 TxPool::submitAsync(bytesConstRef _txBytes)
+{
+    h256 txHash = sha3(_txBytes);
+    Transaction tx;
+    tx.decode(RLP(_txBytes), CheckTransaction::Cheap, txHash);
+    if (!isBlockLimitOk(tx))
+        BOOST_THROW_EXCEPTION(TransactionRefused() << errinfo_comment("invalid block limit"));
+
+    uint64_t limit;
+    {
+        ReadGuard l(m_lock);
+        limit = m_limit;
+    }
+    /// posted under the lock: once stopIngress has taken the pool no drain can be queued, and
+    /// the drains queued before are joined or accounted for by stopIngress
+    Guard l(x_ingress);
+    if (m_ingressStopped)
+        BOOST_THROW_EXCEPTION(TransactionRefused() << errinfo_comment("txpool is stopping"));
+    if (m_ingress.size() >= limit)
+        BOOST_THROW_EXCEPTION(TransactionRefused() << errinfo_comment("ingress queue is full"));
+    m_ingress.push_back(std::move(tx));
+    if (!m_ingressPool)
+        m_ingressPool = std::make_shared<dev::ThreadPool>("TxIngress", m_ingressThreads);
+    if (m_ingressDrains < m_ingressThreads)
+    {
+        m_ingressDrains++;
+        m_ingressPool->enqueue([this]() { drainIngress(); });
+    }
+    return txHash;
+}
+
+/// runs on the ingress threads, the transactions whose sender can't be recovered are dropped
+void TxPool::drainIngress()
+{
+    while (true)
+    {
+        Transactions batch;
+        {
+            Guard l(x_ingress);
+            if (m_ingress.empty())
+            {
+                m_ingressDrains--;
+                return;
+            }
+            size_t size = std::min(m_ingress.size(), c_maxIngressBatch);
+            batch.reserve(size);
+            std::move(m_ingress.begin(), m_ingress.begin() + size, std::back_inserter(batch));
+            m_ingress.erase(m_ingress.begin(), m_ingress.begin() + size);
+        }
+
+        Transactions txs;
+        txs.reserve(batch.size());
+        for (auto& tx : batch)
+        {
+            try
+            {
+                /// as import(bytesConstRef): the canonical encoding, then the sender
+                if (sha3(tx.rlp()) != tx.sha3())
+                    BOOST_THROW_EXCEPTION(InconsistentTransactionSha3()
+                                          << errinfo_comment("Transaction sha3 is inconsistent"));
+                Address sender;
+                if (SenderCache::instance().get(tx.sha3(), sender))
+                    tx.forceSender(sender);
+                else
+                    SenderCache::instance().insert(tx.sha3(), tx.sender());
+                txs.push_back(std::move(tx));
+            }
+            catch (std::exception const& e)
+            {
+                TXPOOL_LOG(WARNING) << "[#submitAsync] [#InvalidTransaction] [tx]:  "
+                                    << tx.sha3().abridged() << " " << e.what() << std::endl;
+            }
+        }
+        batchImport(txs);
+    }
+}
+
+void TxPool::stopIngress()
+{
+    std::shared_ptr<dev::ThreadPool> ingressPool;
+    {
+        Guard l(x_ingress);
+        m_ingressStopped = true;
+        m_ingress.clear();
+        ingressPool.swap(m_ingressPool);
+    }
+    /// joins the ingress threads, a running drain returns at the now empty queue; ~ThreadPool
+    /// drops the drains still queued, they are accounted for here
+    ingressPool.reset();
+    Guard l(x_ingress);
+    m_ingressDrains = 0;
+}
+
+/**
+ * @brief : verify and insert transactions under one write lock, for the batches of the ingress
+ *  threads rather than a lock round trip per transaction
+ * @param _txs : decoded transactions with their senders
+ * @return std::vector<ImportResult> : import result of each transaction
+ */
+std::vector<ImportResult> TxPool::batchImport(Transactions& _txs)
+{
+    std::vector<ImportResult> results;
+    results.reserve(_txs.size());
+    bool imported = false;
+    {
+        u256 importTime = u256(utcTime());
+        WriteGuard l(m_lock);
+        for (auto& tx : _txs)
+        {
+            tx.setImportTime(importTime);
+            ImportResult result = verify(tx);
+            if (result == ImportResult::Success)
+            {
+                insert(tx);
+                imported = true;
+            }
+            results.push_back(result);
+        }
+        /// drop the oversized transactions
+        while (m_txsQueue.size() > m_limit)
+        {
+            removeOutOfBound(m_txsQueue.rbegin()->sha3());
+        }
+    }
+    if (imported)
+        m_onReady();
+    return results;
+}
+
 /**
  * @brief : veirfy specified transaction
  *          && insert the valid transaction into the transaction queue
@@ -86,8 +225,8 @@ ImportResult TxPool::import(bytesConstRef _txBytes, IfDropped _ik)
     Transaction tx;
 
     tx.decode(_txBytes, CheckTransaction::Everything);
-    /// check sha3
-    if (sha3(_txBytes.toBytes()) != tx.sha3())
+    /// check sha3: tx.sha3() is the hash of _txBytes, it must match the canonical encoding
+    if (sha3(tx.rlp()) != tx.sha3())
         BOOST_THROW_EXCEPTION(
             InconsistentTransactionSha3() << errinfo_comment("Transaction sha3 is inconsistent"));
     return import(tx, _ik);
@@ -206,9 +345,10 @@ bool TxPool::removeTrans(h256 const& _txHash, bool needTriggerCallback,
     /// trigger callback from RPC
     if (needTriggerCallback && pReceipt)
     {
-        p_tx->second->tiggerRpcCallback(pReceipt);
+        p_tx->second.first->tiggerRpcCallback(pReceipt);
     }
-    m_txsQueue.erase(p_tx->second);
+    m_txsQueue.erase(p_tx->second.first);
+    m_arrival.erase(p_tx->second.second);
     m_txsHash.erase(p_tx);
     if (m_known.count(_txHash))
         m_known.erase(_txHash);
@@ -238,7 +378,8 @@ void TxPool::insert(Transaction const& _tx)
     }
     m_known.insert(tx_hash);
     PriorityQueue::iterator p_tx = m_txsQueue.emplace(_tx);
-    m_txsHash[tx_hash] = p_tx;
+    m_txsHash[tx_hash] = std::make_pair(p_tx, ++m_lastArrival);
+    m_arrival.emplace_hint(m_arrival.end(), m_lastArrival, p_tx);
 }
 
 /**
@@ -267,6 +408,8 @@ dev::eth::LocalisedTransactionReceipt::Ptr TxPool::constructTransactionReceipt(
 
 bool TxPool::dropBlockTrans(Block const& block)
 {
+    /// slide the nonce window over the block that has just been committed
+    m_nonceCheck->updateCache();
     if (block.getTransactionSize() == 0)
         return true;
     WriteGuard l(m_lock);
@@ -337,6 +480,31 @@ Transactions TxPool::topTransactionsCondition(
     return ret;
 }
 
+/**
+ * @brief Get the transactions queued after a cursor, in arrival order
+ *
+ * @param _limit : Max number of transactions to return.
+ * @param _cursor : 0 for the front of the queue, moved past the returned transactions
+ * @param _admit : returns false to stop before the transaction
+ * @return Transactions : up to _limit transactions
+ */
+Transactions TxPool::topTransactionsSince(uint64_t const& _limit, uint64_t& _cursor,
+    std::function<bool(Transaction const&)> const& _admit)
+{
+    ReadGuard l(m_lock);
+    Transactions ret;
+    uint64_t limit = min(m_limit, _limit);
+    for (auto it = m_arrival.upper_bound(_cursor); ret.size() < limit && it != m_arrival.end();
+         it++)
+    {
+        if (_admit && !_admit(*it->second))
+            break;
+        ret.push_back(*it->second);
+        _cursor = it->first;
+    }
+    return ret;
+}
+
 /// get all transactions(maybe blocksync module need this interface)
 Transactions TxPool::pendingList() const
 {
@@ -373,6 +541,7 @@ void TxPool::clear()
     m_known.clear();
     m_txsQueue.clear();
     m_txsHash.clear();
+    m_arrival.clear();
     WriteGuard l_trans(x_transactionKnownBy);
     m_transactionKnownBy.clear();
 }
@@ -404,6 +573,12 @@ bool TxPool::isTransactionKonwnBySomeone(h256 const& _txHash)
     return !p->second.empty();
 }
 
+bool TxPool::isTransactionInPool(h256 const& _txHash) const
+{
+    ReadGuard l(m_lock);
+    return m_txsHash.count(_txHash);
+}
+
 void TxPool::removeTransactionKnowBy(h256 const& _txHash)
 {
     WriteGuard l(x_transactionKnownBy);
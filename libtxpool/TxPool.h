@@ -25,6 +25,8 @@
 #include "NonceCheck.h"
 #include "TxPoolInterface.h"
 #include <libblockchain/BlockChainInterface.h>
+#include <libdevcore/FlatHash.h>
+#include <libdevcore/ThreadPool.h>
 #include <libdevcore/easylog.h>
 #include <libethcore/Block.h>
 #include <libethcore/Common.h>
@@ -32,6 +34,8 @@
 #include <libethcore/Transaction.h>
 #include <libp2p/P2PInterface.h>
 #include <libp2p/Service.h>
+#include <deque>
+#include <map>
 using namespace dev::eth;
 using namespace dev::p2p;
 
@@ -77,7 +81,11 @@ public:
         m_nonceCheck = std::make_shared<dev::eth::NonceCheck>(m_blockChain, m_protocolId);
     }
 
-    virtual ~TxPool() { clear(); }
+    virtual ~TxPool()
+    {
+        stopIngress();
+        clear();
+    }
 
     /**
      * @brief submit a transaction through RPC/web3sdk
@@ -87,6 +95,18 @@ public:
      */
     std::pair<h256, Address> submit(Transaction& _tx) override;
 
+    /**
+     * @brief accept a transaction through RPC after the checks that need neither the sender nor
+     * the pool lock; the ingress threads recover the senders and import the accepted
+     * transactions in batches
+     *
+     * @param _txBytes : RLP of the signed transaction
+     * @return h256 : hash of the transaction
+     */
+    h256 submitAsync(bytesConstRef _txBytes) override;
+    /// verify and queue _txs under one lock, @returns the import result of each
+    std::vector<ImportResult> batchImport(Transactions& _txs) override;
+
     /**
      * @brief Remove transaction from the queue
      * @param _txHash: transaction hash
@@ -106,6 +126,8 @@ public:
         uint64_t const& _limit, h256Hash& _avoid, bool _updateAvoid = false) override;
     virtual Transactions topTransactionsCondition(uint64_t const& _limit,
         std::function<bool(Transaction const&)> const& _condition = nullptr) override;
+    Transactions topTransactionsSince(uint64_t const& _limit, uint64_t& _cursor,
+        std::function<bool(Transaction const&)> const& _admit = nullptr) override;
 
     /// get all transactions(maybe blocksync module need this interface)
     Transactions pendingList() const override;
@@ -119,7 +141,13 @@ public:
     virtual PROTOCOL_ID const& getProtocolId() const { return m_protocolId; }
     virtual void setMaxBlockLimit(u256 const& _maxBlockLimit) { m_maxBlockLimit = _maxBlockLimit; }
     virtual const u256 maxBlockLimit() const { return m_maxBlockLimit; }
-    void setTxPoolLimit(uint64_t const& _limit) { m_limit = _limit; }
+    void setTxPoolLimit(uint64_t const& _limit)
+    {
+        WriteGuard l(m_lock);
+        m_limit = _limit;
+    }
+    /// number of ingress threads, takes effect before the first submitAsync
+    void setIngressThreads(size_t _threads) { m_ingressThreads = std::max(_threads, (size_t)1); }
 
     /// Set transaction is known by a node
     virtual void transactionIsKonwnBy(h256 const& _txHash, h512 const& _nodeId) override;
@@ -130,6 +158,9 @@ public:
     /// Is the transaction is known by someone
     virtual bool isTransactionKonwnBySomeone(h256 const& _txHash) override;
 
+    /// Is the transaction in the pool ?
+    virtual bool isTransactionInPool(h256 const& _txHash) const override;
+
 protected:
     /**
      * @brief : submit a transaction through p2p, Verify and add transaction to the queue
@@ -164,6 +195,9 @@ private:
     bool removeOutOfBound(h256 const& _txHash);
     void insert(Transaction const& _tx);
     void removeTransactionKnowBy(h256 const& _txHash);
+    /// import batches of the ingress queue until it is empty
+    void drainIngress();
+    void stopIngress();
 
 private:
     /// p2p module
@@ -180,15 +214,31 @@ private:
     /// transaction queue
     using PriorityQueue = std::multiset<Transaction, PriorityCompare>;
     PriorityQueue m_txsQueue;
-    std::unordered_map<h256, PriorityQueue::iterator> m_txsHash;
+    /// position in m_txsQueue and arrival number of each queued transaction
+    FlatHashMap<h256, std::pair<PriorityQueue::iterator, uint64_t>> m_txsHash;
+    /// m_txsQueue by arrival number, cursors of topTransactionsSince point into it
+    std::map<uint64_t, PriorityQueue::iterator> m_arrival;
+    uint64_t m_lastArrival = 0;
     /// hash of imported transactions
-    h256Hash m_known;
+    FlatHashSet<h256> m_known;
     /// hash of dropped transactions
-    h256Hash m_dropped;
+    FlatHashSet<h256> m_dropped;
 
     /// Transaction is known by some peers
     mutable SharedMutex x_transactionKnownBy;
-    std::unordered_map<h256, std::set<h512>> m_transactionKnownBy;
+    FlatHashMap<h256, std::set<h512>> m_transactionKnownBy;
+
+    /// transactions accepted by submitAsync, waiting for the sender recovery and the import
+    std::deque<Transaction> m_ingress;
+    mutable Mutex x_ingress;
+    std::shared_ptr<dev::ThreadPool> m_ingressPool;
+    size_t m_ingressThreads = 4;
+    /// ingress threads draining m_ingress
+    size_t m_ingressDrains = 0;
+    /// set by stopIngress, refuses any later submitAsync
+    bool m_ingressStopped = false;
+    /// most transactions imported under one lock
+    static size_t const c_maxIngressBatch = 1000;
 };
 }  // namespace txpool
 }  // namespace dev
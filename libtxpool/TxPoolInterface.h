@@ -59,6 +59,16 @@ public:
     {
         return dev::eth::Transactions();
     };
+    /**
+     * @brief Get the transactions queued after a cursor, in arrival order
+     *
+     * @param _limit : Max number of transactions to return.
+     * @param _cursor : 0 for the front of the queue, moved past the returned transactions
+     * @param _admit : returns false to stop before the transaction
+     * @return Transactions : up to _limit transactions
+     */
+    virtual dev::eth::Transactions topTransactionsSince(uint64_t const& _limit, uint64_t& _cursor,
+        std::function<bool(dev::eth::Transaction const&)> const& _admit = nullptr) = 0;
 
     /// get all current transactions(maybe blocksync module need this interface)
     virtual dev::eth::Transactions pendingList() const = 0;
@@ -72,6 +82,26 @@ public:
      */
     virtual std::pair<h256, Address> submit(dev::eth::Transaction& _tx) = 0;
 
+    /**
+     * @brief submit an encoded transaction through RPC without waiting for its import
+     * @param _txBytes : RLP of the signed transaction
+     * @return h256 : hash of the transaction, it is still dropped if the import fails
+     */
+    virtual h256 submitAsync(bytesConstRef _txBytes)
+    {
+        dev::eth::Transaction tx(_txBytes, dev::eth::CheckTransaction::Everything);
+        return submit(tx).first;
+    }
+
+    /// verify and queue transactions together, @returns the import result of each
+    virtual std::vector<dev::eth::ImportResult> batchImport(dev::eth::Transactions& _txs)
+    {
+        std::vector<dev::eth::ImportResult> results;
+        for (auto& tx : _txs)
+            results.push_back(import(tx));
+        return results;
+    }
+
     /**
      * @brief : submit a transaction through p2p, Verify and add transaction to the queue
      * synchronously.
@@ -98,6 +128,9 @@ public:
     /// Is the transaction is known by someone
     virtual bool isTransactionKonwnBySomeone(h256 const& _txHash) { return false; };
 
+    /// Is the transaction in the pool ?
+    virtual bool isTransactionInPool(h256 const& _txHash) const { return false; };
+
     /// Register a handler that will be called once there is a new transaction imported
     template <class T>
     dev::eth::Handler<> onReady(T const& _t)
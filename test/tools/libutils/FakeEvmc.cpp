@@ -146,6 +146,10 @@ void call(evmc_result* o_result, evmc_context* _context, evmc_message const* _ms
                 bytesConstRef{o_result->output_data, o_result->output_size}.toBytes();
             fakeState.accountCode(toEvmC(destination)) = generatedCode;
 
+            // the output may live in the result's reserved memory overlapped by create_address
+            if (o_result->release)
+                o_result->release(o_result);
+            o_result->release = nullptr;
             o_result->create_address = toEvmC(destination);
             o_result->output_data = nullptr;
             o_result->output_size = 0;
@@ -238,8 +242,14 @@ evmc_result FakeEvmc::execute(EVMSchedule const& schedule, bytes code, bytes dat
     if (isCreate && result.status_code == EVMC_SUCCESS)
     {
         // We assume that generatedCode is added into state immediately
-        bytes generatedCode = bytesConstRef{result.output_data, result.output_size}.toBytes();
-        fakeState.accountCode(toEvmC(destination)) = generatedCode;
+        bytes& generatedCode = fakeState.accountCode(toEvmC(destination));
+        generatedCode = bytesConstRef{result.output_data, result.output_size}.toBytes();
+        // the output may live in the result's reserved memory overlapped by create_address,
+        // release it and return the code kept in the state instead
+        if (result.release)
+            result.release(&result);
+        result.release = nullptr;
+        result.output_data = generatedCode.data();
         result.create_address = toEvmC(destination);
     }
     return result;
@@ -30,6 +30,7 @@
 #include <libstorage/MemoryTableFactory.h>
 #include <test/tools/libutils/TestOutputHelper.h>
 #include <test/unittests/libethcore/FakeBlock.h>
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 using namespace dev;
@@ -80,6 +81,11 @@ public:
             entry->setField("value", "1");
             entry->setField("index", "0");
         }
+        else if (m_table == "_sys_block_2_nonces_" && key == "2")
+        {
+            entry->setField(
+                "value", toHexPrefixed(sha3("nonce0").asBytes() + sha3("nonce1").asBytes()));
+        }
         entries->addEntry(entry);
         return entries;
     }
@@ -190,6 +196,42 @@ BOOST_AUTO_TEST_CASE(getTxByHash)
     BOOST_CHECK_EQUAL(tx.sha3(), m_fakeBlock->m_transaction[0].sha3());
 }
 
+BOOST_AUTO_TEST_CASE(getNonceDigests)
+{
+    h256s digests = m_blockChainImp->getNonceDigests(2);
+    BOOST_CHECK_EQUAL(digests.size(), 2);
+    BOOST_CHECK_EQUAL(digests[0], sha3("nonce0"));
+    BOOST_CHECK_EQUAL(digests[1], sha3("nonce1"));
+    /// blocks committed before the index existed are decoded instead
+    digests = m_blockChainImp->getNonceDigests(1);
+    BOOST_CHECK_EQUAL(digests.size(), 5);
+    for (size_t i = 0; i < digests.size(); ++i)
+        BOOST_CHECK_EQUAL(digests[i], m_fakeBlock->m_transaction[i].nonceDigest());
+}
+
+BOOST_AUTO_TEST_CASE(getBlockFromBlockStore)
+{
+    boost::filesystem::remove_all("./blockChainStore");
+    /// the block of number() is kept by setBlockStore, the blocks after it were never committed
+    auto blockStore = std::make_shared<BlockStore>("./blockChainStore", 4);
+    h256 hash = sha3("block1");
+    blockStore->put(1, hash, ref(m_fakeBlock->getBlockData()));
+    blockStore->put(2, sha3("block2"), ref(m_fakeBlock->getBlockData()));
+    m_blockChainImp->setBlockStore(blockStore);
+    BOOST_CHECK_EQUAL(blockStore->head(), 1);
+
+    /// only the block store knows hash
+    auto block = m_blockChainImp->getBlockByHash(hash);
+    BOOST_REQUIRE(block);
+    BOOST_CHECK_EQUAL(block->getTransactionSize(), 5);
+    BOOST_CHECK(*m_blockChainImp->getBlockRLPByNumber(1) == m_fakeBlock->getBlockData());
+    auto blocks = m_blockChainImp->getBlockRLPsByRange(1, 1);
+    BOOST_REQUIRE_EQUAL(blocks.size(), 1);
+    BOOST_CHECK(*blocks[0] == m_fakeBlock->getBlockData());
+    m_blockChainImp->setBlockStore(nullptr);
+    boost::filesystem::remove_all("./blockChainStore");
+}
+
 BOOST_AUTO_TEST_CASE(commitBlock)
 {
     // m_blockChainImp->commitBlock(m_fakeBlock->getBlock(), m_executiveContext);
@@ -0,0 +1,186 @@
+/*
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ */
+
+/**
+ * @brief : unit tests of the segmented block store
+ * @file: BlockStore.cpp
+ * @date: 2018-12-21
+ */
+#include <libblockchain/BlockStore.h>
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/Exceptions.h>
+#include <libdevcore/SHA3.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+
+using namespace dev;
+using namespace dev::blockchain;
+namespace dev
+{
+namespace test
+{
+struct BlockStoreFixture : public TestOutputHelperFixture
+{
+    BlockStoreFixture() { boost::filesystem::remove_all(path); }
+    ~BlockStoreFixture() { boost::filesystem::remove_all(path); }
+
+    /// a block of a size depending on _number
+    static bytes block(int64_t _number) { return bytes(100 + _number * 7, byte(_number)); }
+    static h256 hash(int64_t _number) { return sha3(block(_number)); }
+    static void put(BlockStore& _store, int64_t _from, int64_t _to)
+    {
+        for (int64_t number = _from; number <= _to; number++)
+        {
+            bytes data = block(number);
+            _store.put(number, hash(number), dev::ref(data));
+        }
+    }
+    std::string segment(int64_t _first, std::string const& _suffix)
+    {
+        return path + "/" + std::string(12 - toString(_first).size(), '0') + toString(_first) +
+               _suffix;
+    }
+
+    std::string path = "./blockStore";
+};
+
+BOOST_FIXTURE_TEST_SUITE(BlockStoreTest, BlockStoreFixture)
+
+BOOST_AUTO_TEST_CASE(testPutGet)
+{
+    {
+        BlockStore store(path, 4);
+        BOOST_CHECK_EQUAL(store.head(), -1);
+        BOOST_CHECK(!store.get(1));
+        put(store, 1, 10);
+        BOOST_CHECK_EQUAL(store.tail(), 1);
+        BOOST_CHECK_EQUAL(store.head(), 10);
+        BOOST_CHECK(*store.get(7) == block(7));
+        BOOST_CHECK(*store.get(hash(3)) == block(3));
+        BOOST_CHECK_EQUAL(store.number(hash(9)), 9);
+        BOOST_CHECK(!store.get(11));
+        BOOST_CHECK_EQUAL(store.number(sha3("absent")), -1);
+        /// blocks that do not follow the head are refused
+        BOOST_CHECK_THROW(put(store, 12, 12), FileError);
+    }
+    /// reopened, the blocks and the hash index are back
+    BlockStore store(path, 4);
+    BOOST_CHECK_EQUAL(store.tail(), 1);
+    BOOST_CHECK_EQUAL(store.head(), 10);
+    for (int64_t number = 1; number <= 10; number++)
+    {
+        BOOST_CHECK(*store.get(number) == block(number));
+        BOOST_CHECK_EQUAL(store.number(hash(number)), number);
+    }
+    put(store, 11, 12);
+    BOOST_CHECK(*store.get(hash(12)) == block(12));
+    /// another segment size does not read the segments
+    BOOST_CHECK_THROW(BlockStore(path, 8), FileError);
+}
+
+BOOST_AUTO_TEST_CASE(testRange)
+{
+    BlockStore store(path, 4);
+    put(store, 1, 10);
+    auto blocks = store.getRange(2, 9);
+    BOOST_REQUIRE_EQUAL(blocks.size(), 8);
+    for (int64_t number = 2; number <= 9; number++)
+        BOOST_CHECK(*blocks[number - 2] == block(number));
+    /// stops at the head
+    BOOST_CHECK_EQUAL(store.getRange(8, 20).size(), 3);
+    /// nothing from before the tail
+    BOOST_CHECK_EQUAL(store.getRange(0, 5).size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(testReplaceAndTruncate)
+{
+    BlockStore store(path, 4);
+    put(store, 1, 10);
+    /// a block up to the head replaces the blocks from it on
+    bytes other(50, 0xff);
+    store.put(6, sha3(other), dev::ref(other));
+    BOOST_CHECK_EQUAL(store.head(), 6);
+    BOOST_CHECK(*store.get(6) == other);
+    BOOST_CHECK_EQUAL(store.number(hash(6)), -1);
+    BOOST_CHECK_EQUAL(store.number(hash(8)), -1);
+    BOOST_CHECK(!boost::filesystem::exists(segment(8, ".blocks")));
+    put(store, 7, 9);
+    BOOST_CHECK(*store.get(9) == block(9));
+
+    store.truncate(4);
+    BOOST_CHECK_EQUAL(store.head(), 4);
+    BOOST_CHECK(!store.get(5));
+    BOOST_CHECK_EQUAL(boost::filesystem::file_size(segment(4, ".blocks")), block(4).size());
+    store.truncate(0);
+    BOOST_CHECK_EQUAL(store.head(), -1);
+    BOOST_CHECK_EQUAL(store.tail(), -1);
+    put(store, 3, 5);
+    BOOST_CHECK_EQUAL(store.tail(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(testPrune)
+{
+    BlockStore store(path, 4);
+    put(store, 1, 10);
+    /// block 5 is still wanted, the segment [4, 7] stays
+    store.prune(5);
+    BOOST_CHECK_EQUAL(store.tail(), 4);
+    BOOST_CHECK(!store.get(3));
+    BOOST_CHECK_EQUAL(store.number(hash(2)), -1);
+    BOOST_CHECK(*store.get(4) == block(4));
+    BOOST_CHECK(!boost::filesystem::exists(segment(0, ".blocks")));
+    BOOST_CHECK(!boost::filesystem::exists(segment(0, ".index")));
+    BOOST_CHECK_THROW(put(store, 3, 3), FileError);
+    put(store, 11, 12);
+    BOOST_CHECK_EQUAL(store.head(), 12);
+}
+
+BOOST_AUTO_TEST_CASE(testRecover)
+{
+    {
+        BlockStore store(path, 4);
+        put(store, 1, 6);
+    }
+    /// a crash in the middle of writing block 6 leaves its index entry past the end of the file
+    boost::filesystem::resize_file(
+        segment(4, ".blocks"), boost::filesystem::file_size(segment(4, ".blocks")) - 10);
+    {
+        BlockStore store(path, 4);
+        BOOST_CHECK_EQUAL(store.head(), 5);
+        BOOST_CHECK_EQUAL(store.number(hash(6)), -1);
+        BOOST_CHECK_EQUAL(
+            boost::filesystem::file_size(segment(4, ".blocks")), block(4).size() + block(5).size());
+        put(store, 6, 9);
+    }
+    /// bytes written after the last index entry are dropped
+    {
+        std::ofstream file(segment(8, ".blocks"), std::ios::app | std::ios::binary);
+        file << "garbage";
+    }
+    BlockStore store(path, 4);
+    BOOST_CHECK_EQUAL(store.head(), 9);
+    BOOST_CHECK(*store.get(9) == block(9));
+    BOOST_CHECK_EQUAL(boost::filesystem::file_size(segment(8, ".blocks")),
+        block(8).size() + block(9).size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
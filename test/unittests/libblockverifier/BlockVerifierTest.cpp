@@ -145,6 +145,26 @@ BOOST_AUTO_TEST_CASE(executeBlock)
      }*/
 }
 
+BOOST_AUTO_TEST_CASE(executiveContextPool)
+{
+    auto context = m_executiveContextFactory->newExecutiveContext();
+    auto first = std::make_shared<CRUDPrecompiled>();
+    auto second = std::make_shared<CRUDPrecompiled>();
+    BOOST_CHECK(context->registerPrecompiled(first) == Address(0x10001));
+    BOOST_CHECK(context->registerPrecompiled(second) == Address(0x10002));
+    BOOST_CHECK(context->getPrecompiled(Address(0x10001)) == first);
+    BOOST_CHECK(context->getPrecompiled(Address(0x10002)) == second);
+    BOOST_CHECK(!context->getPrecompiled(Address(0x10003)));
+
+    /// a released context is handed out again without the handles of its last block
+    ExecutiveContext* released = context.get();
+    context.reset();
+    context = m_executiveContextFactory->newExecutiveContext();
+    BOOST_CHECK(context.get() == released);
+    BOOST_CHECK(!context->getPrecompiled(Address(0x10001)));
+    BOOST_CHECK(context->registerPrecompiled(second) == Address(0x10001));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace test
@@ -0,0 +1,108 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief: unit test for the execution time predictions of ExecutionCostModel
+ *
+ * @file ExecutionCostModel.cpp
+ * @date 2018-12-18
+ */
+#include <libblockverifier/ExecutionCostModel.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::blockverifier;
+
+namespace dev
+{
+namespace test
+{
+/// a call of _selector on _to
+static Transaction callOf(Address const& _to, bytes const& _selector)
+{
+    bytes data = _selector;
+    data.resize(36, 0);
+    return Transaction(u256(0), u256(1), u256(30000000), _to, data, u256(0));
+}
+
+BOOST_FIXTURE_TEST_SUITE(ExecutionCostModelTest, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(testPredict)
+{
+    ExecutionCostModel model;
+    Transaction transfer = callOf(Address(0x1000), bytes{0xa9, 0x05, 0x9c, 0xbb});
+    Transaction heavy = callOf(Address(0x1000), bytes{0x12, 0x34, 0x56, 0x78});
+    BOOST_CHECK(!model.trained());
+    BOOST_CHECK_EQUAL(model.predict(transfer), 0);
+
+    /// each selector learns its own cost, unseen keys get the average
+    model.update(transfer, 100, u256(20000));
+    model.update(heavy, 5000, u256(400000));
+    BOOST_CHECK(model.trained());
+    BOOST_CHECK_EQUAL(model.predict(transfer), 100);
+    BOOST_CHECK_EQUAL(model.predict(heavy), 5000);
+    Transaction unseen = callOf(Address(0x2000), bytes{0xa9, 0x05, 0x9c, 0xbb});
+    uint64_t average = model.predict(unseen);
+    BOOST_CHECK(average > 100 && average < 5000);
+
+    /// later executions move the prediction towards them
+    for (size_t i = 0; i < 50; i++)
+        model.update(transfer, 200, u256(20000));
+    BOOST_CHECK_EQUAL(model.predict(transfer), 200);
+    BOOST_CHECK_EQUAL(model.stats().keys, 2);
+}
+
+/// a full table drops its least recently executed key, new keys keep coming in
+BOOST_AUTO_TEST_CASE(testEviction)
+{
+    ExecutionCostModel model(2);
+    Transaction a = callOf(Address(0x1000), bytes{0x01, 0x02, 0x03, 0x04});
+    Transaction b = callOf(Address(0x2000), bytes{0x01, 0x02, 0x03, 0x04});
+    Transaction c = callOf(Address(0x3000), bytes{0x01, 0x02, 0x03, 0x04});
+    Transaction d = callOf(Address(0x4000), bytes{0x01, 0x02, 0x03, 0x04});
+    for (size_t i = 0; i < 10; i++)
+        model.update(a, 100, u256(10000));
+    model.update(b, 2000, u256(10000));
+    model.update(a, 100, u256(10000));
+    /// b is the least recent, although a has far more samples c replaces b
+    model.update(c, 3000, u256(10000));
+    BOOST_CHECK_EQUAL(model.stats().keys, 2);
+    BOOST_CHECK_EQUAL(model.predict(a), 100);
+    BOOST_CHECK_EQUAL(model.predict(c), 3000);
+    BOOST_CHECK(model.predict(b) != 2000);
+    /// then a, executed before c, leaves for d
+    model.update(d, 4000, u256(10000));
+    BOOST_CHECK_EQUAL(model.predict(c), 3000);
+    BOOST_CHECK_EQUAL(model.predict(d), 4000);
+    BOOST_CHECK(model.predict(a) != 100);
+}
+
+BOOST_AUTO_TEST_CASE(testReportBlock)
+{
+    ExecutionCostModel model;
+    model.reportBlock(900, 1000);
+    model.reportBlock(1300, 1000);
+    ExecutionCostModel::Stats stats = model.stats();
+    BOOST_CHECK_EQUAL(stats.blocks, 2);
+    BOOST_CHECK_EQUAL(stats.lastPredicted, 1300);
+    BOOST_CHECK_EQUAL(stats.lastActual, 1000);
+    BOOST_CHECK_CLOSE(stats.meanError, 0.2, 0.0001);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
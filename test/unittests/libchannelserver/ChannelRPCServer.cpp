@@ -0,0 +1,284 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief: unit test for the routing of channel messages by ChannelRPCServer: the nodes and the
+ * SDK sessions tried in turn, the timeouts and the sessions going away
+ *
+ * @file ChannelRPCServer.cpp
+ * @date 2018-12-26
+ */
+#include <libchannelserver/ChannelMessage.h>
+#include <libchannelserver/ChannelRPCServer.h>
+#include <libchannelserver/ChannelServer.h>
+#include <libp2p/P2PMsgHandler.h>
+#include <libp2p/Service.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <test/unittests/libp2p/FakeHost.h>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+
+using namespace dev;
+using namespace dev::p2p;
+using namespace dev::channel;
+namespace dev
+{
+namespace test
+{
+/// the nodes following every topic, keeping the channel messages sent to them
+class FakeChannelService : public Service
+{
+public:
+    FakeChannelService(std::shared_ptr<Host> _host, std::shared_ptr<P2PMsgHandler> _p2pMsgHandler)
+      : Service(_host, _p2pMsgHandler)
+    {}
+
+    NodeIDs getPeersByTopic(std::string const&) override { return m_peers; }
+    void asyncSendMessageByNodeID(NodeID const& _nodeID, dev::p2p::Message::Ptr _message,
+        std::function<void(P2PException, dev::p2p::Message::Ptr)>,
+        dev::p2p::Options const& = dev::p2p::Options()) override
+    {
+        auto message = std::make_shared<ChannelMessage>();
+        message->decode(_message->buffer()->data(), _message->buffer()->size());
+        m_sent.push_back(std::make_pair(_nodeID, message));
+    }
+
+    NodeIDs m_peers;
+    std::vector<std::pair<NodeID, dev::channel::Message::Ptr>> m_sent;
+};
+
+/// an SDK connection keeping the messages pushed to it
+class FakeChannelSession : public ChannelSession
+{
+public:
+    FakeChannelSession(std::string const& _topic) { topics()->insert(_topic); }
+
+    void asyncSendMessage(dev::channel::Message::Ptr _request,
+        std::function<void(ChannelException, dev::channel::Message::Ptr)>, uint32_t) override
+    {
+        m_sent.push_back(_request);
+    }
+    void run() override {}
+    bool actived() override { return true; }
+
+    std::vector<dev::channel::Message::Ptr> m_sent;
+};
+
+class ChannelRPCServerFixture : public TestOutputHelperFixture
+{
+public:
+    ChannelRPCServerFixture()
+    {
+        m_host = std::shared_ptr<Host>(createFakeHost("2.0", "127.0.0.1", 30303));
+        m_service = std::make_shared<FakeChannelService>(m_host, std::make_shared<P2PMsgHandler>());
+        m_service->m_peers = {NodeID(1), NodeID(2)};
+        m_ioService = std::make_shared<boost::asio::io_service>();
+        auto channelServer = std::make_shared<ChannelServer>();
+        channelServer->setIOService(m_ioService);
+        channelServer->setMessageFactory(std::make_shared<ChannelMessageFactory>());
+        m_server = std::make_shared<ChannelRPCServer>();
+        m_server->setService(m_service);
+        m_server->setChannelServer(channelServer);
+    }
+
+    std::shared_ptr<FakeChannelSession> connect()
+    {
+        auto session = std::make_shared<FakeChannelSession>(m_topic);
+        m_server->onConnect(ChannelException(), session);
+        return session;
+    }
+
+    /// a channel message of _type for m_topic
+    dev::channel::Message::Ptr channelMessage(uint16_t _type, int _result = 0)
+    {
+        auto message = std::make_shared<ChannelMessage>();
+        message->setType(_type);
+        message->setSeq(m_seq);
+        message->setResult(_result);
+        bytes data(1, byte(m_topic.size() + 1));
+        data.insert(data.end(), m_topic.begin(), m_topic.end());
+        message->setData(data.data(), data.size());
+        return message;
+    }
+
+    /// _message as a node sends it
+    void fromNode(NodeID const& _nodeID, dev::channel::Message::Ptr _message)
+    {
+        auto buffer = std::make_shared<bytes>();
+        _message->encode(*buffer);
+        m_server->onNodeRequest(_nodeID, buffer);
+    }
+
+    /// run the next timeout, @returns the milliseconds waited for it
+    int64_t runTimeout()
+    {
+        auto start = std::chrono::steady_clock::now();
+        m_ioService->reset();
+        BOOST_REQUIRE_EQUAL(m_ioService->run_one(), 1);
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    std::shared_ptr<Host> m_host;
+    std::shared_ptr<FakeChannelService> m_service;
+    std::shared_ptr<boost::asio::io_service> m_ioService;
+    ChannelRPCServer::Ptr m_server;
+    std::string const m_topic = "topic";
+    std::string const m_seq = std::string(31, '0') + "1";
+    int64_t const c_defaultTimeout = ChannelRPCServer::c_defaultMessageTimeout;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ChannelRPCServerTest, ChannelRPCServerFixture)
+
+BOOST_AUTO_TEST_CASE(testForwardToNode)
+{
+    auto sdk = connect();
+    m_server->onClientRequest(sdk, ChannelException(), channelMessage(0x30));
+    BOOST_REQUIRE_EQUAL(m_service->m_sent.size(), 1);
+    NodeID first = m_service->m_sent[0].first;
+    BOOST_CHECK_EQUAL(m_service->m_sent[0].second->seq(), m_seq);
+
+    /// a node failing the message passes it to the next one, whose answer goes to the SDK
+    fromNode(first, channelMessage(0x31, 1));
+    BOOST_REQUIRE_EQUAL(m_service->m_sent.size(), 2);
+    NodeID second = m_service->m_sent[1].first;
+    BOOST_CHECK(second != first);
+    BOOST_CHECK(sdk->m_sent.empty());
+    fromNode(second, channelMessage(0x31));
+    BOOST_REQUIRE_EQUAL(sdk->m_sent.size(), 1);
+    BOOST_CHECK_EQUAL(sdk->m_sent[0]->type(), 0x31);
+    BOOST_CHECK_EQUAL(sdk->m_sent[0]->result(), 0);
+
+    /// answered already
+    fromNode(second, channelMessage(0x31));
+    BOOST_CHECK_EQUAL(sdk->m_sent.size(), 1);
+
+    /// every node failing it
+    m_server->onClientRequest(sdk, ChannelException(), channelMessage(0x30));
+    fromNode(m_service->m_sent[2].first, channelMessage(0x31, 1));
+    fromNode(m_service->m_sent[3].first, channelMessage(0x31, 1));
+    BOOST_REQUIRE_EQUAL(sdk->m_sent.size(), 2);
+    BOOST_CHECK_EQUAL(sdk->m_sent[1]->result(), ChannelRPCServer::REMOTE_PEER_UNAVAILIBLE);
+}
+
+BOOST_AUTO_TEST_CASE(testForwardTimeout)
+{
+    /// the timeout set is the one waited for, not c_defaultMessageTimeout
+    m_server->setMessageTimeout(50);
+    auto sdk = connect();
+    m_server->onClientRequest(sdk, ChannelException(), channelMessage(0x30));
+    BOOST_REQUIRE_EQUAL(m_service->m_sent.size(), 1);
+    BOOST_CHECK_LT(runTimeout(), c_defaultTimeout);
+    BOOST_REQUIRE_EQUAL(m_service->m_sent.size(), 2);
+    BOOST_CHECK(m_service->m_sent[1].first != m_service->m_sent[0].first);
+    BOOST_CHECK(sdk->m_sent.empty());
+
+    /// the node timed out answers too late
+    fromNode(m_service->m_sent[0].first, channelMessage(0x31, 1));
+    BOOST_CHECK_EQUAL(m_service->m_sent.size(), 2);
+
+    runTimeout();
+    BOOST_REQUIRE_EQUAL(sdk->m_sent.size(), 1);
+    BOOST_CHECK_EQUAL(sdk->m_sent[0]->result(), ChannelRPCServer::REMOTE_PEER_UNAVAILIBLE);
+    BOOST_CHECK_EQUAL(m_service->m_sent.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(testAnswerCancelsTimeout)
+{
+    m_server->setMessageTimeout(50);
+    auto sdk = connect();
+    m_server->onClientRequest(sdk, ChannelException(), channelMessage(0x30));
+    fromNode(m_service->m_sent[0].first, channelMessage(0x31));
+    BOOST_REQUIRE_EQUAL(sdk->m_sent.size(), 1);
+    /// only the cancelled wait is left
+    m_ioService->reset();
+    m_ioService->run();
+    BOOST_CHECK_EQUAL(m_service->m_sent.size(), 1);
+    BOOST_CHECK_EQUAL(sdk->m_sent.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testPushToSession)
+{
+    auto sdk1 = connect();
+    auto sdk2 = connect();
+    fromNode(NodeID(1), channelMessage(0x30));
+    BOOST_REQUIRE_EQUAL(sdk1->m_sent.size() + sdk2->m_sent.size(), 1);
+    auto first = sdk1->m_sent.empty() ? sdk2 : sdk1;
+    auto second = first == sdk1 ? sdk2 : sdk1;
+
+    /// a session failing the message passes it to the other one, whose answer goes to the node
+    m_server->onClientRequest(first, ChannelException(), channelMessage(0x31, 1));
+    BOOST_REQUIRE_EQUAL(second->m_sent.size(), 1);
+    BOOST_CHECK(m_service->m_sent.empty());
+    m_server->onClientRequest(second, ChannelException(), channelMessage(0x31));
+    BOOST_REQUIRE_EQUAL(m_service->m_sent.size(), 1);
+    BOOST_CHECK(m_service->m_sent[0].first == NodeID(1));
+    BOOST_CHECK_EQUAL(m_service->m_sent[0].second->type(), 0x31);
+    BOOST_CHECK_EQUAL(m_service->m_sent[0].second->result(), 0);
+
+    /// every session failing it
+    fromNode(NodeID(1), channelMessage(0x30));
+    m_server->onClientRequest(first, ChannelException(), channelMessage(0x31, 1));
+    m_server->onClientRequest(second, ChannelException(), channelMessage(0x31, 1));
+    BOOST_REQUIRE_EQUAL(m_service->m_sent.size(), 2);
+    BOOST_CHECK_EQUAL(
+        m_service->m_sent[1].second->result(), ChannelRPCServer::REMOTE_CLIENT_PEER_UNAVAILBLE);
+}
+
+BOOST_AUTO_TEST_CASE(testPushTimeout)
+{
+    m_server->setMessageTimeout(50);
+    auto sdk1 = connect();
+    auto sdk2 = connect();
+    fromNode(NodeID(1), channelMessage(0x30));
+    BOOST_CHECK_LT(runTimeout(), c_defaultTimeout);
+    BOOST_CHECK_EQUAL(sdk1->m_sent.size(), 1);
+    BOOST_CHECK_EQUAL(sdk2->m_sent.size(), 1);
+    BOOST_CHECK(m_service->m_sent.empty());
+
+    runTimeout();
+    BOOST_REQUIRE_EQUAL(m_service->m_sent.size(), 1);
+    BOOST_CHECK_EQUAL(
+        m_service->m_sent[0].second->result(), ChannelRPCServer::REMOTE_CLIENT_PEER_UNAVAILBLE);
+}
+
+BOOST_AUTO_TEST_CASE(testDisconnect)
+{
+    auto sdk1 = connect();
+    auto sdk2 = connect();
+    fromNode(NodeID(1), channelMessage(0x30));
+    auto first = sdk1->m_sent.empty() ? sdk2 : sdk1;
+    auto second = first == sdk1 ? sdk2 : sdk1;
+
+    /// the message pushed to a session going away goes to another one
+    m_server->onDisconnect(ChannelException(), first);
+    BOOST_REQUIRE_EQUAL(second->m_sent.size(), 1);
+    m_server->onClientRequest(second, ChannelException(), channelMessage(0x31));
+    BOOST_REQUIRE_EQUAL(m_service->m_sent.size(), 1);
+    BOOST_CHECK_EQUAL(m_service->m_sent[0].second->result(), 0);
+
+    /// the requests of a session going away are dropped
+    m_server->onClientRequest(second, ChannelException(), channelMessage(0x30));
+    BOOST_REQUIRE_EQUAL(m_service->m_sent.size(), 2);
+    m_server->onDisconnect(ChannelException(), second);
+    fromNode(m_service->m_sent[1].first, channelMessage(0x31));
+    BOOST_CHECK_EQUAL(second->m_sent.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
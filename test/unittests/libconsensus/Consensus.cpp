@@ -92,6 +92,50 @@ BOOST_AUTO_TEST_CASE(testLoadTransactions)
     fake_pbft.engine()->mutableTimeManager().m_lastConsensusTime = utcTime();
     BOOST_CHECK(fake_pbft.checkTxsEnough(11) == false);
 }
+
+/// a trained cost model packs the transactions that execute within the block interval
+BOOST_AUTO_TEST_CASE(testLoadTransactionsByCost)
+{
+    std::shared_ptr<SyncInterface> sync = std::make_shared<FakeBlockSync>();
+    std::shared_ptr<BlockVerifierInterface> blockVerifier = std::make_shared<FakeBlockverifier>();
+    std::shared_ptr<TxPoolFixture> txpool_creator = std::make_shared<TxPoolFixture>(5, 5);
+
+    std::string str = "transaction";
+    Transaction tx(u256(100), u256(0), u256(100000000), toAddress(KeyPair::create().pub()),
+        bytes(str.begin(), str.end()));
+    Secret sec = KeyPair::create().secret();
+    const size_t txCnt = 10;
+    for (size_t i = 0; i < txCnt; i++)
+    {
+        tx.setNonce(tx.nonce() + u256(i));
+        tx.setBlockLimit(txpool_creator->m_blockChain->number() + 2);
+        dev::Signature sig = sign(sec, tx.sha3(WithoutSignature));
+        tx.updateSignature(SignatureStruct(sig));
+        txpool_creator->m_txPool->submit(tx);
+    }
+    BOOST_CHECK(txpool_creator->m_txPool->pendingSize() == txCnt);
+
+    FakePBFTSealer fake_pbft(txpool_creator->m_topicService, txpool_creator->m_txPool,
+        txpool_creator->m_blockChain, sync, blockVerifier, 10);
+    auto costModel = std::make_shared<ExecutionCostModel>();
+    fake_pbft.setCostModel(costModel);
+    /// every transaction is predicted to take 0.3s of the 1s interval
+    costModel->update(tx, 300000, u256(30000));
+    TimeManager& timeManager = fake_pbft.engine()->mutableTimeManager();
+    timeManager.m_intervalBlockTime = 1000;
+    timeManager.m_lastExecFinishTime = timeManager.m_lastConsensusTime = utcTime();
+
+    fake_pbft.loadTransactions(txCnt);
+    /// three fit in the budget, the block is full with fewer transactions than asked for
+    BOOST_CHECK_EQUAL(fake_pbft.sealingTxNum(), 3);
+    timeManager.m_lastConsensusTime = utcTime();
+    BOOST_CHECK(fake_pbft.checkTxsEnough(txCnt) == true);
+
+    /// without a model the transaction count alone limits the block
+    fake_pbft.setCostModel(nullptr);
+    fake_pbft.loadTransactions(txCnt);
+    BOOST_CHECK_EQUAL(fake_pbft.sealingTxNum(), txCnt);
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
@@ -253,6 +253,7 @@ public:
     {
         return PBFTSealer::checkTxsEnough(maxTxsCanSeal);
     }
+    size_t sealingTxNum() { return m_sealing.block.getTransactionSize(); }
 
     std::shared_ptr<FakePBFTEngine> engine()
     {
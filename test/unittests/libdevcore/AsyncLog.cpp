@@ -0,0 +1,161 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief Unit tests for ASYNC_LOG, its per-thread rings and the rated log sites
+ * @file AsyncLog.cpp
+ * @date 2018-12-20
+ */
+
+#include <libdevcore/easylog.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <thread>
+
+using namespace dev;
+namespace dev
+{
+namespace test
+{
+/// restores the enabled levels of the AsyncLogger
+struct AsyncLogFixture : public TestOutputHelperFixture
+{
+    AsyncLogFixture() : levels(AsyncLogger::enabledLevels()) {}
+    ~AsyncLogFixture() { AsyncLogger::setEnabledLevels(levels); }
+    unsigned levels;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AsyncLog, AsyncLogFixture)
+
+BOOST_AUTO_TEST_CASE(testDisabledLevelSkipsArguments)
+{
+    size_t evaluated = 0;
+    auto argument = [&]() {
+        evaluated++;
+        return std::string("argument");
+    };
+    AsyncLogger::setEnabledLevels((unsigned)el::Level::Info);
+    ASYNC_LOG(TRACE) << argument();
+    ASYNC_LOG(DEBUG) << argument();
+    BOOST_CHECK_EQUAL(evaluated, 0);
+    ASYNC_LOG(INFO) << argument();
+    BOOST_CHECK_EQUAL(evaluated, 1);
+
+    /// an unbraced if/else keeps its meaning around the macro
+    if (evaluated == 0)
+        ASYNC_LOG(INFO) << argument();
+    else
+        evaluated = 10;
+    BOOST_CHECK_EQUAL(evaluated, 10);
+    AsyncLogger::instance().flush();
+}
+
+BOOST_AUTO_TEST_CASE(testRing)
+{
+    AsyncLogRing ring(4);
+    AsyncLogEntry entry;
+    BOOST_CHECK(ring.empty());
+    for (size_t i = 0; i < 4; i++)
+    {
+        entry.message = toString(i);
+        BOOST_CHECK(ring.push(entry));
+    }
+    /// full: the entry stays with the caller
+    entry.message = "dropped";
+    BOOST_CHECK(!ring.push(entry));
+    BOOST_CHECK_EQUAL(entry.message, "dropped");
+    for (size_t i = 0; i < 4; i++)
+    {
+        BOOST_CHECK(ring.pop(entry));
+        BOOST_CHECK_EQUAL(entry.message, toString(i));
+    }
+    BOOST_CHECK(!ring.pop(entry));
+    BOOST_CHECK(ring.empty());
+}
+
+BOOST_AUTO_TEST_CASE(testLogRate)
+{
+    LogRate rate;
+    /// the first event goes through at once, the next ones are counted until the interval ends
+    BOOST_CHECK_EQUAL(rate.hit(), 1);
+    for (size_t i = 0; i < 100; i++)
+        BOOST_CHECK_EQUAL(rate.hit(), 0);
+
+    /// one line for the 100 events of a call site
+    AsyncLogger::setEnabledLevels((unsigned)el::Level::Info);
+    size_t lines = 0;
+    for (size_t i = 0; i < 100; i++)
+        ASYNC_LOG_RATED(INFO) << "rated event " << ++lines;
+    AsyncLogger::instance().flush();
+    BOOST_CHECK_EQUAL(lines, 1);
+}
+
+BOOST_AUTO_TEST_CASE(testLoadEnabledLevels)
+{
+    el::Logger* logger = el::Loggers::getLogger(el::base::consts::kDefaultLoggerId);
+    el::Configurations saved = *logger->configurations();
+    el::Configurations conf = saved;
+    conf.set(el::Level::Trace, el::ConfigurationType::Enabled, "false");
+    conf.set(el::Level::Debug, el::ConfigurationType::Enabled, "false");
+    el::Loggers::reconfigureLogger(logger, conf);
+    AsyncLogger::loadEnabledLevels();
+    BOOST_CHECK(!AsyncLogger::enabled(el::Level::Trace));
+    BOOST_CHECK(!AsyncLogger::enabled(el::Level::Debug));
+    BOOST_CHECK(AsyncLogger::enabled(el::Level::Info));
+    BOOST_CHECK(AsyncLogger::enabled(el::Level::Error));
+
+    /// turned back on by the configuration, as log.conf does
+    conf.set(el::Level::Trace, el::ConfigurationType::Enabled, "true");
+    el::Loggers::reconfigureLogger(logger, conf);
+    AsyncLogger::loadEnabledLevels();
+    BOOST_CHECK(AsyncLogger::enabled(el::Level::Trace));
+    BOOST_CHECK(!AsyncLogger::enabled(el::Level::Debug));
+    el::Loggers::reconfigureLogger(logger, saved);
+}
+
+BOOST_AUTO_TEST_CASE(testOrigin)
+{
+    /// the thread of the call site, not the one writing the line
+    el::base::DefaultLogBuilder::Origin origin;
+    AsyncLogger::stamp(origin);
+    BOOST_CHECK_EQUAL(origin.threadId, el::base::threading::getCurrentThreadId());
+    BOOST_CHECK(origin.time.tv_sec > 0);
+    el::base::DefaultLogBuilder::Origin other;
+    std::thread([&]() { AsyncLogger::stamp(other); }).join();
+    BOOST_CHECK(other.threadId != origin.threadId);
+
+    el::Logger* logger = el::Loggers::getLogger("asyncLogOrigin");
+    el::Configurations conf;
+    conf.setToDefault();
+    conf.setGlobally(el::ConfigurationType::Format, "%datetime{%Y} %thread");
+    el::Loggers::reconfigureLogger(logger, conf);
+    el::base::DefaultLogBuilder builder;
+    el::LogMessage message(el::Level::Info, __FILE__, __LINE__, "", 0, logger);
+    /// ten years after the epoch, whatever the time zone
+    origin.time.tv_sec = 10 * 366 * 24 * 3600;
+    origin.threadId = "origin";
+    {
+        el::base::DefaultLogBuilder::OriginScope scope(origin);
+        BOOST_CHECK_EQUAL(builder.build(&message, false), "1980 origin");
+    }
+    BOOST_CHECK(builder.build(&message, false) != "1980 origin");
+    el::Loggers::unregisterLogger("asyncLogOrigin");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
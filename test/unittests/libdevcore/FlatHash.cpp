@@ -0,0 +1,135 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief Unit tests for FlatHashMap and FlatHashSet
+ * @file FlatHash.cpp
+ * @date 2018-12-19
+ */
+
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/FlatHash.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using namespace dev;
+namespace dev
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(FlatHash, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(testInsertFindErase)
+{
+    FlatHashMap<h256, std::string> map;
+    BOOST_CHECK(map.empty());
+    BOOST_CHECK(map.find(h256(1)) == map.end());
+    BOOST_CHECK(map.begin() == map.end());
+
+    BOOST_CHECK(map.emplace(h256(1), "one").second);
+    BOOST_CHECK(!map.emplace(h256(1), "uno").second);
+    map[h256(2)] = "two";
+    BOOST_CHECK(map.insert(std::make_pair(h256(3), std::string("three"))).second);
+    BOOST_CHECK_EQUAL(map.size(), 3);
+    BOOST_CHECK_EQUAL(map[h256(1)], "one");
+    BOOST_CHECK_EQUAL(map.find(h256(2))->second, "two");
+    BOOST_CHECK_EQUAL(map.count(h256(3)), 1);
+    BOOST_CHECK_EQUAL(map.count(h256(4)), 0);
+
+    BOOST_CHECK_EQUAL(map.erase(h256(2)), 1);
+    BOOST_CHECK_EQUAL(map.erase(h256(2)), 0);
+    BOOST_CHECK(map.find(h256(2)) == map.end());
+    BOOST_CHECK_EQUAL(map.size(), 2);
+    map.clear();
+    BOOST_CHECK(map.empty());
+    BOOST_CHECK(map.find(h256(1)) == map.end());
+
+    FlatHashSet<h512> set;
+    BOOST_CHECK(set.insert(h512(1)).second);
+    BOOST_CHECK(!set.insert(h512(1)).second);
+    BOOST_CHECK(set.emplace(h512(2)).second);
+    BOOST_CHECK_EQUAL(set.size(), 2);
+    BOOST_CHECK_EQUAL(set.count(h512(2)), 1);
+}
+
+/// the same random inserts and erases on a FlatHashMap and on a std::unordered_map
+BOOST_AUTO_TEST_CASE(testAgainstUnorderedMap)
+{
+    FlatHashMap<h256, size_t> map;
+    std::unordered_map<h256, size_t> expected;
+    std::mt19937 random(7);
+    for (size_t i = 0; i < 20000; i++)
+    {
+        /// few keys, so that deleted slots are reused and purged
+        h256 key(unsigned(random() % 512));
+        if (i % 3 == 0)
+            BOOST_CHECK_EQUAL(map.erase(key), expected.erase(key));
+        else
+            map[key] = expected[key] = i;
+    }
+    BOOST_CHECK_EQUAL(map.size(), expected.size());
+    size_t visited = 0;
+    for (auto const& item : map)
+    {
+        BOOST_CHECK_EQUAL(item.second, expected.at(item.first));
+        visited++;
+    }
+    BOOST_CHECK_EQUAL(visited, expected.size());
+    BOOST_CHECK(map.capacity() * 7 >= map.size() * 8);
+}
+
+BOOST_AUTO_TEST_CASE(testEraseWhileIterating)
+{
+    FlatHashMap<h256, size_t> map;
+    for (size_t i = 0; i < 1000; i++)
+        map[h256(i)] = i;
+    for (auto it = map.begin(); it != map.end();)
+    {
+        if (it->second % 2 == 0)
+            it = map.erase(it);
+        else
+            it++;
+    }
+    BOOST_CHECK_EQUAL(map.size(), 500);
+    for (size_t i = 0; i < 1000; i++)
+        BOOST_CHECK_EQUAL(map.count(h256(i)), i % 2);
+
+    /// copies and moves keep the elements
+    FlatHashMap<h256, size_t> copied(map);
+    FlatHashMap<h256, size_t> moved(std::move(map));
+    BOOST_CHECK_EQUAL(copied.size(), 500);
+    BOOST_CHECK_EQUAL(moved.size(), 500);
+    BOOST_CHECK_EQUAL(copied[h256(999)], 999);
+    BOOST_CHECK_EQUAL(moved[h256(1)], 1);
+}
+
+BOOST_AUTO_TEST_CASE(testWordHash)
+{
+    /// hashes of h256 differing in the last byte only must differ in the low bits too
+    h256::hash hasher;
+    BOOST_CHECK((hasher(h256(1)) & 0xffff) != (hasher(h256(2)) & 0xffff));
+    BOOST_CHECK_EQUAL(hasher(h256(1)), std::hash<h256>()(h256(1)));
+    /// sizes that are not a multiple of the word size
+    BOOST_CHECK(h520::hash()(h520(1)) != h520::hash()(h520(2)));
+    BOOST_CHECK(FixedHash<4>::hash()(FixedHash<4>(1)) != FixedHash<4>::hash()(FixedHash<4>(2)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace test
+}  // namespace dev
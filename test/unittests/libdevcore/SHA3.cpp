@@ -89,6 +89,29 @@ BOOST_AUTO_TEST_CASE(testSha3CommonFunc)
                 "9c4cc25ecb5e60f5dd0bf889381084ca6fc4199");
 }
 
+/// sha3Batch must agree with sha3 for every input, whichever lane kernels are used
+BOOST_AUTO_TEST_CASE(testSha3Batch)
+{
+    std::vector<bytes> inputs;
+    /// sizes around the 136 byte keccak rate, several of each so that lanes are filled
+    for (size_t size : {0, 1, 31, 32, 64, 135, 136, 137, 256, 271, 272, 1024})
+    {
+        for (size_t i = 0; i < 9; i++)
+            inputs.push_back(bytes(size, byte(i + size)));
+    }
+    inputs.push_back(asBytes("abcde"));
+    std::vector<bytesConstRef> refs;
+    for (auto const& input : inputs)
+        refs.push_back(ref(input));
+    h256s hashes = sha3Batch(refs);
+    BOOST_REQUIRE_EQUAL(hashes.size(), inputs.size());
+    for (size_t i = 0; i < inputs.size(); i++)
+        BOOST_CHECK_EQUAL(hashes[i], sha3(inputs[i]));
+    BOOST_CHECK_EQUAL(hashes.back(),
+        h256("6377c7e66081cb65e473c1b95db5195a27d04a7108b468890224bedbe1a8a6eb"));
+    BOOST_CHECK(sha3Batch(std::vector<bytesConstRef>()).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
@@ -0,0 +1,100 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief: unit test for BlockView and TransactionView against the decoded Block
+ *
+ * @file BlockView.cpp
+ * @date 2018-12-25
+ */
+#include "FakeBlock.h"
+#include <libethcore/BlockView.h>
+#include <libethcore/TransactionView.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+using namespace dev;
+using namespace dev::eth;
+
+namespace dev
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(BlockViewTest, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(testBlockView)
+{
+    FakeBlock fake_block(5);
+    auto data = std::make_shared<bytes const>(fake_block.getBlockData());
+    BlockView view(data);
+    Block block(*data);
+
+    BOOST_CHECK(view.header() == block.blockHeader());
+    BOOST_CHECK_EQUAL(view.hash(), block.headerHash());
+    BOOST_CHECK_EQUAL(view.number(), block.blockHeader().number());
+    BOOST_CHECK_EQUAL(view.receiptCount(), 0);
+    BOOST_REQUIRE_EQUAL(view.transactionCount(), 5);
+    BOOST_CHECK(view.rlp().data() == data->data());
+
+    h256s hashes = view.transactionHashes();
+    TransactionViews txs = view.transactions();
+    BOOST_REQUIRE_EQUAL(hashes.size(), 5);
+    BOOST_REQUIRE_EQUAL(txs.size(), 5);
+    for (size_t i = 0; i < 5; i++)
+    {
+        Transaction const& tx = block.transactions()[i];
+        BOOST_CHECK_EQUAL(hashes[i], tx.sha3());
+        BOOST_CHECK_EQUAL(txs[i].hash(), tx.sha3());
+        BOOST_CHECK_EQUAL(view.transaction(i).hash(), tx.sha3());
+        BOOST_CHECK(txs[i].toTransaction() == tx);
+    }
+    BOOST_CHECK(view.toBlock()->equalAll(block));
+    BOOST_CHECK_THROW(view.transaction(5), Exception);
+
+    bytes header = fake_block.getBlockHeaderData();
+    BOOST_CHECK_THROW(BlockView(std::make_shared<bytes const>(header)), InvalidBlockFormat);
+}
+
+BOOST_AUTO_TEST_CASE(testTransactionView)
+{
+    FakeBlock fake_block(1);
+    Transaction const& tx = fake_block.m_singleTransaction;
+    auto data = std::make_shared<bytes const>(tx.rlp());
+    TransactionView view(data);
+
+    BOOST_CHECK_EQUAL(view.hash(), tx.sha3());
+    BOOST_CHECK_EQUAL(view.sender(), tx.sender());
+    BOOST_CHECK_EQUAL(view.nonce(), tx.nonce());
+    BOOST_CHECK_EQUAL(view.gasPrice(), tx.gasPrice());
+    BOOST_CHECK_EQUAL(view.gas(), tx.gas());
+    BOOST_CHECK_EQUAL(view.value(), tx.value());
+    BOOST_CHECK_EQUAL(view.isCreation(), tx.isCreation());
+    BOOST_CHECK_EQUAL(view.receiveAddress(), tx.receiveAddress());
+    /// the data is read in place
+    BOOST_CHECK(view.data().toBytes() == tx.data());
+    BOOST_CHECK(view.data().data() >= data->data() &&
+                view.data().data() + view.data().size() <= data->data() + data->size());
+
+    /// the sender is recovered once, then found in SenderCache by any view of the transaction
+    TransactionView copy(std::make_shared<bytes const>(*data));
+    BOOST_CHECK_EQUAL(copy.sender(), tx.sender());
+
+    bytes notList = rlp(u256(1));
+    BOOST_CHECK_THROW(TransactionView(std::make_shared<bytes const>(notList)),
+        InvalidTransactionFormat);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace dev
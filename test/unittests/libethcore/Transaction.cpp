@@ -23,6 +23,8 @@
 #include <libdevcore/Assertions.h>
 #include <libdevcore/CommonJS.h>
 #include <libethcore/CommonJS.h>
+#include <libethcore/Exceptions.h>
+#include <libethcore/SenderCache.h>
 #include <libethcore/Transaction.h>
 #include <test/tools/libutils/TestOutputHelper.h>
 #include <boost/test/unit_test.hpp>
@@ -34,7 +36,16 @@ namespace dev
 {
 namespace test
 {
-BOOST_FIXTURE_TEST_SUITE(TransactionTest, TestOutputHelperFixture)
+/// every decode fills the node-wide SenderCache, each case starts and leaves it empty so that
+/// no case sees the senders recovered by another
+class SenderCacheFixture : public TestOutputHelperFixture
+{
+public:
+    SenderCacheFixture() { SenderCache::instance().clear(); }
+    ~SenderCacheFixture() { SenderCache::instance().clear(); }
+};
+
+BOOST_FIXTURE_TEST_SUITE(TransactionTest, SenderCacheFixture)
 
 BOOST_AUTO_TEST_CASE(testCreateTxByRLP)
 {
@@ -63,6 +74,77 @@ BOOST_AUTO_TEST_CASE(testCreateTxByRLP)
     /*bytes s;
     BOOST_CHECK_NO_THROW(tx.encode(s, eth::IncludeSignature::WithSignature));*/
 }
+/// decoding the same raw transaction again takes the sender from SenderCache
+BOOST_AUTO_TEST_CASE(testSenderCache)
+{
+    Transaction tx(u256(100), u256(0), u256(100000000), toAddress(KeyPair::create().pub()),
+        asBytes("test sender cache"));
+    KeyPair sigKeyPair = KeyPair::create();
+    SignatureStruct sig = dev::sign(sigKeyPair.secret(), tx.sha3(WithoutSignature));
+    tx.updateSignature(sig);
+    bytes encodeBytes = tx.rlp();
+    Transaction decodeTx(ref(encodeBytes), CheckTransaction::Everything);
+    BOOST_CHECK(decodeTx.sender() == toAddress(sigKeyPair.pub()));
+    BOOST_CHECK(decodeTx.sha3() == sha3(encodeBytes));
+    Address cached;
+    BOOST_CHECK(SenderCache::instance().get(sha3(encodeBytes), cached));
+    BOOST_CHECK(cached == toAddress(sigKeyPair.pub()));
+    /// a poisoned entry shows that the second decode did not recover the signature again
+    Address poisoned = Address(12345);
+    SenderCache::instance().insert(sha3(encodeBytes), poisoned);
+    Transaction cachedTx(ref(encodeBytes), CheckTransaction::Everything);
+    BOOST_CHECK(cachedTx.sender() == poisoned);
+}
+
+/// the cache never holds more than its capacity
+BOOST_AUTO_TEST_CASE(testSenderCacheBound)
+{
+    SenderCache cache(64);
+    for (unsigned i = 0; i < 1000; i++)
+        cache.insert(sha3(toString(i)), Address(i));
+    BOOST_CHECK(cache.size() <= 64);
+    Address sender;
+    BOOST_CHECK(cache.get(sha3(toString(999)), sender));
+    BOOST_CHECK(sender == Address(999));
+    BOOST_CHECK(!cache.get(sha3(toString(0)), sender));
+}
+
+/// only the canonical encoding is decoded, its raw hash is the hash of the re-encoding
+BOOST_AUTO_TEST_CASE(testNonCanonicalRLP)
+{
+    Transaction tx(u256(100), u256(0), u256(100000000), toAddress(KeyPair::create().pub()),
+        asBytes("test canonical rlp"));
+    KeyPair sigKeyPair = KeyPair::create();
+    SignatureStruct sig = dev::sign(sigKeyPair.secret(), tx.sha3(WithoutSignature));
+    tx.updateSignature(sig);
+    bytes encodeBytes = tx.rlp();
+    RLP rlp(encodeBytes);
+
+    /// a trailing eleventh field
+    RLPStream extraField(11);
+    for (unsigned i = 0; i < 10; i++)
+        extraField.appendRaw(rlp[i].data());
+    extraField.append(u256(1));
+    bytes extraBytes = extraField.out();
+    Transaction decodeTx;
+    BOOST_CHECK_THROW(decodeTx.decode(ref(extraBytes)), InvalidTransactionFormat);
+
+    /// the zero gas price as the byte 0x00 instead of the empty string
+    bytes zeroByte{0x00};
+    RLPStream zeroPrice(10);
+    for (unsigned i = 0; i < 10; i++)
+        zeroPrice.appendRaw(i == 1 ? bytesConstRef(&zeroByte) : rlp[i].data());
+    bytes zeroPriceBytes = zeroPrice.out();
+    BOOST_CHECK_THROW(decodeTx.decode(ref(zeroPriceBytes)), InconsistentTransactionSha3);
+    BOOST_CHECK_THROW(
+        decodeTx.decode(RLP(zeroPriceBytes), CheckTransaction::None, sha3(zeroPriceBytes)),
+        InconsistentTransactionSha3);
+    Address sender;
+    BOOST_CHECK(!SenderCache::instance().get(sha3(zeroPriceBytes), sender));
+
+    BOOST_CHECK_NO_THROW(decodeTx.decode(ref(encodeBytes)));
+    BOOST_CHECK(decodeTx.sha3() == sha3(encodeBytes));
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
@@ -307,6 +307,51 @@ public:
     {}
 };
 
+class AlethInterpreterStatusTestFixture : public AlethInterpreterExtcodehashTestFixture
+{
+public:
+    void testRevertIsReturnedAsStatus()
+    {
+        // mstore(0, 0x60)
+        // revert(0, 0x20)
+        code = fromHex("606060005260206000fd");
+
+        ExtVM extVm(state, envInfo, address, address, address, value, gasPrice, ref(inputData),
+            ref(code), sha3(code), depth, isCreate, staticCall);
+
+        evmc_status_code status = EVMC_SUCCESS;
+        owning_bytes_ref ret = vm->exec(gas, extVm, OnOpFunc{}, status);
+
+        BOOST_REQUIRE_EQUAL(status, EVMC_REVERT);
+        BOOST_REQUIRE_EQUAL(fromBigEndian<int>(ret.toBytes()), 0x60);
+        BOOST_REQUIRE(gas > 0 && gas < 1000000);
+        BOOST_REQUIRE(toTransactionException(status) == TransactionException::RevertInstruction);
+
+        // the overload without a status still throws
+        BOOST_REQUIRE_THROW(vm->exec(gas, extVm, OnOpFunc{}), RevertInstruction);
+    }
+
+    void testFailureIsReturnedAsStatus()
+    {
+        // jump(0)
+        code = fromHex("600056");
+
+        ExtVM extVm(state, envInfo, address, address, address, value, gasPrice, ref(inputData),
+            ref(code), sha3(code), depth, isCreate, staticCall);
+
+        evmc_status_code status = EVMC_SUCCESS;
+        owning_bytes_ref ret = vm->exec(gas, extVm, OnOpFunc{}, status);
+
+        BOOST_REQUIRE_EQUAL(status, EVMC_BAD_JUMP_DESTINATION);
+        BOOST_REQUIRE(ret.empty());
+        BOOST_REQUIRE(
+            toTransactionException(status) == TransactionException::BadJumpDestination);
+
+        BOOST_REQUIRE_THROW(vm->exec(gas, extVm, OnOpFunc{}), BadJumpDestination);
+    }
+
+    bytes inputData;
+};
 
 }  // namespace
 
@@ -370,4 +415,18 @@ BOOST_AUTO_TEST_CASE(AlethInterpreterExtCodeHashIgnoresHigh12Bytes)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_FIXTURE_TEST_SUITE(AlethInterpreterStatusSuite, AlethInterpreterStatusTestFixture)
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterRevertIsReturnedAsStatus)
+{
+    testRevertIsReturnedAsStatus();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterFailureIsReturnedAsStatus)
+{
+    testFailureIsReturnedAsStatus();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1228,6 +1228,108 @@ BOOST_AUTO_TEST_CASE(errorCodeTest)
     BOOST_CHECK(result.status_code == EVMC_BAD_JUMP_DESTINATION);
 }
 
+BOOST_AUTO_TEST_CASE(blockGasTest)
+{
+    dev::eth::EVMSchedule const& schedule = DefaultSchedule;
+    bytes data = fromHex("");
+    Address destination{KeyPair::create().address()};
+    Address caller = destination;
+    u256 value = 0;
+    int32_t depth = 0;
+    bool isCreate = false;
+    bool isStaticCall = false;
+    auto run = [&](bytes const& _code, int64_t _gas) {
+        evmc_result result = evmc.execute(
+            schedule, _code, data, destination, caller, value, _gas, depth, isCreate, isStaticCall);
+        auto ret = std::make_pair(result.status_code, result.gas_left);
+        if (result.release)
+            result.release(&result);
+        return ret;
+    };
+
+    // PUSH1 01 PUSH1 02 PUSH1 03 ADD DUP1 SWAP2 PUSH1 00 MSTORE PUSH1 20 PUSH1 00 RETURN
+    // runs the fused PUSH ADD, DUP SWAP and PUSH MSTORE; 33 gas whether precharged or not
+    bytes code = fromHex("60016002600301809160005260206000f3");
+    BOOST_CHECK(run(code, 1000) == std::make_pair(EVMC_SUCCESS, int64_t(1000 - 33)));
+    BOOST_CHECK(run(code, 33) == std::make_pair(EVMC_SUCCESS, int64_t(0)));
+    BOOST_CHECK_EQUAL(run(code, 32).first, EVMC_OUT_OF_GAS);
+
+    // PUSH1 01 ADD: the failing instruction decides the status as with per instruction checks
+    code = fromHex("600101");
+    BOOST_CHECK_EQUAL(run(code, 3).first, EVMC_STACK_UNDERFLOW);
+    BOOST_CHECK_EQUAL(run(code, 2).first, EVMC_OUT_OF_GAS);
+
+    // PUSH1 03 JUMPDEST PUSH1 01 SWAP1 SUB DUP1 PUSH1 02 JUMPI STOP
+    // three rounds of a PUSH JUMPI loop: 3 + 3 * (1 + 3 + 3 + 3 + 3 + 3 + 10)
+    code = fromHex("60035b600190038060025700");
+    BOOST_CHECK(run(code, 1000) == std::make_pair(EVMC_SUCCESS, int64_t(1000 - 81)));
+    BOOST_CHECK_EQUAL(run(code, 80).first, EVMC_OUT_OF_GAS);
+
+    // PUSH1 06 JUMP: PUSH JUMP onto a PUSH1 argument is a bad jump, not a JUMPDEST
+    code = fromHex("6006566000605b");
+    BOOST_CHECK_EQUAL(run(code, 1000).first, EVMC_BAD_JUMP_DESTINATION);
+}
+
+BOOST_AUTO_TEST_CASE(reuseVMTest)
+{
+    dev::eth::EVMSchedule const& schedule = DefaultSchedule;
+    bytes data = fromHex("");
+    Address destination{KeyPair::create().address()};
+    Address caller = destination;
+    u256 value = 0;
+    int64_t gas = 1000000;
+    int32_t depth = 0;
+    bool isCreate = false;
+    bool isStaticCall = false;
+
+    // PUSH1 2a PUSH2 07e0 MSTORE PUSH1 20 PUSH1 00 RETURN
+    // a small output is copied, the VM keeps its 2KB memory for the next call
+    bytes storeCode = fromHex("602a6107e05260206000f3");
+    // PUSH2 07e0 MLOAD PUSH1 00 MSTORE PUSH1 20 PUSH1 00 RETURN
+    bytes loadCode = fromHex("6107e05160005260206000f3");
+    // PUSH1 2a PUSH2 07e0 MSTORE PUSH2 0800 PUSH1 00 RETURN
+    // a large output takes the memory of the VM over
+    bytes largeCode = fromHex("602a6107e0526108006000f3");
+
+    evmc_result first = evmc.execute(
+        schedule, storeCode, data, destination, caller, value, gas, depth, isCreate, isStaticCall);
+    BOOST_CHECK(first.status_code == EVMC_SUCCESS);
+    for (size_t i = 0; i < 2; i++)
+    {
+        // the pooled VM must start with empty memory and charge its expansion again
+        evmc_result load = evmc.execute(schedule, loadCode, data, destination, caller, value, gas,
+            depth, isCreate, isStaticCall);
+        BOOST_CHECK(load.status_code == EVMC_SUCCESS);
+        BOOST_CHECK(bytesConstRef(load.output_data, load.output_size).toBytes() == bytes(32, 0));
+        if (load.release)
+            load.release(&load);
+
+        evmc_result store = evmc.execute(schedule, storeCode, data, destination, caller, value, gas,
+            depth, isCreate, isStaticCall);
+        BOOST_CHECK(store.status_code == EVMC_SUCCESS);
+        BOOST_CHECK_EQUAL(store.gas_left, first.gas_left);
+        if (store.release)
+            store.release(&store);
+    }
+    if (first.release)
+        first.release(&first);
+
+    evmc_result large = evmc.execute(
+        schedule, largeCode, data, destination, caller, value, gas, depth, isCreate, isStaticCall);
+    BOOST_CHECK(large.status_code == EVMC_SUCCESS);
+    BOOST_REQUIRE_EQUAL(large.output_size, 0x800);
+    BOOST_CHECK_EQUAL(large.output_data[0x7ff], 0x2a);
+
+    // the output buffer can be taken over without a copy
+    uint8_t const* outputData = large.output_data;
+    bytes output;
+    BOOST_CHECK(takeInterpreterOutput(large, output));
+    BOOST_CHECK(output.data() == outputData);
+    BOOST_CHECK(large.release == nullptr);
+    BOOST_CHECK_EQUAL(output.size(), 0x800);
+    BOOST_CHECK_EQUAL(output[0x7ff], 0x2a);
+    BOOST_CHECK(!takeInterpreterOutput(large, output));
+}
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,171 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief unit test of the interpreter's uint256 against u256
+ *
+ * @file Uint256Test.cpp
+ * @date 2018-12-10
+ */
+
+#include <libdevcore/FixedHash.h>
+#include <libinterpreter/Uint256.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace dev
+{
+namespace test
+{
+class Uint256Fixture : TestOutputHelperFixture
+{
+public:
+    Uint256Fixture() : rng(2018)
+    {
+        u256 const max = ~u256(0);
+        u256 const minSigned = u256(1) << 255;
+        for (u256 v : {u256(0), u256(1), u256(2), u256(255), u256(256), max, max - 1, minSigned,
+                 minSigned - 1, minSigned + 1, u256(std::numeric_limits<uint64_t>::max()),
+                 u256(std::numeric_limits<uint64_t>::max()) + 1, (u256(1) << 128) - 1,
+                 u256(1) << 128, (u256(1) << 192) + 3})
+            values.push_back(v);
+        for (size_t i = 0; i < 200; i++)
+        {
+            // random values of 1 to 4 significant limbs
+            u256 v = 0;
+            for (size_t limbs = 1 + rng() % 4; limbs > 0; limbs--)
+                v = (v << 64) | rng();
+            values.push_back(v);
+        }
+    }
+
+    std::mt19937_64 rng;
+    std::vector<u256> values;
+};
+
+BOOST_FIXTURE_TEST_SUITE(Uint256Test, Uint256Fixture)
+
+BOOST_AUTO_TEST_CASE(conversion)
+{
+    for (auto const& v : values)
+    {
+        BOOST_CHECK(toU256(fromU256(v)) == v);
+        h256 h(v);
+        uint256 fromBytes = uint256::fromBigEndian(h.data());
+        BOOST_CHECK(fromBytes == fromU256(v));
+        h256 back;
+        fromBytes.toBigEndian(back.data());
+        BOOST_CHECK(back == h);
+        BOOST_CHECK_EQUAL(fromBytes.countLeadingZeros(), h.firstBitSet());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(arithmetic)
+{
+    for (auto const& a : values)
+        for (auto const& b : values)
+        {
+            uint256 x = fromU256(a);
+            uint256 y = fromU256(b);
+            BOOST_CHECK(toU256(x + y) == u256(a + b));
+            BOOST_CHECK(toU256(x - y) == u256(a - b));
+            BOOST_CHECK(toU256(x * y) == u256(a * b));
+            BOOST_CHECK(toU256(x / y) == (b ? u256(a / b) : u256(0)));
+            BOOST_CHECK(toU256(x % y) == (b ? u256(a % b) : u256(0)));
+            BOOST_CHECK_EQUAL(x < y, a < b);
+            BOOST_CHECK_EQUAL(x == y, a == b);
+            BOOST_CHECK_EQUAL(slt(x, y), u2s(a) < u2s(b));
+            BOOST_CHECK_EQUAL(sgt(x, y), u2s(a) > u2s(b));
+            if (b)
+            {
+                BOOST_CHECK(toU256(sdiv(x, y)) == s2u(s256(s512(u2s(a)) / s512(u2s(b)))));
+                BOOST_CHECK(toU256(smod(x, y)) == s2u(s256(s512(u2s(a)) % s512(u2s(b)))));
+            }
+        }
+}
+
+BOOST_AUTO_TEST_CASE(modular)
+{
+    for (size_t i = 0; i < 20000; i++)
+    {
+        u256 const& a = values[rng() % values.size()];
+        u256 const& b = values[rng() % values.size()];
+        u256 const& m = values[rng() % values.size()];
+        uint256 x = fromU256(a);
+        uint256 y = fromU256(b);
+        uint256 z = fromU256(m);
+        BOOST_CHECK(toU256(addmod(x, y, z)) == (m ? u256((u512(a) + u512(b)) % m) : u256(0)));
+        BOOST_CHECK(toU256(mulmod(x, y, z)) == (m ? u256((u512(a) * u512(b)) % m) : u256(0)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(exponent)
+{
+    for (auto const& a : values)
+    {
+        u256 expected = 1;
+        for (unsigned e = 0; e < 40; e++)
+        {
+            BOOST_CHECK(toU256(exp256(fromU256(a), uint256(e))) == expected);
+            expected *= a;
+        }
+    }
+    // the exponent is reduced by nothing, only the result wraps
+    BOOST_CHECK(exp256(uint256(2), uint256(255)) == uint256(1) << 255);
+    BOOST_CHECK(exp256(uint256(2), uint256(256)).isZero());
+    BOOST_CHECK(exp256(uint256(3), ~uint256()) == fromU256(boost::multiprecision::powm(
+                                                      u512(3), u512(~u256(0)), u512(1) << 256)
+                                                      .convert_to<u256>()));
+}
+
+BOOST_AUTO_TEST_CASE(bitwise)
+{
+    for (auto const& a : values)
+    {
+        uint256 x = fromU256(a);
+        BOOST_CHECK(toU256(~x) == u256(~a));
+        for (unsigned shift : {0u, 1u, 63u, 64u, 65u, 127u, 128u, 200u, 255u, 256u, 300u})
+        {
+            BOOST_CHECK(toU256(x << shift) == (shift < 256 ? u256(a << shift) : u256(0)));
+            BOOST_CHECK(toU256(x >> shift) == (shift < 256 ? u256(a >> shift) : u256(0)));
+
+            s256 signedShift = shift < 256 ? s256(u2s(a) >> shift) : (u2s(a) < 0 ? -1 : 0);
+            BOOST_CHECK(toU256(sar(x, uint256(shift))) == s2u(signedShift));
+        }
+        for (unsigned i = 0; i < 34; i++)
+        {
+            u256 expected = i < 32 ? u256((a >> (8 * (31 - i))) & 0xff) : u256(0);
+            BOOST_CHECK(toU256(byteAt(x, uint256(i))) == expected);
+
+            u256 extended = a;
+            if (i < 31)
+            {
+                unsigned testBit = i * 8 + 7;
+                u256 mask = (u256(1) << testBit) - 1;
+                extended = boost::multiprecision::bit_test(a, testBit) ? a | ~mask : a & mask;
+            }
+            BOOST_CHECK(toU256(signExtend(uint256(i), x)) == extended);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace dev
@@ -88,6 +88,13 @@ void checkParam(std::shared_ptr<LedgerParam> param)
     /// check state DB param
     BOOST_CHECK(param->dbType() == "AMDB");
     BOOST_CHECK(param->enableMpt() == true);
+    BOOST_CHECK(param->mutableStorageParam().historyBlocks == 1000);
+    BOOST_CHECK(param->mutableStorageParam().blockStore == true);
+    BOOST_CHECK(param->mutableStorageParam().blocksPerSegment == 5000);
+    BOOST_CHECK(param->mutableStorageParam().keepBlocks == 0);
+    BOOST_CHECK(param->mutableStorageParam().cacheSize == 256);
+    BOOST_CHECK(param->mutableStorageParam().bloomFilterBits == 0);
+    BOOST_CHECK(param->mutableStorageParam().writeBufferSize == 32);
 }
 /// test initConfig
 BOOST_AUTO_TEST_CASE(testInitConfig)
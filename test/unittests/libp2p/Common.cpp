@@ -24,6 +24,7 @@
 #include <libp2p/Common.h>
 #include <test/tools/libutils/TestOutputHelper.h>
 #include <boost/test/unit_test.hpp>
+#include <random>
 
 using namespace dev;
 using namespace dev::p2p;
@@ -238,6 +239,76 @@ BOOST_AUTO_TEST_CASE(testNodeSpec)
     BOOST_CHECK(node_spec2.tcpPort() == port);
     BOOST_CHECK(node_spec2.udpPort() == port);
 }
+/// test the payload compression of Message
+BOOST_AUTO_TEST_CASE(testMessageCompress)
+{
+    Message::Ptr msg = std::make_shared<Message>();
+    msg->setProtocolID(3);
+    msg->setPacketType(2);
+    msg->setSeq(7);
+    std::string text;
+    for (size_t i = 0; i < 512; i++)
+        text += "0x60806040526004361061004c576000357c01000000000000000000000000";
+    msg->setBuffer(std::make_shared<bytes>(text.begin(), text.end()));
+
+    /// compression is disabled by default
+    bytes raw;
+    msg->encode(raw);
+    BOOST_CHECK_EQUAL(raw.size(), Message::HEADER_LENGTH + text.size());
+
+    Message::setCompressThreshold(1024);
+    CompressStatistics& stat = Message::compressStatistics();
+    uint64_t packets = stat.compressedPackets;
+    /// a peer that did not announce CompressSupport gets the raw payload
+    bytes unannounced;
+    msg->encode(unannounced);
+    BOOST_CHECK(unannounced == raw);
+    BOOST_CHECK_EQUAL(stat.compressedPackets, packets);
+    bytes compressed;
+    msg->encode(compressed, true);
+    BOOST_CHECK(compressed.size() < raw.size() / 10);
+    BOOST_CHECK_EQUAL(stat.compressedPackets, packets + 1);
+
+    Message::Ptr decoded = std::make_shared<Message>();
+    BOOST_CHECK_EQUAL(decoded->decode(compressed.data(), compressed.size() - 1), 0);
+    BOOST_CHECK_EQUAL(decoded->decode(compressed.data(), compressed.size()), compressed.size());
+    BOOST_CHECK_EQUAL(decoded->protocolID(), 3);
+    BOOST_CHECK_EQUAL(decoded->packetType(), 2);
+    BOOST_CHECK_EQUAL(decoded->seq(), 7);
+    BOOST_CHECK(*decoded->buffer() == *msg->buffer());
+    BOOST_CHECK_EQUAL(decoded->decode(raw.data(), raw.size()), raw.size());
+    BOOST_CHECK(*decoded->buffer() == *msg->buffer());
+
+    /// small or incompressible payloads are sent raw
+    bytes encoded;
+    msg->setBuffer(std::make_shared<bytes>(100, 0x2a));
+    msg->encode(encoded, true);
+    BOOST_CHECK_EQUAL(encoded.size(), Message::HEADER_LENGTH + 100);
+    std::mt19937 generator(1);
+    bytes noise(4096);
+    for (auto& b : noise)
+        b = (byte)generator();
+    msg->setBuffer(std::make_shared<bytes>(noise));
+    msg->encode(encoded, true);
+    BOOST_CHECK_EQUAL(encoded.size(), Message::HEADER_LENGTH + noise.size());
+    /// so are payloads a peer could not inflate
+    msg->setBuffer(std::make_shared<bytes>(Message::MAX_LENGTH + 1, 0x2a));
+    msg->encode(encoded, true);
+    BOOST_CHECK_EQUAL(encoded.size(), Message::HEADER_LENGTH + Message::MAX_LENGTH + 1);
+
+    /// a corrupted or oversized stream is a protocol error
+    compressed[Message::HEADER_LENGTH + 8] ^= 0xff;
+    BOOST_CHECK_EQUAL(decoded->decode(compressed.data(), compressed.size()), PACKET_ERROR);
+    compressed[Message::HEADER_LENGTH + 8] ^= 0xff;
+    compressed[Message::HEADER_LENGTH + 3]--;
+    BOOST_CHECK_EQUAL(decoded->decode(compressed.data(), compressed.size()), PACKET_ERROR);
+    /// an inflated length above MAX_LENGTH is refused before anything is inflated
+    uint32_t bomb = htonl(Message::MAX_LENGTH + 1);
+    memcpy(&compressed[Message::HEADER_LENGTH], &bomb, sizeof(bomb));
+    BOOST_CHECK_EQUAL(decoded->decode(compressed.data(), compressed.size()), PACKET_ERROR);
+    Message::setCompressThreshold(0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
@@ -0,0 +1,169 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief: unit test for the priorities, the back-pressure and the gossip load shedding of
+ * MessageDispatcher
+ *
+ * @file MessageDispatcher.cpp
+ * @date 2018-12-24
+ */
+#include <libethcore/Protocol.h>
+#include <libp2p/MessageDispatcher.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+#include <future>
+
+using namespace dev;
+using namespace dev::p2p;
+using namespace dev::eth;
+namespace dev
+{
+namespace test
+{
+/// a dispatcher on a single thread, which block() keeps busy until release()
+class DispatcherFixture : public TestOutputHelperFixture
+{
+public:
+    DispatcherFixture()
+    {
+        m_threadPool = std::make_shared<ThreadPool>("DispatcherTest", 1);
+        m_dispatcher = std::make_shared<MessageDispatcher>(m_threadPool, 4);
+    }
+
+    void block()
+    {
+        auto running = std::make_shared<std::promise<void>>();
+        auto released = m_released.get_future().share();
+        m_dispatcher->push(getGroupProtoclID(1, ProtocolID::PBFT), [running, released]() {
+            running->set_value();
+            released.wait();
+        });
+        running->get_future().wait();
+    }
+    void release() { m_released.set_value(); }
+
+    /// wait for the handlers pushed so far
+    void drain()
+    {
+        auto done = std::make_shared<std::promise<void>>();
+        m_dispatcher->push(
+            getGroupProtoclID(1, ProtocolID::TxPool), [done]() { done->set_value(); });
+        done->get_future().wait();
+    }
+
+    std::shared_ptr<ThreadPool> m_threadPool;
+    MessageDispatcher::Ptr m_dispatcher;
+    std::promise<void> m_released;
+};
+
+BOOST_FIXTURE_TEST_SUITE(MessageDispatcherTest, DispatcherFixture)
+
+BOOST_AUTO_TEST_CASE(testPriority)
+{
+    BOOST_CHECK_EQUAL(MessageDispatcher::priority(getGroupProtoclID(1, ProtocolID::PBFT)), 0);
+    BOOST_CHECK_EQUAL(MessageDispatcher::priority(-getGroupProtoclID(2, ProtocolID::PBFT)), 0);
+    BOOST_CHECK_EQUAL(MessageDispatcher::priority(getGroupProtoclID(1, ProtocolID::BlockSync)), 1);
+    BOOST_CHECK_EQUAL(MessageDispatcher::priority(ProtocolID::AMOP), 1);
+    BOOST_CHECK_EQUAL(MessageDispatcher::priority(getGroupProtoclID(1, ProtocolID::TxPool)), 2);
+
+    /// queued behind a busy thread, consensus runs first and gossip last
+    block();
+    std::vector<int> order;
+    m_dispatcher->push(
+        getGroupProtoclID(1, ProtocolID::TxPool), [&]() { order.push_back(ProtocolID::TxPool); });
+    m_dispatcher->push(getGroupProtoclID(1, ProtocolID::BlockSync),
+        [&]() { order.push_back(ProtocolID::BlockSync); });
+    m_dispatcher->push(
+        getGroupProtoclID(1, ProtocolID::PBFT), [&]() { order.push_back(ProtocolID::PBFT); });
+    release();
+    drain();
+    BOOST_REQUIRE_EQUAL(order.size(), 3);
+    BOOST_CHECK_EQUAL(order[0], ProtocolID::PBFT);
+    BOOST_CHECK_EQUAL(order[1], ProtocolID::BlockSync);
+    BOOST_CHECK_EQUAL(order[2], ProtocolID::TxPool);
+}
+
+BOOST_AUTO_TEST_CASE(testBackPressure)
+{
+    PROTOCOL_ID protocolID = getGroupProtoclID(1, ProtocolID::BlockSync);
+    block();
+    for (size_t i = 0; i < 3; i++)
+        BOOST_CHECK(m_dispatcher->push(protocolID, []() {}));
+    BOOST_CHECK(!m_dispatcher->push(protocolID, []() {}));
+
+    std::promise<void> resumed;
+    m_dispatcher->onDrained(protocolID, [&]() { resumed.set_value(); });
+    auto future = resumed.get_future();
+    BOOST_CHECK(future.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready);
+    release();
+    future.wait();
+    drain();
+
+    /// a drained queue resumes at once
+    bool resumedNow = false;
+    m_dispatcher->onDrained(protocolID, [&]() { resumedNow = true; });
+    BOOST_CHECK(resumedNow);
+
+    /// the queues of PBFT, BlockSync and, pushed by drain(), TxPool
+    auto status = m_dispatcher->status();
+    BOOST_REQUIRE_EQUAL(status.size(), 3);
+    BOOST_CHECK_EQUAL(status[1].protocolID, protocolID);
+    BOOST_CHECK_EQUAL(status[1].priority, 1);
+    BOOST_CHECK_EQUAL(status[1].depth, 0);
+    BOOST_CHECK_EQUAL(status[1].maxDepth, 4);
+    BOOST_CHECK_EQUAL(status[1].dispatched, 4);
+    BOOST_CHECK_EQUAL(status[1].paused, 1);
+    BOOST_CHECK_EQUAL(status[1].dropped, 0);
+    BOOST_CHECK(status[1].maxWaitMicroseconds > 0);
+}
+
+BOOST_AUTO_TEST_CASE(testGossipDropsOldest)
+{
+    PROTOCOL_ID protocolID = getGroupProtoclID(1, ProtocolID::TxPool);
+    BOOST_CHECK(MessageDispatcher::lossy(protocolID));
+    BOOST_CHECK(!MessageDispatcher::lossy(getGroupProtoclID(1, ProtocolID::PBFT)));
+    BOOST_CHECK(!MessageDispatcher::lossy(getGroupProtoclID(1, ProtocolID::BlockSync)));
+
+    /// a full gossip queue never pauses its sender, it drops its oldest handlers
+    block();
+    std::vector<size_t> run;
+    for (size_t i = 0; i < 6; i++)
+        BOOST_CHECK(m_dispatcher->push(protocolID, [&run, i]() { run.push_back(i); }));
+    /// and the consensus messages read behind the flood still go first
+    bool consensusFirst = false;
+    BOOST_CHECK(m_dispatcher->push(
+        getGroupProtoclID(1, ProtocolID::PBFT), [&]() { consensusFirst = run.empty(); }));
+    /// pushed to the full queue too, dropping one more
+    auto done = std::make_shared<std::promise<void>>();
+    BOOST_CHECK(m_dispatcher->push(protocolID, [done]() { done->set_value(); }));
+    release();
+    done->get_future().wait();
+    BOOST_CHECK(consensusFirst);
+    BOOST_CHECK(run == std::vector<size_t>({3, 4, 5}));
+
+    auto status = m_dispatcher->status();
+    BOOST_REQUIRE_EQUAL(status.size(), 2);
+    BOOST_CHECK_EQUAL(status[1].protocolID, protocolID);
+    BOOST_CHECK_EQUAL(status[1].depth, 0);
+    BOOST_CHECK_EQUAL(status[1].maxDepth, 4);
+    BOOST_CHECK_EQUAL(status[1].dispatched, 4);
+    BOOST_CHECK_EQUAL(status[1].dropped, 3);
+    BOOST_CHECK_EQUAL(status[1].paused, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace dev
@@ -0,0 +1,199 @@
+/**
+ * @CopyRight:
+ * FISCO-BCOS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FISCO-BCOS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FISCO-BCOS.  If not, see <http://www.gnu.org/licenses/>
+ * (c) 2016-2018 fisco-dev contributors.
+ *
+ * @brief: unit test for the session lookup, group peers, multicast and requests of Service
+ *
+ * @file Service.cpp
+ * @date 2018-12-12
+ */
+#include "FakeHost.h"
+#include <libethcore/Protocol.h>
+#include <libp2p/Service.h>
+#include <test/tools/libutils/TestOutputHelper.h>
+#include <boost/test/unit_test.hpp>
+using namespace dev;
+using namespace dev::p2p;
+namespace dev
+{
+namespace test
+{
+/// keeps the buffers sent to it and the callbacks of the requests
+class RecordingSession : public FakeSessionForHost
+{
+public:
+    RecordingSession(Host* _server, std::shared_ptr<Peer> const& _n, PeerSessionInfo _info)
+      : FakeSessionForHost(_server, _n, _info)
+    {}
+    void send(std::shared_ptr<bytes> _msg) override { m_sent.push_back(_msg); }
+    bool addSeq2Callback(uint32_t seq, ResponseCallback::Ptr const& callback) override
+    {
+        m_callbacks[seq] = callback;
+        return true;
+    }
+    ResponseCallback::Ptr getCallbackBySeq(uint32_t seq) override
+    {
+        auto it = m_callbacks.find(seq);
+        return it == m_callbacks.end() ? nullptr : it->second;
+    }
+    bool eraseCallbackBySeq(uint32_t seq) override { return m_callbacks.erase(seq) > 0; }
+    std::vector<std::shared_ptr<bytes>> m_sent;
+    std::map<uint32_t, ResponseCallback::Ptr> m_callbacks;
+};
+
+class ServiceFixture : public TestOutputHelperFixture
+{
+public:
+    ServiceFixture()
+    {
+        m_hostPtr = createFakeHost("2.0", "127.0.0.1", 30304);
+        m_host = std::shared_ptr<Host>(m_hostPtr);
+        m_service = std::make_shared<Service>(m_host, std::make_shared<P2PMsgHandler>());
+        for (size_t i = 0; i < 3; i++)
+            m_sessions.push_back(addSession(30305 + i));
+    }
+
+    std::shared_ptr<RecordingSession> addSession(uint16_t _port)
+    {
+        NodeIPEndpoint endpoint(bi::address::from_string("127.0.0.1"), _port, _port);
+        KeyPair keyPair = KeyPair::create();
+        std::shared_ptr<Peer> peer = std::make_shared<Peer>(keyPair.pub(), endpoint);
+        PeerSessionInfo info(
+            {keyPair.pub(), endpoint.address.to_string(), chrono::steady_clock::duration(), 0});
+        auto session = std::make_shared<RecordingSession>(m_hostPtr, peer, info);
+        session->start();
+        m_hostPtr->setSessions(session);
+        return session;
+    }
+
+    Message::Ptr message()
+    {
+        Message::Ptr msg = std::make_shared<Message>();
+        msg->setProtocolID(getGroupProtoclID(1, dev::eth::ProtocolID::PBFT));
+        msg->setBuffer(std::make_shared<bytes>(100, 0x2a));
+        return msg;
+    }
+
+    FakeHost* m_hostPtr;
+    std::shared_ptr<Host> m_host;
+    std::shared_ptr<Service> m_service;
+    std::vector<std::shared_ptr<RecordingSession>> m_sessions;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ServiceTest, ServiceFixture)
+
+BOOST_AUTO_TEST_CASE(testSessionInfosByProtocolID)
+{
+    PROTOCOL_ID protocolID = getGroupProtoclID(1, dev::eth::ProtocolID::PBFT);
+    BOOST_CHECK(m_service->sessionInfosByProtocolID(protocolID).empty());
+
+    /// one member is not connected
+    std::map<GROUP_ID, h512s> groups;
+    groups[1] = h512s{m_sessions[0]->id(), m_sessions[1]->id(), KeyPair::create().pub()};
+    m_service->setGroupID2NodeList(groups);
+    SessionInfos infos = m_service->sessionInfosByProtocolID(protocolID);
+    BOOST_REQUIRE_EQUAL(infos.size(), 2);
+    BOOST_CHECK(infos[0].nodeID == m_sessions[0]->id());
+    BOOST_CHECK(infos[1].nodeID == m_sessions[1]->id());
+    BOOST_CHECK_EQUAL(m_service->sessionInfosByProtocolID(protocolID).size(), 2);
+
+    /// the cached list follows session and member changes
+    m_hostPtr->disconnectByNodeId(m_sessions[1]->id());
+    infos = m_service->sessionInfosByProtocolID(protocolID);
+    BOOST_REQUIRE_EQUAL(infos.size(), 1);
+    BOOST_CHECK(infos[0].nodeID == m_sessions[0]->id());
+    groups[1].push_back(m_sessions[2]->id());
+    m_service->setGroupID2NodeList(groups);
+    BOOST_CHECK_EQUAL(m_service->sessionInfosByProtocolID(protocolID).size(), 2);
+    BOOST_CHECK(m_service->sessionInfosByProtocolID(
+                    getGroupProtoclID(2, dev::eth::ProtocolID::PBFT))
+                    .empty());
+}
+
+BOOST_AUTO_TEST_CASE(testMulticast)
+{
+    /// one buffer, queued once on each connected node of the list
+    NodeIDs nodeIDs{m_sessions[0]->id(), KeyPair::create().pub(), m_sessions[2]->id()};
+    m_service->asyncMulticastMessageByNodeIDList(nodeIDs, message());
+    BOOST_REQUIRE_EQUAL(m_sessions[0]->m_sent.size(), 1);
+    BOOST_CHECK(m_sessions[1]->m_sent.empty());
+    BOOST_REQUIRE_EQUAL(m_sessions[2]->m_sent.size(), 1);
+    BOOST_CHECK(m_sessions[0]->m_sent[0] == m_sessions[2]->m_sent[0]);
+    BOOST_CHECK_EQUAL(m_sessions[0]->m_sent[0]->size(), Message::HEADER_LENGTH + 100);
+
+    m_service->asyncSendMessageByNodeID(m_sessions[1]->id(), message());
+    BOOST_REQUIRE_EQUAL(m_sessions[1]->m_sent.size(), 1);
+    BOOST_CHECK(*m_sessions[1]->m_sent[0] != *m_sessions[0]->m_sent[0]);
+    m_service->asyncSendMessageByNodeID(KeyPair::create().pub(), message());
+    for (auto const& session : m_sessions)
+        BOOST_CHECK_EQUAL(session->m_sent.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testRequestByNodeID)
+{
+    /// no timeout: the request waits for its response only
+    dev::p2p::Options options;
+    Message::Ptr request = message();
+    ResponseFuture::Ptr future = m_service->requestByNodeID(m_sessions[0]->id(), request, options);
+    BOOST_REQUIRE_EQUAL(m_sessions[0]->m_sent.size(), 1);
+    auto callback = m_sessions[0]->getCallbackBySeq(request->seq());
+    BOOST_REQUIRE(callback);
+    BOOST_CHECK(!future->waitFor(std::chrono::milliseconds(0)));
+
+    Message::Ptr received;
+    future->then([&](P2PException e, Message::Ptr response) {
+        BOOST_CHECK_EQUAL(e.errorCode(), 0);
+        received = response;
+    });
+    Message::Ptr response = message();
+    callback->callbackFunc(P2PException(), response);
+    BOOST_CHECK(received == response);
+    BOOST_CHECK(future->waitFor(std::chrono::milliseconds(0)));
+    BOOST_CHECK(future->get() == response);
+    /// a late answer or a cancel change nothing once it is complete
+    callback->callbackFunc(P2PException(P2PExceptionType::NetworkTimeout,
+                               g_P2PExceptionMsg[P2PExceptionType::NetworkTimeout]),
+        Message::Ptr());
+    future->cancel();
+    BOOST_CHECK(future->get() == response);
+    bool late = false;
+    future->then([&](P2PException, Message::Ptr _response) { late = (_response == received); });
+    BOOST_CHECK(late);
+
+    /// cancel drops the callback of the request
+    request = message();
+    future = m_service->requestByNodeID(m_sessions[1]->id(), request, options);
+    BOOST_REQUIRE(m_sessions[1]->getCallbackBySeq(request->seq()));
+    future->cancel();
+    BOOST_CHECK(!m_sessions[1]->getCallbackBySeq(request->seq()));
+    BOOST_CHECK_THROW(future->get(), P2PException);
+
+    /// not connected: the future fails at once instead of waiting for a timeout
+    future = m_service->requestByNodeID(KeyPair::create().pub(), message(), options);
+    BOOST_CHECK(future->waitFor(std::chrono::milliseconds(0)));
+    try
+    {
+        future->get();
+        BOOST_ERROR("request to an unknown node should fail");
+    }
+    catch (P2PException& e)
+    {
+        BOOST_CHECK_EQUAL(e.errorCode(), P2PExceptionType::Disconnect);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace dev
@@ -80,6 +80,11 @@ public:
             m_asyncSend[nodeID] = 1;
         m_asyncSendMsgs[nodeID] = message;
     }
+    void asyncMulticastMessageByNodeIDList(NodeIDs const& nodeIDs, Message::Ptr message) override
+    {
+        for (auto const& nodeID : nodeIDs)
+            asyncSendMessageByNodeID(nodeID, message);
+    }
     size_t getAsyncSendSizeByNodeID(NodeID const& nodeID)
     {
         if (!m_asyncSend.count(nodeID))
@@ -130,6 +135,7 @@ public:
 
         block.setBlockHeader(blockHeader);
         block.setTransactions(transactions);
+        block.setTransactionReceipts(TransactionReceipts{getTransactionReceiptByHash(h256())});
 
         m_blockHash[blockHash] = 0;
         m_blockChain.push_back(std::make_shared<Block>(block));
@@ -264,6 +270,11 @@ public:
     {
         return transactions;
     }
+    virtual dev::eth::Transactions topTransactionsSince(uint64_t const& _limit, uint64_t& _cursor,
+        std::function<bool(dev::eth::Transaction const&)> const& _admit = nullptr) override
+    {
+        return transactions;
+    }
     virtual bool drop(h256 const& _txHash) override { return true; }
     virtual bool dropBlockTrans(dev::eth::Block const& block) override { return true; }
     virtual PROTOCOL_ID const& getProtocolId() const override { return protocolId; }
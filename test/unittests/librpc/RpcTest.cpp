@@ -22,11 +22,13 @@
 #include <jsonrpccpp/common/exception.h>
 #include <libdevcrypto/Common.h>
 #include <libethcore/CommonJS.h>
+#include <librpc/ModularServer.h>
 #include <librpc/Rpc.h>
 #include <test/tools/libutils/Common.h>
 #include <test/tools/libutils/TestOutputHelper.h>
 #include <test/unittests/libp2p/FakeHost.h>
 #include <boost/test/unit_test.hpp>
+#include <future>
 
 using namespace jsonrpc;
 using namespace dev;
@@ -37,6 +39,29 @@ namespace dev
 {
 namespace test
 {
+/// keeps the last response of the server
+class RecordingConnector : public AbstractServerConnector
+{
+public:
+    bool StartListening() override { return true; }
+    bool StopListening() override { return true; }
+    bool SendResponse(std::string const& _response, void*) override
+    {
+        m_response = _response;
+        return true;
+    }
+    std::string m_response;
+};
+
+/// the text jsonrpccpp writes for _value
+std::string fastWrite(Json::Value const& _value)
+{
+    Json::FastWriter writer;
+    std::string text = writer.write(_value);
+    text.pop_back();
+    return text;
+}
+
 class RpcTestFixure : public TestOutputHelperFixture
 {
 public:
@@ -95,6 +120,15 @@ BOOST_AUTO_TEST_CASE(testSyncPart)
     BOOST_CHECK_THROW(rpc->syncStatus(1), JsonRpcException);
 }
 
+BOOST_AUTO_TEST_CASE(testStorageStatus)
+{
+    /// the fake ledger has no leveldb storage
+    Json::Value status = rpc->storageStatus(0);
+    BOOST_CHECK(status.isObject());
+    BOOST_CHECK_EQUAL(status.size(), 0);
+    BOOST_CHECK_THROW(rpc->storageStatus(1), JsonRpcException);
+}
+
 BOOST_AUTO_TEST_CASE(testP2pPart)
 {
     std::string s = rpc->version();
@@ -111,6 +145,29 @@ BOOST_AUTO_TEST_CASE(testP2pPart)
 
     response = rpc->groupList();
     BOOST_CHECK(response.size() == 1);
+
+    /// the host is not started, its handlers have no queue yet
+    response = rpc->queueStatus();
+    BOOST_CHECK(response.isArray());
+    BOOST_CHECK_EQUAL(response.size(), 0);
+    m_host->setThreadPool(std::make_shared<ThreadPool>("RpcTestPool", 1));
+    auto done = std::make_shared<std::promise<void>>();
+    PROTOCOL_ID protocolID = getGroupProtoclID(1, dev::eth::ProtocolID::PBFT);
+    m_host->dispatcher()->push(protocolID, [done]() { done->set_value(); });
+    done->get_future().wait();
+    response = rpc->queueStatus();
+    BOOST_REQUIRE_EQUAL(response.size(), 1);
+    BOOST_CHECK_EQUAL(response[0]["protocolID"].asInt(), protocolID);
+    BOOST_CHECK_EQUAL(response[0]["priority"].asUInt(), 0);
+    BOOST_CHECK_EQUAL(response[0]["depth"].asUInt64(), 0);
+    BOOST_CHECK_EQUAL(response[0]["dispatched"].asUInt64(), 1);
+    BOOST_CHECK_EQUAL(response[0]["dropped"].asUInt64(), 0);
+
+    response = rpc->compressStatus();
+    BOOST_CHECK_EQUAL(response["compressThreshold"].asUInt64(), Message::compressThreshold());
+    BOOST_CHECK_EQUAL(response["compressedPackets"].asUInt64(),
+        Message::compressStatistics().compressedPackets.load());
+    BOOST_CHECK(response.isMember("decompressMicroseconds"));
 }
 
 BOOST_AUTO_TEST_CASE(testGetBlockByHash)
@@ -323,6 +380,11 @@ BOOST_AUTO_TEST_CASE(testCall)
     BOOST_CHECK(response == "0x");
 
     BOOST_CHECK_THROW(rpc->call(1, request), JsonRpcException);
+
+    request["blockNumber"] = "0x0";
+    BOOST_CHECK(rpc->call(0, request) == "0x");
+    request["blockNumber"] = "0xffff";
+    BOOST_CHECK_THROW(rpc->call(0, request), JsonRpcException);
 }
 
 BOOST_AUTO_TEST_CASE(testSendRawTransaction)
@@ -341,6 +403,214 @@ BOOST_AUTO_TEST_CASE(testSendRawTransaction)
     BOOST_CHECK_THROW(rpc->sendRawTransaction(1, rlpStr), JsonRpcException);
 }
 
+BOOST_AUTO_TEST_CASE(testSendRawTransactions)
+{
+    std::string rlpStr =
+        "f8ef9f65f0d06e39dc3c08e32ac10a5070858962bc6c0f5760baca823f2d5582d03f85174876e7ff"
+        "8609184e729fff82020394d6f1a71052366dbae2f7ab2d5d5845e77965cf0d80b86448f85bce000000"
+        "000000000000000000000000000000000000000000000000000000001bf5bd8a9e7ba8b936ea704292"
+        "ff4aaa5797bf671fdc8526dcd159f23c1f5a05f44e9fa862834dc7cb4541558f2b4961dc39eaaf0af7"
+        "f7395028658d0e01b86a371ca00b2b3fabd8598fefdda4efdb54f626367fc68e1735a8047f0f1c4f84"
+        "0255ca1ea0512500bc29f4cfe18ee1c88683006d73e56c934100b8abf4d2334560e1d2f75e";
+    Json::Value rlps(Json::arrayValue);
+    rlps.append(rlpStr);
+    rlps.append("0xzz");
+    rlps.append(rlpStr);
+    Json::Value response = rpc->sendRawTransactions(0, rlps);
+    BOOST_REQUIRE_EQUAL(response.size(), 3);
+    BOOST_CHECK(response[0] == rpc->sendRawTransaction(0, rlpStr));
+    BOOST_CHECK(response[1].isNull());
+    BOOST_CHECK(response[2] == response[0]);
+
+    BOOST_CHECK_THROW(rpc->sendRawTransactions(1, rlps), JsonRpcException);
+    BOOST_CHECK_THROW(rpc->sendRawTransactions(0, Json::Value(rlpStr)), JsonRpcException);
+    /// one more than c_maxRawTransactions
+    Json::Value tooMany(Json::arrayValue);
+    for (unsigned i = 0; i < 1001; i++)
+        tooMany.append(rlpStr);
+    BOOST_CHECK_THROW(rpc->sendRawTransactions(0, tooMany), JsonRpcException);
+}
+
+BOOST_AUTO_TEST_CASE(testStreamingResponses)
+{
+    std::string blockHash = "0x067150c07dab4facb7160e075548007e067150c07dab4facb7160e075548007e";
+    for (bool includeTransactions : {true, false})
+    {
+        std::string response;
+        JsonWriter writer(response);
+        rpc->getBlockByHash(writer, 0, blockHash, includeTransactions);
+        BOOST_CHECK_EQUAL(
+            response, fastWrite(rpc->getBlockByHash(0, blockHash, includeTransactions)));
+
+        response.clear();
+        rpc->getBlockByNumber(writer, 0, "0x0", includeTransactions);
+        BOOST_CHECK_EQUAL(
+            response, fastWrite(rpc->getBlockByNumber(0, "0x0", includeTransactions)));
+    }
+    std::string response;
+    JsonWriter writer(response);
+    rpc->pendingTransactions(writer, 0);
+    BOOST_CHECK_EQUAL(response, fastWrite(rpc->pendingTransactions(0)));
+
+    BOOST_CHECK_THROW(rpc->getBlockByNumber(writer, 1, "0x0", false), JsonRpcException);
+    BOOST_CHECK_THROW(rpc->pendingTransactions(writer, 1), JsonRpcException);
+}
+
+BOOST_AUTO_TEST_CASE(testBlockRLP)
+{
+    Block block(jsToBytes(rpc->getBlockRLPByNumber(0, "0x0")));
+    BOOST_CHECK(block.headerHash() ==
+                h256("0x2d6d365ccaa099b44a85edac6e0f40666f707e1324db375eee52ed3227640a03"));
+    BOOST_CHECK_EQUAL(block.transactions().size(), 1);
+    BOOST_CHECK(block.transactions()[0].sha3() ==
+                h256("0x7536cf1286b5ce6c110cd4fea5c891467884240c9af366d678eb4191e1c31c6f"));
+
+    bytes receiptsRLP = jsToBytes(rpc->getReceiptsRLPByNumber(0, "0x0"));
+    RLP receipts(receiptsRLP);
+    BOOST_CHECK(receipts.isList());
+    BOOST_CHECK_EQUAL(receipts.itemCount(), 1);
+
+    BOOST_CHECK_THROW(rpc->getBlockRLPByNumber(1, "0x0"), JsonRpcException);
+    BOOST_CHECK_THROW(rpc->getReceiptsRLPByNumber(1, "0x0"), JsonRpcException);
+}
+
+BOOST_AUTO_TEST_CASE(testGetBlocksByRange)
+{
+    Json::Value response = rpc->getBlocksByRange(0, "0x0", "0x10", true);
+    BOOST_REQUIRE(response.isArray());
+    BOOST_REQUIRE_EQUAL(response.size(), 1);
+    BOOST_CHECK(response[0] == rpc->getBlockByNumber(0, "0x0", true));
+    BOOST_CHECK(rpc->getBlocksByRange(0, "0x0", "0x1", false)[0] ==
+                rpc->getBlockByNumber(0, "0x0", false));
+    BOOST_CHECK_EQUAL(rpc->getBlocksByRange(0, "0x1", "0x1", false).size(), 0);
+
+    std::string streamed;
+    JsonWriter writer(streamed);
+    rpc->getBlocksByRange(writer, 0, "0x0", "0x10", true);
+    BOOST_CHECK_EQUAL(streamed, fastWrite(response));
+
+    BOOST_CHECK_THROW(rpc->getBlocksByRange(0, "0x0", "0x0", false), JsonRpcException);
+    BOOST_CHECK_THROW(rpc->getBlocksByRange(0, "0x0", "0x65", false), JsonRpcException);
+    BOOST_CHECK_THROW(rpc->getBlocksByRange(1, "0x0", "0x1", false), JsonRpcException);
+}
+
+BOOST_AUTO_TEST_CASE(testGetBlockReceipts)
+{
+    std::string txHash = "0x7536cf1286b5ce6c110cd4fea5c891467884240c9af366d678eb4191e1c31c6f";
+    Json::Value response = rpc->getBlockReceipts(0, "0x0");
+    BOOST_REQUIRE(response.isArray());
+    BOOST_REQUIRE_EQUAL(response.size(), 1);
+    Json::Value receipt = rpc->getTransactionReceipt(0, txHash);
+    for (auto const& key : {"blockNumber", "contractAddress", "from", "gasUsed", "logsBloom",
+             "status", "to", "transactionHash", "transactionIndex"})
+        BOOST_CHECK(response[0][key] == receipt[key]);
+    BOOST_CHECK(response[0]["blockHash"].asString() ==
+                "0x2d6d365ccaa099b44a85edac6e0f40666f707e1324db375eee52ed3227640a03");
+    BOOST_REQUIRE_EQUAL(response[0]["logs"].size(), 1);
+    BOOST_CHECK(response[0]["logs"][0]["address"] == receipt["logs"][0]["address"]);
+    BOOST_CHECK(response[0]["logs"][0]["data"] == receipt["logs"][0]["data"]);
+    BOOST_CHECK(response[0]["logs"][0]["topics"].isArray());
+
+    /// the tree is built directly, the same as the streamed text
+    std::string streamed;
+    JsonWriter writer(streamed);
+    rpc->getBlockReceipts(writer, 0, "0x0");
+    BOOST_CHECK_EQUAL(streamed, fastWrite(response));
+
+    BOOST_CHECK_THROW(rpc->getBlockReceipts(1, "0x0"), JsonRpcException);
+}
+
+BOOST_AUTO_TEST_CASE(testStreamRequestHandler)
+{
+    ModularServer<Rpc> server(new Rpc(m_ledgerManager, m_service));
+    auto connector = new RecordingConnector();
+    server.addConnector(connector);
+
+    /// served by the streaming implementation
+    connector->OnRequest(
+        R"({"jsonrpc":"2.0","id":7,"method":"getBlockByNumber","params":[0,"0x0",true]})");
+    BOOST_CHECK_EQUAL(connector->m_response, "{\"id\":7,\"jsonrpc\":\"2.0\",\"result\":" +
+                                                 fastWrite(rpc->getBlockByNumber(0, "0x0", true)) +
+                                                 "}\n");
+    connector->OnRequest(
+        R"({"jsonrpc":"2.0","id":"a","method":"getBlockRLPByNumber","params":[0,"0x0"]})");
+    Json::Value response;
+    Json::Reader reader;
+    BOOST_REQUIRE(reader.parse(connector->m_response, response));
+    BOOST_CHECK(response["id"] == "a");
+    BOOST_CHECK(response["result"] == rpc->getBlockRLPByNumber(0, "0x0"));
+
+    /// parameters of other types are answered by jsonrpccpp
+    connector->OnRequest(
+        R"({"jsonrpc":"2.0","id":8,"method":"getBlockByNumber","params":["0","0x0",true]})");
+    BOOST_REQUIRE(reader.parse(connector->m_response, response));
+    BOOST_CHECK(!response["result"].isMember("hash"));
+    /// a failure is answered as the other methods answer theirs, the method is not run again
+    connector->OnRequest(
+        R"({"jsonrpc":"2.0","id":9,"method":"getBlockByNumber","params":[1,"0x0",true]})");
+    BOOST_REQUIRE(reader.parse(connector->m_response, response));
+    BOOST_CHECK(response["id"] == 9);
+    BOOST_CHECK(!response.isMember("error"));
+    BOOST_CHECK_EQUAL(response["result"]["ret_code"].asInt(), -1);
+    try
+    {
+        rpc->getBlockByNumber(1, "0x0", true);
+        BOOST_ERROR("getBlockByNumber of an unknown group did not throw");
+    }
+    catch (JsonRpcException const& e)
+    {
+        BOOST_CHECK_EQUAL(response["result"]["detail_info"].asString(),
+            std::string("callback getBlockByNumber exceptioned, error msg:") + e.what());
+    }
+    /// the same shape as a failure of a method jsonrpccpp answers
+    connector->OnRequest(R"({"jsonrpc":"2.0","id":11,"method":"blockNumber","params":[1]})");
+    Json::Value treeResponse;
+    BOOST_REQUIRE(reader.parse(connector->m_response, treeResponse));
+    BOOST_CHECK_EQUAL(treeResponse["result"]["ret_code"].asInt(), -1);
+    BOOST_CHECK(treeResponse["result"]["detail_info"].isString());
+    /// requests of other methods are handed over unparsed, whatever their parameters say
+    connector->OnRequest(
+        R"({"jsonrpc":"2.0","id":10,"method":"blockNumber","params":[0],"note":"method"})");
+    BOOST_REQUIRE(reader.parse(connector->m_response, response));
+    BOOST_CHECK(response["result"] == "0x0");
+}
+
+/// the streamed and the tree getBlockByHash both answer the canonical hash
+BOOST_AUTO_TEST_CASE(testGetBlockByHashCanonical)
+{
+    std::string blockHash = "0x067150C07DAB4FACB7160E075548007E067150C07DAB4FACB7160E075548007E";
+    Json::Value response = rpc->getBlockByHash(0, blockHash, false);
+    BOOST_CHECK_EQUAL(response["hash"].asString(),
+        "0x067150c07dab4facb7160e075548007e067150c07dab4facb7160e075548007e");
+    std::string streamed;
+    JsonWriter writer(streamed);
+    rpc->getBlockByHash(writer, 0, blockHash, false);
+    BOOST_CHECK_EQUAL(streamed, fastWrite(response));
+}
+
+BOOST_AUTO_TEST_CASE(testBatchRequest)
+{
+    ModularServer<Rpc> server(new Rpc(m_ledgerManager, m_service));
+    auto connector = new RecordingConnector();
+    server.addConnector(connector);
+
+    /// a streamed call, one answered by jsonrpccpp and an invalid member, answered in order
+    connector->OnRequest(
+        R"([{"jsonrpc":"2.0","id":1,"method":"getBlocksByRange","params":[0,"0x0","0x2",false]},)"
+        R"({"jsonrpc":"2.0","id":2,"method":"blockNumber","params":[0]},5])");
+    BOOST_CHECK_EQUAL(connector->m_response.back(), '\n');
+    Json::Value response;
+    Json::Reader reader;
+    BOOST_REQUIRE(reader.parse(connector->m_response, response));
+    BOOST_REQUIRE(response.isArray());
+    BOOST_REQUIRE_EQUAL(response.size(), 3);
+    BOOST_CHECK(response[0]["id"] == 1);
+    BOOST_CHECK(response[0]["result"] == rpc->getBlocksByRange(0, "0x0", "0x2", false));
+    BOOST_CHECK(response[1]["id"] == 2);
+    BOOST_CHECK(response[1]["result"] == "0x0");
+    BOOST_CHECK(response[2].isMember("error"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev
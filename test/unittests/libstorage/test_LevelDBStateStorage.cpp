@@ -1,4 +1,5 @@
 // "Copyright [2018] <fisco-dev>"
+#include "libstorage/Common.h"
 #include "libstorage/LevelDBStorage.h"
 #include <leveldb/db.h>
 #include <boost/test/unit_test.hpp>
@@ -102,6 +103,37 @@ struct MockWriteBatch
     int Count() { return DecodeFixed32(rep_.data() + 8); }
 };
 
+/// iterates over a copy of the data, like an implicit leveldb snapshot
+class MockIterator : public leveldb::Iterator
+{
+public:
+    MockIterator(std::map<std::string, std::string> const& _db) : m_db(_db), m_it(m_db.end()) {}
+
+    virtual bool Valid() const { return m_it != m_db.end(); }
+    virtual void SeekToFirst() { m_it = m_db.begin(); }
+    virtual void SeekToLast() { m_it = m_db.empty() ? m_db.end() : --m_db.end(); }
+    virtual void Seek(const Slice& target)
+    {
+        if (target.starts_with("e_Exception"))
+        {
+            m_status = Status::InvalidArgument(Slice("InvalidArgument"));
+            m_it = m_db.end();
+            return;
+        }
+        m_it = m_db.lower_bound(target.ToString());
+    }
+    virtual void Next() { ++m_it; }
+    virtual void Prev() { m_it = m_it == m_db.begin() ? m_db.end() : --m_it; }
+    virtual Slice key() const { return Slice(m_it->first); }
+    virtual Slice value() const { return Slice(m_it->second); }
+    virtual Status status() const { return m_status; }
+
+private:
+    std::map<std::string, std::string> m_db;
+    std::map<std::string, std::string>::iterator m_it;
+    Status m_status;
+};
+
 class MockLevelDB : public leveldb::DB
 {
 public:
@@ -130,12 +162,19 @@ public:
         for (size_t i = 0; i < count; ++i)
         {
             Slice key, value;
+            /// kTypeDeletion records carry no value
+            bool isDelete = input[0] == 0;
             input.remove_prefix(1);
             GetLengthPrefixedSlice(&input, &key);
+            if (isDelete)
+            {
+                db.erase(key.ToString());
+                continue;
+            }
             GetLengthPrefixedSlice(&input, &value);
-            if (key.ToString() == "e_Exception")
+            if (key.starts_with("e_Exception"))
                 return Status::InvalidArgument(Slice("InvalidArgument"));
-            db.insert(std::make_pair(key.ToString(), value.ToString()));
+            db[key.ToString()] = value.ToString();
         }
         return Status::OK();
     }
@@ -151,13 +190,17 @@ public:
         return Status::OK();
     }
 
-    virtual Iterator* NewIterator(const ReadOptions& options) { return nullptr; }
+    virtual Iterator* NewIterator(const ReadOptions& options) { return new MockIterator(db); }
 
     virtual const Snapshot* GetSnapshot() { return nullptr; }
 
     virtual void ReleaseSnapshot(const Snapshot* snapshot) {}
 
-    virtual bool GetProperty(const Slice& property, std::string* value) { return true; }
+    virtual bool GetProperty(const Slice& property, std::string* value)
+    {
+        *value = "1";
+        return true;
+    }
 
     virtual void GetApproximateSizes(const Range* range, int n, uint64_t* sizes) {}
 
@@ -169,6 +212,7 @@ public:
     };
     virtual void SuspendCompactions(){};
     virtual void ResumeCompactions(){};
+    size_t size() const { return db.size(); }
 
 private:
     // No copying allowed
@@ -182,7 +226,7 @@ struct LevelDBFixture
     LevelDBFixture()
     {
         levelDB = std::make_shared<dev::storage::LevelDBStorage>();
-        std::shared_ptr<MockLevelDB> mockLevelDB = std::make_shared<MockLevelDB>();
+        mockLevelDB = std::make_shared<MockLevelDB>();
         levelDB->setDB(mockLevelDB);
     }
     Entries::Ptr getEntries()
@@ -194,7 +238,28 @@ struct LevelDBFixture
         entries->addEntry(entry);
         return entries;
     }
+    void commitValue(int64_t _num, std::string const& _key, std::string const& _value)
+    {
+        std::vector<dev::storage::TableData::Ptr> datas;
+        dev::storage::TableData::Ptr tableData = std::make_shared<dev::storage::TableData>();
+        tableData->tableName = "t_test";
+        Entries::Ptr entries = std::make_shared<Entries>();
+        Entry::Ptr entry = std::make_shared<Entry>();
+        entry->setField("value", _value);
+        entries->addEntry(entry);
+        tableData->data.insert(std::make_pair(_key, entries));
+        datas.push_back(tableData);
+        levelDB->commit(h256(_num), _num, datas, h256(_num));
+    }
+    std::string selectValue(int _num, std::string const& _key)
+    {
+        auto entries = levelDB->select(h256(_num), _num, "t_test", _key);
+        if (entries->size() == 0)
+            return "";
+        return entries->get(0)->getField("value");
+    }
     dev::storage::LevelDBStorage::Ptr levelDB;
+    std::shared_ptr<MockLevelDB> mockLevelDB;
 };
 
 BOOST_FIXTURE_TEST_SUITE(LevelDB, LevelDBFixture);
@@ -237,6 +302,66 @@ BOOST_AUTO_TEST_CASE(commit)
     BOOST_CHECK_EQUAL(entries->size(), 1u);
 }
 
+BOOST_AUTO_TEST_CASE(selectHistory)
+{
+    commitValue(1, "LiSi", "a");
+    commitValue(3, "LiSi", "b");
+    commitValue(5, "LiSi", "c");
+    commitValue(4, "LiSi1", "d");
+
+    BOOST_CHECK_EQUAL(selectValue(0, "LiSi"), "");
+    BOOST_CHECK_EQUAL(selectValue(1, "LiSi"), "a");
+    BOOST_CHECK_EQUAL(selectValue(2, "LiSi"), "a");
+    BOOST_CHECK_EQUAL(selectValue(3, "LiSi"), "b");
+    BOOST_CHECK_EQUAL(selectValue(4, "LiSi"), "b");
+    BOOST_CHECK_EQUAL(selectValue(5, "LiSi"), "c");
+    BOOST_CHECK_EQUAL(selectValue(LATEST_BLOCK_NUM, "LiSi"), "c");
+    /// a key extending another one must not leak into its versions
+    BOOST_CHECK_EQUAL(selectValue(3, "LiSi1"), "");
+    BOOST_CHECK_EQUAL(selectValue(4, "LiSi1"), "d");
+}
+
+BOOST_AUTO_TEST_CASE(pruneHistory)
+{
+    levelDB->setHistoryBlocks(2);
+    commitValue(1, "LiSi", "a");
+    commitValue(1, "ZhangSan", "x");
+    commitValue(2, "LiSi", "b");
+    commitValue(2, "ZhangSan", "y");
+    commitValue(3, "LiSi", "c");
+    BOOST_CHECK_EQUAL(levelDB->oldestReadableBlock(), 1);
+    BOOST_CHECK_EQUAL(selectValue(1, "LiSi"), "a");
+
+    commitValue(5, "LiSi", "d");
+    BOOST_CHECK_EQUAL(levelDB->oldestReadableBlock(), 3);
+    BOOST_CHECK_THROW(selectValue(2, "LiSi"), boost::exception);
+    BOOST_CHECK_EQUAL(selectValue(3, "LiSi"), "c");
+    BOOST_CHECK_EQUAL(selectValue(4, "LiSi"), "c");
+    BOOST_CHECK_EQUAL(selectValue(5, "LiSi"), "d");
+    /// commits only move the watermark, the versions are deleted by prune
+    BOOST_CHECK_EQUAL(mockLevelDB->size(), 7u);
+
+    /// versions 1 and 2 of LiSi and 1 of ZhangSan, not written since, are deleted
+    BOOST_CHECK_EQUAL(levelDB->prune(), 3u);
+    BOOST_CHECK_EQUAL(selectValue(3, "LiSi"), "c");
+    BOOST_CHECK_EQUAL(selectValue(3, "ZhangSan"), "y");
+    BOOST_CHECK_EQUAL(selectValue(5, "ZhangSan"), "y");
+    /// left are LiSi 3 and 5, ZhangSan 2 and the oldest readable mark
+    BOOST_CHECK_EQUAL(mockLevelDB->size(), 4u);
+    BOOST_CHECK_EQUAL(levelDB->prune(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(status)
+{
+    Json::Value status = levelDB->status();
+    BOOST_CHECK(status.isMember("leveldb.stats"));
+    BOOST_CHECK_EQUAL(status["leveldb.num-files-at-level"].size(), 7);
+    BOOST_CHECK_EQUAL(status["leveldb.num-files-at-level"][0].asInt(), 1);
+    BOOST_CHECK_EQUAL(status["approximateSize"].asUInt64(), 0);
+    /// no block cache of its own when the db is set rather than opened
+    BOOST_CHECK(!status.isMember("blockCacheUsage"));
+}
+
 BOOST_AUTO_TEST_CASE(exception)
 {
     h256 h(0x01);
@@ -106,6 +106,7 @@ BOOST_AUTO_TEST_CASE(open_sysTables)
     table = memoryDBFactory->openTable(SYS_NUMBER_2_HASH);
     table = memoryDBFactory->openTable(SYS_TX_HASH_2_BLOCK);
     table = memoryDBFactory->openTable(SYS_HASH_2_BLOCK);
+    table = memoryDBFactory->openTable(SYS_BLOCK_2_NONCES);
 }
 
 BOOST_AUTO_TEST_CASE(setBlockHash)
@@ -24,6 +24,7 @@
 #include <libp2p/Common.h>
 #include <libsync/SyncMsgEngine.h>
 #include <libsync/SyncMsgPacket.h>
+#include <libtxpool/TxPool.h>
 #include <test/tools/libutils/TestOutputHelper.h>
 #include <test/unittests/libsync/FakeSyncToolsSet.h>
 #include <boost/test/unit_test.hpp>
@@ -100,6 +101,35 @@ BOOST_AUTO_TEST_CASE(SyncTransactionPacketTest)
     auto topTxs = txPoolPtr->topTransactions(1);
     BOOST_CHECK(topTxs.size() == 1);
     BOOST_CHECK_EQUAL(topTxs[0].sha3(), txPtr->sha3());
+
+    /// the same transaction from another peer is only marked as known by it
+    auto otherSessionPtr = fakeSyncToolsSet.createSessionWithID(h512(0x5678));
+    fakeMsgEngine.messageHandler(fakeException, otherSessionPtr, txPacket.toMessage(0x02));
+    BOOST_CHECK_EQUAL(txPoolPtr->pendingSize(), 1);
+    BOOST_CHECK(txPoolPtr->isTransactionKonwnBy(txPtr->sha3(), h512(0x5678)));
+}
+
+BOOST_AUTO_TEST_CASE(SyncRejectedTransactionRegossipTest)
+{
+    auto txPacket = SyncTransactionsPacket();
+    auto txPtr = fakeSyncToolsSet.createTransaction(0);
+    txPacket.encode(0x01, txPtr->rlp());
+    auto txPool = std::dynamic_pointer_cast<dev::txpool::TxPool>(fakeSyncToolsSet.getTxPoolPtr());
+    BOOST_REQUIRE(txPool);
+
+    /// the block limit is out of range, the first import fails
+    txPool->setMaxBlockLimit(u256(10));
+    auto fakeSessionPtr = fakeSyncToolsSet.createSession();
+    fakeMsgEngine.messageHandler(fakeException, fakeSessionPtr, txPacket.toMessage(0x02));
+    BOOST_CHECK_EQUAL(txPool->pendingSize(), 0);
+    BOOST_CHECK(!txPool->isTransactionInPool(txPtr->sha3()));
+
+    /// the rejected transaction is verified again when gossiped later
+    txPool->setMaxBlockLimit(u256(1000));
+    auto otherSessionPtr = fakeSyncToolsSet.createSessionWithID(h512(0x5678));
+    fakeMsgEngine.messageHandler(fakeException, otherSessionPtr, txPacket.toMessage(0x02));
+    BOOST_CHECK_EQUAL(txPool->pendingSize(), 1);
+    BOOST_CHECK(txPool->isTransactionInPool(txPtr->sha3()));
 }
 
 BOOST_AUTO_TEST_CASE(SyncBlocksPacketTest)
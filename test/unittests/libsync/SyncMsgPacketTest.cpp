@@ -22,12 +22,15 @@
  */
 
 #include <libdevcrypto/Common.h>
+#include <libethcore/Protocol.h>
 #include <libp2p/Common.h>
+#include <libp2p/MessageDispatcher.h>
 #include <libsync/SyncMsgPacket.h>
 #include <test/tools/libutils/TestOutputHelper.h>
 #include <test/unittests/libethcore/FakeBlock.h>
 #include <test/unittests/libp2p/FakeHost.h>
 #include <boost/test/unit_test.hpp>
+#include <future>
 #include <memory>
 
 using namespace std;
@@ -153,6 +156,51 @@ BOOST_AUTO_TEST_CASE(SyncTransactionsPacketTest)
     BOOST_CHECK(tx == fakeTransaction);
 }
 
+/// the transactions packets of the sync protocol are transaction gossip for the dispatcher
+BOOST_AUTO_TEST_CASE(SyncTransactionsDispatchTest)
+{
+    PROTOCOL_ID syncProtocolID = eth::getGroupProtoclID(1, eth::ProtocolID::BlockSync);
+    SyncTransactionsPacket txPacket;
+    txPacket.encode(0x01, fakeTransaction.rlp());
+    auto txMsg = txPacket.toMessage(syncProtocolID);
+    SyncStatusPacket statusPacket;
+    statusPacket.encode(0x00, h256(0xab), h256(0xcd));
+    auto statusMsg = statusPacket.toMessage(syncProtocolID);
+
+    PROTOCOL_ID gossipID = MessageDispatcher::queueID(txMsg->protocolID(), ref(*txMsg->buffer()));
+    BOOST_CHECK_EQUAL(gossipID, eth::getGroupProtoclID(1, eth::ProtocolID::TxPool));
+    BOOST_CHECK_EQUAL(MessageDispatcher::priority(gossipID), 2);
+    BOOST_CHECK(MessageDispatcher::lossy(gossipID));
+    PROTOCOL_ID statusID =
+        MessageDispatcher::queueID(statusMsg->protocolID(), ref(*statusMsg->buffer()));
+    BOOST_CHECK_EQUAL(statusID, syncProtocolID);
+    BOOST_CHECK(!MessageDispatcher::lossy(statusID));
+
+    /// behind a busy thread, a flood of transactions packets drops its oldest ones rather than
+    /// pause the socket, and the status read behind it goes first
+    auto dispatcher =
+        make_shared<MessageDispatcher>(make_shared<ThreadPool>("SyncDispatchTest", 1), 4);
+    auto running = make_shared<promise<void>>();
+    promise<void> released;
+    auto releasedFuture = released.get_future().share();
+    dispatcher->push(eth::getGroupProtoclID(1, eth::ProtocolID::PBFT), [=]() {
+        running->set_value();
+        releasedFuture.wait();
+    });
+    running->get_future().wait();
+    vector<size_t> run;
+    for (size_t i = 0; i < 6; i++)
+        BOOST_CHECK(dispatcher->push(gossipID, [&run, i]() { run.push_back(i); }));
+    bool statusFirst = false;
+    BOOST_CHECK(dispatcher->push(statusID, [&]() { statusFirst = run.empty(); }));
+    auto done = make_shared<promise<void>>();
+    BOOST_CHECK(dispatcher->push(gossipID, [done]() { done->set_value(); }));
+    released.set_value();
+    done->get_future().wait();
+    BOOST_CHECK(statusFirst);
+    BOOST_CHECK(run == vector<size_t>({3, 4, 5}));
+}
+
 BOOST_AUTO_TEST_CASE(SyncBlocksPacketTest)
 {
     SyncBlocksPacket blocksPacket;
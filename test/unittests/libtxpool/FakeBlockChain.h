@@ -57,6 +57,11 @@ public:
             m_asyncSend[nodeID] = 1;
         m_asyncSendMsgs[nodeID] = message;
     }
+    void asyncMulticastMessageByNodeIDList(NodeIDs const& nodeIDs, Message::Ptr message) override
+    {
+        for (auto const& nodeID : nodeIDs)
+            asyncSendMessageByNodeID(nodeID, message);
+    }
     size_t getAsyncSendSizeByNodeID(NodeID const& nodeID)
     {
         if (!m_asyncSend.count(nodeID))
@@ -165,6 +170,7 @@ public:
         m_blockChain.push_back(p_block);
         m_blockHash[p_block->blockHeader().hash()] = m_blockNumber;
         m_blockNumber += 1;
+        return CommitResult::OK;
     }
     void setGroupMark(std::string const& groupMark) override {}
     std::map<h256, int64_t> m_blockHash;
@@ -25,6 +25,7 @@
 #include <libdevcrypto/Common.h>
 #include <test/tools/libutils/TestOutputHelper.h>
 #include <boost/test/unit_test.hpp>
+#include <thread>
 using namespace dev;
 using namespace dev::txpool;
 using namespace dev::blockchain;
@@ -136,6 +137,131 @@ BOOST_AUTO_TEST_CASE(testImportAndSubmit)
     pool_test.m_txPool->setMaxBlockLimit(u256(100));
     BOOST_CHECK(pool_test.m_txPool->maxBlockLimit() == u256(100));
 }
+
+BOOST_AUTO_TEST_CASE(testSubmitAsync)
+{
+    TxPoolFixture pool_test(5, 5);
+    std::shared_ptr<FakeBlockChain> blockChain = pool_test.m_blockChain;
+    Transactions trans = blockChain->getBlockByNumber(0)->transactions();
+    std::vector<bytes> encoded;
+    for (size_t i = 0; i < trans.size(); i++)
+    {
+        Transaction tx = trans[i];
+        tx.setNonce(tx.nonce() + u256(i) + u256(1));
+        tx.setBlockLimit(blockChain->number() + u256(1));
+        Signature sig = sign(blockChain->m_sec, tx.sha3(WithoutSignature));
+        tx.updateSignature(SignatureStruct(sig));
+        bytes data;
+        tx.encode(data);
+        encoded.push_back(data);
+    }
+    /// the hash comes back before the import, which follows on the ingress threads
+    pool_test.m_txPool->setIngressThreads(2);
+    for (auto const& data : encoded)
+        BOOST_CHECK(pool_test.m_txPool->submitAsync(ref(data)) == sha3(data));
+    for (size_t i = 0; i < 100 && pool_test.m_txPool->pendingSize() < encoded.size(); i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    BOOST_CHECK_EQUAL(pool_test.m_txPool->pendingSize(), encoded.size());
+
+    /// duplicates are accepted and dropped at the import
+    BOOST_CHECK(pool_test.m_txPool->submitAsync(ref(encoded[0])) == sha3(encoded[0]));
+    /// refused without queueing: malformed and invalid block limit
+    bytes malformed(encoded[0].begin(), encoded[0].begin() + 10);
+    BOOST_CHECK_THROW(pool_test.m_txPool->submitAsync(ref(malformed)), Exception);
+    Transaction tx = trans[0];
+    tx.setNonce(tx.nonce() + u256(100));
+    tx.setBlockLimit(blockChain->number());
+    Signature sig = sign(blockChain->m_sec, tx.sha3(WithoutSignature));
+    tx.updateSignature(SignatureStruct(sig));
+    bytes data;
+    tx.encode(data);
+    BOOST_CHECK_THROW(pool_test.m_txPool->submitAsync(ref(data)), TransactionRefused);
+
+    /// batchImport reports each transaction
+    tx.setBlockLimit(blockChain->number() + u256(1));
+    sig = sign(blockChain->m_sec, tx.sha3(WithoutSignature));
+    tx.updateSignature(SignatureStruct(sig));
+    Transactions batch{tx, Transaction(encoded[1], CheckTransaction::Everything)};
+    std::vector<ImportResult> results = pool_test.m_txPool->batchImport(batch);
+    BOOST_REQUIRE_EQUAL(results.size(), 2);
+    BOOST_CHECK(results[0] == ImportResult::Success);
+    BOOST_CHECK(results[1] == ImportResult::AlreadyKnown);
+    BOOST_CHECK_EQUAL(pool_test.m_txPool->pendingSize(), encoded.size() + 1);
+}
+
+BOOST_AUTO_TEST_CASE(testTopTransactionsSince)
+{
+    TxPoolFixture pool_test(5, 5);
+    std::shared_ptr<FakeBlockChain> blockChain = pool_test.m_blockChain;
+    Transactions trans = blockChain->getBlockByNumber(0)->transactions();
+    Transactions imported;
+    for (size_t i = 0; i < trans.size(); i++)
+    {
+        Transaction tx = trans[i];
+        tx.setNonce(tx.nonce() + u256(i) + u256(1));
+        tx.setBlockLimit(blockChain->number() + u256(1));
+        Signature sig = sign(blockChain->m_sec, tx.sha3(WithoutSignature));
+        tx.updateSignature(SignatureStruct(sig));
+        imported.push_back(tx);
+    }
+    Transactions first(imported.begin(), imported.begin() + 4);
+    pool_test.m_txPool->batchImport(first);
+
+    /// each call continues after the transactions returned before
+    uint64_t cursor = 0;
+    Transactions top = pool_test.m_txPool->topTransactionsSince(3, cursor);
+    BOOST_REQUIRE_EQUAL(top.size(), 3);
+    for (size_t i = 0; i < top.size(); i++)
+        BOOST_CHECK(top[i].sha3() == imported[i].sha3());
+    /// a dropped transaction is skipped
+    BOOST_CHECK(pool_test.m_txPool->drop(imported[3].sha3()));
+    BOOST_CHECK(pool_test.m_txPool->topTransactionsSince(3, cursor).empty());
+    Transactions last{imported[4]};
+    pool_test.m_txPool->batchImport(last);
+    top = pool_test.m_txPool->topTransactionsSince(3, cursor);
+    BOOST_REQUIRE_EQUAL(top.size(), 1);
+    BOOST_CHECK(top[0].sha3() == imported[4].sha3());
+    BOOST_CHECK(pool_test.m_txPool->topTransactionsSince(3, cursor).empty());
+
+    /// a reset cursor starts from the front again
+    cursor = 0;
+    BOOST_CHECK_EQUAL(pool_test.m_txPool->topTransactionsSince(10, cursor).size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(testNonceCheckWindow)
+{
+    TxPoolFixture pool_test(5, 5);
+    std::shared_ptr<FakeBlockChain> blockChain = pool_test.m_blockChain;
+    NonceCheck nonceCheck(blockChain, pool_test.m_txPool->getProtocolId());
+    /// every block of the fake chain carries the same five transactions
+    Transactions trans = blockChain->getBlockByNumber(1)->transactions();
+    BOOST_CHECK_EQUAL(nonceCheck.size(), trans.size());
+    for (auto const& tx : trans)
+        BOOST_CHECK(nonceCheck.ok(tx) == false);
+
+    Transaction tx = trans[0];
+    tx.setNonce(tx.nonce() + u256(100));
+    Signature sig = sign(blockChain->m_sec, tx.sha3(WithoutSignature));
+    tx.updateSignature(SignatureStruct(sig));
+    BOOST_CHECK(nonceCheck.ok(tx, true) == true);
+    BOOST_CHECK(nonceCheck.ok(tx) == false);
+    nonceCheck.delCache(Transactions{tx});
+    BOOST_CHECK(nonceCheck.ok(tx) == true);
+
+    /// sliding the window over two empty blocks evicts every earlier nonce
+    u256 maxBlockSize = NonceCheck::maxblocksize;
+    NonceCheck::maxblocksize = u256(1);
+    for (size_t i = 0; i < 2; i++)
+    {
+        Block emptyBlock = FakeBlock().getBlock();
+        blockChain->commitBlock(emptyBlock, nullptr);
+    }
+    nonceCheck.updateCache();
+    NonceCheck::maxblocksize = maxBlockSize;
+    BOOST_CHECK_EQUAL(nonceCheck.size(), 0);
+    for (auto const& tx : trans)
+        BOOST_CHECK(nonceCheck.ok(tx) == true);
+}
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace dev